@@ -0,0 +1,78 @@
+#include "benchmarks.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+// the global operator new and delete of the cooker count the allocations for the benchmarks. each block keeps its
+// size in front of it for the live and peak bytes. the over-aligned forms are left to the standard library and are
+// not counted
+namespace
+{
+    constexpr size_t k_allocation_header_size = alignof(std::max_align_t);
+
+    std::atomic<uint64_t> g_allocation_count {0};
+    std::atomic<size_t>   g_live_bytes {0};
+    std::atomic<size_t>   g_peak_bytes {0};
+
+    void* allocate(size_t size) noexcept
+    {
+        void* block = std::malloc(size + k_allocation_header_size);
+        if (block == nullptr)
+            return nullptr;
+        *static_cast<size_t*>(block) = size;
+
+        g_allocation_count.fetch_add(1, std::memory_order_relaxed);
+        const size_t live_bytes = g_live_bytes.fetch_add(size, std::memory_order_relaxed) + size;
+        size_t       peak_bytes = g_peak_bytes.load(std::memory_order_relaxed);
+        while (live_bytes > peak_bytes &&
+               !g_peak_bytes.compare_exchange_weak(peak_bytes, live_bytes, std::memory_order_relaxed))
+        {
+        }
+        return static_cast<char*>(block) + k_allocation_header_size;
+    }
+
+    void* allocateOrThrow(size_t size)
+    {
+        void* pointer = allocate(size);
+        if (pointer == nullptr)
+            throw std::bad_alloc();
+        return pointer;
+    }
+
+    void deallocate(void* pointer) noexcept
+    {
+        if (pointer == nullptr)
+            return;
+        void* block = static_cast<char*>(pointer) - k_allocation_header_size;
+        g_live_bytes.fetch_sub(*static_cast<size_t*>(block), std::memory_order_relaxed);
+        std::free(block);
+    }
+} // namespace
+
+void* operator new(size_t size) { return allocateOrThrow(size); }
+void* operator new[](size_t size) { return allocateOrThrow(size); }
+void* operator new(size_t size, const std::nothrow_t&) noexcept { return allocate(size); }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept { return allocate(size); }
+
+void operator delete(void* pointer) noexcept { deallocate(pointer); }
+void operator delete[](void* pointer) noexcept { deallocate(pointer); }
+void operator delete(void* pointer, size_t) noexcept { deallocate(pointer); }
+void operator delete[](void* pointer, size_t) noexcept { deallocate(pointer); }
+void operator delete(void* pointer, const std::nothrow_t&) noexcept { deallocate(pointer); }
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept { deallocate(pointer); }
+
+namespace Piccolo
+{
+    AllocationCounts getAllocationCounts()
+    {
+        AllocationCounts counts;
+        counts.allocation_count = g_allocation_count.load(std::memory_order_relaxed);
+        counts.live_bytes       = g_live_bytes.load(std::memory_order_relaxed);
+        counts.peak_bytes       = g_peak_bytes.load(std::memory_order_relaxed);
+        return counts;
+    }
+
+    void resetPeakAllocatedBytes() { g_peak_bytes.store(g_live_bytes.load(std::memory_order_relaxed)); }
+} // namespace Piccolo
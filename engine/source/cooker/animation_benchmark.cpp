@@ -0,0 +1,167 @@
+#include "benchmarks.h"
+
+#include "runtime/core/job/job_system.h"
+
+#include "runtime/function/framework/component/animation/animation_component.h"
+#include "runtime/function/framework/component/component_storage.h"
+#include "runtime/function/global/global_context.h"
+
+#include "runtime/resource/asset_manager/asset_manager.h"
+#include "runtime/resource/config_manager/config_manager.h"
+#include "runtime/resource/res_type/common/level.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Piccolo
+{
+    namespace
+    {
+        const char* const k_animation_benchmark_level_url = "asset/level/animation_benchmark.level.json";
+
+        // the animation component of each object of the level, as its definition describes it
+        bool loadLevelAnimationComponents(const std::string& level_url, std::vector<AnimationComponent>& out_components)
+        {
+            const AssetManager& asset_manager = *g_runtime_global_context.m_asset_manager;
+
+            LevelRes level_res;
+            if (!asset_manager.loadAsset(level_url, level_res))
+                return false;
+
+            std::map<std::string, std::shared_ptr<const ObjectDefinitionRes>> definitions;
+            for (const ObjectInstanceRes& object_instance_res : level_res.m_objects)
+            {
+                std::shared_ptr<const ObjectDefinitionRes>& definition_res =
+                    definitions[object_instance_res.m_definition];
+                if (!definition_res)
+                {
+                    definition_res =
+                        asset_manager.loadSharedAsset<ObjectDefinitionRes>(object_instance_res.m_definition);
+                    if (!definition_res)
+                        return false;
+                }
+
+                for (const auto& component : definition_res->m_components)
+                {
+                    if (component && component.getTypeName() == "AnimationComponent")
+                    {
+                        out_components.push_back(*static_cast<const AnimationComponent*>(component.getPtr()));
+                    }
+                }
+            }
+            return true;
+        }
+    } // namespace
+
+    int benchmarkAnimation(uint32_t character_count)
+    {
+        const uint32_t frame_count = 60;
+        const float    delta_time  = 1.0f / 30.0f;
+
+        std::vector<AnimationComponent> level_components;
+        if (!loadLevelAnimationComponents(k_animation_benchmark_level_url, level_components) ||
+            level_components.empty())
+        {
+            std::cout << "no animated object in " << k_animation_benchmark_level_url
+                      << ", generate it with scripts/generate_animation_benchmark_level.py" << std::endl;
+            return 1;
+        }
+        if (character_count == 0)
+        {
+            character_count = static_cast<uint32_t>(level_components.size());
+        }
+
+        // the characters are pooled and ticked by the storage of the components, declared as the level does
+        ComponentStorage component_storage;
+        component_storage.registerPool<AnimationComponent>(
+            "AnimationComponent", {{"AnimationAsset", "TransformComponent"}, {}, true});
+
+        std::vector<AnimationComponent*> characters;
+        characters.reserve(character_count);
+        for (uint32_t character_index = 0; character_index < character_count; ++character_index)
+        {
+            Reflection::ReflectionPtr<Component> component(
+                "AnimationComponent",
+                new AnimationComponent(level_components[character_index % level_components.size()]));
+            component_storage.adopt(component, Reflection::TypeIdOf<AnimationComponent>::value);
+            characters.push_back(static_cast<AnimationComponent*>(component.getPtr()));
+        }
+
+        // the skeletons and the clips are read by the first character
+        AllocationCounts start_counts = getAllocationCounts();
+        auto             start_time   = std::chrono::steady_clock::now();
+        for (AnimationComponent* character : characters)
+        {
+            character->postLoadResource(std::weak_ptr<GObject>());
+        }
+        const double   load_seconds     = getBenchmarkSecondsSince(start_time);
+        const uint64_t load_allocations = getAllocationCounts().allocation_count - start_counts.allocation_count;
+
+        // the first tick sizes the poses of the skeletons
+        start_counts = getAllocationCounts();
+        component_storage.tick(delta_time);
+        const uint64_t first_tick_allocations = getAllocationCounts().allocation_count - start_counts.allocation_count;
+
+        std::cout << character_count << " characters of " << k_animation_benchmark_level_url << ", "
+                  << characters.front()->getSkeleton().getBonesCount() << " bones, " << frame_count
+                  << " frames at the full animation lod" << std::endl;
+        std::cout << std::fixed << std::setprecision(2) << "load:       " << load_seconds * 1000.0 << " ms, "
+                  << load_allocations << " allocations" << std::endl;
+        std::cout << "first tick: " << first_tick_allocations << " allocations" << std::endl;
+
+        // the workers the engine starts by default, at least 4 so that the cost of the workers shows on small
+        // machines too
+        JobSystem default_job_system;
+        default_job_system.initialize(g_runtime_global_context.m_config_manager->getJobWorkerCount());
+        const uint32_t max_worker_count = std::max(default_job_system.getWorkerCount(), 4u);
+        default_job_system.clear();
+
+        std::vector<uint32_t> worker_counts {0};
+        for (uint32_t worker_count = 1; worker_count < max_worker_count; worker_count *= 2)
+        {
+            worker_counts.push_back(worker_count);
+        }
+        worker_counts.push_back(max_worker_count);
+
+        std::cout << "workers  ms per frame  us per character  allocations per frame" << std::endl;
+        bool is_allocating = false;
+        for (uint32_t worker_count : worker_counts)
+        {
+            std::shared_ptr<JobSystem> job_system = std::make_shared<JobSystem>();
+            job_system->initialize(static_cast<int>(worker_count));
+            g_runtime_global_context.m_job_system = job_system;
+
+            // the queue of the jobs is sized by a first frame
+            component_storage.tick(delta_time);
+
+            start_counts = getAllocationCounts();
+            start_time   = std::chrono::steady_clock::now();
+            for (uint32_t frame = 0; frame < frame_count; ++frame)
+            {
+                component_storage.tick(delta_time);
+            }
+            const double   tick_seconds     = getBenchmarkSecondsSince(start_time) / frame_count;
+            const uint64_t tick_allocations = getAllocationCounts().allocation_count - start_counts.allocation_count;
+
+            g_runtime_global_context.m_job_system.reset();
+            job_system->clear();
+
+            std::cout << std::setw(7) << worker_count << std::setw(14) << tick_seconds * 1000.0 << std::setw(18)
+                      << tick_seconds * 1000000.0 / character_count << std::setw(23)
+                      << static_cast<double>(tick_allocations) / frame_count << std::endl;
+            is_allocating = is_allocating || tick_allocations != 0;
+        }
+
+        if (is_allocating)
+        {
+            std::cout << "the ticks of the animation components allocate" << std::endl;
+            return 1;
+        }
+        return 0;
+    }
+} // namespace Piccolo
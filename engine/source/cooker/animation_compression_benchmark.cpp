@@ -0,0 +1,232 @@
+#include "benchmarks.h"
+
+#include "runtime/core/meta/serializer/binary_serializer.h"
+
+#include "runtime/function/animation/animation_compression.h"
+#include "runtime/function/animation/animation_loader.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Piccolo
+{
+    namespace
+    {
+        bool isAnimationClipFile(const std::filesystem::path& file_path)
+        {
+            const std::string file_name   = file_path.filename().generic_string();
+            const std::string clip_suffix = ".animation_clip.json";
+            return file_name.size() > clip_suffix.size() &&
+                   file_name.compare(file_name.size() - clip_suffix.size(), clip_suffix.size(), clip_suffix) == 0;
+        }
+
+        // the key of a track at a frame, missing keys repeat the last one like in the compressed clip
+        template<typename T>
+        const T& getTrackKey(const std::vector<T>& keys, uint32_t frame, const T& default_value)
+        {
+            return keys.empty() ? default_value : keys[std::min<size_t>(frame, keys.size() - 1)];
+        }
+
+        // what the skeleton sampled from the source clip before the compression
+        void sampleSourceClip(const AnimationClip& clip, float phase, AnimationPose& out_pose)
+        {
+            const uint32_t channel_count =
+                static_cast<uint32_t>(std::min<size_t>(std::max(clip.node_count, 0), clip.node_channels.size()));
+            const uint32_t frame_count = static_cast<uint32_t>(std::max(clip.total_frame, 1));
+            out_pose.position.resize(channel_count);
+            out_pose.rotation.resize(channel_count);
+            out_pose.scaling.resize(channel_count);
+
+            const float    exact_frame = std::clamp(phase, 0.f, 1.f) * (frame_count - 1);
+            const uint32_t frame_low   = std::min(static_cast<uint32_t>(exact_frame), frame_count - 1);
+            const uint32_t frame_high  = std::min(frame_low + 1, frame_count - 1);
+            const float    alpha       = exact_frame - frame_low;
+            for (uint32_t channel = 0; channel < channel_count; ++channel)
+            {
+                const AnimationChannel& source_channel = clip.node_channels[channel];
+                out_pose.position[channel] =
+                    Vector3::lerp(getTrackKey(source_channel.position_keys, frame_low, Vector3::ZERO),
+                                  getTrackKey(source_channel.position_keys, frame_high, Vector3::ZERO),
+                                  alpha);
+                out_pose.rotation[channel] =
+                    Quaternion::nLerp(alpha,
+                                      getTrackKey(source_channel.rotation_keys, frame_low, Quaternion::IDENTITY),
+                                      getTrackKey(source_channel.rotation_keys, frame_high, Quaternion::IDENTITY),
+                                      true);
+                out_pose.scaling[channel] =
+                    Vector3::lerp(getTrackKey(source_channel.scaling_keys, frame_low, Vector3::UNIT_SCALE),
+                                  getTrackKey(source_channel.scaling_keys, frame_high, Vector3::UNIT_SCALE),
+                                  alpha);
+            }
+        }
+
+        // angle between two rotations, from the chord between the quaternions
+        float getRotationError(const Quaternion& lhs, const Quaternion& rhs)
+        {
+            const Quaternion difference = lhs.dot(rhs) < 0.f ? lhs + rhs : lhs - rhs;
+            return 4.f * std::asin(0.5f * std::min(difference.length(), 2.f));
+        }
+
+        struct PoseError
+        {
+            float position {0.f};
+            float rotation {0.f};
+            float scaling {0.f};
+        };
+
+        void accumulatePoseError(const AnimationPose& pose, const AnimationPose& source_pose, PoseError& error)
+        {
+            for (size_t channel = 0; channel < source_pose.rotation.size(); ++channel)
+            {
+                error.position =
+                    std::max(error.position, pose.position[channel].distance(source_pose.position[channel]));
+                error.rotation =
+                    std::max(error.rotation, getRotationError(pose.rotation[channel], source_pose.rotation[channel]));
+                error.scaling = std::max(error.scaling, pose.scaling[channel].distance(source_pose.scaling[channel]));
+            }
+        }
+
+        // so the sampled poses are not optimized away
+        float getPoseChecksum(const AnimationPose& pose)
+        {
+            float checksum = 0.f;
+            for (size_t channel = 0; channel < pose.rotation.size(); ++channel)
+            {
+                checksum += pose.position[channel].x + pose.rotation[channel].w + pose.scaling[channel].z;
+            }
+            return checksum;
+        }
+
+        bool arePosesEqual(const AnimationPose& lhs, const AnimationPose& rhs)
+        {
+            return lhs.position == rhs.position && lhs.rotation == rhs.rotation && lhs.scaling == rhs.scaling;
+        }
+    } // namespace
+
+    int benchmarkAnimationCompression(const std::filesystem::path& asset_folder)
+    {
+        const float    tolerance_scales[] = {0.1f, 1.0f, 10.0f, 100.0f};
+        const uint32_t sample_count       = 1000;
+        const uint32_t pass_count         = 20;
+
+        bool     is_round_trip_equal = true;
+        uint32_t clip_count          = 0;
+        float    checksum            = 0.f;
+        for (const auto& directory_entry : std::filesystem::recursive_directory_iterator {asset_folder})
+        {
+            const std::filesystem::path& clip_file = directory_entry.path();
+            if (!directory_entry.is_regular_file() || !isAnimationClipFile(clip_file))
+                continue;
+
+            const std::shared_ptr<AnimationClip> clip =
+                AnimationLoader().loadAnimationClipData(clip_file.generic_string());
+            clip_count++;
+            std::cout << clip_file.filename().generic_string() << ": " << clip->total_frame << " frames, "
+                      << clip->node_channels.size() << " channels" << std::endl;
+
+            // the error against the size, the errors are the largest of the tracks on the keys
+            std::cout << "tolerance     bytes   ratio  constant  over  position error  rotation error  scale error"
+                      << std::endl;
+            CompressedAnimationClip compressed_clip;
+            for (float tolerance_scale : tolerance_scales)
+            {
+                const AnimationCompressionSettings default_settings;
+                AnimationCompressionSettings       settings;
+                settings.position_tolerance = default_settings.position_tolerance * tolerance_scale;
+                settings.rotation_tolerance = default_settings.rotation_tolerance * tolerance_scale;
+                settings.scale_tolerance    = default_settings.scale_tolerance * tolerance_scale;
+                compressed_clip.compress(*clip, settings);
+
+                const AnimationCompressionReport& report = compressed_clip.getReport();
+                std::cout << std::setw(8) << std::defaultfloat << std::setprecision(3) << tolerance_scale << "x"
+                          << std::setw(10) << report.compressed_size;
+                std::cout << std::fixed << std::setprecision(2) << std::setw(8)
+                          << static_cast<double>(report.raw_size) / report.compressed_size;
+                std::cout << std::setw(10) << report.constant_track_count << std::setw(6)
+                          << report.over_tolerance_track_count;
+                std::cout << std::scientific << std::setprecision(2) << std::setw(16) << report.max_position_error
+                          << std::setw(16) << report.max_rotation_error << std::setw(13) << report.max_scale_error
+                          << std::defaultfloat << std::endl;
+            }
+
+            // what a load costs when the clip is compressed then and when its cooked data is read
+            auto start_time = std::chrono::steady_clock::now();
+            for (uint32_t pass = 0; pass < pass_count; ++pass)
+            {
+                compressed_clip.compress(*clip);
+            }
+            const double compress_seconds = getBenchmarkSecondsSince(start_time) / pass_count;
+
+            BinaryWriter writer;
+            compressed_clip.write(writer);
+            CompressedAnimationClip cooked_clip;
+            start_time = std::chrono::steady_clock::now();
+            for (uint32_t pass = 0; pass < pass_count; ++pass)
+            {
+                BinaryReader reader(writer.getBuffer().data(), writer.getBuffer().size());
+                is_round_trip_equal = is_round_trip_equal && cooked_clip.read(reader) && reader.remaining() == 0;
+            }
+            const double read_seconds = getBenchmarkSecondsSince(start_time) / pass_count;
+            std::cout << std::fixed << std::setprecision(3) << "compress: " << compress_seconds * 1000.0
+                      << " ms, read the cooked " << writer.getBuffer().size() << " bytes: " << read_seconds * 1000.0
+                      << " ms" << std::endl;
+
+            // the cooked clip must sample the same poses as the one compressed at load
+
+            AnimationPose pose;
+            AnimationPose cooked_pose;
+            AnimationPose source_pose;
+            PoseError     sampled_error;
+            for (uint32_t sample = 0; sample < sample_count; ++sample)
+            {
+                const float phase = (sample + 0.5f) / sample_count;
+                compressed_clip.sample(phase, pose);
+                cooked_clip.sample(phase, cooked_pose);
+                sampleSourceClip(*clip, phase, source_pose);
+                is_round_trip_equal = is_round_trip_equal && arePosesEqual(pose, cooked_pose);
+                accumulatePoseError(pose, source_pose, sampled_error);
+            }
+
+            start_time = std::chrono::steady_clock::now();
+            for (uint32_t pass = 0; pass < pass_count; ++pass)
+            {
+                for (uint32_t sample = 0; sample < sample_count; ++sample)
+                {
+                    sampleSourceClip(*clip, (sample + 0.5f) / sample_count, source_pose);
+                    checksum += getPoseChecksum(source_pose);
+                }
+            }
+            const double source_seconds = getBenchmarkSecondsSince(start_time) / (pass_count * sample_count);
+
+            start_time = std::chrono::steady_clock::now();
+            for (uint32_t pass = 0; pass < pass_count; ++pass)
+            {
+                for (uint32_t sample = 0; sample < sample_count; ++sample)
+                {
+                    compressed_clip.sample((sample + 0.5f) / sample_count, pose);
+                    checksum += getPoseChecksum(pose);
+                }
+            }
+            const double compressed_seconds = getBenchmarkSecondsSince(start_time) / (pass_count * sample_count);
+
+            std::cout << "sampled between the keys, largest error: position " << std::scientific
+                      << std::setprecision(2) << sampled_error.position << ", rotation " << sampled_error.rotation
+                      << ", scale " << sampled_error.scaling << std::endl;
+            std::cout << std::fixed << std::setprecision(3) << "sample: source " << source_seconds * 1000000.0
+                      << " us, compressed " << compressed_seconds * 1000000.0 << " us" << std::endl;
+        }
+
+        std::cout << clip_count << " clips, checksum " << std::defaultfloat << checksum << std::endl;
+        if (!is_round_trip_equal)
+        {
+            std::cout << "a clip read back from its cooked data samples other poses" << std::endl;
+            return 1;
+        }
+        return 0;
+    }
+} // namespace Piccolo
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+
+// the --benchmark modes of PiccoloAssetCooker besides the serializers, each prints its measurements and returns the
+// exit code of the cooker, 1 when a checked result is wrong
+namespace Piccolo
+{
+    inline double getBenchmarkSecondsSince(std::chrono::steady_clock::time_point start_time)
+    {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+    }
+
+    // counted by the operator new of the cooker since it started
+    struct AllocationCounts
+    {
+        uint64_t allocation_count {0};
+        size_t   live_bytes {0};
+        size_t   peak_bytes {0};
+    };
+
+    AllocationCounts getAllocationCounts();
+    // the peak starts again from the bytes allocated now
+    void resetPeakAllocatedBytes();
+
+    // TiledFrustumCullBoxes against TiledFrustumIntersectBox box by box and against the bvh, on generated boxes
+    int benchmarkCulling();
+    // the mesh cooking and the steps of MeshOptimizer on the obj, or on a generated 2.4M triangle sphere and a 2M
+    // triangle heightfield without one
+    int benchmarkMeshOptimizer(const std::filesystem::path& obj_path);
+    // RenderDrawList against the maps of material to mesh to nodes the mesh passes built, at 1k to 50k nodes
+    int benchmarkDrawList();
+    // the load and the ticks of the animation components of the generated animation_benchmark level, copied to the
+    // character count, or as many as the level has with 0, pooled and ticked on 0, 1, 2, 4... workers up to the
+    // default JobWorkerCount. fails when a tick allocates
+    int benchmarkAnimation(uint32_t character_count);
+    // the size and the error of each clip of the folder compressed at several tolerances, and the sampling of the
+    // compressed clip against the source one. fails when a clip read back from its cooked data samples other poses
+    int benchmarkAnimationCompression(const std::filesystem::path& asset_folder);
+    // the guids of the parts and the materials of the render scene, from the allocator against the maps it replaced
+    int benchmarkGuidAllocator();
+    // the json assets of the level read from the json and from the cooked files, with the peak and the kept heap
+    int benchmarkLevelLoad(const std::string& level_url);
+} // namespace Piccolo
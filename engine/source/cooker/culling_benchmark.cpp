@@ -0,0 +1,127 @@
+#include "benchmarks.h"
+
+#include "runtime/core/math/math.h"
+#include "runtime/core/math/matrix4.h"
+
+#include "runtime/function/render/render_entity_bvh.h"
+#include "runtime/function/render/render_helper.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace Piccolo
+{
+    namespace
+    {
+        struct CullingView
+        {
+            const char* name;
+            Vector3     eye;
+            Vector3     target;
+        };
+
+        // the render camera projection, looking at target with z up
+        ClusterFrustum createViewFrustum(const CullingView& view)
+        {
+            const Matrix4x4 fix_matrix(1, 0, 0, 0, 0, -1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1);
+            const Matrix4x4 proj_matrix =
+                fix_matrix * Math::makePerspectiveMatrix(Radian(Degree(60.0f)), 16.0f / 9.0f, 0.1f, 1000.0f);
+            const Matrix4x4 view_matrix = Math::makeLookAtMatrix(view.eye, view.target, Vector3::UNIT_Z);
+            return CreateClusterFrustumFromMatrix(proj_matrix * view_matrix, -1.0, 1.0, -1.0, 1.0, 0.0, 1.0);
+        }
+
+        template<typename CullFunction>
+        double measureCulling(uint32_t pass_count, CullFunction&& cull)
+        {
+            const auto start_time = std::chrono::steady_clock::now();
+            for (uint32_t pass_index = 0; pass_index < pass_count; ++pass_index)
+            {
+                cull();
+            }
+            return getBenchmarkSecondsSince(start_time) / pass_count;
+        }
+
+        void printMilliseconds(double seconds)
+        {
+            std::cout << std::setw(10) << std::fixed << std::setprecision(3) << seconds * 1000.0;
+        }
+    } // namespace
+
+    int benchmarkCulling()
+    {
+        const uint32_t box_count  = 100000;
+        const uint32_t pass_count = 50;
+
+        // boxes of 0.5 to 4 meters scattered on a field of 1 km, as the entities of a large level
+        std::mt19937                          random_engine(7);
+        std::uniform_real_distribution<float> position_distribution(-500.0f, 500.0f);
+        std::uniform_real_distribution<float> height_distribution(0.0f, 5.0f);
+        std::uniform_real_distribution<float> size_distribution(0.5f, 4.0f);
+
+        std::vector<BoundingBox> boxes(box_count);
+        RenderEntityBvh          bvh;
+        for (uint32_t box_index = 0; box_index < box_count; ++box_index)
+        {
+            const Vector3 min_bound(position_distribution(random_engine),
+                                    position_distribution(random_engine),
+                                    height_distribution(random_engine));
+            const Vector3 size(
+                size_distribution(random_engine), size_distribution(random_engine), size_distribution(random_engine));
+            boxes[box_index] = BoundingBox(min_bound, min_bound + size);
+            bvh.insert(box_index, boxes[box_index]);
+        }
+
+        const CullingView views[] = {{"in the field", Vector3(0.0f, 0.0f, 2.0f), Vector3(100.0f, 0.0f, 2.0f)},
+                                     {"overlooking", Vector3(0.0f, 0.0f, 300.0f), Vector3(200.0f, 0.0f, 0.0f)},
+                                     {"at a corner", Vector3(-500.0f, -500.0f, 10.0f), Vector3(0.0f, 0.0f, 0.0f)}};
+
+        std::cout << box_count << " boxes, " << pass_count << " passes, TiledFrustumCullBoxes with "
+                  << TiledFrustumCullInstructionSet() << ", ms per pass" << std::endl;
+        std::cout << "view          visible    scalar    kernel       bvh" << std::endl;
+
+        bool                  is_matching = true;
+        std::vector<uint32_t> scalar_visible;
+        std::vector<uint32_t> kernel_visible;
+        std::vector<uint32_t> bvh_visible;
+        for (const CullingView& view : views)
+        {
+            const ClusterFrustum frustum = createViewFrustum(view);
+
+            const double scalar_seconds = measureCulling(pass_count, [&]() {
+                scalar_visible.clear();
+                for (uint32_t box_index = 0; box_index < box_count; ++box_index)
+                {
+                    if (TiledFrustumIntersectBox(frustum, boxes[box_index]))
+                    {
+                        scalar_visible.push_back(box_index);
+                    }
+                }
+            });
+            const double kernel_seconds = measureCulling(
+                pass_count, [&]() { TiledFrustumCullBoxes(frustum, bvh.getEntityBoundingBoxes(), kernel_visible); });
+            const double bvh_seconds =
+                measureCulling(pass_count, [&]() { bvh.queryFrustum(frustum, bvh_visible); });
+
+            // the bvh returns the entities in traversal order
+            std::sort(bvh_visible.begin(), bvh_visible.end());
+            is_matching = is_matching && kernel_visible == scalar_visible && bvh_visible == scalar_visible;
+
+            std::cout << std::left << std::setw(12) << view.name << std::right << std::setw(9)
+                      << scalar_visible.size();
+            printMilliseconds(scalar_seconds);
+            printMilliseconds(kernel_seconds);
+            printMilliseconds(bvh_seconds);
+            std::cout << std::endl;
+        }
+
+        if (!is_matching)
+        {
+            std::cout << "the kernel or the bvh does not return the visible boxes of the scalar test" << std::endl;
+            return 1;
+        }
+        return 0;
+    }
+} // namespace Piccolo
@@ -0,0 +1,199 @@
+#include "benchmarks.h"
+
+#include "runtime/core/math/matrix4.h"
+
+#include "runtime/function/render/render_common.h"
+#include "runtime/function/render/render_draw_list.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <random>
+#include <vector>
+
+namespace Piccolo
+{
+    namespace
+    {
+        // what the mesh passes kept of a node in their maps before the draw list
+        struct MapMeshNode
+        {
+            const Matrix4x4*           model_matrix {nullptr};
+            const Matrix4x4*           joint_matrices {nullptr};
+            uint32_t                   joint_count {0};
+            const RenderMeshDrawRange* draw_ranges {nullptr};
+            uint32_t                   draw_range_count {0};
+        };
+
+        using MeshDrawcallBatch = std::map<VulkanPBRMaterial*, std::map<VulkanMesh*, std::vector<MapMeshNode>>>;
+
+        // the map of material to mesh to nodes that each mesh pass built every frame, returns the drawcall count so
+        // the maps are not optimized away
+        size_t buildDrawcallMap(const std::vector<RenderMeshNode>& nodes)
+        {
+            MeshDrawcallBatch drawcall_batch;
+            for (const RenderMeshNode& node : nodes)
+            {
+                auto& mesh_instanced = drawcall_batch[node.ref_material];
+                auto& mesh_nodes     = mesh_instanced[node.ref_mesh];
+
+                MapMeshNode temp;
+                temp.model_matrix     = node.model_matrix;
+                temp.draw_ranges      = node.draw_ranges;
+                temp.draw_range_count = node.draw_range_count;
+                if (node.enable_vertex_blending)
+                {
+                    temp.joint_matrices = node.joint_matrices;
+                    temp.joint_count    = node.joint_count;
+                }
+                mesh_nodes.push_back(temp);
+            }
+
+            size_t drawcall_count = 0;
+            for (const auto& mesh_instanced : drawcall_batch)
+            {
+                for (const auto& mesh_nodes : mesh_instanced.second)
+                {
+                    drawcall_count += (mesh_nodes.second.size() + s_mesh_per_drawcall_max_instance_count - 1) /
+                                      s_mesh_per_drawcall_max_instance_count;
+                }
+            }
+            return drawcall_count;
+        }
+
+        // every node of the pass in exactly one batch, the batches of one state within the instance limit
+        bool isDrawListValid(const RenderDrawList&              draw_list,
+                             RenderDrawListPass                 pass,
+                             const std::vector<RenderMeshNode>& nodes)
+        {
+            std::vector<const RenderMeshNode*> batched_nodes;
+            for (const RenderDrawBatch& batch : draw_list.getBatches(pass))
+            {
+                if (batch.instance_count == 0 || batch.instance_count > s_mesh_per_drawcall_max_instance_count)
+                    return false;
+
+                for (uint32_t instance = 0; instance < batch.instance_count; ++instance)
+                {
+                    const RenderMeshNode& node = draw_list.getInstance(batch.first_instance + instance);
+                    if (node.ref_mesh != batch.ref_mesh || node.ref_material != batch.ref_material ||
+                        node.enable_vertex_blending != batch.enable_vertex_blending)
+                        return false;
+                    batched_nodes.push_back(&node);
+                }
+            }
+
+            std::vector<const RenderMeshNode*> pass_nodes;
+            for (const RenderMeshNode& node : nodes)
+            {
+                pass_nodes.push_back(&node);
+            }
+            std::sort(batched_nodes.begin(), batched_nodes.end());
+            std::sort(pass_nodes.begin(), pass_nodes.end());
+            return batched_nodes == pass_nodes;
+        }
+    } // namespace
+
+    int benchmarkDrawList()
+    {
+        const uint32_t mesh_count     = 2000;
+        const uint32_t material_count = 500;
+        const uint32_t frame_count    = 20;
+
+        std::vector<VulkanMesh>        meshes(mesh_count);
+        std::vector<VulkanPBRMaterial> materials(material_count);
+        Matrix4x4                      joint_matrices[s_mesh_vertex_blending_max_joint_count];
+
+        std::cout << mesh_count << " meshes, " << material_count << " materials, 5% skinned, " << frame_count
+                  << " frames. the main camera view is drawn twice, by the gbuffer and the pick passes, the shadow "
+                     "views see half and a quarter of the nodes"
+                  << std::endl;
+        std::cout << "nodes     maps ms  draw list ms  batches" << std::endl;
+
+        bool is_valid = true;
+        for (uint32_t node_count : {1000u, 10000u, 50000u})
+        {
+            std::mt19937                            random_engine(node_count);
+            std::uniform_int_distribution<uint32_t> mesh_distribution(0, mesh_count - 1);
+            std::uniform_int_distribution<uint32_t> material_distribution(0, material_count - 1);
+            std::uniform_real_distribution<float>   position_distribution(-500.0f, 500.0f);
+            std::uniform_real_distribution<float>   skinned_distribution(0.0f, 1.0f);
+
+            std::vector<Matrix4x4>      model_matrices(node_count);
+            std::vector<RenderMeshNode> main_camera_nodes(node_count);
+            for (uint32_t node_index = 0; node_index < node_count; ++node_index)
+            {
+                model_matrices[node_index].makeTrans(Vector3(position_distribution(random_engine),
+                                                             position_distribution(random_engine),
+                                                             position_distribution(random_engine)));
+
+                const uint32_t mesh     = mesh_distribution(random_engine);
+                const uint32_t material = material_distribution(random_engine);
+
+                RenderMeshNode& node   = main_camera_nodes[node_index];
+                node.model_matrix      = &model_matrices[node_index];
+                node.ref_mesh          = &meshes[mesh];
+                node.ref_material      = &materials[material];
+                node.mesh_asset_id     = mesh + 1;
+                node.material_asset_id = material + 1;
+                node.node_id           = node_index;
+                if (skinned_distribution(random_engine) < 0.05f)
+                {
+                    node.enable_vertex_blending = true;
+                    node.joint_matrices         = joint_matrices;
+                    node.joint_count            = s_mesh_vertex_blending_max_joint_count;
+                }
+            }
+            const std::vector<RenderMeshNode> directional_light_nodes(main_camera_nodes.begin(),
+                                                                      main_camera_nodes.begin() + node_count / 2);
+            const std::vector<RenderMeshNode> point_light_nodes(main_camera_nodes.begin() + node_count / 2,
+                                                                main_camera_nodes.begin() + node_count * 3 / 4);
+
+            size_t drawcall_count = 0;
+            auto   start_time     = std::chrono::steady_clock::now();
+            for (uint32_t frame = 0; frame < frame_count; ++frame)
+            {
+                drawcall_count += buildDrawcallMap(main_camera_nodes);
+                drawcall_count += buildDrawcallMap(main_camera_nodes);
+                drawcall_count += buildDrawcallMap(directional_light_nodes);
+                drawcall_count += buildDrawcallMap(point_light_nodes);
+            }
+            const double map_seconds = getBenchmarkSecondsSince(start_time) / frame_count;
+
+            RenderDrawList draw_list;
+            start_time = std::chrono::steady_clock::now();
+            for (uint32_t frame = 0; frame < frame_count; ++frame)
+            {
+                draw_list.clear();
+                draw_list.addNodes(_draw_list_pass_main_camera, main_camera_nodes, Vector3::ZERO, Vector3::UNIT_X);
+                draw_list.addNodes(
+                    _draw_list_pass_directional_light, directional_light_nodes, Vector3::ZERO, Vector3::ZERO);
+                draw_list.addNodes(_draw_list_pass_point_lights, point_light_nodes, Vector3::ZERO, Vector3::ZERO);
+                draw_list.build();
+            }
+            const double draw_list_seconds = getBenchmarkSecondsSince(start_time) / frame_count;
+
+            is_valid = is_valid && isDrawListValid(draw_list, _draw_list_pass_main_camera, main_camera_nodes) &&
+                       isDrawListValid(draw_list, _draw_list_pass_directional_light, directional_light_nodes) &&
+                       isDrawListValid(draw_list, _draw_list_pass_point_lights, point_light_nodes);
+
+            size_t batch_count = 0;
+            for (uint32_t pass = 0; pass < _draw_list_pass_count; ++pass)
+            {
+                batch_count += draw_list.getBatches(static_cast<RenderDrawListPass>(pass)).size();
+            }
+            std::cout << std::setw(5) << node_count << std::fixed << std::setprecision(2) << std::setw(13)
+                      << map_seconds * 1000.0 << std::setw(14) << draw_list_seconds * 1000.0 << std::setw(9)
+                      << batch_count << std::endl;
+            // the maps drew the main camera view twice
+            is_valid = is_valid && drawcall_count > 0;
+        }
+
+        if (!is_valid)
+        {
+            std::cout << "a batch of the draw list misses nodes or mixes states" << std::endl;
+            return 1;
+        }
+        return 0;
+    }
+} // namespace Piccolo
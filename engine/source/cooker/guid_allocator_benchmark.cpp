@@ -0,0 +1,190 @@
+#include "benchmarks.h"
+
+#include "runtime/function/render/render_guid_allocator.h"
+#include "runtime/function/render/render_object.h"
+#include "runtime/function/render/render_type.h"
+
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Piccolo
+{
+    namespace
+    {
+        // the guid allocator the render scene had before, two maps and a probe for the first free guid
+        template<typename T>
+        class MapGuidAllocator
+        {
+        public:
+            size_t allocGuid(const T& t)
+            {
+                auto find_it = m_elements_guid_map.find(t);
+                if (find_it != m_elements_guid_map.end())
+                {
+                    return find_it->second;
+                }
+
+                for (size_t i = 0; i < m_guid_elements_map.size() + 1; i++)
+                {
+                    size_t guid = i + 1;
+                    if (m_guid_elements_map.find(guid) == m_guid_elements_map.end())
+                    {
+                        m_guid_elements_map.insert(std::make_pair(guid, t));
+                        m_elements_guid_map.insert(std::make_pair(t, guid));
+                        return guid;
+                    }
+                }
+
+                return s_invalid_guid;
+            }
+
+            bool hasElement(const T& t) { return m_elements_guid_map.find(t) != m_elements_guid_map.end(); }
+
+            void freeGuid(size_t guid)
+            {
+                auto find_it = m_guid_elements_map.find(guid);
+                if (find_it != m_guid_elements_map.end())
+                {
+                    const auto& ele = find_it->second;
+                    m_elements_guid_map.erase(ele);
+                    m_guid_elements_map.erase(guid);
+                }
+            }
+
+        private:
+            std::unordered_map<T, size_t> m_elements_guid_map;
+            std::unordered_map<size_t, T> m_guid_elements_map;
+        };
+
+        // the parts of the objects of a level are added, half of the objects leave and as many come back, like the
+        // instance ids of the render scene. returns the guids given to the parts that came back
+        template<typename Allocator>
+        std::vector<size_t> allocatePartGuids(Allocator& allocator, uint32_t object_count, uint32_t part_count)
+        {
+            std::vector<size_t> part_guids;
+            for (uint32_t object_index = 0; object_index < object_count; ++object_index)
+            {
+                for (uint32_t part_index = 0; part_index < part_count; ++part_index)
+                {
+                    part_guids.push_back(allocator.allocGuid(GameObjectPartId {object_index, part_index}));
+                }
+            }
+            for (size_t part_guid_index = 0; part_guid_index < part_guids.size(); part_guid_index += 2)
+            {
+                allocator.freeGuid(part_guids[part_guid_index]);
+            }
+
+            std::vector<size_t> new_part_guids;
+            for (uint32_t object_index = 0; object_index < object_count / 2; ++object_index)
+            {
+                for (uint32_t part_index = 0; part_index < part_count; ++part_index)
+                {
+                    new_part_guids.push_back(
+                        allocator.allocGuid(GameObjectPartId {object_count + object_index, part_index}));
+                }
+            }
+            return new_part_guids;
+        }
+
+        // the full paths of the textures of a material, as getMaterialSource gives them
+        MaterialSourceDesc makeMaterialSource(uint32_t material_index)
+        {
+            const std::string folder =
+                "/home/user/piccolo/engine/asset/objects/environment/props/material_" + std::to_string(material_index);
+            return {folder + "/base_color.png",
+                    folder + "/metallic_roughness.png",
+                    folder + "/normal.png",
+                    folder + "/occlusion.png",
+                    folder + "/emissive.png"};
+        }
+
+        // each part looks its material up and allocates its guid, like RenderSystem::addGameObject
+        template<typename Allocator>
+        size_t allocateMaterialGuids(Allocator& allocator, const std::vector<MaterialSourceDesc>& part_materials)
+        {
+            size_t loaded_count = 0;
+            for (const MaterialSourceDesc& material_source : part_materials)
+            {
+                loaded_count += allocator.hasElement(material_source) ? 1 : 0;
+                allocator.allocGuid(material_source);
+            }
+            return loaded_count;
+        }
+    } // namespace
+
+    int benchmarkGuidAllocator()
+    {
+        const uint32_t object_count        = 5000;
+        const uint32_t part_count          = 4;
+        const uint32_t material_part_count = 20000;
+        const uint32_t material_count      = 500;
+
+        std::cout << object_count << " objects of " << part_count << " parts, then half of them replaced. "
+                  << material_part_count << " parts over " << material_count << " materials" << std::endl;
+        std::cout << "               maps ms  guid allocator ms" << std::endl;
+
+        MapGuidAllocator<GameObjectPartId> map_part_allocator;
+        auto                               start_time = std::chrono::steady_clock::now();
+        allocatePartGuids(map_part_allocator, object_count, part_count);
+        const double map_part_seconds = getBenchmarkSecondsSince(start_time);
+
+        GuidAllocator<GameObjectPartId> part_allocator;
+        start_time                             = std::chrono::steady_clock::now();
+        const std::vector<size_t> part_guids   = allocatePartGuids(part_allocator, object_count, part_count);
+        const double              part_seconds = getBenchmarkSecondsSince(start_time);
+
+        std::cout << "parts    " << std::fixed << std::setprecision(2) << std::setw(13) << map_part_seconds * 1000.0
+                  << std::setw(19) << part_seconds * 1000.0 << std::endl;
+
+        std::mt19937                            random_engine(material_part_count);
+        std::uniform_int_distribution<uint32_t> material_distribution(0, material_count - 1);
+        std::vector<MaterialSourceDesc>         part_materials;
+        for (uint32_t part_index = 0; part_index < material_part_count; ++part_index)
+        {
+            part_materials.push_back(makeMaterialSource(material_distribution(random_engine)));
+        }
+
+        MapGuidAllocator<MaterialSourceDesc> map_material_allocator;
+        start_time                        = std::chrono::steady_clock::now();
+        const size_t map_loaded_count     = allocateMaterialGuids(map_material_allocator, part_materials);
+        const double map_material_seconds = getBenchmarkSecondsSince(start_time);
+
+        GuidAllocator<MaterialSourceDesc> material_allocator;
+        start_time                    = std::chrono::steady_clock::now();
+        const size_t loaded_count     = allocateMaterialGuids(material_allocator, part_materials);
+        const double material_seconds = getBenchmarkSecondsSince(start_time);
+
+        std::cout << "materials" << std::setw(13) << map_material_seconds * 1000.0 << std::setw(19)
+                  << material_seconds * 1000.0 << std::endl;
+
+        // the replaced parts reuse the freed guids and every guid gives its element back
+        bool is_valid = loaded_count == map_loaded_count;
+        for (size_t part_guid : part_guids)
+        {
+            GameObjectPartId part_id;
+            is_valid = is_valid && part_guid <= object_count * part_count &&
+                       part_allocator.getGuidRelatedElement(part_guid, part_id) && part_id.m_go_id >= object_count;
+        }
+        for (const MaterialSourceDesc& material_source : part_materials)
+        {
+            size_t             material_guid = s_invalid_guid;
+            MaterialSourceDesc found_material_source;
+            is_valid = is_valid && material_allocator.getElementGuid(material_source, material_guid) &&
+                       material_allocator.getGuidRelatedElement(material_guid, found_material_source) &&
+                       found_material_source == material_source;
+        }
+        is_valid = is_valid && part_allocator.getAllocatedGuids().size() == object_count * part_count &&
+                   material_allocator.getAllocatedGuids().size() == part_materials.size() - loaded_count;
+
+        if (!is_valid)
+        {
+            std::cout << "a guid does not give its element back" << std::endl;
+            return 1;
+        }
+        return 0;
+    }
+} // namespace Piccolo
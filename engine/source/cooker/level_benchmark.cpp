@@ -0,0 +1,110 @@
+#include "benchmarks.h"
+
+#include "runtime/function/global/global_context.h"
+
+#include "runtime/resource/asset_manager/asset_cooker.h"
+#include "runtime/resource/asset_manager/asset_manager.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <regex>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace Piccolo
+{
+    namespace
+    {
+        // the level and the cookable json assets it refers to, directly or through the assets it refers to
+        std::vector<std::filesystem::path> collectLevelAssets(const AssetManager& asset_manager,
+                                                              const std::string&  level_url)
+        {
+            const std::regex asset_url_pattern(R"url("(asset/[^"]+\.json)")url");
+
+            std::vector<std::filesystem::path> asset_paths {asset_manager.getFullPath(level_url).lexically_normal()};
+            std::set<std::filesystem::path>    visited_paths(asset_paths.begin(), asset_paths.end());
+            for (size_t asset_index = 0; asset_index < asset_paths.size(); ++asset_index)
+            {
+                std::ifstream     asset_file(asset_paths[asset_index], std::ios::binary);
+                const std::string asset_json_text {std::istreambuf_iterator<char>(asset_file),
+                                                   std::istreambuf_iterator<char>()};
+                const std::sregex_iterator matches_end;
+                for (std::sregex_iterator match(asset_json_text.begin(), asset_json_text.end(), asset_url_pattern);
+                     match != matches_end;
+                     ++match)
+                {
+                    const std::filesystem::path asset_path =
+                        asset_manager.getFullPath((*match)[1].str()).lexically_normal();
+                    if (AssetCooker::isCookable(asset_path) && visited_paths.insert(asset_path).second)
+                    {
+                        asset_paths.push_back(asset_path);
+                    }
+                }
+            }
+            return asset_paths;
+        }
+
+        void printKilobytes(const char* name, size_t size)
+        {
+            std::cout << name << std::fixed << std::setprecision(1) << std::setw(8)
+                      << static_cast<double>(size) / 1024.0 << " KB";
+        }
+    } // namespace
+
+    int benchmarkLevelLoad(const std::string& level_url)
+    {
+        const uint32_t      pass_count    = 10;
+        const AssetManager& asset_manager = *g_runtime_global_context.m_asset_manager;
+        const AssetCooker   asset_cooker(asset_manager);
+
+        const std::vector<std::filesystem::path> asset_paths = collectLevelAssets(asset_manager, level_url);
+        std::cout << level_url << ": " << asset_paths.size() << " json assets, " << pass_count
+                  << " passes, the heap is counted by the operator new of the cooker" << std::endl;
+        std::cout << std::left << std::setw(7) << "format" << std::right << std::setw(13) << "files" << std::setw(10)
+                  << "load ms" << std::setw(15) << "peak heap" << std::setw(15) << "kept heap" << std::endl;
+
+        bool is_loaded = true;
+        for (bool is_cooked : {false, true})
+        {
+            AssetLoadBenchmarkResult result;
+            double                   seconds    = 0.0;
+            size_t                   peak_bytes = 0;
+            size_t                   kept_bytes = 0;
+            for (uint32_t pass = 0; pass < pass_count && is_loaded; ++pass)
+            {
+                std::vector<std::shared_ptr<void>> assets;
+                resetPeakAllocatedBytes();
+                const AllocationCounts start_counts = getAllocationCounts();
+
+                result   = asset_cooker.benchmarkLoads(asset_paths, is_cooked, assets);
+                is_loaded = result.failed_count == 0;
+                seconds += result.seconds;
+
+                const AllocationCounts loaded_counts = getAllocationCounts();
+                peak_bytes = std::max(peak_bytes, loaded_counts.peak_bytes - start_counts.live_bytes);
+                kept_bytes = loaded_counts.live_bytes - start_counts.live_bytes;
+            }
+            if (!is_loaded)
+                break;
+
+            std::cout << std::left << std::setw(7) << (is_cooked ? "cooked" : "json") << std::right;
+            printKilobytes("  ", result.file_size);
+            std::cout << std::setw(10) << seconds * 1000.0 / pass_count;
+            printKilobytes("    ", peak_bytes);
+            printKilobytes("    ", kept_bytes);
+            std::cout << std::endl;
+        }
+
+        if (!is_loaded)
+        {
+            std::cout << "an asset of the level cannot be loaded, cook the asset folder first" << std::endl;
+            return 1;
+        }
+        return 0;
+    }
+} // namespace Piccolo
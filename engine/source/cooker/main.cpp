@@ -0,0 +1,306 @@
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cstring>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include "benchmarks.h"
+
+#include "runtime/core/log/log_system.h"
+#include "runtime/core/meta/reflection/reflection_register.h"
+
+#include "runtime/function/animation/animation_clip_blob.h"
+#include "runtime/function/animation/animation_system.h"
+#include "runtime/function/global/global_context.h"
+#include "runtime/function/render/mesh_blob.h"
+#include "runtime/function/render/render_resource_base.h"
+#include "runtime/function/render/texture_blob.h"
+
+#include "runtime/resource/asset_manager/asset_cooker.h"
+#include "runtime/resource/asset_manager/asset_manager.h"
+#include "runtime/resource/config_manager/config_manager.h"
+
+namespace
+{
+    void printUsage()
+    {
+        std::cerr << "usage: PiccoloAssetCooker <asset folder> "
+                     "[--force | --benchmark [serializers | culling | mesh [obj file] | draw-list | "
+                     "animation [character count] | animation-compression | guid-allocator | level [level url]]]"
+                  << std::endl;
+    }
+
+    // the whole text is a decimal number that fits in out_count
+    bool parseCount(const char* text, uint32_t& out_count)
+    {
+        const char* text_end     = text + std::strlen(text);
+        const auto [end, result] = std::from_chars(text, text_end, out_count);
+        return result == std::errc() && end == text_end;
+    }
+
+    bool isMeshSource(const std::filesystem::path& file_path)
+    {
+        if (file_path.extension() == ".obj")
+            return true;
+
+        const std::string file_name   = file_path.filename().generic_string();
+        const std::string json_suffix = ".mesh_bind.json";
+        return file_name.size() > json_suffix.size() &&
+               file_name.compare(file_name.size() - json_suffix.size(), json_suffix.size(), json_suffix) == 0;
+    }
+
+    // the meshes are cooked to mesh blobs instead of binary assets
+    Piccolo::AssetCookResult cookMeshes(const std::filesystem::path& asset_folder, bool force)
+    {
+        Piccolo::AssetCookResult result;
+        for (const auto& directory_entry : std::filesystem::recursive_directory_iterator {asset_folder})
+        {
+            const std::filesystem::path& mesh_file = directory_entry.path();
+            if (!directory_entry.is_regular_file() || !isMeshSource(mesh_file))
+                continue;
+
+            if (!force && Piccolo::MeshBlob::isUpToDate(mesh_file, Piccolo::MeshBlob::getBlobPath(mesh_file)))
+            {
+                result.skipped_count++;
+                continue;
+            }
+
+            if (Piccolo::RenderResourceBase::cookMeshData(Piccolo::MeshSourceDesc {mesh_file.generic_string()}))
+            {
+                result.cooked_count++;
+            }
+            else
+            {
+                result.failed_count++;
+            }
+        }
+        return result;
+    }
+
+    bool isImageSource(const std::filesystem::path& file_path)
+    {
+        std::string extension = file_path.extension().generic_string();
+        std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char character) {
+            return static_cast<char>(std::tolower(character));
+        });
+        return extension == ".png" || extension == ".jpg" || extension == ".jpeg" || extension == ".tga" ||
+               extension == ".hdr";
+    }
+
+    // the images are cooked to texture blobs with their compressed mip chain
+    Piccolo::AssetCookResult cookTextures(const std::filesystem::path& asset_folder, bool force)
+    {
+        Piccolo::AssetCookResult result;
+        for (const auto& directory_entry : std::filesystem::recursive_directory_iterator {asset_folder})
+        {
+            const std::filesystem::path& image_file = directory_entry.path();
+            if (!directory_entry.is_regular_file() || !isImageSource(image_file))
+                continue;
+
+            if (!force &&
+                Piccolo::TextureBlob::isUpToDate(image_file, Piccolo::TextureBlob::getBlobPath(image_file)))
+            {
+                result.skipped_count++;
+                continue;
+            }
+
+            if (Piccolo::RenderResourceBase::cookTextureData(image_file.generic_string()))
+            {
+                result.cooked_count++;
+            }
+            else
+            {
+                result.failed_count++;
+            }
+        }
+        return result;
+    }
+
+    bool isAnimationClipSource(const std::filesystem::path& file_path)
+    {
+        const std::string file_name   = file_path.filename().generic_string();
+        const std::string clip_suffix = ".animation_clip.json";
+        return file_name.size() > clip_suffix.size() &&
+               file_name.compare(file_name.size() - clip_suffix.size(), clip_suffix.size(), clip_suffix) == 0;
+    }
+
+    // the clips are compressed offline to animation clip blobs
+    Piccolo::AssetCookResult cookAnimationClips(const std::filesystem::path& asset_folder, bool force)
+    {
+        Piccolo::AssetCookResult result;
+        for (const auto& directory_entry : std::filesystem::recursive_directory_iterator {asset_folder})
+        {
+            const std::filesystem::path& clip_file = directory_entry.path();
+            if (!directory_entry.is_regular_file() || !isAnimationClipSource(clip_file))
+                continue;
+
+            if (!force && Piccolo::AnimationClipBlob::isUpToDate(clip_file,
+                                                                 Piccolo::AnimationClipBlob::getBlobPath(clip_file)))
+            {
+                result.skipped_count++;
+                continue;
+            }
+
+            // a relative url would be resolved from the root folder, not from the working directory
+            if (Piccolo::AnimationManager::cookAnimation(std::filesystem::absolute(clip_file).generic_string()))
+            {
+                result.cooked_count++;
+            }
+            else
+            {
+                result.failed_count++;
+            }
+        }
+        return result;
+    }
+
+    void printThroughput(const char* name, size_t json_size, double seconds)
+    {
+        const double megabytes = static_cast<double>(json_size) / (1024.0 * 1024.0);
+        std::cout << name << std::fixed << std::setprecision(1) << seconds * 1000.0 << " ms, "
+                  << (seconds > 0.0 ? megabytes / seconds : 0.0) << " MB/s" << std::endl;
+    }
+
+    // the json serializers over the assets of the folder, nothing is written
+    int benchmarkSerializers(const std::filesystem::path& asset_folder)
+    {
+        const uint32_t                          pass_count = 10;
+        Piccolo::AssetCooker                    asset_cooker(*Piccolo::g_runtime_global_context.m_asset_manager);
+        const Piccolo::SerializerBenchmarkResult result = asset_cooker.benchmarkSerializers(asset_folder, pass_count);
+
+        std::cout << "assets: " << result.asset_count << ", failed " << result.failed_count << ", json "
+                  << result.json_size << " bytes, " << pass_count << " passes" << std::endl;
+        printThroughput("document read:  ", result.json_size, result.document_read_seconds);
+        printThroughput("document write: ", result.json_size, result.document_write_seconds);
+        printThroughput("stream read:    ", result.json_size, result.stream_read_seconds);
+        printThroughput("stream write:   ", result.json_size, result.stream_write_seconds);
+        return result.failed_count == 0 ? 0 : 1;
+    }
+} // namespace
+
+// PiccoloAssetCooker <asset folder>
+//     [--force | --benchmark [serializers | culling | mesh [obj file] | draw-list | animation [character count] |
+//                             animation-compression | guid-allocator | level [level url]]]
+// cooks the json assets, the meshes, the textures and the animation clips of the folder next to them,
+// only the outdated ones without --force.
+// --benchmark measures instead:
+//   serializers, the default: the json serializers on the assets of the folder
+//   culling: the frustum culling of generated entity boxes
+//   mesh: cooks the obj file, or generated meshes of millions of triangles, and times the optimizer steps
+//   draw-list: the batching of the visible mesh nodes of generated scenes
+//   animation: the allocations and the time of the animation ticks of the animation_benchmark level, for each
+//              job worker count
+//   animation-compression: the error against the size of the compressed clips of the folder and their sampling
+//   guid-allocator: the guids of the parts and the materials of the render scene, against the previous maps
+//   level: the load time and the heap of the json assets of the level, 1-1 by default, json against cooked
+int main(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        printUsage();
+        return 1;
+    }
+
+    const std::filesystem::path asset_folder   = argv[1];
+    const bool                  force          = argc > 2 && std::string(argv[2]) == "--force";
+    const bool                  benchmark      = argc > 2 && std::string(argv[2]) == "--benchmark";
+    const std::string           benchmark_name = argc > 3 ? argv[3] : "serializers";
+    if (!std::filesystem::is_directory(asset_folder))
+    {
+        std::cerr << asset_folder.generic_string() << " is not a folder" << std::endl;
+        return 1;
+    }
+
+    // only the reflection and the log are needed to read and write the assets, not the whole engine
+    Piccolo::Reflection::TypeMetaRegister::metaRegister();
+    Piccolo::g_runtime_global_context.m_logger_system = std::make_shared<Piccolo::LogSystem>();
+    Piccolo::g_runtime_global_context.m_asset_manager = std::make_shared<Piccolo::AssetManager>();
+    // the urls of the assets start with the name of the asset folder
+    Piccolo::g_runtime_global_context.m_config_manager = std::make_shared<Piccolo::ConfigManager>();
+    Piccolo::g_runtime_global_context.m_config_manager->initializeRootFolder(
+        std::filesystem::absolute(asset_folder / "").parent_path().parent_path());
+
+    int exit_code = 0;
+    if (benchmark)
+    {
+        if (benchmark_name == "serializers")
+        {
+            exit_code = benchmarkSerializers(asset_folder);
+        }
+        else if (benchmark_name == "culling")
+        {
+            exit_code = Piccolo::benchmarkCulling();
+        }
+        else if (benchmark_name == "mesh")
+        {
+            exit_code = Piccolo::benchmarkMeshOptimizer(argc > 4 ? argv[4] : "");
+        }
+        else if (benchmark_name == "draw-list")
+        {
+            exit_code = Piccolo::benchmarkDrawList();
+        }
+        else if (benchmark_name == "animation")
+        {
+            uint32_t character_count = 0;
+            if (argc > 4 && !parseCount(argv[4], character_count))
+            {
+                std::cerr << argv[4] << " is not a character count" << std::endl;
+                printUsage();
+                exit_code = 1;
+            }
+            else
+            {
+                exit_code = Piccolo::benchmarkAnimation(character_count);
+            }
+        }
+        else if (benchmark_name == "animation-compression")
+        {
+            exit_code = Piccolo::benchmarkAnimationCompression(asset_folder);
+        }
+        else if (benchmark_name == "guid-allocator")
+        {
+            exit_code = Piccolo::benchmarkGuidAllocator();
+        }
+        else if (benchmark_name == "level")
+        {
+            exit_code = Piccolo::benchmarkLevelLoad(argc > 4 ? argv[4] : "asset/level/1-1.level.json");
+        }
+        else
+        {
+            std::cerr << "unknown benchmark " << benchmark_name << std::endl;
+            exit_code = 1;
+        }
+    }
+    else
+    {
+        Piccolo::AssetCooker           asset_cooker(*Piccolo::g_runtime_global_context.m_asset_manager);
+        const Piccolo::AssetCookResult result         = asset_cooker.cookFolder(asset_folder, force);
+        const Piccolo::AssetCookResult mesh_result    = cookMeshes(asset_folder, force);
+        const Piccolo::AssetCookResult texture_result = cookTextures(asset_folder, force);
+        const Piccolo::AssetCookResult clip_result    = cookAnimationClips(asset_folder, force);
+
+        std::cout << "assets: cooked " << result.cooked_count << ", up to date " << result.skipped_count
+                  << ", failed " << result.failed_count << std::endl;
+        std::cout << "meshes: cooked " << mesh_result.cooked_count << ", up to date " << mesh_result.skipped_count
+                  << ", failed " << mesh_result.failed_count << std::endl;
+        std::cout << "textures: cooked " << texture_result.cooked_count << ", up to date "
+                  << texture_result.skipped_count << ", failed " << texture_result.failed_count << std::endl;
+        std::cout << "animation clips: cooked " << clip_result.cooked_count << ", up to date "
+                  << clip_result.skipped_count << ", failed " << clip_result.failed_count << std::endl;
+        exit_code = result.failed_count == 0 && mesh_result.failed_count == 0 && texture_result.failed_count == 0 &&
+                            clip_result.failed_count == 0 ?
+                        0 :
+                        1;
+    }
+
+    Piccolo::g_runtime_global_context.m_asset_manager.reset();
+    Piccolo::g_runtime_global_context.m_config_manager.reset();
+    Piccolo::g_runtime_global_context.m_logger_system.reset();
+    Piccolo::Reflection::TypeMetaRegister::metaUnregister();
+
+    return exit_code;
+}
@@ -0,0 +1,322 @@
+#include "benchmarks.h"
+
+#include "runtime/core/math/axis_aligned.h"
+#include "runtime/core/math/math.h"
+
+#include "runtime/function/render/mesh_blob.h"
+#include "runtime/function/render/mesh_optimizer.h"
+#include "runtime/function/render/render_resource_base.h"
+
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace Piccolo
+{
+    namespace
+    {
+        using TriangleKey = std::array<float, 9>;
+
+        // a uv sphere with normals, ring_count * segment_count * 2 triangles less the degenerate ones at the poles
+        bool writeSphereObj(const std::filesystem::path& obj_path, uint32_t ring_count, uint32_t segment_count)
+        {
+            std::ofstream obj_file(obj_path);
+            obj_file << std::fixed << std::setprecision(6);
+            for (uint32_t ring = 0; ring <= ring_count; ++ring)
+            {
+                const float theta = Math_PI * ring / ring_count;
+                for (uint32_t segment = 0; segment < segment_count; ++segment)
+                {
+                    const float   phi = Math_PI * 2.0f * segment / segment_count;
+                    const Vector3 normal(
+                        std::sin(theta) * std::cos(phi), std::sin(theta) * std::sin(phi), std::cos(theta));
+                    obj_file << "v " << normal.x << ' ' << normal.y << ' ' << normal.z << '\n';
+                    obj_file << "vn " << normal.x << ' ' << normal.y << ' ' << normal.z << '\n';
+                }
+            }
+
+            auto write_face = [&](uint32_t a, uint32_t b, uint32_t c) {
+                obj_file << "f " << a + 1 << "//" << a + 1 << ' ' << b + 1 << "//" << b + 1 << ' ' << c + 1 << "//"
+                         << c + 1 << '\n';
+            };
+            for (uint32_t ring = 0; ring < ring_count; ++ring)
+            {
+                for (uint32_t segment = 0; segment < segment_count; ++segment)
+                {
+                    const uint32_t next_segment = (segment + 1) % segment_count;
+                    const uint32_t top_left     = ring * segment_count + segment;
+                    const uint32_t top_right    = ring * segment_count + next_segment;
+                    const uint32_t bottom_left  = (ring + 1) * segment_count + segment;
+                    const uint32_t bottom_right = (ring + 1) * segment_count + next_segment;
+                    if (ring != 0)
+                    {
+                        write_face(top_left, bottom_left, top_right);
+                    }
+                    if (ring != ring_count - 1)
+                    {
+                        write_face(top_right, bottom_left, bottom_right);
+                    }
+                }
+            }
+            return obj_file.good();
+        }
+
+        // a rolling terrain of 2 * cell_count^2 triangles with texture coordinates and no normals
+        bool writeHeightfieldObj(const std::filesystem::path& obj_path, uint32_t cell_count)
+        {
+            std::ofstream obj_file(obj_path);
+            obj_file << std::fixed << std::setprecision(6);
+            for (uint32_t row = 0; row <= cell_count; ++row)
+            {
+                for (uint32_t column = 0; column <= cell_count; ++column)
+                {
+                    const float u = static_cast<float>(column) / cell_count;
+                    const float v = static_cast<float>(row) / cell_count;
+                    const float height =
+                        std::sin(u * 25.0f) * std::cos(v * 17.0f) * 4.0f + std::sin((u + v) * 63.0f) * 0.5f;
+                    obj_file << "v " << u * 1000.0f << ' ' << v * 1000.0f << ' ' << height << '\n';
+                    obj_file << "vt " << u << ' ' << v << '\n';
+                }
+            }
+
+            auto write_face = [&](uint32_t a, uint32_t b, uint32_t c) {
+                obj_file << "f " << a + 1 << '/' << a + 1 << ' ' << b + 1 << '/' << b + 1 << ' ' << c + 1 << '/'
+                         << c + 1 << '\n';
+            };
+            const uint32_t row_size = cell_count + 1;
+            for (uint32_t row = 0; row < cell_count; ++row)
+            {
+                for (uint32_t column = 0; column < cell_count; ++column)
+                {
+                    const uint32_t corner = row * row_size + column;
+                    write_face(corner, corner + 1, corner + row_size);
+                    write_face(corner + 1, corner + row_size + 1, corner + row_size);
+                }
+            }
+            return obj_file.good();
+        }
+
+        uint32_t getIndex(const StaticMeshData& mesh_data, size_t index_position)
+        {
+            if (mesh_data.m_index_type == RHI_INDEX_TYPE_UINT16)
+                return static_cast<const uint16_t*>(mesh_data.m_index_buffer->m_data)[index_position];
+            return static_cast<const uint32_t*>(mesh_data.m_index_buffer->m_data)[index_position];
+        }
+
+        size_t getIndexCount(const StaticMeshData& mesh_data)
+        {
+            return mesh_data.m_index_buffer->m_size / MeshOptimizer::getIndexSize(mesh_data.m_index_type);
+        }
+
+        // the triangles of the mesh with three vertices each, in a random order, as a loader that does not share
+        // vertices gives them
+        std::vector<MeshVertexDataDefinition> expandTriangles(const StaticMeshData& mesh_data)
+        {
+            const MeshVertexDataDefinition* vertices =
+                static_cast<const MeshVertexDataDefinition*>(mesh_data.m_vertex_buffer->m_data);
+            const size_t triangle_count = getIndexCount(mesh_data) / 3;
+
+            std::vector<size_t> triangle_order(triangle_count);
+            for (size_t triangle = 0; triangle < triangle_count; ++triangle)
+            {
+                triangle_order[triangle] = triangle;
+            }
+            std::shuffle(triangle_order.begin(), triangle_order.end(), std::mt19937(11));
+
+            std::vector<MeshVertexDataDefinition> expanded_vertices;
+            expanded_vertices.reserve(triangle_count * 3);
+            for (size_t triangle : triangle_order)
+            {
+                for (size_t corner = 0; corner < 3; ++corner)
+                {
+                    expanded_vertices.push_back(vertices[getIndex(mesh_data, triangle * 3 + corner)]);
+                }
+            }
+            return expanded_vertices;
+        }
+
+        // the corner positions from the smallest one on, which keeps the winding
+        std::vector<TriangleKey> getSortedTriangles(const std::vector<MeshVertexDataDefinition>& vertices,
+                                                    const std::vector<uint32_t>&                 indices)
+        {
+            std::vector<TriangleKey> triangles(indices.size() / 3);
+            for (size_t triangle = 0; triangle < triangles.size(); ++triangle)
+            {
+                std::array<std::array<float, 3>, 3> corners;
+                for (size_t corner = 0; corner < 3; ++corner)
+                {
+                    const MeshVertexDataDefinition& vertex = vertices[indices[triangle * 3 + corner]];
+                    corners[corner]                        = {vertex.x, vertex.y, vertex.z};
+                }
+                const size_t first = std::min_element(corners.begin(), corners.end()) - corners.begin();
+                for (size_t corner = 0; corner < 3; ++corner)
+                {
+                    std::copy(corners[(first + corner) % 3].begin(),
+                              corners[(first + corner) % 3].end(),
+                              triangles[triangle].begin() + corner * 3);
+                }
+            }
+            std::sort(triangles.begin(), triangles.end());
+            return triangles;
+        }
+
+        void printStep(const char* name, double seconds)
+        {
+            std::cout << "  " << std::left << std::setw(30) << name << std::right << std::setw(10) << std::fixed
+                      << std::setprecision(1) << seconds * 1000.0 << " ms";
+        }
+
+        void printAcmr(float acmr) { std::cout << ", ACMR " << std::setprecision(3) << acmr; }
+
+        bool benchmarkMeshFile(const std::filesystem::path& obj_path)
+        {
+            const MeshSourceDesc mesh_source {obj_path.generic_string()};
+
+            auto start_time = std::chrono::steady_clock::now();
+            if (!RenderResourceBase::cookMeshData(mesh_source))
+            {
+                std::cout << "cooking " << obj_path.generic_string() << " failed" << std::endl;
+                return false;
+            }
+            const double cook_seconds = getBenchmarkSecondsSince(start_time);
+
+            start_time = std::chrono::steady_clock::now();
+            AxisAlignedBox       bounding_box;
+            const RenderMeshData mesh_data    = RenderResourceBase::decodeMeshData(mesh_source, bounding_box);
+            const double         load_seconds = getBenchmarkSecondsSince(start_time);
+
+            const StaticMeshData& static_mesh  = mesh_data.m_static_mesh_data;
+            const size_t          index_count  = getIndexCount(static_mesh);
+            const size_t          vertex_count = static_mesh.m_vertex_buffer->m_size / sizeof(MeshVertexDataDefinition);
+            const size_t meshlet_count = static_mesh.m_meshlet_buffer->m_size / sizeof(MeshletDataDefinition);
+            const double megabyte      = 1024.0 * 1024.0;
+
+            std::cout << obj_path.filename().generic_string() << ": " << index_count / 3 << " triangles, "
+                      << vertex_count << " vertices, "
+                      << (static_mesh.m_index_type == RHI_INDEX_TYPE_UINT16 ? 16 : 32) << " bit indices, "
+                      << meshlet_count << " meshlets" << std::endl;
+            std::cout << "  vertex and index data " << std::fixed << std::setprecision(1)
+                      << index_count * (sizeof(MeshVertexDataDefinition) + sizeof(uint32_t)) / megabyte
+                      << " MB expanded, "
+                      << (static_mesh.m_vertex_buffer->m_size + static_mesh.m_index_buffer->m_size) / megabyte
+                      << " MB optimized" << std::endl;
+            printStep("cook (parse, optimize, save)", cook_seconds);
+            std::cout << std::endl;
+            printStep("load of the blob", load_seconds);
+            std::cout << std::endl;
+
+            // the steps of optimizeMesh one by one on the same triangles, shuffled
+            std::vector<MeshVertexDataDefinition> vertices = expandTriangles(static_mesh);
+            std::vector<uint32_t>                 indices(vertices.size());
+            for (size_t index = 0; index < indices.size(); ++index)
+            {
+                indices[index] = static_cast<uint32_t>(index);
+            }
+            const std::vector<TriangleKey> source_triangles = getSortedTriangles(vertices, indices);
+
+            std::vector<MeshVertexDataDefinition> source_vertices = vertices;
+            std::vector<uint32_t>                 source_indices  = indices;
+            start_time                                            = std::chrono::steady_clock::now();
+            const RenderMeshData optimized_data =
+                MeshOptimizer::optimizeMesh(std::move(source_vertices), std::move(source_indices), {});
+            printStep("optimizeMesh", getBenchmarkSecondsSince(start_time));
+            std::cout << std::endl;
+
+            std::vector<uint32_t> remap;
+            start_time                = std::chrono::steady_clock::now();
+            const size_t welded_count = MeshOptimizer::weldVertices(vertices, {}, remap);
+            for (uint32_t& index : indices)
+            {
+                index = remap[index];
+            }
+            for (size_t vertex = 0; vertex < vertices.size(); ++vertex)
+            {
+                vertices[remap[vertex]] = vertices[vertex];
+            }
+            vertices.resize(welded_count);
+            printStep("  weldVertices", getBenchmarkSecondsSince(start_time));
+            printAcmr(MeshOptimizer::getAverageCacheMissRatio(indices, vertices.size()));
+            std::cout << std::endl;
+
+            start_time = std::chrono::steady_clock::now();
+            MeshOptimizer::optimizeVertexCache(indices, vertices.size());
+            printStep("  optimizeVertexCache", getBenchmarkSecondsSince(start_time));
+            printAcmr(MeshOptimizer::getAverageCacheMissRatio(indices, vertices.size()));
+            std::cout << std::endl;
+
+            start_time = std::chrono::steady_clock::now();
+            MeshOptimizer::optimizeOverdraw(indices, vertices);
+            printStep("  optimizeOverdraw", getBenchmarkSecondsSince(start_time));
+            printAcmr(MeshOptimizer::getAverageCacheMissRatio(indices, vertices.size()));
+            std::cout << std::endl;
+
+            start_time = std::chrono::steady_clock::now();
+            MeshOptimizer::optimizeVertexFetch(indices, vertices.size(), remap);
+            printStep("  optimizeVertexFetch", getBenchmarkSecondsSince(start_time));
+            std::cout << std::endl;
+
+            std::vector<MeshVertexDataDefinition> fetched_vertices(vertices.size());
+            for (size_t vertex = 0; vertex < vertices.size(); ++vertex)
+            {
+                if (remap[vertex] != UINT32_MAX)
+                {
+                    fetched_vertices[remap[vertex]] = vertices[vertex];
+                }
+            }
+            start_time = std::chrono::steady_clock::now();
+            MeshOptimizer::buildMeshlets(indices, fetched_vertices);
+            printStep("  buildMeshlets", getBenchmarkSecondsSince(start_time));
+            std::cout << std::endl;
+
+            // optimizeMesh may only reorder the triangles and their corners
+            const StaticMeshData& optimized_mesh = optimized_data.m_static_mesh_data;
+            const MeshVertexDataDefinition* optimized_vertex_data =
+                static_cast<const MeshVertexDataDefinition*>(optimized_mesh.m_vertex_buffer->m_data);
+            std::vector<uint32_t> optimized_indices(getIndexCount(optimized_mesh));
+            for (size_t index = 0; index < optimized_indices.size(); ++index)
+            {
+                optimized_indices[index] = getIndex(optimized_mesh, index);
+            }
+            const std::vector<MeshVertexDataDefinition> optimized_vertices(
+                optimized_vertex_data,
+                optimized_vertex_data + optimized_mesh.m_vertex_buffer->m_size / sizeof(MeshVertexDataDefinition));
+            if (getSortedTriangles(optimized_vertices, optimized_indices) != source_triangles)
+            {
+                std::cout << "optimizeMesh changed the triangles of " << obj_path.generic_string() << std::endl;
+                return false;
+            }
+            return true;
+        }
+    } // namespace
+
+    int benchmarkMeshOptimizer(const std::filesystem::path& obj_path)
+    {
+        if (!obj_path.empty())
+            return benchmarkMeshFile(obj_path) ? 0 : 1;
+
+        // the generated meshes and their blobs are removed afterwards
+        const std::filesystem::path temporary_folder = std::filesystem::temp_directory_path();
+        const std::filesystem::path sphere_path      = temporary_folder / "piccolo_benchmark_sphere.obj";
+        const std::filesystem::path heightfield_path = temporary_folder / "piccolo_benchmark_heightfield.obj";
+
+        auto start_time = std::chrono::steady_clock::now();
+        bool is_passed  = writeSphereObj(sphere_path, 1000, 1200) && writeHeightfieldObj(heightfield_path, 1000);
+        std::cout << "objs written in " << std::fixed << std::setprecision(1)
+                  << getBenchmarkSecondsSince(start_time) << " s" << std::endl;
+
+        is_passed = is_passed && benchmarkMeshFile(sphere_path);
+        is_passed = is_passed && benchmarkMeshFile(heightfield_path);
+
+        for (const std::filesystem::path& obj_path : {sphere_path, heightfield_path})
+        {
+            std::error_code error;
+            std::filesystem::remove(obj_path, error);
+            std::filesystem::remove(MeshBlob::getBlobPath(obj_path), error);
+        }
+        return is_passed ? 0 : 1;
+    }
+} // namespace Piccolo
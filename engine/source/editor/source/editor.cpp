@@ -10,11 +10,18 @@
 #include "editor/include/editor_scene_manager.h"
 #include "editor/include/editor_ui.h"
 
+#include "_generated/reflection/all_type_id.h"
+
 namespace Piccolo
 {
     void registerEdtorTickComponent(std::string component_type_name)
     {
-        g_editor_tick_component_types.insert(component_type_name);
+        const Reflection::TypeId component_type_id = Reflection::getTypeIdByName(component_type_name);
+        if (component_type_id >= Reflection::k_component_type_count)
+            return;
+
+        g_editor_tick_component_types.resize(Reflection::k_component_type_count, false);
+        g_editor_tick_component_types[component_type_id] = true;
     }
 
     PiccoloEditor::PiccoloEditor()
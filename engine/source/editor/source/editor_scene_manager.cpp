@@ -293,7 +293,7 @@ namespace Piccolo
             current_active_level->deleteGObjectByID(m_selected_gobject_id);
 
             RenderSwapContext& swap_context = g_editor_global_context.m_render_system->getSwapContext();
-            swap_context.getLogicSwapData().addDeleteGameObject(GameObjectDesc {selected_object->getID(), {}});
+            swap_context.getLogicCommands().deleteGameObject(selected_object->getID());
         }
         onGObjectSelected(k_invalid_gobject_id);
     }
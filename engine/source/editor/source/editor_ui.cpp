@@ -367,6 +367,14 @@ namespace Piccolo
                         }
                         ImGui::EndMenu();
                     }
+                    if (ImGui::BeginMenu("Performance"))
+                    {
+                        if (ImGui::MenuItem(g_runtime_global_context.m_render_debug_config->performance.show_tick_time ? "off tick time" : "show tick time"))
+                        {
+                            g_runtime_global_context.m_render_debug_config->performance.show_tick_time = !g_runtime_global_context.m_render_debug_config->performance.show_tick_time;
+                        }
+                        ImGui::EndMenu();
+                    }
                     ImGui::EndMenu();
                 }
                 if (ImGui::MenuItem("Exit"))
@@ -452,12 +460,8 @@ namespace Piccolo
 
     void EditorUI::createLeafNodeUI(Reflection::ReflectionInstance& instance)
     {
-        Reflection::FieldAccessor* fields;
-        int                        fields_count = instance.m_meta.getFieldsList(fields);
-
-        for (size_t index = 0; index < fields_count; index++)
+        for (const Reflection::FieldAccessor& field : instance.m_meta.getFields())
         {
-            auto field = fields[index];
             if (field.isArrayType())
             {
                 Reflection::ArrayAccessor array_accessor;
@@ -476,7 +480,7 @@ namespace Piccolo
                         {
                             m_editor_ui_creator["TreeNodePush"]("[" + std::to_string(index) + "]", nullptr);
                             auto object_instance = Reflection::ReflectionInstance(
-                                Piccolo::Reflection::TypeMeta::newMetaFromName(item_type_meta_item.getTypeName().c_str()),
+                                item_type_meta_item,
                                 array_accessor.get(index, field_instance));
                             createClassUI(object_instance);
                             m_editor_ui_creator["TreeNodePop"]("[" + std::to_string(index) + "]", nullptr);
@@ -523,7 +527,6 @@ namespace Piccolo
                                                                      field.get(instance.m_instance));
             }
         }
-        delete[] fields;
     }
 
     void EditorUI::showEditorDetailWindow(bool* p_open)
@@ -563,7 +566,7 @@ namespace Piccolo
         {
             m_editor_ui_creator["TreeNodePush"](("<" + component_ptr.getTypeName() + ">").c_str(), nullptr);
             auto object_instance = Reflection::ReflectionInstance(
-                Piccolo::Reflection::TypeMeta::newMetaFromName(component_ptr.getTypeName().c_str()),
+                Piccolo::Reflection::TypeMeta::newMetaFromName(component_ptr.getTypeName()),
                 component_ptr.operator->());
             createClassUI(object_instance);
             m_editor_ui_creator["TreeNodePop"](("<" + component_ptr.getTypeName() + ">").c_str(), nullptr);
@@ -45,6 +45,21 @@ std::string Cursor::getSourceFile(void) const
 
 bool Cursor::isDefinition(void) const { return clang_isCursorDefinition(m_handle); }
 
+bool Cursor::isFromMainFile(void) const
+{
+    // the reflected types are declared through the CLASS and STRUCT macros, whose expansions are not in any file, so
+    // the file the macro is expanded in is compared instead
+    CXFile file = nullptr;
+    clang_getExpansionLocation(clang_getCursorLocation(m_handle), &file, nullptr, nullptr, nullptr);
+    if (file == nullptr)
+        return false;
+
+    CXTranslationUnit translation_unit = clang_Cursor_getTranslationUnit(m_handle);
+    std::string       main_file_name;
+    Utils::toString(clang_getTranslationUnitSpelling(translation_unit), main_file_name);
+    return clang_File_isEqual(file, clang_getFile(translation_unit, main_file_name.c_str())) != 0;
+}
+
 CursorType Cursor::getType(void) const { return clang_getCursorType(m_handle); }
 
 Cursor::List Cursor::getChildren(void) const
@@ -19,6 +19,8 @@ public:
     std::string getSourceFile(void) const;
 
     bool isDefinition(void) const;
+    // declared in the file the translation unit was created from, not in one of its includes
+    bool isFromMainFile(void) const;
 
     CursorType getType(void) const;
 
@@ -21,6 +21,7 @@ namespace Generator
         GeneratorInterface::prepareStatus(path);
         TemplateManager::getInstance()->loadTemplates(m_root_path, "commonReflectionFile");
         TemplateManager::getInstance()->loadTemplates(m_root_path, "allReflectionFile");
+        TemplateManager::getInstance()->loadTemplates(m_root_path, "allTypeIdFile");
         return;
     }
 
@@ -53,6 +54,18 @@ namespace Generator
             class_names.insert_or_assign(class_temp->getClassName(), false);
             class_names[class_temp->getClassName()] = true;
 
+            if (class_temp->m_is_struct)
+                m_struct_names.insert(class_temp->getClassName());
+            else
+                m_struct_names.erase(class_temp->getClassName());
+
+            std::vector<std::string>& base_names = m_class_base_names[class_temp->getClassName()];
+            base_names.clear();
+            for (auto& base_class : class_temp->m_base_classes)
+            {
+                base_names.emplace_back(base_class->name);
+            }
+
             std::vector<std::string>                                   field_names;
             std::map<std::string, std::pair<std::string, std::string>> vector_map;
 
@@ -135,6 +148,60 @@ namespace Generator
         std::string render_string =
             TemplateManager::getInstance()->renderByTemplate("allReflectionFile", mustache_data);
         Utils::saveFile(render_string, m_out_path + "/all_reflection.h");
+
+        genTypeIdFile();
+    }
+
+    void ReflectionGenerator::genTypeIdFile()
+    {
+        static const std::string component_base_name = "Component";
+
+        // a class is a component type if Component is one of its direct or indirect bases
+        std::function<bool(const std::string&)> is_component_type = [&](const std::string& class_name) {
+            auto iter = m_class_base_names.find(class_name);
+            if (iter == m_class_base_names.end())
+                return false;
+            for (auto& base_name : iter->second)
+            {
+                if (base_name == component_base_name || is_component_type(base_name))
+                    return true;
+            }
+            return false;
+        };
+
+        // the component types take the ids from 0, so the objects can index their components by type id,
+        // both lists are sorted by name so the ids do not depend on the parsing order
+        std::vector<std::string> component_type_names;
+        std::vector<std::string> other_type_names;
+        for (auto& class_item : m_class_base_names)
+        {
+            if (is_component_type(class_item.first))
+                component_type_names.emplace_back(class_item.first);
+            else
+                other_type_names.emplace_back(class_item.first);
+        }
+
+        Mustache::data mustache_data;
+        Mustache::data class_defines = Mustache::data::type::list;
+
+        size_t type_id = 0;
+        for (auto type_names : {&component_type_names, &other_type_names})
+        {
+            for (auto& type_name : *type_names)
+            {
+                Mustache::data class_def;
+                class_def.set("class_name", type_name);
+                class_def.set("class_key", m_struct_names.count(type_name) ? "struct" : "class");
+                class_def.set("class_type_id", std::to_string(type_id++));
+                class_defines.push_back(class_def);
+            }
+        }
+        mustache_data.set("class_defines", class_defines);
+        mustache_data.set("component_type_count", std::to_string(component_type_names.size()));
+        mustache_data.set("type_count", std::to_string(type_id));
+
+        std::string render_string = TemplateManager::getInstance()->renderByTemplate("allTypeIdFile", mustache_data);
+        Utils::saveFile(render_string, m_out_path + "/all_type_id.h");
     }
 
     ReflectionGenerator::~ReflectionGenerator() {}
@@ -1,5 +1,8 @@
 #pragma once
 #include "generator/generator.h"
+
+#include <map>
+#include <set>
 namespace Generator
 {
     class ReflectionGenerator : public GeneratorInterface
@@ -16,7 +19,14 @@ namespace Generator
         virtual std::string processFileName(std::string path) override;
 
     private:
+        void genTypeIdFile();
+
         std::vector<std::string> m_head_file_list;
         std::vector<std::string> m_sourcefile_list;
+
+        // all reflected classes with the names of their base classes, used to number the types
+        std::map<std::string, std::vector<std::string>> m_class_base_names;
+        // the reflected classes declared with struct
+        std::set<std::string> m_struct_names;
     };
 } // namespace Generator
@@ -43,6 +43,12 @@ namespace Generator
             Mustache::data class_def;
             genClassRenderData(class_temp, class_def);
 
+            std::string binary_schema_signature = class_temp->getClassName() + ":";
+            for (auto& base_class : class_temp->m_base_classes)
+            {
+                binary_schema_signature += base_class->name + ",";
+            }
+
             // deal base class
             for (int index = 0; index < class_temp->m_base_classes.size(); ++index)
             {
@@ -61,6 +67,7 @@ namespace Generator
             {
                 if (!field->shouldCompile())
                     continue;
+                binary_schema_signature += ";" + field->m_type + " " + field->m_name;
                 // deal vector
                 if (field->m_type.find("std::vector") == 0)
                 {
@@ -79,6 +86,7 @@ namespace Generator
             }
             class_defines.push_back(class_def);
             m_class_defines.push_back(class_def);
+            m_binary_schema_signatures.push_back(binary_schema_signature);
         }
 
         muatache_data.set("class_defines", class_defines);
@@ -98,6 +106,18 @@ namespace Generator
         mustache_data.set("class_defines", m_class_defines);
         mustache_data.set("include_headfiles", m_include_headfiles);
 
+        // FNV-1a over the sorted signatures, independent of the order the headers were parsed in
+        std::sort(m_binary_schema_signatures.begin(), m_binary_schema_signatures.end());
+        uint32_t binary_schema_hash = 2166136261u;
+        for (const std::string& signature : m_binary_schema_signatures)
+        {
+            for (const char character : signature + "\n")
+            {
+                binary_schema_hash = (binary_schema_hash ^ static_cast<uint8_t>(character)) * 16777619u;
+            }
+        }
+        mustache_data.set("binary_schema_hash", std::to_string(binary_schema_hash));
+
         std::string render_string = TemplateManager::getInstance()->renderByTemplate("allSerializer.h", mustache_data);
         Utils::saveFile(render_string, m_out_path + "/all_serializer.h");
         render_string = TemplateManager::getInstance()->renderByTemplate("allSerializer.ipp", mustache_data);
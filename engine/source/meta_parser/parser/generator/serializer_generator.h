@@ -22,5 +22,7 @@ namespace Generator
     private:
         Mustache::data m_class_defines {Mustache::data::type::list};
         Mustache::data m_include_headfiles {Mustache::data::type::list};
+        // bases and field types of every serialized class, hashed into the binary schema version
+        std::vector<std::string> m_binary_schema_signatures;
     };
 } // namespace Generator
@@ -4,10 +4,12 @@
 
 BaseClass::BaseClass(const Cursor& cursor) : name(Utils::getTypeNameWithoutNamespace(cursor.getType())) {}
 
+BaseClass::BaseClass(const std::string& base_class_name) : name(base_class_name) {}
+
 Class::Class(const Cursor& cursor, const Namespace& current_namespace) :
     TypeInfo(cursor, current_namespace), m_name(cursor.getDisplayName()),
     m_qualified_name(Utils::getTypeNameWithoutNamespace(cursor.getType())),
-    m_display_name(Utils::getNameWithoutFirstM(m_qualified_name))
+    m_display_name(Utils::getNameWithoutFirstM(m_qualified_name)), m_is_struct(cursor.getKind() == CXCursor_StructDecl)
 {
     Utils::replaceAll(m_name, " ", "");
     Utils::replaceAll(m_name, "Piccolo::", "");
@@ -35,6 +37,17 @@ Class::Class(const Cursor& cursor, const Namespace& current_namespace) :
     }
 }
 
+Class::Class(const std::string& name,
+             const std::string& qualified_name,
+             bool               is_struct,
+             const MetaInfo&    meta_data,
+             const std::string& source_file,
+             const Namespace&   current_namespace) :
+    TypeInfo(meta_data, source_file, current_namespace),
+    m_name(name), m_qualified_name(qualified_name), m_display_name(Utils::getNameWithoutFirstM(m_qualified_name)),
+    m_is_struct(is_struct)
+{}
+
 bool Class::shouldCompile(void) const { return shouldCompileFields()|| shouldCompileMethods(); }
 
 bool Class::shouldCompileFields(void) const
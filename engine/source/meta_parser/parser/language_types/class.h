@@ -8,6 +8,7 @@
 struct BaseClass
 {
     BaseClass(const Cursor& cursor);
+    explicit BaseClass(const std::string& base_class_name);
 
     std::string name;
 };
@@ -21,6 +22,13 @@ class Class : public TypeInfo
 
 public:
     Class(const Cursor& cursor, const Namespace& current_namespace);
+    // read back from the meta cache, the bases, fields and methods are added by the cache
+    Class(const std::string& name,
+          const std::string& qualified_name,
+          bool               is_struct,
+          const MetaInfo&    meta_data,
+          const std::string& source_file,
+          const Namespace&   current_namespace);
 
     virtual bool shouldCompile(void) const;
 
@@ -44,5 +52,8 @@ public:
 
     std::string m_display_name;
 
+    // declared with struct rather than class, the forward declarations must use the same keyword
+    bool m_is_struct {false};
+
     bool isAccessible(void) const;
 };
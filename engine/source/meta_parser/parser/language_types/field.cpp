@@ -15,6 +15,17 @@ Field::Field(const Cursor& cursor, const Namespace& current_namespace, Class* pa
     m_default       = ret_string;
 }
 
+Field::Field(const std::string& name,
+             const std::string& type,
+             bool               is_const,
+             const MetaInfo&    meta_data,
+             const Namespace&   current_namespace,
+             Class*             parent) :
+    TypeInfo(meta_data, parent->getSourceFile(), current_namespace),
+    m_is_const(is_const), m_parent(parent), m_name(name), m_display_name(Utils::getNameWithoutFirstM(m_name)),
+    m_type(type), m_default(Utils::getStringWithoutQuot(m_meta_data.getProperty("default")))
+{}
+
 bool Field::shouldCompile(void) const { return isAccessible(); }
 
 bool Field::isAccessible(void) const
@@ -9,6 +9,12 @@ class Field : public TypeInfo
 
 public:
     Field(const Cursor& cursor, const Namespace& current_namespace, Class* parent = nullptr);
+    Field(const std::string& name,
+          const std::string& type,
+          bool               is_const,
+          const MetaInfo&    meta_data,
+          const Namespace&   current_namespace,
+          Class*             parent);
 
     virtual ~Field(void) {}
 
@@ -7,6 +7,10 @@ Method::Method(const Cursor& cursor, const Namespace& current_namespace, Class*
     TypeInfo(cursor, current_namespace), m_parent(parent), m_name(cursor.getSpelling())
 {}
 
+Method::Method(const std::string& name, const MetaInfo& meta_data, const Namespace& current_namespace, Class* parent) :
+    TypeInfo(meta_data, parent->getSourceFile(), current_namespace), m_parent(parent), m_name(name)
+{}
+
 bool Method::shouldCompile(void) const { return isAccessible(); }
 
 bool Method::isAccessible(void) const
@@ -9,6 +9,7 @@ class Method : public TypeInfo
 
 public:
     Method(const Cursor& cursor, const Namespace& current_namespace, Class* parent = nullptr);
+    Method(const std::string& name, const MetaInfo& meta_data, const Namespace& current_namespace, Class* parent);
 
     virtual ~Method(void) {}
 
@@ -3,14 +3,18 @@
 #include "type_info.h"
 
 TypeInfo::TypeInfo(const Cursor& cursor, const Namespace& current_namespace) :
-    m_meta_data(cursor), m_enabled(m_meta_data.getFlag(NativeProperty::Enable)), m_root_cursor(cursor),
-    m_namespace(current_namespace)
+    m_meta_data(cursor), m_enabled(m_meta_data.getFlag(NativeProperty::Enable)), m_namespace(current_namespace),
+    m_source_file(cursor.getSourceFile())
+{}
+
+TypeInfo::TypeInfo(const MetaInfo& meta_data, const std::string& source_file, const Namespace& current_namespace) :
+    m_meta_data(meta_data), m_enabled(m_meta_data.getFlag(NativeProperty::Enable)), m_namespace(current_namespace),
+    m_source_file(source_file)
 {}
 
 const MetaInfo& TypeInfo::getMetaData(void) const { return m_meta_data; }
 
-std::string TypeInfo::getSourceFile(void) const { return m_root_cursor.getSourceFile(); }
+std::string TypeInfo::getSourceFile(void) const { return m_source_file; }
 
 Namespace TypeInfo::getCurrentNamespace() const { return m_namespace; }
 
-Cursor& TypeInfo::getCurosr() { return m_root_cursor; }
@@ -10,6 +10,8 @@ class TypeInfo
 {
 public:
     TypeInfo(const Cursor& cursor, const Namespace& current_namespace);
+    // read back from the meta cache, without a cursor
+    TypeInfo(const MetaInfo& meta_data, const std::string& source_file, const Namespace& current_namespace);
     virtual ~TypeInfo(void) {}
 
     const MetaInfo& getMetaData(void) const;
@@ -18,8 +20,6 @@ public:
 
     Namespace getCurrentNamespace() const;
 
-    Cursor& getCurosr();
-
 protected:
     MetaInfo m_meta_data;
 
@@ -30,6 +30,7 @@ protected:
     Namespace m_namespace;
 
 private:
-    // cursor that represents the root of this language type
-    Cursor m_root_cursor;
+    // file of the cursor that represents the root of this language type, the cursor does not outlive its
+    // translation unit
+    std::string m_source_file;
 };
\ No newline at end of file
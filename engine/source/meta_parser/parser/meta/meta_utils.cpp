@@ -263,7 +263,7 @@ namespace Utils
         return template_stream.str();
     }
 
-    void saveFile(const std::string& outpu_string, const std::string& output_file)
+    bool saveFile(const std::string& outpu_string, const std::string& output_file)
     {
         fs::path out_path(output_file);
 
@@ -271,12 +271,26 @@ namespace Utils
         {
             fs::create_directories(out_path.parent_path());
         }
+
+        // an unchanged file keeps its time stamp, so the code including it is not rebuilt
+        std::ifstream existing_file_stream(output_file);
+        if (existing_file_stream.is_open())
+        {
+            std::stringstream existing_content;
+            existing_content << existing_file_stream.rdbuf();
+            if (existing_content.str() == outpu_string + "\n")
+            {
+                return false;
+            }
+            existing_file_stream.close();
+        }
+
         std::fstream output_file_stream(output_file, std::ios_base::out);
 
         output_file_stream << outpu_string << std::endl;
         output_file_stream.flush();
         output_file_stream.close();
-        return;
+        return true;
     }
 
     void replaceAll(std::string& resource_str, std::string sub_str, std::string new_str)
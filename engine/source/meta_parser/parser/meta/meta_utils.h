@@ -47,7 +47,8 @@ namespace Utils
 
     std::string loadFile(std::string path);
 
-    void saveFile(const std::string& outpu_string, const std::string& output_file);
+    // false when the file already had this content and was left untouched
+    bool saveFile(const std::string& outpu_string, const std::string& output_file);
 
     void replaceAll(std::string& resource_str, std::string sub_str, std::string new_str);
 
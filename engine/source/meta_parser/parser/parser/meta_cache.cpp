@@ -0,0 +1,271 @@
+#include "common/precompiled.h"
+
+#include "language_types/class.h"
+
+#include "meta_cache.h"
+
+namespace
+{
+    // bump when the cached data changes, the old caches are then ignored
+    const std::string k_cache_header  = "PiccoloMetaCache";
+    const std::string k_cache_version = "2";
+
+    std::string escape(const std::string& value)
+    {
+        std::string result;
+        result.reserve(value.size());
+        for (const char character : value)
+        {
+            switch (character)
+            {
+                case '\\':
+                    result += "\\\\";
+                    break;
+                case '\t':
+                    result += "\\t";
+                    break;
+                case '\n':
+                    result += "\\n";
+                    break;
+                case '\r':
+                    result += "\\r";
+                    break;
+                default:
+                    result += character;
+                    break;
+            }
+        }
+        return result;
+    }
+
+    // a line of tab separated escaped values
+    std::vector<std::string> splitLine(const std::string& line)
+    {
+        std::vector<std::string> values(1);
+        for (size_t index = 0; index < line.size(); ++index)
+        {
+            const char character = line[index];
+            if (character == '\t')
+            {
+                values.emplace_back();
+            }
+            else if (character == '\\' && index + 1 < line.size())
+            {
+                const char escaped = line[++index];
+                values.back() += escaped == 't' ? '\t' : escaped == 'n' ? '\n' : escaped == 'r' ? '\r' : escaped;
+            }
+            else
+            {
+                values.back() += character;
+            }
+        }
+        return values;
+    }
+
+    void writeProperties(std::ostream& out_stream, const MetaInfo& meta_data)
+    {
+        // sorted so the cache does not change from one run to the other
+        std::map<std::string, std::string> properties(meta_data.getProperties().begin(),
+                                                      meta_data.getProperties().end());
+        for (auto& property : properties)
+        {
+            out_stream << "meta\t" << escape(property.first) << "\t" << escape(property.second) << "\n";
+        }
+    }
+} // namespace
+
+MetaCache::MetaCache(std::string cache_file_path, uint64_t arguments_hash) :
+    m_cache_file_path(std::move(cache_file_path)), m_arguments_hash(arguments_hash)
+{}
+
+uint64_t MetaCache::hashString(const std::string& content)
+{
+    // FNV-1a
+    uint64_t hash = 14695981039346656037ull;
+    for (const char character : content)
+    {
+        hash = (hash ^ static_cast<uint8_t>(character)) * 1099511628211ull;
+    }
+    return hash;
+}
+
+uint64_t MetaCache::getFileHash(const std::string& file_path)
+{
+    auto iter = m_file_hashes.find(file_path);
+    if (iter != m_file_hashes.end())
+        return iter->second;
+
+    uint64_t      hash = 0;
+    std::ifstream file_stream(file_path, std::ios::binary);
+    if (file_stream.is_open())
+    {
+        std::stringstream content;
+        content << file_stream.rdbuf();
+        hash = hashString(content.str());
+    }
+    m_file_hashes.emplace(file_path, hash);
+    return hash;
+}
+
+const MetaCache::HeaderEntry* MetaCache::findUpToDateEntry(const std::string& header_path)
+{
+    auto iter = m_entries.find(header_path);
+    if (iter == m_entries.end() || iter->second.content_hash != getFileHash(header_path))
+        return nullptr;
+
+    for (auto& dependency : iter->second.dependencies)
+    {
+        if (dependency.second != getFileHash(dependency.first))
+            return nullptr;
+    }
+    return &iter->second;
+}
+
+void MetaCache::setEntry(const std::string& header_path, HeaderEntry entry)
+{
+    m_entries.insert_or_assign(header_path, std::move(entry));
+    m_used_headers.insert(header_path);
+}
+
+void MetaCache::removeUnusedEntries(void)
+{
+    for (auto iter = m_entries.begin(); iter != m_entries.end();)
+    {
+        if (m_used_headers.count(iter->first) == 0)
+            iter = m_entries.erase(iter);
+        else
+            ++iter;
+    }
+}
+
+void MetaCache::load(void)
+{
+    m_entries.clear();
+
+    std::ifstream cache_file(m_cache_file_path);
+    std::string   line;
+    if (!cache_file.is_open() || !std::getline(cache_file, line))
+        return;
+
+    std::vector<std::string> values = splitLine(line);
+    if (values.size() != 3 || values[0] != k_cache_header || values[1] != k_cache_version ||
+        values[2] != std::to_string(m_arguments_hash))
+    {
+        std::cout << "The meta cache was written by another version or with other arguments, parsing everything"
+                  << std::endl;
+        return;
+    }
+
+    HeaderEntry*                                 entry = nullptr;
+    std::shared_ptr<Class>                       class_temp;
+    Namespace                                    class_namespace;
+    std::unordered_map<std::string, std::string> properties;
+    while (std::getline(cache_file, line))
+    {
+        values = splitLine(line);
+        const std::string& kind = values[0];
+        if (kind == "header" && values.size() == 3)
+        {
+            entry               = &m_entries[values[1]];
+            entry->content_hash = std::stoull(values[2]);
+            class_temp.reset();
+        }
+        else if (entry == nullptr)
+        {
+            break;
+        }
+        else if (kind == "dependency" && values.size() == 3)
+        {
+            entry->dependencies.emplace_back(values[1], std::stoull(values[2]));
+        }
+        // the properties come before the class, field or method they belong to
+        else if (kind == "meta" && values.size() == 3)
+        {
+            properties.emplace(values[1], values[2]);
+        }
+        else if (kind == "class" && values.size() == 6)
+        {
+            class_namespace = Utils::split(values[5], "::");
+            class_temp      = std::make_shared<Class>(
+                values[1], values[2], values[3] == "1", MetaInfo(std::move(properties)), values[4], class_namespace);
+            entry->classes.emplace_back(class_temp);
+            properties.clear();
+        }
+        else if (kind == "base" && values.size() == 2 && class_temp)
+        {
+            class_temp->m_base_classes.emplace_back(new BaseClass(values[1]));
+        }
+        else if (kind == "field" && values.size() == 4 && class_temp)
+        {
+            class_temp->m_fields.emplace_back(new Field(values[1],
+                                                        values[2],
+                                                        values[3] == "1",
+                                                        MetaInfo(std::move(properties)),
+                                                        class_namespace,
+                                                        class_temp.get()));
+            properties.clear();
+        }
+        else if (kind == "method" && values.size() == 2 && class_temp)
+        {
+            class_temp->m_methods.emplace_back(
+                new Method(values[1], MetaInfo(std::move(properties)), class_namespace, class_temp.get()));
+            properties.clear();
+        }
+        else
+        {
+            break;
+        }
+    }
+
+    if (!cache_file.eof())
+    {
+        std::cout << "The meta cache " << m_cache_file_path << " is corrupted, parsing everything" << std::endl;
+        m_entries.clear();
+    }
+}
+
+void MetaCache::save(void) const
+{
+    std::stringstream out_stream;
+    out_stream << k_cache_header << "\t" << k_cache_version << "\t" << m_arguments_hash << "\n";
+    for (auto& entry : m_entries)
+    {
+        out_stream << "header\t" << escape(entry.first) << "\t" << entry.second.content_hash << "\n";
+        for (auto& dependency : entry.second.dependencies)
+        {
+            out_stream << "dependency\t" << escape(dependency.first) << "\t" << dependency.second << "\n";
+        }
+        for (auto& class_temp : entry.second.classes)
+        {
+            writeClass(out_stream, *class_temp);
+        }
+    }
+
+    std::string cache_content = out_stream.str();
+    cache_content.pop_back();
+    Utils::saveFile(cache_content, m_cache_file_path);
+}
+
+void MetaCache::writeClass(std::ostream& out_stream, const Class& class_temp) const
+{
+    writeProperties(out_stream, class_temp.getMetaData());
+    out_stream << "class\t" << escape(class_temp.m_name) << "\t" << escape(class_temp.m_qualified_name) << "\t"
+               << (class_temp.m_is_struct ? "1" : "0") << "\t" << escape(class_temp.getSourceFile()) << "\t"
+               << escape(Utils::join(class_temp.getCurrentNamespace(), "::")) << "\n";
+
+    for (auto& base_class : class_temp.m_base_classes)
+    {
+        out_stream << "base\t" << escape(base_class->name) << "\n";
+    }
+    for (auto& field : class_temp.m_fields)
+    {
+        writeProperties(out_stream, field->getMetaData());
+        out_stream << "field\t" << escape(field->m_name) << "\t" << escape(field->m_type) << "\t"
+                   << (field->m_is_const ? "1" : "0") << "\n";
+    }
+    for (auto& method : class_temp.m_methods)
+    {
+        writeProperties(out_stream, method->getMetaData());
+        out_stream << "method\t" << escape(method->m_name) << "\n";
+    }
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "common/precompiled.h"
+
+class Class;
+
+/// The reflected classes found in every header by the previous run, with the content hash of the header and of
+/// the engine headers it includes. A header whose hashes did not change is not parsed again, its classes are
+/// read back from the cache and generated like freshly parsed ones.
+class MetaCache
+{
+public:
+    struct HeaderEntry
+    {
+        uint64_t content_hash {0};
+        // engine headers included by the header and their content hash when it was parsed
+        std::vector<std::pair<std::string, uint64_t>> dependencies;
+        std::vector<std::shared_ptr<Class>>           classes;
+    };
+
+    // the cache is dropped when the parser is called with other arguments
+    MetaCache(std::string cache_file_path, uint64_t arguments_hash);
+
+    void load(void);
+    void save(void) const;
+
+    // nullptr when the header is not cached or it or one of its dependencies changed since
+    const HeaderEntry* findUpToDateEntry(const std::string& header_path);
+    void               setEntry(const std::string& header_path, HeaderEntry entry);
+    // drops the headers not set during this run
+    void removeUnusedEntries(void);
+
+    // hashed once per run, 0 when the file cannot be read
+    uint64_t getFileHash(const std::string& file_path);
+
+    static uint64_t hashString(const std::string& content);
+
+private:
+    void writeClass(std::ostream& out_stream, const Class& class_temp) const;
+
+    std::string m_cache_file_path;
+    uint64_t    m_arguments_hash;
+
+    std::map<std::string, HeaderEntry>        m_entries;
+    std::unordered_set<std::string>           m_used_headers;
+    std::unordered_map<std::string, uint64_t> m_file_hashes;
+};
@@ -7,7 +7,10 @@
 
 #include "parser.h"
 
-#define RECURSE_NAMESPACES(kind, cursor, method, namespaces) \
+#include <atomic>
+#include <thread>
+
+#define RECURSE_NAMESPACES(kind, cursor, method, namespaces, ...) \
     { \
         if (kind == CXCursor_Namespace) \
         { \
@@ -15,7 +18,7 @@
             if (!display_name.empty()) \
             { \
                 namespaces.emplace_back(display_name); \
-                method(cursor, namespaces); \
+                method(cursor, namespaces, __VA_ARGS__); \
                 namespaces.pop_back(); \
             } \
         } \
@@ -31,6 +34,23 @@
         } \
     }
 
+namespace
+{
+    // the reflected types are declared through the CLASS and STRUCT macros, the other headers are not parsed
+    bool mayDeclareReflectedTypes(const std::string& header_file)
+    {
+        const std::string content = Utils::loadFile(header_file);
+        return content.find("CLASS(") != std::string::npos || content.find("STRUCT(") != std::string::npos;
+    }
+
+    bool isInDirectory(const fs::path& file_path, const fs::path& directory_path)
+    {
+        const std::string file_string      = file_path.lexically_normal().generic_string();
+        const std::string directory_string = directory_path.lexically_normal().generic_string();
+        return file_string.compare(0, directory_string.size(), directory_string) == 0;
+    }
+} // namespace
+
 void MetaParser::prepare(void) {}
 
 std::string MetaParser::getIncludeFile(std::string name)
@@ -46,8 +66,8 @@ MetaParser::MetaParser(const std::string project_input_file,
                        const std::string module_name,
                        bool              is_show_errors) :
     m_project_input_file(project_input_file),
-    m_source_include_file_name(include_file_path), m_index(nullptr), m_translation_unit(nullptr),
-    m_sys_include(sys_include), m_module_name(module_name), m_is_show_errors(is_show_errors)
+    m_source_include_file_name(include_file_path), m_sys_include(sys_include), m_module_name(module_name),
+    m_is_show_errors(is_show_errors)
 {
     m_work_paths = Utils::split(include_path, ";");
 
@@ -64,12 +84,6 @@ MetaParser::~MetaParser(void)
         delete item;
     }
     m_generators.clear();
-
-    if (m_translation_unit)
-        clang_disposeTranslationUnit(m_translation_unit);
-
-    if (m_index)
-        clang_disposeIndex(m_index);
 }
 
 void MetaParser::finish(void)
@@ -98,6 +112,8 @@ bool MetaParser::parseProject()
 
     std::string context = buffer.str();
 
+    // the runtime and editor header lists are joined by a comma
+    Utils::replace(context, ",", ";");
     auto         inlcude_files = Utils::split(context, ";");
     std::fstream include_file;
 
@@ -130,6 +146,7 @@ bool MetaParser::parseProject()
         std::string temp_string(include_item);
         Utils::replace(temp_string, '\\', '/');
         include_file << "#include  \"" << temp_string << "\"" << std::endl;
+        m_header_files.emplace_back(temp_string);
     }
 
     include_file << "#endif" << std::endl;
@@ -146,9 +163,6 @@ int MetaParser::parse(void)
         return -1;
     }
 
-    std::cerr << "Parsing the whole project..." << std::endl;
-    int is_show_errors      = m_is_show_errors ? 1 : 0;
-    m_index                 = clang_createIndex(true, is_show_errors);
     std::string pre_include = "-I";
     std::string sys_include_temp;
     if (!(m_sys_include == "*"))
@@ -165,26 +179,146 @@ int MetaParser::parse(void)
         arguments.emplace_back(paths[index].c_str());
     }
 
-    fs::path input_path(m_source_include_file_name);
-    if (!fs::exists(input_path))
+    // the classes of a header are reused while the header and the engine headers it includes are unchanged
+    std::string arguments_string;
+    for (const char* argument : arguments)
     {
-        std::cerr << input_path << " is not exist" << std::endl;
-        return -2;
+        arguments_string += std::string(argument) + "\n";
     }
+    MetaCache meta_cache(fs::path(m_source_include_file_name).replace_extension(".meta_cache").string(),
+                         MetaCache::hashString(arguments_string));
+    meta_cache.load();
 
-    m_translation_unit = clang_createTranslationUnitFromSourceFile(
-        m_index, m_source_include_file_name.c_str(), static_cast<int>(arguments.size()), arguments.data(), 0, nullptr);
-    auto cursor = clang_getTranslationUnitCursor(m_translation_unit);
+    std::vector<std::string> outdated_header_files;
+    size_t                   cached_header_count = 0;
+    for (auto& header_file : m_header_files)
+    {
+        const MetaCache::HeaderEntry* cache_entry = meta_cache.findUpToDateEntry(header_file);
+        if (cache_entry)
+        {
+            addClasses(cache_entry->classes);
+            meta_cache.setEntry(header_file, *cache_entry);
+            cached_header_count++;
+        }
+        else if (!mayDeclareReflectedTypes(header_file))
+        {
+            MetaCache::HeaderEntry empty_entry;
+            empty_entry.content_hash = meta_cache.getFileHash(header_file);
+            meta_cache.setEntry(header_file, empty_entry);
+        }
+        else
+        {
+            outdated_header_files.emplace_back(header_file);
+        }
+    }
 
-    Namespace temp_namespace;
+    std::vector<ParsedHeader> parsed_headers(outdated_header_files.size());
+    parseHeaders(outdated_header_files, parsed_headers);
 
-    buildClassAST(cursor, temp_namespace);
+    for (size_t index = 0; index < outdated_header_files.size(); ++index)
+    {
+        ParsedHeader& parsed_header = parsed_headers[index];
+        addClasses(parsed_header.classes);
+        // a header that failed is parsed again by the next run
+        if (!parsed_header.is_parsed)
+            continue;
+
+        MetaCache::HeaderEntry cache_entry;
+        cache_entry.content_hash = meta_cache.getFileHash(outdated_header_files[index]);
+        for (auto& dependency : parsed_header.dependencies)
+        {
+            cache_entry.dependencies.emplace_back(dependency, meta_cache.getFileHash(dependency));
+        }
+        cache_entry.classes = std::move(parsed_header.classes);
+        meta_cache.setEntry(outdated_header_files[index], std::move(cache_entry));
+    }
 
-    temp_namespace.clear();
+    meta_cache.removeUnusedEntries();
+    meta_cache.save();
 
+    std::cout << "Parsed " << outdated_header_files.size() << " of " << m_header_files.size() << " headers, "
+              << cached_header_count << " read from the meta cache" << std::endl;
     return 0;
 }
 
+void MetaParser::parseHeaders(const std::vector<std::string>& header_files,
+                              std::vector<ParsedHeader>&      out_parsed_headers)
+{
+    if (header_files.empty())
+        return;
+
+    const size_t thread_count =
+        std::min<size_t>(std::max(1u, std::thread::hardware_concurrency()), header_files.size());
+    std::cerr << "Parsing " << header_files.size() << " headers on " << thread_count << " threads..." << std::endl;
+
+    std::atomic<size_t>      next_header_index {0};
+    std::vector<std::thread> threads;
+    for (size_t thread_index = 0; thread_index < thread_count; ++thread_index)
+    {
+        threads.emplace_back([this, &header_files, &out_parsed_headers, &next_header_index] {
+            // an index is not shared between threads
+            CXIndex index = clang_createIndex(true, m_is_show_errors ? 1 : 0);
+            for (size_t header_index = next_header_index++; header_index < header_files.size();
+                 header_index        = next_header_index++)
+            {
+                parseHeader(index, header_files[header_index], out_parsed_headers[header_index]);
+            }
+            clang_disposeIndex(index);
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+}
+
+bool MetaParser::parseHeader(CXIndex index, const std::string& header_file, ParsedHeader& out_parsed_header) const
+{
+    CXTranslationUnit translation_unit = nullptr;
+    CXErrorCode       error            = clang_parseTranslationUnit2(index,
+                                                      header_file.c_str(),
+                                                      arguments.data(),
+                                                      static_cast<int>(arguments.size()),
+                                                      nullptr,
+                                                      0,
+                                                      CXTranslationUnit_SkipFunctionBodies,
+                                                      &translation_unit);
+    if (error != CXError_Success)
+    {
+        std::cerr << "Parsing " << header_file << " failed with error " << error << std::endl;
+        return false;
+    }
+
+    Namespace temp_namespace;
+    buildClassAST(clang_getTranslationUnitCursor(translation_unit), temp_namespace, out_parsed_header.classes);
+
+    // only the engine headers can change between two runs
+    struct InclusionContext
+    {
+        fs::path                  root_path;
+        std::vector<std::string>* dependencies;
+    } inclusion_context {m_work_paths[0], &out_parsed_header.dependencies};
+    clang_getInclusions(
+        translation_unit,
+        [](CXFile included_file, CXSourceLocation* inclusion_stack, unsigned include_length, CXClientData data) {
+            auto context = static_cast<InclusionContext*>(data);
+            if (include_length == 0)
+                return;
+
+            std::string file_name;
+            Utils::toString(clang_getFileName(included_file), file_name);
+            if (isInDirectory(file_name, context->root_path))
+            {
+                context->dependencies->emplace_back(file_name);
+            }
+        },
+        &inclusion_context);
+
+    clang_disposeTranslationUnit(translation_unit);
+    out_parsed_header.is_parsed = true;
+    return true;
+}
+
 void MetaParser::generateFiles(void)
 {
     std::cerr << "Start generate runtime schemas(" << m_schema_modules.size() << ")..." << std::endl;
@@ -199,22 +333,38 @@ void MetaParser::generateFiles(void)
     finish();
 }
 
-void MetaParser::buildClassAST(const Cursor& cursor, Namespace& current_namespace)
+void MetaParser::buildClassAST(const Cursor&                        cursor,
+                               Namespace&                           current_namespace,
+                               std::vector<std::shared_ptr<Class>>& out_classes) const
 {
     for (auto& child : cursor.getChildren())
     {
+        // the included headers are parsed on their own
+        if (!child.isFromMainFile())
+            continue;
+
         auto kind = child.getKind();
 
         // actual definition and a class or struct
         if (child.isDefinition() && (kind == CXCursor_ClassDecl || kind == CXCursor_StructDecl))
         {
             auto class_ptr = std::make_shared<Class>(child, current_namespace);
-
-            TRY_ADD_LANGUAGE_TYPE(class_ptr, classes);
+            if (class_ptr->shouldCompile())
+            {
+                out_classes.emplace_back(class_ptr);
+            }
         }
         else
         {
-            RECURSE_NAMESPACES(kind, child, buildClassAST, current_namespace);
+            RECURSE_NAMESPACES(kind, child, buildClassAST, current_namespace, out_classes);
         }
     }
 }
+
+void MetaParser::addClasses(const std::vector<std::shared_ptr<Class>>& classes)
+{
+    for (auto& class_ptr : classes)
+    {
+        TRY_ADD_LANGUAGE_TYPE(class_ptr, classes);
+    }
+}
@@ -8,6 +8,7 @@
 #include "cursor/cursor.h"
 
 #include "generator/generator.h"
+#include "parser/meta_cache.h"
 #include "template_manager/template_manager.h"
 
 class Class;
@@ -35,12 +36,12 @@ private:
     std::string              m_module_name;
     std::string              m_sys_include;
     std::string              m_source_include_file_name;
+    // the headers of the project file, each one is parsed as its own translation unit
+    std::vector<std::string> m_header_files;
 
-    CXIndex           m_index;
-    CXTranslationUnit m_translation_unit;
-
-    std::unordered_map<std::string, std::string>  m_type_table;
-    std::unordered_map<std::string, SchemaMoudle> m_schema_modules;
+    std::unordered_map<std::string, std::string> m_type_table;
+    // sorted by file so the generated files do not depend on the parsing order
+    std::map<std::string, SchemaMoudle> m_schema_modules;
 
     std::vector<const char*>                    arguments = {{"-x",
                                            "c++",
@@ -58,7 +59,20 @@ private:
     bool m_is_show_errors;
 
 private:
-    bool        parseProject(void);
-    void        buildClassAST(const Cursor& cursor, Namespace& current_namespace);
+    struct ParsedHeader
+    {
+        bool                                is_parsed {false};
+        std::vector<std::string>            dependencies;
+        std::vector<std::shared_ptr<Class>> classes;
+    };
+
+    bool parseProject(void);
+    // the headers are shared between the threads, each one parses the next header left until there is none
+    void parseHeaders(const std::vector<std::string>& header_files, std::vector<ParsedHeader>& out_parsed_headers);
+    bool parseHeader(CXIndex index, const std::string& header_file, ParsedHeader& out_parsed_header) const;
+    void buildClassAST(const Cursor&                        cursor,
+                       Namespace&                           current_namespace,
+                       std::vector<std::shared_ptr<Class>>& out_classes) const;
+    void addClasses(const std::vector<std::shared_ptr<Class>>& classes);
     std::string getIncludeFile(std::string name);
 };
@@ -0,0 +1,224 @@
+#include "runtime/core/job/job_system.h"
+
+#include <algorithm>
+
+namespace Piccolo
+{
+    void JobHandle::wait() const
+    {
+        if (m_job_system && !isDone())
+        {
+            m_job_system->wait(*this);
+        }
+    }
+
+    JobSystem::~JobSystem() { clear(); }
+
+    void JobSystem::initialize(int worker_count)
+    {
+        clear();
+
+        if (worker_count < 0)
+        {
+            const unsigned int hardware_thread_count = std::thread::hardware_concurrency();
+            worker_count = hardware_thread_count > 1 ? static_cast<int>(hardware_thread_count) - 1 : 0;
+        }
+
+        m_is_stopping = false;
+        m_workers.reserve(worker_count);
+        for (int worker_index = 0; worker_index < worker_count; ++worker_index)
+        {
+            m_workers.emplace_back(&JobSystem::workerMain, this);
+        }
+    }
+
+    void JobSystem::clear()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_is_stopping = true;
+        }
+        m_condition.notify_all();
+
+        for (std::thread& worker : m_workers)
+        {
+            worker.join();
+        }
+        m_workers.clear();
+    }
+
+    void JobSystem::parallelFor(size_t count, size_t batch_size, const JobRangeFunction& function)
+    {
+        if (count == 0)
+            return;
+
+        batch_size = std::max<size_t>(batch_size, 1);
+
+        // nothing to share, skip the queue
+        if (m_workers.empty() || count <= batch_size)
+        {
+            function(0, count);
+            return;
+        }
+
+        std::atomic<size_t> pending_count {(count + batch_size - 1) / batch_size};
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            // the jobs already taken are dropped first, so the queue does not grow when it is never drained
+            m_jobs.erase(m_jobs.begin(), m_jobs.begin() + m_next_job);
+            m_next_job = 0;
+            for (size_t begin = 0; begin < count; begin += batch_size)
+            {
+                m_jobs.push_back({&function, begin, std::min(begin + batch_size, count), &pending_count});
+            }
+        }
+        m_condition.notify_all();
+
+        // help the workers until all batches of this call are done, the queue may hold
+        // jobs of other callers as well, running them here is fine
+        while (pending_count.load(std::memory_order_acquire) != 0)
+        {
+            Job job;
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_condition.wait(lock, [this, &pending_count] {
+                    return pending_count.load(std::memory_order_acquire) == 0 || hasJob();
+                });
+                if (pending_count.load(std::memory_order_acquire) == 0)
+                    break;
+
+                job = popJob();
+            }
+            runJob(job);
+        }
+    }
+
+    JobHandle JobSystem::submit(JobTaskFunction function)
+    {
+        JobHandle handle;
+        handle.m_job_system = this;
+        handle.m_is_done    = std::make_shared<std::atomic<bool>>(false);
+
+        Task task {std::move(function), handle.m_is_done};
+        if (m_workers.empty())
+        {
+            runTask(task);
+            return handle;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_tasks.push_back(std::move(task));
+        }
+        m_condition.notify_all();
+        return handle;
+    }
+
+    void JobSystem::wait(const JobHandle& handle)
+    {
+        // unlike parallelFor, the waiting thread also takes tasks, the one waited for may still be queued
+        while (!handle.isDone())
+        {
+            Job  job;
+            Task task;
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_condition.wait(lock, [this, &handle] {
+                    return handle.isDone() || hasJob() || !m_tasks.empty();
+                });
+                if (handle.isDone())
+                    break;
+
+                if (hasJob())
+                {
+                    job = popJob();
+                }
+                else
+                {
+                    task = std::move(m_tasks.front());
+                    m_tasks.pop_front();
+                }
+            }
+            if (job.function)
+            {
+                runJob(job);
+            }
+            else
+            {
+                runTask(task);
+            }
+        }
+    }
+
+    void JobSystem::workerMain()
+    {
+        while (true)
+        {
+            Job  job;
+            Task task;
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_condition.wait(lock, [this] { return m_is_stopping || hasJob() || !m_tasks.empty(); });
+                // the queued tasks are finished before stopping, their handles may still be waited for
+                if (!hasJob() && m_tasks.empty())
+                    return;
+
+                // the batches of the frame first
+                if (hasJob())
+                {
+                    job = popJob();
+                }
+                else
+                {
+                    task = std::move(m_tasks.front());
+                    m_tasks.pop_front();
+                }
+            }
+            if (job.function)
+            {
+                runJob(job);
+            }
+            else
+            {
+                runTask(task);
+            }
+        }
+    }
+
+    JobSystem::Job JobSystem::popJob()
+    {
+        Job job = m_jobs[m_next_job++];
+        // the queue starts over once drained, so the next frames reuse its storage instead of allocating
+        if (m_next_job == m_jobs.size())
+        {
+            m_jobs.clear();
+            m_next_job = 0;
+        }
+        return job;
+    }
+
+    void JobSystem::runJob(const Job& job)
+    {
+        (*job.function)(job.begin, job.end);
+
+        // the submitting thread may return as soon as the count reaches zero,
+        // so the counter must not be touched after the decrement
+        if (job.pending_count->fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            // take the lock so the wake up can not slip between the waiter's check and its wait
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_condition.notify_all();
+        }
+    }
+
+    void JobSystem::runTask(Task& task)
+    {
+        task.function();
+        // drop the captures before the waiters see the task done
+        task.function = nullptr;
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        task.is_done->store(true, std::memory_order_release);
+        m_condition.notify_all();
+    }
+} // namespace Piccolo
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Piccolo
+{
+    using JobRangeFunction = std::function<void(size_t begin, size_t end)>;
+    using JobTaskFunction  = std::function<void()>;
+
+    class JobSystem;
+
+    /// Completion of a task submitted with JobSystem::submit. Everything the task wrote is visible once
+    /// isDone() returned true.
+    class JobHandle
+    {
+    public:
+        bool isValid() const { return m_is_done != nullptr; }
+        // an empty handle is done
+        bool isDone() const { return !m_is_done || m_is_done->load(std::memory_order_acquire); }
+        // block until the task is done, running queued jobs meanwhile
+        void wait() const;
+
+    private:
+        friend class JobSystem;
+
+        JobSystem*                         m_job_system {nullptr};
+        std::shared_ptr<std::atomic<bool>> m_is_done;
+    };
+
+    /// Engine wide pool of worker threads.
+    /// Work is submitted as an index range that is split into batches, the submitting thread
+    /// runs batches as well while it waits, so nested submissions from inside a job are allowed.
+    /// Longer background work like asset loading is submitted as tasks, the workers only pick a task when no
+    /// batch is queued so the frame is not delayed by them, and parallelFor never runs a task on its caller.
+    class JobSystem final
+    {
+    public:
+        JobSystem() = default;
+        ~JobSystem();
+
+        JobSystem(const JobSystem&) = delete;
+        JobSystem& operator=(const JobSystem&) = delete;
+
+        // a negative worker count uses one worker per hardware thread besides the calling one,
+        // with zero workers every job runs on the calling thread
+        void initialize(int worker_count);
+        void clear();
+
+        uint32_t getWorkerCount() const { return static_cast<uint32_t>(m_workers.size()); }
+
+        // call function(begin, end) on batches of at most batch_size indices covering [0, count),
+        // return when all batches are finished
+        void parallelFor(size_t count, size_t batch_size, const JobRangeFunction& function);
+
+        // run function on a worker and return at once, with zero workers it runs before returning
+        JobHandle submit(JobTaskFunction function);
+        void      wait(const JobHandle& handle);
+
+    private:
+        struct Job
+        {
+            const JobRangeFunction* function {nullptr};
+            size_t                  begin {0};
+            size_t                  end {0};
+            std::atomic<size_t>*    pending_count {nullptr};
+        };
+
+        struct Task
+        {
+            JobTaskFunction                    function;
+            std::shared_ptr<std::atomic<bool>> is_done;
+        };
+
+        // called with the mutex held
+        bool hasJob() const { return m_next_job < m_jobs.size(); }
+        Job  popJob();
+
+        void workerMain();
+        void runJob(const Job& job);
+        void runTask(Task& task);
+
+        std::vector<std::thread> m_workers;
+
+        std::mutex              m_mutex;
+        std::condition_variable m_condition;
+        std::vector<Job>        m_jobs;
+        size_t                  m_next_job {0};
+        std::deque<Task>        m_tasks;
+        bool                    m_is_stopping {false};
+    };
+} // namespace Piccolo
@@ -1,6 +1,9 @@
 #include "reflection.h"
+#include "runtime/core/meta/serializer/json_stream_serializer.h"
+
 #include <cstring>
-#include <map>
+#include <string_view>
+#include <unordered_map>
 
 namespace Piccolo
 {
@@ -9,24 +12,84 @@ namespace Piccolo
         const char* k_unknown_type = "UnknownType";
         const char* k_unknown      = "Unknown";
 
-        static std::map<std::string, ClassFunctionTuple*>       m_class_map;
-        static std::multimap<std::string, FieldFunctionTuple*>  m_field_map;
-        static std::multimap<std::string, MethodFunctionTuple*> m_method_map;
-        static std::map<std::string, ArrayFunctionTuple*>       m_array_map;
+        /// Everything known about a type, built while the types are registered. The names used as keys are the
+        /// string literals of the generated registration code, they live as long as the program.
+        struct TypeData
+        {
+            std::string                                  type_name;
+            ClassFunctionTuple*                          class_functions {nullptr};
+            std::vector<FieldAccessor>                   fields;
+            std::vector<MethodAccessor>                  methods;
+            std::unordered_map<std::string_view, size_t> field_indices;
+            std::unordered_map<std::string_view, size_t> method_indices;
+            // has fields or methods, a type only seen as the type of a field is not valid
+            bool is_valid {false};
+        };
+
+        static std::unordered_map<std::string_view, TypeData>             m_type_map;
+        static std::unordered_map<std::string_view, ArrayFunctionTuple*> m_array_map;
+
+        static const std::string k_unknown_type_name = k_unknown_type;
+
+        namespace
+        {
+            // the types of the fields and array elements get an entry too, their metas are then looked up
+            // without keeping their name around
+            TypeData& internType(const char* type_name)
+            {
+                auto iter = m_type_map.try_emplace(type_name).first;
+                if (iter->second.type_name.empty())
+                {
+                    iter->second.type_name = type_name;
+                }
+                return iter->second;
+            }
+
+            const TypeData* findType(std::string_view type_name)
+            {
+                auto iter = m_type_map.find(type_name);
+                return iter == m_type_map.end() ? nullptr : &iter->second;
+            }
+
+            const ClassFunctionTuple* findClassFunctions(std::string_view type_name)
+            {
+                const TypeData* type_data = findType(type_name);
+                return type_data ? type_data->class_functions : nullptr;
+            }
+        } // namespace
 
         void TypeMetaRegisterinterface::registerToFieldMap(const char* name, FieldFunctionTuple* value)
         {
-            m_field_map.insert(std::make_pair(name, value));
+            TypeData&     type_data = internType(name);
+            FieldAccessor field(value);
+            if (!type_data.field_indices.emplace(field.getFieldName(), type_data.fields.size()).second)
+            {
+                delete value;
+                return;
+            }
+            type_data.fields.push_back(field);
+            type_data.is_valid = true;
+
+            internType(field.getFieldTypeName());
         }
         void TypeMetaRegisterinterface::registerToMethodMap(const char* name, MethodFunctionTuple* value)
         {
-            m_method_map.insert(std::make_pair(name, value));
+            TypeData&      type_data = internType(name);
+            MethodAccessor method(value);
+            if (!type_data.method_indices.emplace(method.getMethodName(), type_data.methods.size()).second)
+            {
+                delete value;
+                return;
+            }
+            type_data.methods.push_back(method);
+            type_data.is_valid = true;
         }
         void TypeMetaRegisterinterface::registerToArrayMap(const char* name, ArrayFunctionTuple* value)
         {
             if (m_array_map.find(name) == m_array_map.end())
             {
                 m_array_map.insert(std::make_pair(name, value));
+                internType(std::get<4>(*value)());
             }
             else
             {
@@ -36,9 +99,10 @@ namespace Piccolo
 
         void TypeMetaRegisterinterface::registerToClassMap(const char* name, ClassFunctionTuple* value)
         {
-            if (m_class_map.find(name) == m_class_map.end())
+            TypeData& type_data = internType(name);
+            if (type_data.class_functions == nullptr)
             {
-                m_class_map.insert(std::make_pair(name, value));
+                type_data.class_functions = value;
             }
             else
             {
@@ -48,16 +112,20 @@ namespace Piccolo
 
         void TypeMetaRegisterinterface::unregisterAll()
         {
-            for (const auto& itr : m_field_map)
+            for (auto& type_pair : m_type_map)
             {
-                delete itr.second;
+                TypeData& type_data = type_pair.second;
+                for (const FieldAccessor& field : type_data.fields)
+                {
+                    delete field.m_functions;
+                }
+                for (const MethodAccessor& method : type_data.methods)
+                {
+                    delete method.m_functions;
+                }
+                delete type_data.class_functions;
             }
-            m_field_map.clear();
-            for (const auto& itr : m_class_map)
-            {
-                delete itr.second;
-            }
-            m_class_map.clear();
+            m_type_map.clear();
             for (const auto& itr : m_array_map)
             {
                 delete itr.second;
@@ -65,42 +133,11 @@ namespace Piccolo
             m_array_map.clear();
         }
 
-        TypeMeta::TypeMeta(std::string type_name) : m_type_name(type_name)
-        {
-            m_is_valid = false;
-            m_fields.clear();
-            m_methods.clear();
-
-            auto fileds_iter = m_field_map.equal_range(type_name);
-            while (fileds_iter.first != fileds_iter.second)
-            {
-                FieldAccessor f_field(fileds_iter.first->second);
-                m_fields.emplace_back(f_field);
-                m_is_valid = true;
-
-                ++fileds_iter.first;
-            }
-
-            auto methods_iter = m_method_map.equal_range(type_name);
-            while (methods_iter.first != methods_iter.second)
-            {
-                MethodAccessor f_method(methods_iter.first->second);
-                m_methods.emplace_back(f_method);
-                m_is_valid = true;
-
-                ++methods_iter.first;
-            }
-        }
-
-        TypeMeta::TypeMeta() : m_type_name(k_unknown_type), m_is_valid(false) { m_fields.clear(); m_methods.clear(); }
+        TypeMeta::TypeMeta() : m_data(nullptr) {}
 
-        TypeMeta TypeMeta::newMetaFromName(std::string type_name)
-        {
-            TypeMeta f_type(type_name);
-            return f_type;
-        }
+        TypeMeta TypeMeta::newMetaFromName(std::string_view type_name) { return TypeMeta(findType(type_name)); }
 
-        bool TypeMeta::newArrayAccessorFromName(std::string array_type_name, ArrayAccessor& accessor)
+        bool TypeMeta::newArrayAccessorFromName(std::string_view array_type_name, ArrayAccessor& accessor)
         {
             auto iter = m_array_map.find(array_type_name);
 
@@ -114,102 +151,107 @@ namespace Piccolo
             return false;
         }
 
-        ReflectionInstance TypeMeta::newFromNameAndJson(std::string type_name, const Json& json_context)
+        ReflectionInstance TypeMeta::newFromNameAndJson(std::string_view type_name, const Json& json_context)
         {
-            auto iter = m_class_map.find(type_name);
-
-            if (iter != m_class_map.end())
+            const ClassFunctionTuple* class_functions = findClassFunctions(type_name);
+            if (class_functions)
             {
-                return ReflectionInstance(TypeMeta(type_name), (std::get<1>(*iter->second)(json_context)));
+                return ReflectionInstance(newMetaFromName(type_name), (std::get<1>(*class_functions)(json_context)));
             }
             return ReflectionInstance();
         }
 
-        Json TypeMeta::writeByName(std::string type_name, void* instance)
+        Json TypeMeta::writeByName(std::string_view type_name, void* instance)
         {
-            auto iter = m_class_map.find(type_name);
-
-            if (iter != m_class_map.end())
+            const ClassFunctionTuple* class_functions = findClassFunctions(type_name);
+            if (class_functions)
             {
-                return std::get<2>(*iter->second)(instance);
+                return std::get<2>(*class_functions)(instance);
             }
             return Json();
         }
 
-        std::string TypeMeta::getTypeName() { return m_type_name; }
-
-        int TypeMeta::getFieldsList(FieldAccessor*& out_list)
+        ReflectionInstance TypeMeta::newFromNameAndJsonReader(std::string_view type_name, JsonReader& reader)
         {
-            int count = m_fields.size();
-            out_list  = new FieldAccessor[count];
-            for (int i = 0; i < count; ++i)
+            const ClassFunctionTuple* class_functions = findClassFunctions(type_name);
+            if (class_functions)
             {
-                out_list[i] = m_fields[i];
+                return ReflectionInstance(newMetaFromName(type_name), (std::get<4>(*class_functions)(reader)));
             }
-            return count;
+            return ReflectionInstance();
         }
 
-        int TypeMeta::getMethodsList(MethodAccessor*& out_list)
+        void TypeMeta::writeByName(std::string_view type_name, void* instance, JsonWriter& writer)
         {
-            int count = m_methods.size();
-            out_list  = new MethodAccessor[count];
-            for (int i = 0; i < count; ++i)
+            const ClassFunctionTuple* class_functions = findClassFunctions(type_name);
+            if (class_functions)
             {
-                out_list[i] = m_methods[i];
+                std::get<5>(*class_functions)(writer, instance);
+                return;
             }
-            return count;
+            writer.writeNull();
         }
 
-        int TypeMeta::getBaseClassReflectionInstanceList(ReflectionInstance*& out_list, void* instance)
+        ReflectionInstance TypeMeta::newCopyFromName(std::string_view type_name, const void* instance)
         {
-            auto iter = m_class_map.find(m_type_name);
-
-            if (iter != m_class_map.end())
+            const ClassFunctionTuple* class_functions = findClassFunctions(type_name);
+            if (class_functions)
             {
-                return (std::get<0>(*iter->second))(out_list, instance);
+                return ReflectionInstance(newMetaFromName(type_name), (std::get<3>(*class_functions)(instance)));
             }
-
-            return 0;
+            return ReflectionInstance();
         }
 
-        FieldAccessor TypeMeta::getFieldByName(const char* name)
+        const std::string& TypeMeta::getTypeName() const { return m_data ? m_data->type_name : k_unknown_type_name; }
+
+        AccessorSpan<const FieldAccessor> TypeMeta::getFields() const
         {
-            const auto it = std::find_if(m_fields.begin(), m_fields.end(), [&](const auto& i) {
-                return std::strcmp(i.getFieldName(), name) == 0;
-            });
-            if (it != m_fields.end())
-                return *it;
-            return FieldAccessor(nullptr);
+            if (m_data == nullptr)
+                return {};
+            return {m_data->fields.data(), m_data->fields.size()};
         }
 
-        MethodAccessor TypeMeta::getMethodByName(const char* name)
+        AccessorSpan<const MethodAccessor> TypeMeta::getMethods() const
         {
-            const auto it = std::find_if(m_methods.begin(), m_methods.end(), [&](const auto& i) {
-                return std::strcmp(i.getMethodName(), name) == 0;
-            });
-            if (it != m_methods.end())
-                return *it;
-            return MethodAccessor(nullptr);
+            if (m_data == nullptr)
+                return {};
+            return {m_data->methods.data(), m_data->methods.size()};
         }
 
-        TypeMeta& TypeMeta::operator=(const TypeMeta& dest)
+        int TypeMeta::getBaseClassReflectionInstanceList(ReflectionInstance*& out_list, void* instance) const
         {
-            if (this == &dest)
+            if (m_data && m_data->class_functions)
             {
-                return *this;
+                return (std::get<0>(*m_data->class_functions))(out_list, instance);
             }
-            m_fields.clear();
-            m_fields = dest.m_fields;
 
-            
-            m_methods.clear();
-            m_methods = dest.m_methods;
+            return 0;
+        }
 
-            m_type_name = dest.m_type_name;
-            m_is_valid  = dest.m_is_valid;
+        FieldAccessor TypeMeta::getFieldByName(std::string_view name) const
+        {
+            if (m_data)
+            {
+                auto iter = m_data->field_indices.find(name);
+                if (iter != m_data->field_indices.end())
+                    return m_data->fields[iter->second];
+            }
+            return FieldAccessor(nullptr);
+        }
 
-            return *this;
+        MethodAccessor TypeMeta::getMethodByName(std::string_view name) const
+        {
+            if (m_data)
+            {
+                auto iter = m_data->method_indices.find(name);
+                if (iter != m_data->method_indices.end())
+                    return m_data->methods[iter->second];
+            }
+            return MethodAccessor(nullptr);
         }
+
+        bool TypeMeta::isValid() const { return m_data && m_data->is_valid; }
+
         FieldAccessor::FieldAccessor()
         {
             m_field_type_name = k_unknown_type;
@@ -230,36 +272,34 @@ namespace Piccolo
             m_field_name      = (std::get<3>(*m_functions))();
         }
 
-        void* FieldAccessor::get(void* instance)
+        void* FieldAccessor::get(void* instance) const
         {
             // todo: should check validation
             return static_cast<void*>((std::get<1>(*m_functions))(instance));
         }
 
-        void FieldAccessor::set(void* instance, void* value)
+        void FieldAccessor::set(void* instance, void* value) const
         {
             // todo: should check validation
             (std::get<0>(*m_functions))(instance, value);
         }
 
-        TypeMeta FieldAccessor::getOwnerTypeMeta()
+        TypeMeta FieldAccessor::getOwnerTypeMeta() const
         {
             // todo: should check validation
-            TypeMeta f_type((std::get<2>(*m_functions))());
-            return f_type;
+            return TypeMeta::newMetaFromName((std::get<2>(*m_functions))());
         }
 
-        bool FieldAccessor::getTypeMeta(TypeMeta& field_type)
+        bool FieldAccessor::getTypeMeta(TypeMeta& field_type) const
         {
-            TypeMeta f_type(m_field_type_name);
-            field_type = f_type;
-            return f_type.m_is_valid;
+            field_type = TypeMeta::newMetaFromName(m_field_type_name);
+            return field_type.isValid();
         }
 
         const char* FieldAccessor::getFieldName() const { return m_field_name; }
-        const char* FieldAccessor::getFieldTypeName() { return m_field_type_name; }
+        const char* FieldAccessor::getFieldTypeName() const { return m_field_type_name; }
 
-        bool FieldAccessor::isArrayType()
+        bool FieldAccessor::isArrayType() const
         {
             // todo: should check validation
             return (std::get<5>(*m_functions))();
@@ -306,7 +346,7 @@ namespace Piccolo
             m_method_name      = dest.m_method_name;
             return *this;
         }
-        void MethodAccessor::invoke(void* instance) { (std::get<1>(*m_functions))(instance); }
+        void MethodAccessor::invoke(void* instance) const { (std::get<1>(*m_functions))(instance); }
         ArrayAccessor::ArrayAccessor() :
             m_func(nullptr), m_array_type_name("UnKnownType"), m_element_type_name("UnKnownType")
         {}
@@ -1,8 +1,11 @@
 #pragma once
 #include "runtime/core/meta/json.h"
 
+#include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -24,7 +27,9 @@ namespace Piccolo
 
 #define REFLECTION_BODY(class_name) \
     friend class Reflection::TypeFieldReflectionOparator::Type##class_name##Operator; \
-    friend class Serializer;
+    friend class Serializer; \
+    friend class BinarySerializer; \
+    friend class JsonStreamSerializer;
     // public: virtual std::string getTypeName() override {return #class_name;}
 
 #define REFLECTION_TYPE(class_name) \
@@ -75,24 +80,44 @@ namespace Piccolo
         class MethodAccessor;
         class ArrayAccessor;
         class ReflectionInstance;
+
+        using TypeId                       = uint32_t;
+        constexpr TypeId k_invalid_type_id = static_cast<TypeId>(-1);
+
+        // compile time id of a reflected type, the meta parser specializes it for every
+        // reflected type in _generated/reflection/all_type_id.h
+        template<typename T>
+        struct TypeIdOf;
     } // namespace Reflection
-    typedef std::function<void(void*, void*)>      SetFuncion;
-    typedef std::function<void*(void*)>            GetFuncion;
-    typedef std::function<const char*()>           GetNameFuncion;
-    typedef std::function<void(int, void*, void*)> SetArrayFunc;
-    typedef std::function<void*(int, void*)>       GetArrayFunc;
-    typedef std::function<int(void*)>              GetSizeFunc;
-    typedef std::function<bool()>                  GetBoolFunc;
-    typedef std::function<void(void*)>             InvokeFunction;
-
-    typedef std::function<void*(const Json&)>                           ConstructorWithJson;
-    typedef std::function<Json(void*)>                                  WriteJsonByName;
-    typedef std::function<int(Reflection::ReflectionInstance*&, void*)> GetBaseClassReflectionInstanceListFunc;
+    class JsonReader;
+    class JsonWriter;
+
+    typedef void (*SetFuncion)(void*, void*);
+    typedef void* (*GetFuncion)(void*);
+    typedef const char* (*GetNameFuncion)();
+    typedef void (*SetArrayFunc)(int, void*, void*);
+    typedef void* (*GetArrayFunc)(int, void*);
+    typedef int (*GetSizeFunc)(void*);
+    typedef bool (*GetBoolFunc)();
+    typedef void (*InvokeFunction)(void*);
+
+    typedef void* (*ConstructorWithJson)(const Json&);
+    typedef Json (*WriteJsonByName)(void*);
+    typedef void* (*CopyConstructor)(const void*);
+    typedef void* (*ConstructorWithJsonReader)(JsonReader&);
+    typedef void (*WriteJsonWriterByName)(JsonWriter&, void*);
+    typedef int (*GetBaseClassReflectionInstanceListFunc)(Reflection::ReflectionInstance*&, void*);
 
     typedef std::tuple<SetFuncion, GetFuncion, GetNameFuncion, GetNameFuncion, GetNameFuncion, GetBoolFunc>
                                                        FieldFunctionTuple;
     typedef std::tuple<GetNameFuncion, InvokeFunction> MethodFunctionTuple;
-    typedef std::tuple<GetBaseClassReflectionInstanceListFunc, ConstructorWithJson, WriteJsonByName> ClassFunctionTuple;
+    typedef std::tuple<GetBaseClassReflectionInstanceListFunc,
+                       ConstructorWithJson,
+                       WriteJsonByName,
+                       CopyConstructor,
+                       ConstructorWithJsonReader,
+                       WriteJsonWriterByName>
+        ClassFunctionTuple;
     typedef std::tuple<SetArrayFunc, GetArrayFunc, GetSizeFunc, GetNameFuncion, GetNameFuncion>      ArrayFunctionTuple;
 
     namespace Reflection
@@ -108,6 +133,29 @@ namespace Piccolo
 
             static void unregisterAll();
         };
+        struct TypeData;
+
+        /// Contiguous accessors of a type, owned by the registry.
+        template<typename T>
+        class AccessorSpan
+        {
+        public:
+            AccessorSpan() = default;
+            AccessorSpan(T* data, size_t size) : m_data(data), m_size(size) {}
+
+            T*     begin() const { return m_data; }
+            T*     end() const { return m_data + m_size; }
+            T&     operator[](size_t index) const { return m_data[index]; }
+            size_t size() const { return m_size; }
+            bool   empty() const { return m_size == 0; }
+
+        private:
+            T*     m_data {nullptr};
+            size_t m_size {0};
+        };
+
+        /// Handle to the metadata of a type. The metadata is built once while the types are registered and never
+        /// changes after, so the lookups neither allocate nor lock and the handle is a pointer copy.
         class TypeMeta
         {
             friend class FieldAccessor;
@@ -117,50 +165,51 @@ namespace Piccolo
         public:
             TypeMeta();
 
-            // static void Register();
-
-            static TypeMeta newMetaFromName(std::string type_name);
-
-            static bool               newArrayAccessorFromName(std::string array_type_name, ArrayAccessor& accessor);
-            static ReflectionInstance newFromNameAndJson(std::string type_name, const Json& json_context);
-            static Json               writeByName(std::string type_name, void* instance);
+            static TypeMeta newMetaFromName(std::string_view type_name);
 
-            std::string getTypeName();
+            static bool newArrayAccessorFromName(std::string_view array_type_name, ArrayAccessor& accessor);
+            static ReflectionInstance newFromNameAndJson(std::string_view type_name, const Json& json_context);
+            static Json               writeByName(std::string_view type_name, void* instance);
+            // streaming counterparts of newFromNameAndJson and writeByName
+            static ReflectionInstance newFromNameAndJsonReader(std::string_view type_name, JsonReader& reader);
+            static void               writeByName(std::string_view type_name, void* instance, JsonWriter& writer);
+            // a new instance of the named type copied from instance, copied through json when it is not copyable
+            static ReflectionInstance newCopyFromName(std::string_view type_name, const void* instance);
 
-            int getFieldsList(FieldAccessor*& out_list);
-            int getMethodsList(MethodAccessor*& out_list);
+            const std::string& getTypeName() const;
 
-            int getBaseClassReflectionInstanceList(ReflectionInstance*& out_list, void* instance);
+            // valid until the types are unregistered
+            AccessorSpan<const FieldAccessor>  getFields() const;
+            AccessorSpan<const MethodAccessor> getMethods() const;
 
-            FieldAccessor getFieldByName(const char* name);
-            MethodAccessor getMethodByName(const char* name);
+            int getBaseClassReflectionInstanceList(ReflectionInstance*& out_list, void* instance) const;
 
-            bool isValid() { return m_is_valid; }
+            // an accessor without functions when the name is not found
+            FieldAccessor  getFieldByName(std::string_view name) const;
+            MethodAccessor getMethodByName(std::string_view name) const;
 
-            TypeMeta& operator=(const TypeMeta& dest);
+            // a reflected type with fields or methods
+            bool isValid() const;
 
         private:
-            TypeMeta(std::string type_name);
+            explicit TypeMeta(const TypeData* data) : m_data(data) {}
 
         private:
-            std::vector<FieldAccessor, std::allocator<FieldAccessor>>   m_fields;
-            std::vector<MethodAccessor, std::allocator<MethodAccessor>> m_methods;
-            std::string                                                 m_type_name;
-
-            bool m_is_valid;
+            const TypeData* m_data {nullptr};
         };
 
         class FieldAccessor
         {
             friend class TypeMeta;
+            friend class TypeMetaRegisterinterface;
 
         public:
             FieldAccessor();
 
-            void* get(void* instance);
-            void  set(void* instance, void* value);
+            void* get(void* instance) const;
+            void  set(void* instance, void* value) const;
 
-            TypeMeta getOwnerTypeMeta();
+            TypeMeta getOwnerTypeMeta() const;
 
             /**
              * param: TypeMeta out_type
@@ -170,10 +219,11 @@ namespace Piccolo
              *        true: it's a reflection type
              *        false: it's not a reflection type
              */
-            bool        getTypeMeta(TypeMeta& field_type);
+            bool        getTypeMeta(TypeMeta& field_type) const;
             const char* getFieldName() const;
-            const char* getFieldTypeName();
-            bool        isArrayType();
+            const char* getFieldTypeName() const;
+            bool        isArrayType() const;
+            bool        isValid() const { return m_functions != nullptr; }
 
             FieldAccessor& operator=(const FieldAccessor& dest);
 
@@ -188,13 +238,15 @@ namespace Piccolo
         class MethodAccessor
         {
             friend class TypeMeta;
+            friend class TypeMetaRegisterinterface;
 
         public:
             MethodAccessor();
 
-            void invoke(void* instance);
+            void invoke(void* instance) const;
 
             const char* getMethodName() const;
+            bool        isValid() const { return m_functions != nullptr; }
 
             MethodAccessor& operator=(const MethodAccessor& dest);
 
@@ -211,6 +263,7 @@ namespace Piccolo
         class ArrayAccessor
         {
             friend class TypeMeta;
+            friend class TypeMetaRegisterinterface;
 
         public:
             ArrayAccessor();
@@ -305,7 +358,7 @@ namespace Piccolo
                 return *this;
             }
 
-            std::string getTypeName() const { return m_type_name; }
+            const std::string& getTypeName() const { return m_type_name; }
 
             void setTypeName(std::string name) { m_type_name = name; }
 
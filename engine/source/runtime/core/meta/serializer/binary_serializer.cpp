@@ -0,0 +1,97 @@
+#include "binary_serializer.h"
+
+namespace Piccolo
+{
+    template<>
+    void BinarySerializer::write(BinaryWriter& writer, const char& instance)
+    {
+        writer.writeBytes(&instance, sizeof(instance));
+    }
+    template<>
+    char& BinarySerializer::read(BinaryReader& reader, char& instance)
+    {
+        reader.readBytes(&instance, sizeof(instance));
+        return instance;
+    }
+
+    template<>
+    void BinarySerializer::write(BinaryWriter& writer, const int& instance)
+    {
+        const int32_t value = instance;
+        writer.writeBytes(&value, sizeof(value));
+    }
+    template<>
+    int& BinarySerializer::read(BinaryReader& reader, int& instance)
+    {
+        int32_t value = 0;
+        reader.readBytes(&value, sizeof(value));
+        return instance = value;
+    }
+
+    template<>
+    void BinarySerializer::write(BinaryWriter& writer, const unsigned int& instance)
+    {
+        const uint32_t value = instance;
+        writer.writeBytes(&value, sizeof(value));
+    }
+    template<>
+    unsigned int& BinarySerializer::read(BinaryReader& reader, unsigned int& instance)
+    {
+        uint32_t value = 0;
+        reader.readBytes(&value, sizeof(value));
+        return instance = value;
+    }
+
+    template<>
+    void BinarySerializer::write(BinaryWriter& writer, const float& instance)
+    {
+        writer.writeBytes(&instance, sizeof(instance));
+    }
+    template<>
+    float& BinarySerializer::read(BinaryReader& reader, float& instance)
+    {
+        reader.readBytes(&instance, sizeof(instance));
+        return instance;
+    }
+
+    template<>
+    void BinarySerializer::write(BinaryWriter& writer, const double& instance)
+    {
+        writer.writeBytes(&instance, sizeof(instance));
+    }
+    template<>
+    double& BinarySerializer::read(BinaryReader& reader, double& instance)
+    {
+        reader.readBytes(&instance, sizeof(instance));
+        return instance;
+    }
+
+    template<>
+    void BinarySerializer::write(BinaryWriter& writer, const bool& instance)
+    {
+        const uint8_t value = instance ? 1 : 0;
+        writer.writeBytes(&value, sizeof(value));
+    }
+    template<>
+    bool& BinarySerializer::read(BinaryReader& reader, bool& instance)
+    {
+        uint8_t value = 0;
+        reader.readBytes(&value, sizeof(value));
+        return instance = value != 0;
+    }
+
+    template<>
+    void BinarySerializer::write(BinaryWriter& writer, const std::string& instance)
+    {
+        writer.writeSize(instance.size());
+        writer.writeBytes(instance.data(), instance.size());
+    }
+    template<>
+    std::string& BinarySerializer::read(BinaryReader& reader, std::string& instance)
+    {
+        const size_t size = reader.readSize();
+        instance.resize(size);
+        reader.readBytes(instance.data(), size);
+        return instance;
+    }
+} // namespace Piccolo
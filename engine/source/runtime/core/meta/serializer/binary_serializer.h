@@ -0,0 +1,206 @@
+#pragma once
+#include "runtime/core/meta/reflection/reflection.h"
+#include "runtime/core/meta/serializer/json_stream_serializer.h"
+#include "runtime/core/meta/serializer/serializer.h"
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace Piccolo
+{
+    /// Growing little endian byte buffer the binary serializer writes to.
+    class BinaryWriter
+    {
+    public:
+        void writeBytes(const void* data, size_t size)
+        {
+            const uint8_t* bytes = static_cast<const uint8_t*>(data);
+            m_buffer.insert(m_buffer.end(), bytes, bytes + size);
+        }
+        // element counts and string lengths
+        void writeSize(size_t size)
+        {
+            const uint32_t size_32 = static_cast<uint32_t>(size);
+            writeBytes(&size_32, sizeof(size_32));
+        }
+
+        const std::vector<uint8_t>& getBuffer() const { return m_buffer; }
+        std::vector<uint8_t>&       getBuffer() { return m_buffer; }
+
+    private:
+        std::vector<uint8_t> m_buffer;
+    };
+
+    /// Reads back what BinaryWriter wrote. Running past the end or reading a count larger than the remaining data
+    /// invalidates the reader instead of touching memory out of the buffer, every following read is then ignored.
+    class BinaryReader
+    {
+    public:
+        BinaryReader(const uint8_t* data, size_t size) : m_current(data), m_end(data + size) {}
+
+        bool readBytes(void* data, size_t size)
+        {
+            if (!m_is_valid || static_cast<size_t>(m_end - m_current) < size)
+            {
+                m_is_valid = false;
+                return false;
+            }
+            std::memcpy(data, m_current, size);
+            m_current += size;
+            return true;
+        }
+        // element_size is the smallest encoded size of an element, a count that cannot fit is rejected
+        size_t readSize(size_t element_size = 1)
+        {
+            uint32_t size_32 = 0;
+            if (!readBytes(&size_32, sizeof(size_32)))
+                return 0;
+            if (element_size > 0 && size_32 > remaining() / element_size)
+            {
+                m_is_valid = false;
+                return 0;
+            }
+            return size_32;
+        }
+
+        size_t remaining() const { return static_cast<size_t>(m_end - m_current); }
+        bool   isValid() const { return m_is_valid; }
+
+    private:
+        const uint8_t* m_current;
+        const uint8_t* m_end;
+        bool           m_is_valid {true};
+    };
+
+    /// Compact counterpart of Serializer, the fields are written in declaration order without their names.
+    /// The generated code implements it for every reflected type next to the json one, the layout is identified by
+    /// k_binary_schema_hash in all_serializer.h and changes whenever a reflected field does.
+    class BinarySerializer
+    {
+    public:
+        template<typename T>
+        static void writePointer(BinaryWriter& writer, T* instance)
+        {
+            const bool is_null = instance == nullptr;
+            writer.writeBytes(&is_null, sizeof(is_null));
+            if (!is_null)
+            {
+                write(writer, *instance);
+            }
+        }
+
+        template<typename T>
+        static T*& readPointer(BinaryReader& reader, T*& instance)
+        {
+            assert(instance == nullptr);
+            bool is_null = true;
+            reader.readBytes(&is_null, sizeof(is_null));
+            if (!is_null && reader.isValid())
+            {
+                instance = new T;
+                read(reader, *instance);
+            }
+            return instance;
+        }
+
+        // the dynamic type is only known by name, its content is kept as json text through the reflection
+        template<typename T>
+        static void write(BinaryWriter& writer, const Reflection::ReflectionPtr<T>& instance)
+        {
+            T*                instance_ptr = static_cast<T*>(instance.operator->());
+            const std::string type_name    = instance.getTypeName();
+            write(writer, type_name);
+
+            JsonWriter context_writer;
+            Reflection::TypeMeta::writeByName(type_name, instance_ptr, context_writer);
+            write(writer, context_writer.getBuffer());
+        }
+
+        template<typename T>
+        static T*& read(BinaryReader& reader, Reflection::ReflectionPtr<T>& instance)
+        {
+            std::string type_name;
+            std::string context_text;
+            read(reader, type_name);
+            read(reader, context_text);
+            instance.setTypeName(type_name);
+
+            T*& instance_ptr = instance.getPtrReference();
+            assert(instance_ptr == nullptr);
+            if (!reader.isValid())
+                return instance_ptr;
+
+            JsonReader context_reader(context_text);
+            instance_ptr =
+                static_cast<T*>(Reflection::TypeMeta::newFromNameAndJsonReader(type_name, context_reader).m_instance);
+            return instance_ptr;
+        }
+
+        template<typename T>
+        static void write(BinaryWriter& writer, const T& instance)
+        {
+            if constexpr (std::is_pointer<T>::value)
+            {
+                writePointer(writer, (T)instance);
+            }
+            else
+            {
+                static_assert(always_false<T>, "BinarySerializer::write<T> has not been implemented yet!");
+            }
+        }
+
+        template<typename T>
+        static T& read(BinaryReader& reader, T& instance)
+        {
+            if constexpr (std::is_pointer<T>::value)
+            {
+                return readPointer(reader, instance);
+            }
+            else
+            {
+                static_assert(always_false<T>, "BinarySerializer::read<T> has not been implemented yet!");
+                return instance;
+            }
+        }
+    };
+
+    // implementation of base types
+    template<>
+    void BinarySerializer::write(BinaryWriter& writer, const char& instance);
+    template<>
+    char& BinarySerializer::read(BinaryReader& reader, char& instance);
+
+    template<>
+    void BinarySerializer::write(BinaryWriter& writer, const int& instance);
+    template<>
+    int& BinarySerializer::read(BinaryReader& reader, int& instance);
+
+    template<>
+    void BinarySerializer::write(BinaryWriter& writer, const unsigned int& instance);
+    template<>
+    unsigned int& BinarySerializer::read(BinaryReader& reader, unsigned int& instance);
+
+    template<>
+    void BinarySerializer::write(BinaryWriter& writer, const float& instance);
+    template<>
+    float& BinarySerializer::read(BinaryReader& reader, float& instance);
+
+    template<>
+    void BinarySerializer::write(BinaryWriter& writer, const double& instance);
+    template<>
+    double& BinarySerializer::read(BinaryReader& reader, double& instance);
+
+    template<>
+    void BinarySerializer::write(BinaryWriter& writer, const bool& instance);
+    template<>
+    bool& BinarySerializer::read(BinaryReader& reader, bool& instance);
+
+    template<>
+    void BinarySerializer::write(BinaryWriter& writer, const std::string& instance);
+    template<>
+    std::string& BinarySerializer::read(BinaryReader& reader, std::string& instance);
+} // namespace Piccolo
@@ -0,0 +1,643 @@
+#include "json_stream_serializer.h"
+
+#include <charconv>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+
+namespace Piccolo
+{
+    namespace
+    {
+        void appendUtf8(std::string& out, uint32_t code_point)
+        {
+            if (code_point < 0x80)
+            {
+                out += static_cast<char>(code_point);
+            }
+            else if (code_point < 0x800)
+            {
+                out += static_cast<char>(0xc0 | (code_point >> 6));
+                out += static_cast<char>(0x80 | (code_point & 0x3f));
+            }
+            else if (code_point < 0x10000)
+            {
+                out += static_cast<char>(0xe0 | (code_point >> 12));
+                out += static_cast<char>(0x80 | ((code_point >> 6) & 0x3f));
+                out += static_cast<char>(0x80 | (code_point & 0x3f));
+            }
+            else
+            {
+                out += static_cast<char>(0xf0 | (code_point >> 18));
+                out += static_cast<char>(0x80 | ((code_point >> 12) & 0x3f));
+                out += static_cast<char>(0x80 | ((code_point >> 6) & 0x3f));
+                out += static_cast<char>(0x80 | (code_point & 0x3f));
+            }
+        }
+
+        int hexValue(char c)
+        {
+            if (c >= '0' && c <= '9')
+                return c - '0';
+            if (c >= 'a' && c <= 'f')
+                return c - 'a' + 10;
+            if (c >= 'A' && c <= 'F')
+                return c - 'A' + 10;
+            return -1;
+        }
+    } // namespace
+
+    void JsonWriter::beginValue()
+    {
+        if (m_is_after_key)
+        {
+            m_is_after_key = false;
+            return;
+        }
+        if (!m_is_first_value.back())
+        {
+            m_buffer += ',';
+        }
+        m_is_first_value.back() = false;
+    }
+
+    void JsonWriter::beginObject()
+    {
+        beginValue();
+        m_buffer += '{';
+        m_is_first_value.push_back(true);
+    }
+
+    void JsonWriter::endObject()
+    {
+        m_is_first_value.pop_back();
+        m_buffer += '}';
+    }
+
+    void JsonWriter::beginArray()
+    {
+        beginValue();
+        m_buffer += '[';
+        m_is_first_value.push_back(true);
+    }
+
+    void JsonWriter::endArray()
+    {
+        m_is_first_value.pop_back();
+        m_buffer += ']';
+    }
+
+    void JsonWriter::writeKey(std::string_view key)
+    {
+        writeString(key);
+        m_buffer += ':';
+        m_is_after_key = true;
+    }
+
+    void JsonWriter::writeString(std::string_view value)
+    {
+        beginValue();
+        m_buffer += '"';
+        for (const char c : value)
+        {
+            switch (c)
+            {
+                case '"':
+                    m_buffer += "\\\"";
+                    break;
+                case '\\':
+                    m_buffer += "\\\\";
+                    break;
+                case '\n':
+                    m_buffer += "\\n";
+                    break;
+                case '\r':
+                    m_buffer += "\\r";
+                    break;
+                case '\t':
+                    m_buffer += "\\t";
+                    break;
+                case '\b':
+                    m_buffer += "\\b";
+                    break;
+                case '\f':
+                    m_buffer += "\\f";
+                    break;
+                default:
+                    if (static_cast<unsigned char>(c) < 0x20)
+                    {
+                        char escaped[8];
+                        std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned>(c));
+                        m_buffer += escaped;
+                    }
+                    else
+                    {
+                        m_buffer += c;
+                    }
+                    break;
+            }
+        }
+        m_buffer += '"';
+    }
+
+    void JsonWriter::writeInt(int64_t value)
+    {
+        beginValue();
+        char text[24];
+        m_buffer.append(text, std::to_chars(text, text + sizeof(text), value).ptr);
+    }
+
+    void JsonWriter::writeUnsigned(uint64_t value)
+    {
+        beginValue();
+        char text[24];
+        m_buffer.append(text, std::to_chars(text, text + sizeof(text), value).ptr);
+    }
+
+    void JsonWriter::writeFloat(float value)
+    {
+        // 9 digits read back to the same float
+        beginValue();
+        char text[32];
+        const int size = std::snprintf(text, sizeof(text), "%.9g", static_cast<double>(value));
+        m_buffer.append(text, size);
+    }
+
+    void JsonWriter::writeDouble(double value)
+    {
+        beginValue();
+        char text[32];
+        const int size = std::snprintf(text, sizeof(text), "%.17g", value);
+        m_buffer.append(text, size);
+    }
+
+    void JsonWriter::writeBool(bool value)
+    {
+        beginValue();
+        m_buffer += value ? "true" : "false";
+    }
+
+    void JsonWriter::writeNull()
+    {
+        beginValue();
+        m_buffer += "null";
+    }
+
+    void JsonReader::skipWhitespace()
+    {
+        while (m_current < m_end &&
+               (*m_current == ' ' || *m_current == '\n' || *m_current == '\r' || *m_current == '\t'))
+        {
+            ++m_current;
+        }
+    }
+
+    bool JsonReader::fail()
+    {
+        m_is_valid = false;
+        return false;
+    }
+
+    bool JsonReader::consume(char expected)
+    {
+        skipWhitespace();
+        if (!m_is_valid || m_current == m_end || *m_current != expected)
+            return false;
+        ++m_current;
+        return true;
+    }
+
+    bool JsonReader::beginObject()
+    {
+        if (!consume('{'))
+            return fail();
+        m_has_previous.push_back(false);
+        return true;
+    }
+
+    bool JsonReader::nextKey(std::string_view& out_key)
+    {
+        if (!m_is_valid || m_has_previous.empty())
+            return fail();
+
+        if (consume('}'))
+        {
+            m_has_previous.pop_back();
+            return false;
+        }
+        if (m_has_previous.back() && !consume(','))
+            return fail();
+        m_has_previous.back() = true;
+
+        skipWhitespace();
+        if (!readStringView(out_key) || !consume(':'))
+            return fail();
+        return true;
+    }
+
+    bool JsonReader::beginArray()
+    {
+        if (!consume('['))
+            return fail();
+        m_has_previous.push_back(false);
+        return true;
+    }
+
+    bool JsonReader::nextElement()
+    {
+        if (!m_is_valid || m_has_previous.empty())
+            return fail();
+
+        if (consume(']'))
+        {
+            m_has_previous.pop_back();
+            return false;
+        }
+        if (m_has_previous.back() && !consume(','))
+            return fail();
+        m_has_previous.back() = true;
+        return true;
+    }
+
+    bool JsonReader::readStringView(std::string_view& out_value)
+    {
+        if (m_current == m_end || *m_current != '"')
+            return fail();
+        ++m_current;
+
+        // strings without escapes are returned in place
+        const char* begin = m_current;
+        while (m_current < m_end && *m_current != '"' && *m_current != '\\')
+        {
+            ++m_current;
+        }
+        if (m_current == m_end)
+            return fail();
+        if (*m_current == '"')
+        {
+            out_value = std::string_view(begin, static_cast<size_t>(m_current - begin));
+            ++m_current;
+            return true;
+        }
+
+        m_scratch.assign(begin, m_current);
+        while (m_current < m_end && *m_current != '"')
+        {
+            char c = *m_current++;
+            if (c != '\\')
+            {
+                m_scratch += c;
+                continue;
+            }
+            if (m_current == m_end)
+                return fail();
+
+            c = *m_current++;
+            switch (c)
+            {
+                case '"':
+                case '\\':
+                case '/':
+                    m_scratch += c;
+                    break;
+                case 'b':
+                    m_scratch += '\b';
+                    break;
+                case 'f':
+                    m_scratch += '\f';
+                    break;
+                case 'n':
+                    m_scratch += '\n';
+                    break;
+                case 'r':
+                    m_scratch += '\r';
+                    break;
+                case 't':
+                    m_scratch += '\t';
+                    break;
+                case 'u': {
+                    uint32_t code_point = 0;
+                    for (int digit = 0; digit < 4; ++digit)
+                    {
+                        const int value = m_current < m_end ? hexValue(*m_current++) : -1;
+                        if (value < 0)
+                            return fail();
+                        code_point = (code_point << 4) | static_cast<uint32_t>(value);
+                    }
+                    // a high surrogate is followed by the low one
+                    if (code_point >= 0xd800 && code_point < 0xdc00 && m_end - m_current >= 6 && m_current[0] == '\\' &&
+                        m_current[1] == 'u')
+                    {
+                        uint32_t low = 0;
+                        for (int digit = 2; digit < 6; ++digit)
+                        {
+                            const int value = hexValue(m_current[digit]);
+                            if (value < 0)
+                                return fail();
+                            low = (low << 4) | static_cast<uint32_t>(value);
+                        }
+                        if (low >= 0xdc00 && low < 0xe000)
+                        {
+                            code_point = 0x10000 + ((code_point - 0xd800) << 10) + (low - 0xdc00);
+                            m_current += 6;
+                        }
+                    }
+                    appendUtf8(m_scratch, code_point);
+                    break;
+                }
+                default:
+                    return fail();
+            }
+        }
+        if (m_current == m_end)
+            return fail();
+        ++m_current;
+        out_value = m_scratch;
+        return true;
+    }
+
+    bool JsonReader::readString(std::string& out_value)
+    {
+        skipWhitespace();
+        std::string_view value;
+        if (!m_is_valid || !readStringView(value))
+            return fail();
+        out_value.assign(value.data(), value.size());
+        return true;
+    }
+
+    bool JsonReader::readDouble(double& out_value)
+    {
+        skipWhitespace();
+        if (!m_is_valid || m_current == m_end)
+            return fail();
+
+        char*        number_end = nullptr;
+        const double value      = std::strtod(m_current, &number_end);
+        if (number_end == m_current || number_end > m_end)
+            return fail();
+        m_current = number_end;
+        out_value = value;
+        return true;
+    }
+
+    bool JsonReader::readInt(int64_t& out_value)
+    {
+        skipWhitespace();
+        if (!m_is_valid || m_current == m_end)
+            return fail();
+
+        // plain integers are parsed here, the others are truncated like the json serializer does
+        const char* current     = m_current;
+        const bool  is_negative = *current == '-';
+        if (is_negative)
+        {
+            ++current;
+        }
+        uint64_t    value        = 0;
+        const char* digits_begin = current;
+        while (current < m_end && *current >= '0' && *current <= '9' && current - digits_begin < 18)
+        {
+            value = value * 10 + static_cast<uint64_t>(*current - '0');
+            ++current;
+        }
+        if (current != digits_begin && (current == m_end || (*current != '.' && *current != 'e' && *current != 'E' &&
+                                                             (*current < '0' || *current > '9'))))
+        {
+            m_current = current;
+            out_value = is_negative ? -static_cast<int64_t>(value) : static_cast<int64_t>(value);
+            return true;
+        }
+
+        double double_value = 0.0;
+        if (!readDouble(double_value))
+            return false;
+        out_value = static_cast<int64_t>(double_value);
+        return true;
+    }
+
+    bool JsonReader::readBool(bool& out_value)
+    {
+        skipWhitespace();
+        if (skipLiteral("true"))
+        {
+            out_value = true;
+            return true;
+        }
+        if (skipLiteral("false"))
+        {
+            out_value = false;
+            return true;
+        }
+        return fail();
+    }
+
+    bool JsonReader::readNull()
+    {
+        skipWhitespace();
+        return skipLiteral("null");
+    }
+
+    bool JsonReader::skipLiteral(std::string_view literal)
+    {
+        if (!m_is_valid || static_cast<size_t>(m_end - m_current) < literal.size() ||
+            std::string_view(m_current, literal.size()) != literal)
+            return false;
+        m_current += literal.size();
+        return true;
+    }
+
+    bool JsonReader::skipString()
+    {
+        if (m_current == m_end || *m_current != '"')
+            return fail();
+        ++m_current;
+        while (m_current < m_end && *m_current != '"')
+        {
+            m_current += *m_current == '\\' ? 2 : 1;
+        }
+        if (m_current >= m_end)
+            return fail();
+        ++m_current;
+        return true;
+    }
+
+    bool JsonReader::skipNumber()
+    {
+        double value = 0.0;
+        return readDouble(value);
+    }
+
+    std::string_view JsonReader::skipValue()
+    {
+        skipWhitespace();
+        const char* begin = m_current;
+        if (!m_is_valid || m_current == m_end)
+        {
+            fail();
+            return {};
+        }
+
+        switch (*m_current)
+        {
+            case '{': {
+                beginObject();
+                std::string_view key;
+                while (nextKey(key))
+                {
+                    skipValue();
+                }
+                break;
+            }
+            case '[':
+                beginArray();
+                while (nextElement())
+                {
+                    skipValue();
+                }
+                break;
+            case '"':
+                skipString();
+                break;
+            case 't':
+            case 'f':
+            case 'n':
+                if (!skipLiteral("true") && !skipLiteral("false") && !skipLiteral("null"))
+                {
+                    fail();
+                }
+                break;
+            default:
+                skipNumber();
+                break;
+        }
+        return m_is_valid ? std::string_view(begin, static_cast<size_t>(m_current - begin)) : std::string_view();
+    }
+
+    void JsonStreamSerializer::readTypedObject(JsonReader&                             reader,
+                                               std::string&                            out_type_name,
+                                               const std::function<void(JsonReader&)>& read_context)
+    {
+        if (!reader.beginObject())
+            return;
+
+        // the json serializer writes the keys sorted, the context comes first and is read after the type name
+        std::string_view context_text;
+        bool             is_context_read = false;
+        std::string_view key;
+        while (reader.nextKey(key))
+        {
+            if (key == "$typeName")
+            {
+                reader.readString(out_type_name);
+            }
+            else if (key == "$context" && !out_type_name.empty())
+            {
+                read_context(reader);
+                is_context_read = true;
+            }
+            else if (key == "$context")
+            {
+                context_text = reader.skipValue();
+            }
+            else
+            {
+                reader.skipValue();
+            }
+        }
+
+        if (!is_context_read && !context_text.empty() && !out_type_name.empty() && reader.isValid())
+        {
+            JsonReader context_reader(context_text);
+            read_context(context_reader);
+        }
+    }
+
+    template<>
+    void JsonStreamSerializer::write(JsonWriter& writer, const char& instance)
+    {
+        writer.writeInt(instance);
+    }
+    template<>
+    char& JsonStreamSerializer::read(JsonReader& reader, char& instance)
+    {
+        int64_t value = 0;
+        reader.readInt(value);
+        return instance = static_cast<char>(value);
+    }
+
+    template<>
+    void JsonStreamSerializer::write(JsonWriter& writer, const int& instance)
+    {
+        writer.writeInt(instance);
+    }
+    template<>
+    int& JsonStreamSerializer::read(JsonReader& reader, int& instance)
+    {
+        int64_t value = 0;
+        reader.readInt(value);
+        return instance = static_cast<int>(value);
+    }
+
+    template<>
+    void JsonStreamSerializer::write(JsonWriter& writer, const unsigned int& instance)
+    {
+        writer.writeUnsigned(instance);
+    }
+    template<>
+    unsigned int& JsonStreamSerializer::read(JsonReader& reader, unsigned int& instance)
+    {
+        int64_t value = 0;
+        reader.readInt(value);
+        return instance = static_cast<unsigned int>(value);
+    }
+
+    template<>
+    void JsonStreamSerializer::write(JsonWriter& writer, const float& instance)
+    {
+        writer.writeFloat(instance);
+    }
+    template<>
+    float& JsonStreamSerializer::read(JsonReader& reader, float& instance)
+    {
+        double value = 0.0;
+        reader.readDouble(value);
+        return instance = static_cast<float>(value);
+    }
+
+    template<>
+    void JsonStreamSerializer::write(JsonWriter& writer, const double& instance)
+    {
+        writer.writeDouble(instance);
+    }
+    template<>
+    double& JsonStreamSerializer::read(JsonReader& reader, double& instance)
+    {
+        reader.readDouble(instance);
+        return instance;
+    }
+
+    template<>
+    void JsonStreamSerializer::write(JsonWriter& writer, const bool& instance)
+    {
+        writer.writeBool(instance);
+    }
+    template<>
+    bool& JsonStreamSerializer::read(JsonReader& reader, bool& instance)
+    {
+        reader.readBool(instance);
+        return instance;
+    }
+
+    template<>
+    void JsonStreamSerializer::write(JsonWriter& writer, const std::string& instance)
+    {
+        writer.writeString(instance);
+    }
+    template<>
+    std::string& JsonStreamSerializer::read(JsonReader& reader, std::string& instance)
+    {
+        reader.readString(instance);
+        return instance;
+    }
+} // namespace Piccolo
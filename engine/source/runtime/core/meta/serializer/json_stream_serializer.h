@@ -0,0 +1,269 @@
+#pragma once
+#include "runtime/core/meta/reflection/reflection.h"
+#include "runtime/core/meta/serializer/serializer.h"
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Piccolo
+{
+    /// Appends json text to a string, reserved up front by the caller when the size is roughly known.
+    /// The structure is written in order, keys only inside objects, the separators are added by the writer.
+    class JsonWriter
+    {
+    public:
+        explicit JsonWriter(size_t reserved_size = 0) { m_buffer.reserve(reserved_size); }
+
+        void beginObject();
+        void endObject();
+        void beginArray();
+        void endArray();
+        void writeKey(std::string_view key);
+
+        void writeString(std::string_view value);
+        void writeInt(int64_t value);
+        void writeUnsigned(uint64_t value);
+        void writeFloat(float value);
+        void writeDouble(double value);
+        void writeBool(bool value);
+        void writeNull();
+
+        const std::string& getBuffer() const { return m_buffer; }
+        std::string&       getBuffer() { return m_buffer; }
+
+    private:
+        // a separator before every value but the first of its object or array, none after a key
+        void beginValue();
+
+        std::string       m_buffer;
+        std::vector<bool> m_is_first_value {true};
+        bool              m_is_after_key {false};
+    };
+
+    /// Pull tokenizer over json text, the values are read in document order straight into their destination.
+    /// Like BinaryReader a malformed document invalidates the reader, every following read then fails.
+    /// The text must stay alive and be null terminated, as a std::string is.
+    class JsonReader
+    {
+    public:
+        JsonReader(const char* data, size_t size) : m_begin(data), m_current(data), m_end(data + size) {}
+        explicit JsonReader(std::string_view text) : JsonReader(text.data(), text.size()) {}
+
+        // false when the next value is not an object
+        bool beginObject();
+        // the next key of the current object, false and the object is closed when there is none left.
+        // the key is valid until the next read
+        bool nextKey(std::string_view& out_key);
+        bool beginArray();
+        // false and the array is closed when there is no element left
+        bool nextElement();
+
+        bool readString(std::string& out_value);
+        bool readDouble(double& out_value);
+        bool readInt(int64_t& out_value);
+        bool readBool(bool& out_value);
+        // consumes the next value when it is null
+        bool readNull();
+        // the text of the skipped value
+        std::string_view skipValue();
+
+        bool   isValid() const { return m_is_valid; }
+        size_t getOffset() const { return static_cast<size_t>(m_current - m_begin); }
+
+    private:
+        void skipWhitespace();
+        bool consume(char expected);
+        bool fail();
+        bool readStringView(std::string_view& out_value);
+        bool skipString();
+        bool skipNumber();
+        bool skipLiteral(std::string_view literal);
+
+        const char* m_begin;
+        const char* m_current;
+        const char* m_end;
+        bool        m_is_valid {true};
+        // an element or key already read in the current array or object, the next one needs a comma
+        std::vector<bool> m_has_previous;
+        // unescaped keys and strings
+        std::string m_scratch;
+    };
+
+    /// Counterpart of Serializer without the Json document, the generated code reads and writes every reflected type
+    /// field by field on a JsonReader or JsonWriter. The text is the same json Serializer reads and writes.
+    class JsonStreamSerializer
+    {
+    public:
+        template<typename T>
+        static void writePointer(JsonWriter& writer, T* instance)
+        {
+            writer.beginObject();
+            writer.writeKey("$typeName");
+            writer.writeString("*");
+            writer.writeKey("$context");
+            write(writer, *instance);
+            writer.endObject();
+        }
+
+        template<typename T>
+        static T*& readPointer(JsonReader& reader, T*& instance)
+        {
+            assert(instance == nullptr);
+            std::string type_name;
+            readTypedObject(reader, type_name, [&instance, &type_name](JsonReader& context_reader) {
+                if (!type_name.empty() && '*' == type_name[0])
+                {
+                    instance = new T;
+                    read(context_reader, *instance);
+                }
+                else
+                {
+                    instance = static_cast<T*>(
+                        Reflection::TypeMeta::newFromNameAndJsonReader(type_name, context_reader).m_instance);
+                }
+            });
+            return instance;
+        }
+
+        template<typename T>
+        static void write(JsonWriter& writer, const Reflection::ReflectionPtr<T>& instance)
+        {
+            T*                 instance_ptr = static_cast<T*>(instance.operator->());
+            const std::string& type_name    = instance.getTypeName();
+            writer.beginObject();
+            writer.writeKey("$typeName");
+            writer.writeString(type_name);
+            writer.writeKey("$context");
+            Reflection::TypeMeta::writeByName(type_name, instance_ptr, writer);
+            writer.endObject();
+        }
+
+        template<typename T>
+        static T*& read(JsonReader& reader, Reflection::ReflectionPtr<T>& instance)
+        {
+            T*& instance_ptr = instance.getPtrReference();
+            assert(instance_ptr == nullptr);
+            std::string type_name;
+            readTypedObject(reader, type_name, [&instance_ptr, &type_name](JsonReader& context_reader) {
+                instance_ptr = static_cast<T*>(
+                    Reflection::TypeMeta::newFromNameAndJsonReader(type_name, context_reader).m_instance);
+            });
+            instance.setTypeName(type_name);
+            return instance_ptr;
+        }
+
+        template<typename T>
+        static void writeArray(JsonWriter& writer, const std::vector<T>& instance)
+        {
+            writer.beginArray();
+            for (const auto& item : instance)
+            {
+                write(writer, item);
+            }
+            writer.endArray();
+        }
+
+        template<typename T>
+        static std::vector<T>& readArray(JsonReader& reader, std::vector<T>& instance)
+        {
+            instance.clear();
+            if (!reader.beginArray())
+                return instance;
+            while (reader.nextElement())
+            {
+                instance.emplace_back();
+                read(reader, instance.back());
+            }
+            return instance;
+        }
+
+        template<typename T>
+        static void write(JsonWriter& writer, const T& instance)
+        {
+            if constexpr (std::is_pointer<T>::value)
+            {
+                writePointer(writer, (T)instance);
+            }
+            else
+            {
+                static_assert(always_false<T>, "JsonStreamSerializer::write<T> has not been implemented yet!");
+            }
+        }
+
+        template<typename T>
+        static T& read(JsonReader& reader, T& instance)
+        {
+            if constexpr (std::is_pointer<T>::value)
+            {
+                return readPointer(reader, instance);
+            }
+            else
+            {
+                static_assert(always_false<T>, "JsonStreamSerializer::read<T> has not been implemented yet!");
+                return instance;
+            }
+        }
+
+        // the fields of a reflected type, without the braces so the derived types write theirs in the same object
+        template<typename T>
+        static void writeFields(JsonWriter& writer, const T& instance)
+        {
+            static_assert(always_false<T>, "JsonStreamSerializer::writeFields<T> has not been implemented yet!");
+        }
+
+        // reads the value of key when it is a field of the type or of its bases, false when it is not
+        template<typename T>
+        static bool readField(JsonReader& reader, std::string_view key, T& instance)
+        {
+            static_assert(always_false<T>, "JsonStreamSerializer::readField<T> has not been implemented yet!");
+            return false;
+        }
+
+    private:
+        // {"$typeName": ..., "$context": ...} in any order, the context is read once the type name is known
+        static void readTypedObject(JsonReader&                             reader,
+                                    std::string&                            out_type_name,
+                                    const std::function<void(JsonReader&)>& read_context);
+    };
+
+    // implementation of base types
+    template<>
+    void JsonStreamSerializer::write(JsonWriter& writer, const char& instance);
+    template<>
+    char& JsonStreamSerializer::read(JsonReader& reader, char& instance);
+
+    template<>
+    void JsonStreamSerializer::write(JsonWriter& writer, const int& instance);
+    template<>
+    int& JsonStreamSerializer::read(JsonReader& reader, int& instance);
+
+    template<>
+    void JsonStreamSerializer::write(JsonWriter& writer, const unsigned int& instance);
+    template<>
+    unsigned int& JsonStreamSerializer::read(JsonReader& reader, unsigned int& instance);
+
+    template<>
+    void JsonStreamSerializer::write(JsonWriter& writer, const float& instance);
+    template<>
+    float& JsonStreamSerializer::read(JsonReader& reader, float& instance);
+
+    template<>
+    void JsonStreamSerializer::write(JsonWriter& writer, const double& instance);
+    template<>
+    double& JsonStreamSerializer::read(JsonReader& reader, double& instance);
+
+    template<>
+    void JsonStreamSerializer::write(JsonWriter& writer, const bool& instance);
+    template<>
+    bool& JsonStreamSerializer::read(JsonReader& reader, bool& instance);
+
+    template<>
+    void JsonStreamSerializer::write(JsonWriter& writer, const std::string& instance);
+    template<>
+    std::string& JsonStreamSerializer::read(JsonReader& reader, std::string& instance);
+} // namespace Piccolo
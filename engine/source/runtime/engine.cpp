@@ -12,10 +12,12 @@
 #include "runtime/function/render/window_system.h"
 #include "runtime/function/render/debugdraw/debug_draw_manager.h"
 
+#include "runtime/resource/config_manager/config_manager.h"
+
 namespace Piccolo
 {
-    bool                            g_is_editor_mode {false};
-    std::unordered_set<std::string> g_editor_tick_component_types {};
+    bool              g_is_editor_mode {false};
+    std::vector<bool> g_editor_tick_component_types {};
 
     void PiccoloEngine::startEngine(const std::string& config_file_path)
     {
@@ -43,11 +45,18 @@ namespace Piccolo
         std::shared_ptr<WindowSystem> window_system = g_runtime_global_context.m_window_system;
         ASSERT(window_system);
 
+        if (g_runtime_global_context.m_config_manager->isThreadedLogic())
+        {
+            startLogicThread();
+        }
+
         while (!window_system->shouldClose())
         {
             const float delta_time = calculateDeltaTime();
             tickOneFrame(delta_time);
         }
+
+        stopLogicThread();
     }
 
     float PiccoloEngine::calculateDeltaTime()
@@ -67,21 +76,43 @@ namespace Piccolo
 
     bool PiccoloEngine::tickOneFrame(float delta_time)
     {
-        logicalTick(delta_time);
-        calculateFPS(delta_time);
+        if (m_logic_thread.joinable())
+        {
+            // hand off, the logic thread is idle until the next logic frame is started
+            waitForLogicFrame();
+            calculateFPS(delta_time);
 
-        // single thread
-        // exchange data between logic and render contexts
-        g_runtime_global_context.m_render_system->swapLogicRenderData();
+            // the input callbacks write the input state read by the logic
+            g_runtime_global_context.m_window_system->pollEvents();
 
-        rendererTick(delta_time);
+            // exchange data between logic and render contexts
+            g_runtime_global_context.m_render_system->swapLogicRenderData();
 
 #ifdef ENABLE_PHYSICS_DEBUG_RENDERER
-        g_runtime_global_context.m_physics_manager->renderPhysicsWorld(delta_time);
+            g_runtime_global_context.m_physics_manager->renderPhysicsWorld(delta_time);
 #endif
 
-        g_runtime_global_context.m_window_system->pollEvents();
+            // the logic of the next frame overlaps the render of this one
+            startLogicFrame(delta_time);
+            rendererTick(delta_time);
+        }
+        else
+        {
+            logicalTick(delta_time);
+            calculateFPS(delta_time);
+
+            // single thread
+            // exchange data between logic and render contexts
+            g_runtime_global_context.m_render_system->swapLogicRenderData();
 
+            rendererTick(delta_time);
+
+#ifdef ENABLE_PHYSICS_DEBUG_RENDERER
+            g_runtime_global_context.m_physics_manager->renderPhysicsWorld(delta_time);
+#endif
+
+            g_runtime_global_context.m_window_system->pollEvents();
+        }
 
         g_runtime_global_context.m_window_system->setTitle(
             std::string("Piccolo - " + std::to_string(getFPS()) + " FPS").c_str());
@@ -102,6 +133,66 @@ namespace Piccolo
         return true;
     }
 
+    void PiccoloEngine::startLogicThread()
+    {
+        if (m_logic_thread.joinable())
+            return;
+
+        m_is_logic_frame_pending   = false;
+        m_is_logic_thread_stopping = false;
+        m_logic_thread             = std::thread(&PiccoloEngine::logicThreadMain, this);
+        LOG_INFO("logic thread started");
+    }
+
+    void PiccoloEngine::stopLogicThread()
+    {
+        if (!m_logic_thread.joinable())
+            return;
+
+        // the pending frame is finished first
+        {
+            std::lock_guard<std::mutex> lock(m_logic_mutex);
+            m_is_logic_thread_stopping = true;
+        }
+        m_logic_condition.notify_all();
+        m_logic_thread.join();
+    }
+
+    void PiccoloEngine::logicThreadMain()
+    {
+        std::unique_lock<std::mutex> lock(m_logic_mutex);
+        while (true)
+        {
+            m_logic_condition.wait(lock, [this] { return m_is_logic_frame_pending || m_is_logic_thread_stopping; });
+            if (!m_is_logic_frame_pending)
+                break;
+
+            const float delta_time = m_logic_delta_time;
+            lock.unlock();
+            logicalTick(delta_time);
+            lock.lock();
+
+            m_is_logic_frame_pending = false;
+            m_logic_condition.notify_all();
+        }
+    }
+
+    void PiccoloEngine::waitForLogicFrame()
+    {
+        std::unique_lock<std::mutex> lock(m_logic_mutex);
+        m_logic_condition.wait(lock, [this] { return !m_is_logic_frame_pending; });
+    }
+
+    void PiccoloEngine::startLogicFrame(float delta_time)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_logic_mutex);
+            m_logic_delta_time       = delta_time;
+            m_is_logic_frame_pending = true;
+        }
+        m_logic_condition.notify_all();
+    }
+
     const float PiccoloEngine::s_fps_alpha = 1.f / 100;
     void        PiccoloEngine::calculateFPS(float delta_time)
     {
@@ -2,15 +2,35 @@
 
 #include <atomic>
 #include <chrono>
+#include <condition_variable>
 #include <filesystem>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <unordered_set>
+#include <vector>
 
 namespace Piccolo
 {
-    extern bool                            g_is_editor_mode;
-    extern std::unordered_set<std::string> g_editor_tick_component_types;
+    extern bool g_is_editor_mode;
+    // indexed by component type id, see _generated/reflection/all_type_id.h
+    extern std::vector<bool> g_editor_tick_component_types;
 
+    /// Runs the frames of the logic and of the render.
+    /// In the single threaded mode a frame ticks the logic, hands its render commands over and renders them.
+    /// In the threaded mode, selected by ThreadedLogic=1 in the config and used by run, the logic ticks on a logic
+    /// thread one frame ahead of the render on the calling thread, the render of frame N overlapping the logic of
+    /// frame N + 1. The two only meet at the hand off, when the logic thread is idle: the window events are polled,
+    /// the RenderSwapContext is swapped and the next logic frame is started.
+    /// Ownership in the threaded mode:
+    /// - m_world_manager, m_input_system and the components belong to the logic thread, the window, input callbacks
+    ///   included, and the physics debug renderer run at the hand off
+    /// - m_render_system belongs to the render thread, the logic only submits to the logic commands of its swap
+    ///   context, reads the render camera, whose fov and view matrix are guarded, and the cull time copied at the
+    ///   hand off
+    /// - the skinning palettes have a copy per side of the swap context
+    /// - DebugDrawManager locks its groups, the logic fills them and the render copies them in its tick
+    /// The editor edits the world from its ui in the render pass, so it always runs single threaded.
     class PiccoloEngine
     {
         friend class PiccoloEditor;
@@ -36,6 +56,13 @@ namespace Piccolo
 
         void calculateFPS(float delta_time);
 
+        void startLogicThread();
+        void stopLogicThread();
+        void logicThreadMain();
+        // block until the logic thread finished its frame
+        void waitForLogicFrame();
+        void startLogicFrame(float delta_time);
+
         /**
          *  Each frame can only be called once
          */
@@ -49,6 +76,13 @@ namespace Piccolo
         float m_average_duration {0.f};
         int   m_frame_count {0};
         int   m_fps {0};
+
+        std::thread             m_logic_thread;
+        std::mutex              m_logic_mutex;
+        std::condition_variable m_logic_condition;
+        bool                    m_is_logic_frame_pending {false};
+        bool                    m_is_logic_thread_stopping {false};
+        float                   m_logic_delta_time {0.f};
     };
 
 } // namespace Piccolo
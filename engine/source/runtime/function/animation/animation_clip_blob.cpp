@@ -0,0 +1,100 @@
+#include "runtime/function/animation/animation_clip_blob.h"
+
+#include "runtime/core/base/macro.h"
+#include "runtime/core/meta/serializer/binary_serializer.h"
+
+#include "runtime/function/animation/animation_compression.h"
+
+#include <fstream>
+#include <system_error>
+#include <vector>
+
+namespace Piccolo
+{
+    namespace
+    {
+        bool readHeader(std::ifstream& blob_file, AnimationClipBlobHeader& out_header)
+        {
+            blob_file.read(reinterpret_cast<char*>(&out_header), sizeof(out_header));
+            return blob_file && out_header.magic == AnimationClipBlob::k_magic &&
+                   out_header.version == AnimationClipBlob::k_version;
+        }
+    } // namespace
+
+    std::filesystem::path AnimationClipBlob::getBlobPath(const std::filesystem::path& clip_file)
+    {
+        std::filesystem::path blob_path = clip_file;
+        blob_path += k_extension;
+        return blob_path;
+    }
+
+    bool AnimationClipBlob::isUpToDate(const std::filesystem::path& clip_file, const std::filesystem::path& blob_path)
+    {
+        std::error_code error;
+        const auto      blob_time = std::filesystem::last_write_time(blob_path, error);
+        if (error)
+            return false;
+        const auto clip_time = std::filesystem::last_write_time(clip_file, error);
+        if (!error && blob_time < clip_time)
+            return false;
+
+        std::ifstream           blob_file(blob_path, std::ios::binary);
+        AnimationClipBlobHeader header;
+        return readHeader(blob_file, header);
+    }
+
+    bool AnimationClipBlob::load(const std::filesystem::path& blob_path, CompressedAnimationClip& out_clip)
+    {
+        std::ifstream           blob_file(blob_path, std::ios::binary | std::ios::ate);
+        AnimationClipBlobHeader header;
+        const size_t            file_size = blob_file ? static_cast<size_t>(blob_file.tellg()) : 0;
+        blob_file.seekg(0);
+        if (!readHeader(blob_file, header))
+        {
+            LOG_ERROR("animation clip blob {} is missing or outdated!", blob_path.generic_string());
+            return false;
+        }
+
+        if (header.data_size != file_size - sizeof(header))
+        {
+            LOG_ERROR("animation clip blob {} is corrupted!", blob_path.generic_string());
+            return false;
+        }
+
+        std::vector<uint8_t> data(header.data_size);
+        if (!blob_file.read(reinterpret_cast<char*>(data.data()), data.size()))
+        {
+            LOG_ERROR("read animation clip blob {} failed!", blob_path.generic_string());
+            return false;
+        }
+
+        BinaryReader reader(data.data(), data.size());
+        if (!out_clip.read(reader) || reader.remaining() != 0)
+        {
+            LOG_ERROR("animation clip blob {} is corrupted!", blob_path.generic_string());
+            return false;
+        }
+        return true;
+    }
+
+    bool AnimationClipBlob::save(const std::filesystem::path& blob_path, const CompressedAnimationClip& clip)
+    {
+        BinaryWriter writer;
+        clip.write(writer);
+
+        AnimationClipBlobHeader header;
+        header.magic     = k_magic;
+        header.version   = k_version;
+        header.data_size = static_cast<uint32_t>(writer.getBuffer().size());
+
+        std::ofstream blob_file(blob_path, std::ios::binary);
+        if (!blob_file)
+        {
+            LOG_ERROR("open file {} failed!", blob_path.generic_string());
+            return false;
+        }
+        blob_file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        blob_file.write(reinterpret_cast<const char*>(writer.getBuffer().data()), writer.getBuffer().size());
+        return static_cast<bool>(blob_file);
+    }
+} // namespace Piccolo
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+
+namespace Piccolo
+{
+    class CompressedAnimationClip;
+
+    /// Compressed clip cooked next to its .animation_clip.json, so the clip is not compressed when it is loaded.
+    /// The data of CompressedAnimationClip::write follows the header.
+    struct AnimationClipBlobHeader
+    {
+        uint32_t magic {0};
+        uint32_t version {0};
+        uint32_t data_size {0};
+    };
+
+    class AnimationClipBlob
+    {
+    public:
+        static constexpr uint32_t k_magic = 0x4D4E4150; // "PANM"
+        // raised whenever the layout or the compression of CompressedAnimationClip changes
+        static constexpr uint32_t    k_version   = 1;
+        static constexpr const char* k_extension = ".clip";
+
+        // asset/foo.animation_clip.json -> asset/foo.animation_clip.json.clip
+        static std::filesystem::path getBlobPath(const std::filesystem::path& clip_file);
+        // written after the last change of clip_file and by this version
+        static bool isUpToDate(const std::filesystem::path& clip_file, const std::filesystem::path& blob_path);
+
+        static bool load(const std::filesystem::path& blob_path, CompressedAnimationClip& out_clip);
+        static bool save(const std::filesystem::path& blob_path, const CompressedAnimationClip& clip);
+    };
+} // namespace Piccolo
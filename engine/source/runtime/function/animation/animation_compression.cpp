@@ -0,0 +1,531 @@
+#include "runtime/function/animation/animation_compression.h"
+
+#include "runtime/core/meta/serializer/binary_serializer.h"
+
+#include "runtime/resource/res_type/data/animation_clip.h"
+
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PICCOLO_ANIMATION_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace Piccolo
+{
+    namespace
+    {
+        constexpr uint32_t k_lanes            = CompressedAnimationClip::k_group_width;
+        constexpr float    k_vector_key_max   = 65535.f;
+        constexpr float    k_rotation_key_max = 32767.f;
+
+        // the keys of a track resampled to the frame count of the clip, missing keys repeat the last one
+        // the same way the uncompressed sampling clamps to the last key
+        template<typename T>
+        std::vector<T> getTrackKeys(const std::vector<T>& keys, uint32_t frame_count, const T& default_value)
+        {
+            std::vector<T> track(frame_count, keys.empty() ? default_value : keys.back());
+            std::copy_n(keys.begin(), std::min<size_t>(keys.size(), frame_count), track.begin());
+            return track;
+        }
+
+        // angle between two rotations, from the chord between the quaternions since acos of their dot
+        // product is too coarse close to 1
+        float getRotationError(const Quaternion& lhs, const Quaternion& rhs)
+        {
+            const Quaternion difference = lhs.dot(rhs) < 0.f ? lhs + rhs : lhs - rhs;
+            const float      chord      = std::min(difference.length(), 2.f);
+            return 4.f * std::asin(0.5f * chord);
+        }
+
+        struct QuantizedVectorTrack
+        {
+            uint32_t              channel {0};
+            Vector3               min;
+            Vector3               step;
+            std::vector<uint16_t> keys; // x, y, z per frame
+        };
+
+        struct QuantizedRotationTrack
+        {
+            uint32_t             channel {0};
+            std::vector<int16_t> keys; // x, y, z, w per frame
+        };
+
+        QuantizedVectorTrack quantizeVectorTrack(uint32_t channel, const std::vector<Vector3>& keys, float& out_error)
+        {
+            QuantizedVectorTrack track;
+            track.channel = channel;
+            Vector3 max   = keys[0];
+            track.min     = keys[0];
+            for (const Vector3& key : keys)
+            {
+                track.min.makeFloor(key);
+                max.makeCeil(key);
+            }
+            track.step = (max - track.min) / k_vector_key_max;
+
+            out_error = 0.f;
+            track.keys.reserve(keys.size() * 3);
+            for (const Vector3& key : keys)
+            {
+                Vector3 decoded;
+                for (size_t component = 0; component < 3; component++)
+                {
+                    const float step      = track.step[component];
+                    const float offset    = key[component] - track.min[component];
+                    const float quantized = step > 0.f ? std::round(std::min(offset / step, k_vector_key_max)) : 0.f;
+                    track.keys.push_back(static_cast<uint16_t>(quantized));
+                    decoded[component] = track.min[component] + quantized * step;
+                }
+                out_error = std::max(out_error, decoded.distance(key));
+            }
+            return track;
+        }
+
+        QuantizedRotationTrack
+        quantizeRotationTrack(uint32_t channel, const std::vector<Quaternion>& keys, float& out_error)
+        {
+            QuantizedRotationTrack track;
+            track.channel = channel;
+
+            out_error = 0.f;
+            track.keys.reserve(keys.size() * 4);
+            for (const Quaternion& key : keys)
+            {
+                const float components[4] = {key.x, key.y, key.z, key.w};
+                int16_t     quantized[4];
+                for (size_t component = 0; component < 4; component++)
+                {
+                    quantized[component] = static_cast<int16_t>(
+                        std::round(std::clamp(components[component], -1.f, 1.f) * k_rotation_key_max));
+                    track.keys.push_back(quantized[component]);
+                }
+                Quaternion decoded(quantized[3], quantized[0], quantized[1], quantized[2]);
+                decoded.normalise();
+                out_error = std::max(out_error, getRotationError(decoded, key));
+            }
+            return track;
+        }
+
+        void sampleVectorGroup(const float*    range,
+                               const uint16_t* keys_low,
+                               const uint16_t* keys_high,
+                               float           alpha,
+                               float           out_values[3][k_lanes])
+        {
+#ifdef PICCOLO_ANIMATION_SSE2
+            const __m128i zero = _mm_setzero_si128();
+            const __m128  t    = _mm_set1_ps(alpha);
+            for (size_t component = 0; component < 3; component++)
+            {
+                const __m128 low = _mm_cvtepi32_ps(_mm_unpacklo_epi16(
+                    _mm_loadl_epi64(reinterpret_cast<const __m128i*>(keys_low + component * k_lanes)), zero));
+                const __m128 high = _mm_cvtepi32_ps(_mm_unpacklo_epi16(
+                    _mm_loadl_epi64(reinterpret_cast<const __m128i*>(keys_high + component * k_lanes)), zero));
+                // the quantization is linear, so lerp first and dequantize once
+                const __m128 quantized = _mm_add_ps(low, _mm_mul_ps(_mm_sub_ps(high, low), t));
+                const __m128 min       = _mm_loadu_ps(range + component * k_lanes);
+                const __m128 step      = _mm_loadu_ps(range + (3 + component) * k_lanes);
+                _mm_storeu_ps(out_values[component], _mm_add_ps(min, _mm_mul_ps(quantized, step)));
+            }
+#else
+            for (size_t component = 0; component < 3; component++)
+            {
+                for (size_t lane = 0; lane < k_lanes; lane++)
+                {
+                    const float low       = keys_low[component * k_lanes + lane];
+                    const float high      = keys_high[component * k_lanes + lane];
+                    const float quantized = low + (high - low) * alpha;
+                    out_values[component][lane] =
+                        range[component * k_lanes + lane] + quantized * range[(3 + component) * k_lanes + lane];
+                }
+            }
+#endif
+        }
+
+        void sampleRotationGroup(const int16_t* keys_low,
+                                 const int16_t* keys_high,
+                                 float          alpha,
+                                 float          out_values[4][k_lanes])
+        {
+            // the compressor keeps consecutive keys in the same hemisphere, so nlerp needs no sign check,
+            // and the normalization cancels the quantization scale
+#ifdef PICCOLO_ANIMATION_SSE2
+            const __m128i zero = _mm_setzero_si128();
+            const __m128  t    = _mm_set1_ps(alpha);
+            __m128        components[4];
+            __m128        length_squared = _mm_setzero_ps();
+            for (size_t component = 0; component < 4; component++)
+            {
+                // sign extend the 16 bit keys
+                const __m128 low = _mm_cvtepi32_ps(_mm_srai_epi32(
+                    _mm_unpacklo_epi16(
+                        zero, _mm_loadl_epi64(reinterpret_cast<const __m128i*>(keys_low + component * k_lanes))),
+                    16));
+                const __m128 high = _mm_cvtepi32_ps(_mm_srai_epi32(
+                    _mm_unpacklo_epi16(
+                        zero, _mm_loadl_epi64(reinterpret_cast<const __m128i*>(keys_high + component * k_lanes))),
+                    16));
+                components[component] = _mm_add_ps(low, _mm_mul_ps(_mm_sub_ps(high, low), t));
+                length_squared = _mm_add_ps(length_squared, _mm_mul_ps(components[component], components[component]));
+            }
+            const __m128 inverse_length = _mm_div_ps(_mm_set1_ps(1.f), _mm_sqrt_ps(length_squared));
+            for (size_t component = 0; component < 4; component++)
+            {
+                _mm_storeu_ps(out_values[component], _mm_mul_ps(components[component], inverse_length));
+            }
+#else
+            for (size_t lane = 0; lane < k_lanes; lane++)
+            {
+                float length_squared = 0.f;
+                for (size_t component = 0; component < 4; component++)
+                {
+                    const float low             = keys_low[component * k_lanes + lane];
+                    const float high            = keys_high[component * k_lanes + lane];
+                    out_values[component][lane] = low + (high - low) * alpha;
+                    length_squared += out_values[component][lane] * out_values[component][lane];
+                }
+                const float inverse_length = 1.f / std::sqrt(length_squared);
+                for (size_t component = 0; component < 4; component++)
+                {
+                    out_values[component][lane] *= inverse_length;
+                }
+            }
+#endif
+        }
+
+        template<typename T>
+        size_t getByteSize(const std::vector<T>& values)
+        {
+            return values.size() * sizeof(T);
+        }
+
+        template<typename T>
+        void writeValues(BinaryWriter& writer, const std::vector<T>& values)
+        {
+            static_assert(std::is_trivially_copyable<T>::value, "the values are written as bytes");
+            writer.writeSize(values.size());
+            writer.writeBytes(values.data(), getByteSize(values));
+        }
+
+        template<typename T>
+        void readValues(BinaryReader& reader, std::vector<T>& out_values)
+        {
+            static_assert(std::is_trivially_copyable<T>::value, "the values are read as bytes");
+            out_values.resize(reader.readSize(sizeof(T)));
+            reader.readBytes(out_values.data(), getByteSize(out_values));
+        }
+    } // namespace
+
+    void CompressedAnimationClip::compress(const AnimationClip& clip, const AnimationCompressionSettings& settings)
+    {
+        *this = CompressedAnimationClip();
+
+        m_frame_count = static_cast<uint32_t>(std::max(clip.total_frame, 1));
+        m_channel_count =
+            static_cast<uint32_t>(std::min<size_t>(std::max(clip.node_count, 0), clip.node_channels.size()));
+
+        std::vector<QuantizedVectorTrack>   position_tracks;
+        std::vector<QuantizedRotationTrack> rotation_tracks;
+        std::vector<QuantizedVectorTrack>   scaling_tracks;
+
+        // the constant ones are stored right away, the others are quantized and laid out by groups below
+        auto add_vector_track = [this](uint32_t                           channel,
+                                       const std::vector<Vector3>&        source_keys,
+                                       const Vector3&                     default_value,
+                                       float                              tolerance,
+                                       float&                             max_error,
+                                       std::vector<ConstantVectorTrack>&  constant_tracks,
+                                       std::vector<QuantizedVectorTrack>& quantized_tracks) {
+            m_report.raw_size += getByteSize(source_keys);
+            m_report.track_count++;
+
+            const std::vector<Vector3> keys = getTrackKeys(source_keys, m_frame_count, default_value);
+
+            float constant_error = 0.f;
+            for (const Vector3& key : keys)
+            {
+                constant_error = std::max(constant_error, key.distance(keys[0]));
+            }
+            if (constant_error <= tolerance)
+            {
+                constant_tracks.push_back({channel, keys[0]});
+                m_report.constant_track_count++;
+                max_error = std::max(max_error, constant_error);
+                return;
+            }
+
+            float quantization_error = 0.f;
+            quantized_tracks.push_back(quantizeVectorTrack(channel, keys, quantization_error));
+            if (quantization_error > tolerance)
+            {
+                m_report.over_tolerance_track_count++;
+            }
+            max_error = std::max(max_error, quantization_error);
+        };
+
+        for (uint32_t channel = 0; channel < m_channel_count; channel++)
+        {
+            const AnimationChannel& source_channel = clip.node_channels[channel];
+
+            add_vector_track(channel,
+                             source_channel.position_keys,
+                             Vector3::ZERO,
+                             settings.position_tolerance,
+                             m_report.max_position_error,
+                             m_constant_positions,
+                             position_tracks);
+            add_vector_track(channel,
+                             source_channel.scaling_keys,
+                             Vector3::UNIT_SCALE,
+                             settings.scale_tolerance,
+                             m_report.max_scale_error,
+                             m_constant_scalings,
+                             scaling_tracks);
+
+            m_report.raw_size += getByteSize(source_channel.rotation_keys);
+            m_report.track_count++;
+
+            std::vector<Quaternion> keys =
+                getTrackKeys(source_channel.rotation_keys, m_frame_count, Quaternion::IDENTITY);
+            float constant_error = 0.f;
+            for (size_t frame = 0; frame < keys.size(); frame++)
+            {
+                keys[frame].normalise();
+                // q and -q are the same rotation, keep neighbouring keys on the same side for nlerp
+                if (frame > 0 && keys[frame].dot(keys[frame - 1]) < 0.f)
+                {
+                    keys[frame] = -keys[frame];
+                }
+                constant_error = std::max(constant_error, getRotationError(keys[frame], keys[0]));
+            }
+            if (constant_error <= settings.rotation_tolerance)
+            {
+                m_constant_rotations.push_back({channel, keys[0]});
+                m_report.constant_track_count++;
+                m_report.max_rotation_error = std::max(m_report.max_rotation_error, constant_error);
+                continue;
+            }
+
+            float quantization_error = 0.f;
+            rotation_tracks.push_back(quantizeRotationTrack(channel, keys, quantization_error));
+            if (quantization_error > settings.rotation_tolerance)
+            {
+                m_report.over_tolerance_track_count++;
+            }
+            m_report.max_rotation_error = std::max(m_report.max_rotation_error, quantization_error);
+        }
+
+        // interleave the quantized tracks, the padding lanes of the last group keep zero keys and are never read
+        auto layout_vector_tracks = [this](const std::vector<QuantizedVectorTrack>& quantized_tracks,
+                                           VectorTracks&                            out_tracks) {
+            out_tracks.group_count = static_cast<uint32_t>((quantized_tracks.size() + k_lanes - 1) / k_lanes);
+            out_tracks.ranges.assign(out_tracks.group_count * 6 * k_lanes, 0.f);
+            out_tracks.keys.assign(static_cast<size_t>(m_frame_count) * out_tracks.group_count * 3 * k_lanes, 0);
+            for (size_t track_index = 0; track_index < quantized_tracks.size(); track_index++)
+            {
+                const QuantizedVectorTrack& track = quantized_tracks[track_index];
+                const size_t                group = track_index / k_lanes;
+                const size_t                lane  = track_index % k_lanes;
+                out_tracks.channels.push_back(track.channel);
+                for (size_t component = 0; component < 3; component++)
+                {
+                    out_tracks.ranges[(group * 6 + component) * k_lanes + lane]     = track.min[component];
+                    out_tracks.ranges[(group * 6 + 3 + component) * k_lanes + lane] = track.step[component];
+                }
+                for (size_t frame = 0; frame < m_frame_count; frame++)
+                {
+                    for (size_t component = 0; component < 3; component++)
+                    {
+                        out_tracks.keys[((frame * out_tracks.group_count + group) * 3 + component) * k_lanes + lane] =
+                            track.keys[frame * 3 + component];
+                    }
+                }
+            }
+        };
+        layout_vector_tracks(position_tracks, m_positions);
+        layout_vector_tracks(scaling_tracks, m_scalings);
+
+        m_rotations.group_count = static_cast<uint32_t>((rotation_tracks.size() + k_lanes - 1) / k_lanes);
+        m_rotations.keys.assign(static_cast<size_t>(m_frame_count) * m_rotations.group_count * 4 * k_lanes, 0);
+        for (size_t track_index = 0; track_index < rotation_tracks.size(); track_index++)
+        {
+            const QuantizedRotationTrack& track = rotation_tracks[track_index];
+            const size_t                  group = track_index / k_lanes;
+            const size_t                  lane  = track_index % k_lanes;
+            m_rotations.channels.push_back(track.channel);
+            for (size_t frame = 0; frame < m_frame_count; frame++)
+            {
+                for (size_t component = 0; component < 4; component++)
+                {
+                    m_rotations.keys[((frame * m_rotations.group_count + group) * 4 + component) * k_lanes + lane] =
+                        track.keys[frame * 4 + component];
+                }
+            }
+        }
+
+        m_report.compressed_size = sizeof(CompressedAnimationClip) + getByteSize(m_constant_positions) +
+                                   getByteSize(m_constant_rotations) + getByteSize(m_constant_scalings) +
+                                   getByteSize(m_positions.channels) + getByteSize(m_positions.ranges) +
+                                   getByteSize(m_positions.keys) + getByteSize(m_rotations.channels) +
+                                   getByteSize(m_rotations.keys) + getByteSize(m_scalings.channels) +
+                                   getByteSize(m_scalings.ranges) + getByteSize(m_scalings.keys);
+    }
+
+    void CompressedAnimationClip::sample(float phase, AnimationPose& out_pose) const
+    {
+        // same size from one frame to the next, the resize only allocates the first time
+        out_pose.position.resize(m_channel_count);
+        out_pose.rotation.resize(m_channel_count);
+        out_pose.scaling.resize(m_channel_count);
+        if (m_frame_count == 0)
+            return;
+
+        const float    exact_frame = std::clamp(phase, 0.f, 1.f) * (m_frame_count - 1);
+        const uint32_t frame_low   = std::min(static_cast<uint32_t>(exact_frame), m_frame_count - 1);
+        const uint32_t frame_high  = std::min(frame_low + 1, m_frame_count - 1);
+        const float    alpha       = exact_frame - frame_low;
+
+        for (const ConstantVectorTrack& track : m_constant_positions)
+        {
+            out_pose.position[track.channel] = track.value;
+        }
+        for (const ConstantRotationTrack& track : m_constant_rotations)
+        {
+            out_pose.rotation[track.channel] = track.value;
+        }
+        for (const ConstantVectorTrack& track : m_constant_scalings)
+        {
+            out_pose.scaling[track.channel] = track.value;
+        }
+
+        sampleVectorTracks(m_positions, frame_low, frame_high, alpha, out_pose.position);
+        sampleRotationTracks(frame_low, frame_high, alpha, out_pose);
+        sampleVectorTracks(m_scalings, frame_low, frame_high, alpha, out_pose.scaling);
+    }
+
+    void CompressedAnimationClip::write(BinaryWriter& writer) const
+    {
+        writer.writeBytes(&m_frame_count, sizeof(m_frame_count));
+        writer.writeBytes(&m_channel_count, sizeof(m_channel_count));
+        writer.writeBytes(&m_report, sizeof(m_report));
+
+        writeValues(writer, m_constant_positions);
+        writeValues(writer, m_constant_rotations);
+        writeValues(writer, m_constant_scalings);
+        for (const VectorTracks* tracks : {&m_positions, &m_scalings})
+        {
+            writeValues(writer, tracks->channels);
+            writer.writeBytes(&tracks->group_count, sizeof(tracks->group_count));
+            writeValues(writer, tracks->ranges);
+            writeValues(writer, tracks->keys);
+        }
+        writeValues(writer, m_rotations.channels);
+        writer.writeBytes(&m_rotations.group_count, sizeof(m_rotations.group_count));
+        writeValues(writer, m_rotations.keys);
+    }
+
+    bool CompressedAnimationClip::read(BinaryReader& reader)
+    {
+        *this = CompressedAnimationClip();
+
+        reader.readBytes(&m_frame_count, sizeof(m_frame_count));
+        reader.readBytes(&m_channel_count, sizeof(m_channel_count));
+        reader.readBytes(&m_report, sizeof(m_report));
+
+        readValues(reader, m_constant_positions);
+        readValues(reader, m_constant_rotations);
+        readValues(reader, m_constant_scalings);
+        for (VectorTracks* tracks : {&m_positions, &m_scalings})
+        {
+            readValues(reader, tracks->channels);
+            reader.readBytes(&tracks->group_count, sizeof(tracks->group_count));
+            readValues(reader, tracks->ranges);
+            readValues(reader, tracks->keys);
+        }
+        readValues(reader, m_rotations.channels);
+        reader.readBytes(&m_rotations.group_count, sizeof(m_rotations.group_count));
+        readValues(reader, m_rotations.keys);
+
+        // sample indexes the keys and the pose by these counts without checking them
+        auto are_constants_valid = [this](const auto& tracks) {
+            return std::all_of(
+                tracks.begin(), tracks.end(), [this](const auto& track) { return track.channel < m_channel_count; });
+        };
+        auto are_groups_valid = [this](const std::vector<uint32_t>& channels,
+                                       uint32_t                     group_count,
+                                       size_t                       key_count,
+                                       size_t                       component_count) {
+            return std::all_of(channels.begin(),
+                               channels.end(),
+                               [this](uint32_t channel) { return channel < m_channel_count; }) &&
+                   group_count == (channels.size() + k_lanes - 1) / k_lanes &&
+                   key_count == static_cast<size_t>(m_frame_count) * group_count * component_count * k_lanes;
+        };
+        const bool is_valid =
+            reader.isValid() && m_frame_count > 0 && are_constants_valid(m_constant_positions) &&
+            are_constants_valid(m_constant_rotations) && are_constants_valid(m_constant_scalings) &&
+            are_groups_valid(m_positions.channels, m_positions.group_count, m_positions.keys.size(), 3) &&
+            m_positions.ranges.size() == static_cast<size_t>(m_positions.group_count) * 6 * k_lanes &&
+            are_groups_valid(m_scalings.channels, m_scalings.group_count, m_scalings.keys.size(), 3) &&
+            m_scalings.ranges.size() == static_cast<size_t>(m_scalings.group_count) * 6 * k_lanes &&
+            are_groups_valid(m_rotations.channels, m_rotations.group_count, m_rotations.keys.size(), 4);
+        if (!is_valid)
+        {
+            *this = CompressedAnimationClip();
+        }
+        return is_valid;
+    }
+
+    void CompressedAnimationClip::sampleVectorTracks(const VectorTracks&   tracks,
+                                                     uint32_t              frame_low,
+                                                     uint32_t              frame_high,
+                                                     float                 alpha,
+                                                     std::vector<Vector3>& out_values) const
+    {
+        const size_t    frame_stride = static_cast<size_t>(tracks.group_count) * 3 * k_lanes;
+        const uint16_t* keys_low     = tracks.keys.data() + frame_low * frame_stride;
+        const uint16_t* keys_high    = tracks.keys.data() + frame_high * frame_stride;
+        for (size_t group = 0; group < tracks.group_count; group++)
+        {
+            float values[3][k_lanes];
+            sampleVectorGroup(tracks.ranges.data() + group * 6 * k_lanes,
+                              keys_low + group * 3 * k_lanes,
+                              keys_high + group * 3 * k_lanes,
+                              alpha,
+                              values);
+
+            const size_t lane_count = std::min<size_t>(k_lanes, tracks.channels.size() - group * k_lanes);
+            for (size_t lane = 0; lane < lane_count; lane++)
+            {
+                out_values[tracks.channels[group * k_lanes + lane]] =
+                    Vector3(values[0][lane], values[1][lane], values[2][lane]);
+            }
+        }
+    }
+
+    void CompressedAnimationClip::sampleRotationTracks(uint32_t       frame_low,
+                                                       uint32_t       frame_high,
+                                                       float          alpha,
+                                                       AnimationPose& out_pose) const
+    {
+        const size_t   frame_stride = static_cast<size_t>(m_rotations.group_count) * 4 * k_lanes;
+        const int16_t* keys_low     = m_rotations.keys.data() + frame_low * frame_stride;
+        const int16_t* keys_high    = m_rotations.keys.data() + frame_high * frame_stride;
+        for (size_t group = 0; group < m_rotations.group_count; group++)
+        {
+            float values[4][k_lanes];
+            sampleRotationGroup(keys_low + group * 4 * k_lanes, keys_high + group * 4 * k_lanes, alpha, values);
+
+            const size_t lane_count = std::min<size_t>(k_lanes, m_rotations.channels.size() - group * k_lanes);
+            for (size_t lane = 0; lane < lane_count; lane++)
+            {
+                out_pose.rotation[m_rotations.channels[group * k_lanes + lane]] =
+                    Quaternion(values[3][lane], values[0][lane], values[1][lane], values[2][lane]);
+            }
+        }
+    }
+} // namespace Piccolo
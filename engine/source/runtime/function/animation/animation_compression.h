@@ -0,0 +1,118 @@
+#pragma once
+
+#include "runtime/core/math/quaternion.h"
+#include "runtime/core/math/vector3.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace Piccolo
+{
+    class AnimationClip;
+    class BinaryReader;
+    class BinaryWriter;
+
+    struct AnimationCompressionSettings
+    {
+        // a track whose keys all stay within its tolerance of the first key is stored as one constant,
+        // the quantization error of the other tracks is checked against the same bound
+        float position_tolerance {1e-3f};
+        float rotation_tolerance {1e-3f}; // radians
+        float scale_tolerance {1e-4f};
+    };
+
+    /// Size and error of a compressed clip, the errors are measured on the keys against the source clip.
+    struct AnimationCompressionReport
+    {
+        size_t   raw_size {0};
+        size_t   compressed_size {0};
+        uint32_t track_count {0};
+        uint32_t constant_track_count {0};
+        uint32_t over_tolerance_track_count {0};
+        float    max_position_error {0.f};
+        float    max_rotation_error {0.f};
+        float    max_scale_error {0.f};
+    };
+
+    /// Local transform of each channel of a clip, indexed like AnimationClip::node_channels.
+    struct AnimationPose
+    {
+        std::vector<Vector3>    position;
+        std::vector<Quaternion> rotation;
+        std::vector<Vector3>    scaling;
+    };
+
+    /// Runtime format of an AnimationClip.
+    /// Constant tracks are stored once. The keys of the other tracks are quantized to 16 bits per
+    /// component and interleaved by groups of k_group_width tracks (x x x x y y y y ...), so a group is
+    /// sampled with a few SIMD operations; all the keys of one frame are contiguous.
+    class CompressedAnimationClip
+    {
+    public:
+        static constexpr uint32_t k_group_width = 4;
+
+        void compress(const AnimationClip& clip, const AnimationCompressionSettings& settings = {});
+
+        // phase in [0, 1] over the whole clip, the pose is resized to the channel count
+        void sample(float phase, AnimationPose& out_pose) const;
+
+        // the compressed data as is, for the clips cooked offline. read fails on data that does not describe a clip
+        void write(BinaryWriter& writer) const;
+        bool read(BinaryReader& reader);
+
+        uint32_t                          getFrameCount() const { return m_frame_count; }
+        uint32_t                          getChannelCount() const { return m_channel_count; }
+        const AnimationCompressionReport& getReport() const { return m_report; }
+
+    private:
+        struct ConstantVectorTrack
+        {
+            uint32_t channel {0};
+            Vector3  value;
+        };
+
+        struct ConstantRotationTrack
+        {
+            uint32_t   channel {0};
+            Quaternion value;
+        };
+
+        struct VectorTracks
+        {
+            std::vector<uint32_t> channels;
+            uint32_t              group_count {0};
+            // per group: min x, y, z then step x, y, z, each for the k_group_width lanes
+            std::vector<float> ranges;
+            // per frame, per group: x, y, z for the k_group_width lanes
+            std::vector<uint16_t> keys;
+        };
+
+        struct RotationTracks
+        {
+            std::vector<uint32_t> channels;
+            uint32_t              group_count {0};
+            // per frame, per group: x, y, z, w for the k_group_width lanes, scaled by 32767
+            std::vector<int16_t> keys;
+        };
+
+        void sampleVectorTracks(const VectorTracks&   tracks,
+                                uint32_t              frame_low,
+                                uint32_t              frame_high,
+                                float                 alpha,
+                                std::vector<Vector3>& out_values) const;
+        void sampleRotationTracks(uint32_t frame_low, uint32_t frame_high, float alpha, AnimationPose& out_pose) const;
+
+        uint32_t m_frame_count {0};
+        uint32_t m_channel_count {0};
+
+        std::vector<ConstantVectorTrack>   m_constant_positions;
+        std::vector<ConstantRotationTrack> m_constant_rotations;
+        std::vector<ConstantVectorTrack>   m_constant_scalings;
+
+        VectorTracks   m_positions;
+        RotationTracks m_rotations;
+        VectorTracks   m_scalings;
+
+        AnimationCompressionReport m_report;
+    };
+} // namespace Piccolo
@@ -0,0 +1,84 @@
+#include "runtime/function/animation/animation_lod.h"
+
+#include "runtime/function/render/render_camera.h"
+
+#include <cmath>
+#include <iterator>
+
+namespace Piccolo
+{
+    namespace
+    {
+        struct AnimationLodLevel
+        {
+            // smallest projected radius, relative to the half height of the screen
+            float        min_screen_size;
+            AnimationLod lod;
+        };
+
+        // from the closest to the farthest, the last level is used below all the thresholds
+        constexpr AnimationLodLevel k_lod_levels[] = {
+            {0.15f, {1, std::numeric_limits<uint32_t>::max()}},
+            {0.06f, {2, std::numeric_limits<uint32_t>::max()}},
+            {0.02f, {4, 6}},
+            {0.f, {8, 3}},
+        };
+
+        // outside of the view, the character may still cast a shadow into it, so its whole skeleton keeps moving
+        constexpr AnimationLod k_out_of_view_lod {8, std::numeric_limits<uint32_t>::max()};
+
+        // the bounding sphere is the one of the binding pose, stretched limbs reach out of it
+        constexpr float k_pose_radius_scale = 1.5f;
+    } // namespace
+
+    void AnimationLodView::update(RenderCamera& camera)
+    {
+        const Vector2 fov = camera.getFOV();
+        m_is_valid        = fov.x > 0.f && fov.y > 0.f;
+        if (!m_is_valid)
+            return;
+
+        m_view_matrix    = camera.getViewMatrix();
+        m_tan_half_fov_x = Math::tan(Radian(Degree(fov.x) * 0.5f));
+        m_tan_half_fov_y = Math::tan(Radian(Degree(fov.y) * 0.5f));
+
+        // a sphere touching a side plane has its center radius * sqrt(1 + tan^2) away from it along x or y
+        m_side_radius_scale_x = std::sqrt(1.f + m_tan_half_fov_x * m_tan_half_fov_x);
+        m_side_radius_scale_y = std::sqrt(1.f + m_tan_half_fov_y * m_tan_half_fov_y);
+    }
+
+    AnimationLod AnimationLodView::selectLod(const Vector3& center, float radius) const
+    {
+        // no camera yet, keep the full animation
+        if (!m_is_valid)
+            return k_lod_levels[0].lod;
+
+        // the view looks down -z
+        const Vector3 view_center = m_view_matrix.transformAffine(center);
+        // the camera is inside of the sphere
+        if (view_center.squaredLength() <= radius * radius)
+            return k_lod_levels[0].lod;
+
+        const float distance    = -view_center.z;
+        const float pose_radius = radius * k_pose_radius_scale;
+        if (distance < -pose_radius)
+            return k_out_of_view_lod;
+
+        // the sphere is outside of a side plane when its center is farther than its radius from it
+        const float side_x = distance * m_tan_half_fov_x + pose_radius * m_side_radius_scale_x;
+        const float side_y = distance * m_tan_half_fov_y + pose_radius * m_side_radius_scale_y;
+        if (std::fabs(view_center.x) > side_x || std::fabs(view_center.y) > side_y)
+            return k_out_of_view_lod;
+        // close enough to cover a large part of the screen
+        if (distance <= radius)
+            return k_lod_levels[0].lod;
+
+        const float screen_size = radius / (distance * m_tan_half_fov_y);
+        for (const AnimationLodLevel& level : k_lod_levels)
+        {
+            if (screen_size >= level.min_screen_size)
+                return level.lod;
+        }
+        return k_lod_levels[std::size(k_lod_levels) - 1].lod;
+    }
+} // namespace Piccolo
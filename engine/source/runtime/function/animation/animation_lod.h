@@ -0,0 +1,45 @@
+#pragma once
+
+#include "runtime/core/math/matrix4.h"
+#include "runtime/core/math/vector3.h"
+
+#include <cstdint>
+#include <limits>
+
+namespace Piccolo
+{
+    class RenderCamera;
+
+    /// How much of the skeleton of a character is evaluated.
+    struct AnimationLod
+    {
+        // the skeleton is evaluated every update_interval ticks and interpolated in between,
+        // 0 pauses the animation
+        uint32_t update_interval {1};
+        // the bones deeper in the hierarchy keep their binding pose
+        uint32_t max_bone_depth {std::numeric_limits<uint32_t>::max()};
+
+        bool isPaused() const { return update_interval == 0; }
+    };
+
+    /// The camera of the current frame, used to choose the LOD of each animated character from its bounding
+    /// sphere: fewer updates and bones as it gets smaller on screen. Outside of the view it keeps the slowest
+    /// interval instead of pausing, as its shadow may still fall into the view.
+    class AnimationLodView
+    {
+    public:
+        // once per tick, before the animations are ticked
+        void update(RenderCamera& camera);
+        void reset() { m_is_valid = false; }
+
+        AnimationLod selectLod(const Vector3& center, float radius) const;
+
+    private:
+        bool      m_is_valid {false};
+        Matrix4x4 m_view_matrix {Matrix4x4::IDENTITY};
+        float     m_tan_half_fov_x {1.f};
+        float     m_tan_half_fov_y {1.f};
+        float     m_side_radius_scale_x {1.f};
+        float     m_side_radius_scale_y {1.f};
+    };
+} // namespace Piccolo
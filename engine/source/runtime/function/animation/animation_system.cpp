@@ -2,151 +2,182 @@
 
 #include "resource/res_type/data/skeleton_mask.h"
 
+#include "runtime/core/base/macro.h"
+
+#include "runtime/function/animation/animation_clip_blob.h"
 #include "runtime/function/animation/animation_loader.h"
 #include "runtime/function/animation/skeleton.h"
+#include "runtime/function/global/global_context.h"
+#include "runtime/function/render/render_system.h"
+
+#include "runtime/resource/asset_manager/asset_manager.h"
+
+#include <algorithm>
 
 namespace Piccolo
 {
-    std::map<std::string, std::shared_ptr<SkeletonData>>  AnimationManager::m_skeleton_definition_cache;
-    std::map<std::string, std::shared_ptr<AnimationClip>> AnimationManager::m_animation_data_cache;
-    std::map<std::string, std::shared_ptr<AnimSkelMap>>   AnimationManager::m_animation_skeleton_map_cache;
-    std::map<std::string, std::shared_ptr<BoneBlendMask>> AnimationManager::m_skeleton_mask_cache;
+    AnimationLodView AnimationManager::m_lod_view;
 
     std::shared_ptr<SkeletonData> AnimationManager::tryLoadSkeleton(std::string file_path)
     {
-        std::shared_ptr<SkeletonData> res;
-        AnimationLoader               loader;
-        auto                          found = m_skeleton_definition_cache.find(file_path);
-        if (found == m_skeleton_definition_cache.end())
-        {
-            res = loader.loadSkeletonData(file_path);
-            m_skeleton_definition_cache.emplace(file_path, res);
-        }
-        else
-        {
-            res = found->second;
-        }
-        return res;
+        return g_runtime_global_context.m_asset_manager->getOrCreateSharedAsset<SkeletonData>(
+            file_path, [&file_path] { return AnimationLoader().loadSkeletonData(file_path); });
     }
 
-    std::shared_ptr<AnimationClip> AnimationManager::tryLoadAnimation(std::string file_path)
+    namespace
     {
-        std::shared_ptr<AnimationClip> res;
-        AnimationLoader                loader;
-        auto                           found = m_animation_data_cache.find(file_path);
-        if (found == m_animation_data_cache.end())
+        std::shared_ptr<CompressedAnimationClip> compressAnimation(const std::string&   file_path,
+                                                                   const AnimationClip& clip)
         {
-            res = loader.loadAnimationClipData(file_path);
-            m_animation_data_cache.emplace(file_path, res);
-        }
-        else
-        {
-            res = found->second;
-        }
-        return res;
+            std::shared_ptr<CompressedAnimationClip> res = std::make_shared<CompressedAnimationClip>();
+            res->compress(clip);
+
+            const AnimationCompressionReport& report = res->getReport();
+            LOG_INFO("compressed animation {}: {} -> {} bytes, {}/{} constant tracks, max error position {} "
+                     "rotation {} scale {}, {} tracks over tolerance",
+                     file_path,
+                     report.raw_size,
+                     report.compressed_size,
+                     report.constant_track_count,
+                     report.track_count,
+                     report.max_position_error,
+                     report.max_rotation_error,
+                     report.max_scale_error,
+                     report.over_tolerance_track_count);
+            return res;
+        }
+    } // namespace
+
+    std::shared_ptr<CompressedAnimationClip> AnimationManager::tryLoadAnimation(std::string file_path)
+    {
+        // only the compressed clip is cached, the raw one is released once compressed
+        return g_runtime_global_context.m_asset_manager->getOrCreateSharedAsset<CompressedAnimationClip>(
+            file_path, [&file_path] {
+                const std::filesystem::path clip_path =
+                    g_runtime_global_context.m_asset_manager->getFullPath(file_path);
+                const std::filesystem::path blob_path = AnimationClipBlob::getBlobPath(clip_path);
+                if (AnimationClipBlob::isUpToDate(clip_path, blob_path))
+                {
+                    std::shared_ptr<CompressedAnimationClip> res = std::make_shared<CompressedAnimationClip>();
+                    if (AnimationClipBlob::load(blob_path, *res))
+                        return res;
+                }
+                return compressAnimation(file_path, *AnimationLoader().loadAnimationClipData(file_path));
+            });
+    }
+
+    bool AnimationManager::cookAnimation(std::string file_path)
+    {
+        // unlike at load, a clip that cannot be read is not cooked as an empty one
+        AnimationAsset animation_asset;
+        if (!g_runtime_global_context.m_asset_manager->loadAsset(file_path, animation_asset))
+            return false;
+
+        const std::filesystem::path clip_path = g_runtime_global_context.m_asset_manager->getFullPath(file_path);
+        return AnimationClipBlob::save(AnimationClipBlob::getBlobPath(clip_path),
+                                       *compressAnimation(file_path, animation_asset.clip_data));
     }
 
     std::shared_ptr<AnimSkelMap> AnimationManager::tryLoadAnimationSkeletonMap(std::string file_path)
     {
-        std::shared_ptr<AnimSkelMap> res;
-        AnimationLoader              loader;
-        auto                         found = m_animation_skeleton_map_cache.find(file_path);
-        if (found == m_animation_skeleton_map_cache.end())
-        {
-            res = loader.loadAnimSkelMap(file_path);
-            m_animation_skeleton_map_cache.emplace(file_path, res);
-        }
-        else
-        {
-            res = found->second;
-        }
-        return res;
+        return g_runtime_global_context.m_asset_manager->getOrCreateSharedAsset<AnimSkelMap>(
+            file_path, [&file_path] { return AnimationLoader().loadAnimSkelMap(file_path); });
     }
 
     std::shared_ptr<BoneBlendMask> AnimationManager::tryLoadSkeletonMask(std::string file_path)
     {
-        std::shared_ptr<BoneBlendMask> res;
-        AnimationLoader                loader;
-        auto                           found = m_skeleton_mask_cache.find(file_path);
-        if (found == m_skeleton_mask_cache.end())
-        {
-            res = loader.loadSkeletonMask(file_path);
-            m_skeleton_mask_cache.emplace(file_path, res);
-        }
-        else
-        {
-            res = found->second;
-        }
-        return res;
+        return g_runtime_global_context.m_asset_manager->getOrCreateSharedAsset<BoneBlendMask>(
+            file_path, [&file_path] { return AnimationLoader().loadSkeletonMask(file_path); });
     }
 
-    BlendStateWithClipData AnimationManager::getBlendStateWithClipData(const BlendState& blend_state)
+    BlendStateWithClipData AnimationManager::getBlendStateWithClipData(const BlendState& blend_state,
+                                                                       size_t            bone_count)
     {
+        BlendStateWithClipData blend_state_with_clip_data;
 
-        for (auto animation_file_path : blend_state.blend_clip_file_path)
-        {
-            tryLoadAnimation(animation_file_path);
-        }
-        for (auto anim_skel_map_path : blend_state.blend_anim_skel_map_path)
-        {
-            tryLoadAnimationSkeletonMap(anim_skel_map_path);
-        }
-        for (auto skeleton_mask_path : blend_state.blend_mask_file_path)
+        const size_t clip_count = std::min({static_cast<size_t>(std::max(blend_state.clip_count, 0)),
+                                            blend_state.blend_clip_file_path.size(),
+                                            blend_state.blend_anim_skel_map_path.size(),
+                                            blend_state.blend_weight.size(),
+                                            blend_state.blend_ratio.size()});
+        if (clip_count != static_cast<size_t>(std::max(blend_state.clip_count, 0)))
         {
-            tryLoadSkeletonMask(skeleton_mask_path);
+            LOG_WARN("blend state declares {} clips but describes {}", blend_state.clip_count, clip_count);
         }
 
-        BlendStateWithClipData blend_state_with_clip_data;
-        blend_state_with_clip_data.clip_count  = blend_state.clip_count;
-        blend_state_with_clip_data.blend_ratio = blend_state.blend_ratio;
-        for (const auto& iter : blend_state.blend_clip_file_path)
-        {
-            blend_state_with_clip_data.blend_clip.push_back(*m_animation_data_cache[iter]);
-        }
-        for (const auto& iter : blend_state.blend_anim_skel_map_path)
-        {
-            blend_state_with_clip_data.blend_anim_skel_map.push_back(*m_animation_skeleton_map_cache[iter]);
-        }
         std::vector<std::shared_ptr<BoneBlendMask>> blend_masks;
-        for (auto& iter : blend_state.blend_mask_file_path)
-        {
-            blend_masks.push_back(m_skeleton_mask_cache[iter]);
-            tryLoadAnimationSkeletonMap(m_skeleton_mask_cache[iter]->skeleton_file_path);
+        blend_state_with_clip_data.clip_count = static_cast<int>(clip_count);
+        blend_state_with_clip_data.blend_ratio.assign(blend_state.blend_ratio.begin(),
+                                                      blend_state.blend_ratio.begin() + clip_count);
+        for (size_t clip_index = 0; clip_index < clip_count; clip_index++)
+        {
+            const bool is_additive =
+                clip_index < blend_state.blend_clip_additive.size() && blend_state.blend_clip_additive[clip_index] != 0;
+            blend_state_with_clip_data.blend_clip.push_back(
+                tryLoadAnimation(blend_state.blend_clip_file_path[clip_index]));
+            blend_state_with_clip_data.blend_anim_skel_map.push_back(
+                tryLoadAnimationSkeletonMap(blend_state.blend_anim_skel_map_path[clip_index]));
+            blend_state_with_clip_data.blend_clip_additive.push_back(is_additive);
+            // a clip without mask moves all the bones
+            blend_masks.push_back(clip_index < blend_state.blend_mask_file_path.size() ?
+                                      tryLoadSkeletonMask(blend_state.blend_mask_file_path[clip_index]) :
+                                      nullptr);
         }
-        size_t skeleton_bone_count = m_skeleton_definition_cache[blend_masks[0]->skeleton_file_path]->bones_map.size();
-        blend_state_with_clip_data.blend_weight.resize(blend_state.clip_count);
-        for (size_t clip_index = 0; clip_index < blend_state.clip_count; clip_index++)
-        {
-            blend_state_with_clip_data.blend_weight[clip_index].blend_weight.resize(skeleton_bone_count);
-        }
-        for (size_t bone_index = 0; bone_index < skeleton_bone_count; bone_index++)
+
+        auto is_bone_enabled = [&blend_masks](size_t clip_index, size_t bone_index) {
+            const std::shared_ptr<BoneBlendMask>& mask = blend_masks[clip_index];
+            return !mask || bone_index >= mask->enabled.size() || mask->enabled[bone_index] != 0;
+        };
+
+        // the per bone weights only depend on the blend state, so they are computed here once,
+        // the blended clips are normalized per bone while the additive ones keep their own weight
+        blend_state_with_clip_data.bone_count = bone_count;
+        blend_state_with_clip_data.blend_weight.assign(clip_count * bone_count, 0.f);
+        for (size_t bone_index = 0; bone_index < bone_count; bone_index++)
         {
             float sum_weight = 0;
-            for (size_t clip_index = 0; clip_index < blend_state.clip_count; clip_index++)
+            for (size_t clip_index = 0; clip_index < clip_count; clip_index++)
             {
-                if (blend_masks[clip_index]->enabled[bone_index])
+                if (!blend_state_with_clip_data.blend_clip_additive[clip_index] &&
+                    is_bone_enabled(clip_index, bone_index))
                 {
                     sum_weight += blend_state.blend_weight[clip_index];
                 }
             }
-            if (fabs(sum_weight) < 0.0001f)
+            for (size_t clip_index = 0; clip_index < clip_count; clip_index++)
             {
-                // LOG_ERROR
-            }
-            for (size_t clip_index = 0; clip_index < blend_state.clip_count; clip_index++)
-            {
-                if (blend_masks[clip_index]->enabled[bone_index])
-                {
+                if (!is_bone_enabled(clip_index, bone_index))
+                    continue;
 
-                    blend_state_with_clip_data.blend_weight[clip_index].blend_weight[bone_index] =
-                        blend_state.blend_weight[clip_index] / sum_weight;
+                float& weight = blend_state_with_clip_data.blend_weight[clip_index * bone_count + bone_index];
+                if (blend_state_with_clip_data.blend_clip_additive[clip_index])
+                {
+                    weight = blend_state.blend_weight[clip_index];
                 }
-                else
+                else if (fabs(sum_weight) >= 0.0001f)
                 {
-                    blend_state_with_clip_data.blend_weight[clip_index].blend_weight[bone_index] = 0;
+                    weight = blend_state.blend_weight[clip_index] / sum_weight;
                 }
             }
         }
         return blend_state_with_clip_data;
     }
+
+    void AnimationManager::updateLodView()
+    {
+        std::shared_ptr<RenderCamera> camera;
+        if (g_runtime_global_context.m_render_system)
+        {
+            camera = g_runtime_global_context.m_render_system->getRenderCamera();
+        }
+
+        if (camera)
+        {
+            m_lod_view.update(*camera);
+        }
+        else
+        {
+            m_lod_view.reset();
+        }
+    }
 } // namespace Piccolo
@@ -1,31 +1,66 @@
 #pragma once
 
+#include "runtime/function/animation/animation_compression.h"
+#include "runtime/function/animation/animation_lod.h"
+
 #include "runtime/resource/res_type/data/animation_clip.h"
 #include "runtime/resource/res_type/data/animation_skeleton_node_map.h"
 #include "runtime/resource/res_type/data/blend_state.h"
 #include "runtime/resource/res_type/data/skeleton_data.h"
 #include "runtime/resource/res_type/data/skeleton_mask.h"
 
-#include <map>
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace Piccolo
 {
+    /// BlendState with its clips and skeleton maps resolved to the cached animation data.
+    /// It is built once when the animation is loaded, the clip data is shared and never copied,
+    /// only blend_ratio changes from frame to frame.
+    /// The blended clips are weighted against each other, the additive ones are applied on top of the result.
+    class BlendStateWithClipData
+    {
+    public:
+        int                                                         clip_count {0};
+        std::vector<std::shared_ptr<const CompressedAnimationClip>> blend_clip;
+        std::vector<std::shared_ptr<const AnimSkelMap>>             blend_anim_skel_map;
+        std::vector<bool>                                           blend_clip_additive;
+        // masked weight of each clip for each bone, indexed by clip_index * bone_count + bone_index
+        size_t             bone_count {0};
+        std::vector<float> blend_weight;
+        std::vector<float> blend_ratio;
+
+        float getBlendWeight(size_t clip_index, size_t bone_index) const
+        {
+            return blend_weight[clip_index * bone_count + bone_index];
+        }
+        bool isAdditive(size_t clip_index) const
+        {
+            return clip_index < blend_clip_additive.size() && blend_clip_additive[clip_index];
+        }
+    };
+
+    /// The animation data is shared through the asset cache of the AssetManager, by file and type.
     class AnimationManager
     {
     private:
-        static std::map<std::string, std::shared_ptr<SkeletonData>>  m_skeleton_definition_cache;
-        static std::map<std::string, std::shared_ptr<AnimationClip>> m_animation_data_cache;
-        static std::map<std::string, std::shared_ptr<AnimSkelMap>>   m_animation_skeleton_map_cache;
-        static std::map<std::string, std::shared_ptr<BoneBlendMask>> m_skeleton_mask_cache;
+        static AnimationLodView m_lod_view;
 
     public:
-        static std::shared_ptr<SkeletonData>  tryLoadSkeleton(std::string file_path);
-        static std::shared_ptr<AnimationClip> tryLoadAnimation(std::string file_path);
-        static std::shared_ptr<AnimSkelMap>   tryLoadAnimationSkeletonMap(std::string file_path);
-        static std::shared_ptr<BoneBlendMask> tryLoadSkeletonMask(std::string file_path);
-        static BlendStateWithClipData         getBlendStateWithClipData(const BlendState& blend_state);
+        static std::shared_ptr<SkeletonData> tryLoadSkeleton(std::string file_path);
+        // the clip cooked by cookAnimation is read when it is up to date, otherwise the clip is compressed when it is
+        // first loaded. only the compressed data is kept
+        static std::shared_ptr<CompressedAnimationClip> tryLoadAnimation(std::string file_path);
+        // compresses the clip offline into its AnimationClipBlob
+        static bool cookAnimation(std::string file_path);
+        static std::shared_ptr<AnimSkelMap>             tryLoadAnimationSkeletonMap(std::string file_path);
+        static std::shared_ptr<BoneBlendMask>           tryLoadSkeletonMask(std::string file_path);
+        static BlendStateWithClipData getBlendStateWithClipData(const BlendState& blend_state, size_t bone_count);
+
+        // snapshot of the render camera, taken once per tick before the animations are ticked
+        static void                    updateLodView();
+        static const AnimationLodView& getLodView() { return m_lod_view; }
 
         AnimationManager() = default;
     };
@@ -1,9 +1,13 @@
 #include "runtime/function/animation/skeleton.h"
 
+#include "runtime/core/math/axis_aligned.h"
 #include "runtime/core/math/math.h"
 
+#include "runtime/function/animation/animation_system.h"
 #include "runtime/function/animation/utilities.h"
 
+#include <algorithm>
+
 namespace Piccolo
 {
     Skeleton::~Skeleton() { delete[] m_bones; }
@@ -28,131 +32,175 @@ namespace Piccolo
         }
         m_bone_count = skeleton_definition.bones_map.size();
         m_bones      = new Bone[m_bone_count];
+        m_bone_depths.assign(m_bone_count, 0);
         for (size_t i = 0; i < m_bone_count; i++)
         {
             const RawBone bone_definition = skeleton_definition.bones_map[i];
             Bone*         parent_bone     = find_by_index(m_bones, bone_definition.parent_index, i, m_is_flat);
             m_bones[i].initialize(std::make_shared<RawBone>(bone_definition), parent_bone);
+            if (parent_bone)
+            {
+                // the parents come first in topological order
+                m_bone_depths[i] = m_bone_depths[parent_bone - m_bones] + 1;
+            }
         }
+
+        // bounds of the binding pose, the animation LOD uses them as the extent of the character
+        AxisAlignedBox binding_pose_bounds;
+        for (size_t i = 0; i < m_bone_count; i++)
+        {
+            m_bones[i].update();
+            binding_pose_bounds.merge(m_bones[i]._getDerivedPosition());
+        }
+        m_bounding_center = m_bone_count > 0 ? binding_pose_bounds.getCenter() : Vector3::ZERO;
+        m_bounding_radius = m_bone_count > 0 ? binding_pose_bounds.getHalfExtent().length() : 0.f;
     }
 
-    void Skeleton::applyAnimation(const BlendStateWithClipData& blend_state)
+    void Skeleton::applyAnimation(const BlendStateWithClipData& blend_state, uint32_t max_bone_depth)
     {
         if (!m_bones)
         {
             return;
         }
-        resetSkeleton();
-        for (size_t clip_index = 0; clip_index < 1; clip_index++)
+
+        // the pose of every bone relative to its binding pose, accumulated clip after clip, each clip is one
+        // linear pass over its channels, the buffers keep their size so nothing is allocated after the first tick
+        m_local_pose.position.assign(m_bone_count, Vector3::ZERO);
+        m_local_pose.rotation.assign(m_bone_count, Quaternion(0.f, 0.f, 0.f, 0.f));
+        m_local_pose.scaling.assign(m_bone_count, Vector3::ZERO);
+        m_local_pose_weight.assign(m_bone_count, 0.f);
+
+        const bool has_bone_weights = blend_state.bone_count == static_cast<size_t>(m_bone_count);
+
+        // blended clips: weighted sum, the weights of a bone add up to 1 over the clips its masks enable
+        for (size_t clip_index = 0; clip_index < static_cast<size_t>(blend_state.clip_count); clip_index++)
         {
-            const AnimationClip& animation_clip = blend_state.blend_clip[clip_index];
-            const float          phase          = blend_state.blend_ratio[clip_index];
-            const AnimSkelMap&   anim_skel_map  = blend_state.blend_anim_skel_map[clip_index];
-
-            float exact_frame        = phase * (animation_clip.total_frame - 1);
-            int   current_frame_low  = floor(exact_frame);
-            int   current_frame_high = ceil(exact_frame);
-            float lerp_ratio         = exact_frame - current_frame_low;
-            // for (size_t node_index = 0; node_index < 0; node_index++)
-            for (size_t node_index = 0;
-                 node_index < animation_clip.node_count && node_index < anim_skel_map.convert.size();
-                 node_index++)
+            if (blend_state.isAdditive(clip_index) || !sampleClip(blend_state, clip_index))
+                continue;
+
+            const AnimSkelMap& anim_skel_map = *blend_state.blend_anim_skel_map[clip_index];
+            const size_t channel_count = std::min<size_t>(m_pose.position.size(), anim_skel_map.convert.size());
+            for (size_t node_index = 0; node_index < channel_count; node_index++)
             {
-                AnimationChannel channel    = animation_clip.node_channels[node_index];
-                size_t           bone_index = anim_skel_map.convert[node_index];
-                float            weight     = 1; // blend_state.blend_weight[clip_index]->blend_weight[bone_index];
-                weight                      = 1;
-                if (fabs(weight) < 0.0001f)
-                {
+                const size_t bone_index = anim_skel_map.convert[node_index];
+                if (bone_index >= static_cast<size_t>(m_bone_count) || m_bone_depths[bone_index] > max_bone_depth)
                     continue;
-                }
-                if (bone_index == std::numeric_limits<size_t>().max())
-                {
-                    // LOG_WARNING
+
+                const float weight = has_bone_weights ? blend_state.getBlendWeight(clip_index, bone_index) : 1.f;
+                if (weight < 0.0001f)
                     continue;
-                }
-                Bone* bone = &m_bones[bone_index];
-                if (channel.position_keys.size() <= current_frame_high)
-                {
-                    current_frame_high = channel.position_keys.size() - 1;
-                }
-                if (channel.scaling_keys.size() <= current_frame_high)
-                {
-                    current_frame_high = channel.scaling_keys.size() - 1;
-                }
-                if (channel.rotation_keys.size() <= current_frame_high)
-                {
-                    current_frame_high = channel.rotation_keys.size() - 1;
-                }
-                current_frame_low = (current_frame_low < current_frame_high) ? current_frame_low : current_frame_high;
-                Vector3 position  = Vector3::lerp(
-                    channel.position_keys[current_frame_low], channel.position_keys[current_frame_high], lerp_ratio);
-                Vector3 scaling = Vector3::lerp(
-                    channel.scaling_keys[current_frame_low], channel.scaling_keys[current_frame_high], lerp_ratio);
-                Quaternion rotation = Quaternion::nLerp(lerp_ratio,
-                                                        channel.rotation_keys[current_frame_low],
-                                                        channel.rotation_keys[current_frame_high],
-                                                        true);
-
-                {
-                    bone->rotate(rotation);
-                    bone->scale(scaling);
-                    bone->translate(position);
-
-                    // bone->rotate({ {},0.01,0,0,1 });
-                    // bone->scale({ {},0.9,0.9,0.9 });
-                }
+
+                // q and -q are the same rotation, keep the sum in one hemisphere
+                const Quaternion& rotation      = m_pose.rotation[node_index];
+                Quaternion&       rotation_sum  = m_local_pose.rotation[bone_index];
+                const float       signed_weight = rotation_sum.dot(rotation) < 0.f ? -weight : weight;
+
+                m_local_pose.position[bone_index] += weight * m_pose.position[node_index];
+                rotation_sum = rotation_sum + signed_weight * rotation;
+                m_local_pose.scaling[bone_index] += weight * m_pose.scaling[node_index];
+                m_local_pose_weight[bone_index] += weight;
             }
         }
-        // bones[77].rotate(Quaternion{ {},1,0,0,1 });
-        // bones[18].translate(Vector3{ {},0,1,0 });
-        // bones[0].setScale(Vector3{ {},0,1,0.01 });
+
+        for (size_t bone_index = 0; bone_index < m_bone_count; bone_index++)
+        {
+            const float weight = m_local_pose_weight[bone_index];
+            if (weight < 0.0001f)
+            {
+                // no clip moves this bone, keep it in its binding pose
+                m_local_pose.position[bone_index] = Vector3::ZERO;
+                m_local_pose.rotation[bone_index] = Quaternion::IDENTITY;
+                m_local_pose.scaling[bone_index]  = Vector3::UNIT_SCALE;
+                continue;
+            }
+            // renormalize for the bones some clips do not animate
+            m_local_pose.position[bone_index] /= weight;
+            m_local_pose.rotation[bone_index].normalise();
+            m_local_pose.scaling[bone_index] /= weight;
+        }
+
+        // additive clips: applied on top of the blended pose, scaled by their own weight
+        for (size_t clip_index = 0; clip_index < static_cast<size_t>(blend_state.clip_count); clip_index++)
+        {
+            if (!blend_state.isAdditive(clip_index) || !sampleClip(blend_state, clip_index))
+                continue;
+
+            const AnimSkelMap& anim_skel_map = *blend_state.blend_anim_skel_map[clip_index];
+            const size_t channel_count = std::min<size_t>(m_pose.position.size(), anim_skel_map.convert.size());
+            for (size_t node_index = 0; node_index < channel_count; node_index++)
+            {
+                const size_t bone_index = anim_skel_map.convert[node_index];
+                if (bone_index >= static_cast<size_t>(m_bone_count) || m_bone_depths[bone_index] > max_bone_depth)
+                    continue;
+
+                const float weight = has_bone_weights ? blend_state.getBlendWeight(clip_index, bone_index) : 1.f;
+                if (weight < 0.0001f)
+                    continue;
+
+                m_local_pose.position[bone_index] += weight * m_pose.position[node_index];
+                m_local_pose.rotation[bone_index] =
+                    m_local_pose.rotation[bone_index] *
+                    Quaternion::nLerp(weight, Quaternion::IDENTITY, m_pose.rotation[node_index], true);
+                m_local_pose.scaling[bone_index] *=
+                    Vector3::lerp(Vector3::UNIT_SCALE, m_pose.scaling[node_index], weight);
+            }
+        }
+
+        applyLocalPose(m_local_pose, max_bone_depth);
+    }
+
+    void Skeleton::applyLocalPose(const AnimationPose& local_pose, uint32_t max_bone_depth)
+    {
+        if (!m_bones)
+        {
+            return;
+        }
+        resetSkeleton();
+
+        for (size_t bone_index = 0; bone_index < m_bone_count; bone_index++)
+        {
+            if (m_bone_depths[bone_index] > max_bone_depth)
+                continue;
+
+            Bone& bone = m_bones[bone_index];
+            bone.rotate(local_pose.rotation[bone_index]);
+            bone.scale(local_pose.scaling[bone_index]);
+            bone.translate(local_pose.position[bone_index]);
+        }
+
         for (size_t i = 0; i < m_bone_count; i++)
         {
             m_bones[i].update();
         }
-#ifdef _DEBUG
-        // bones[107].m_derived_position += Vector3{ {},10, 0, 0 };
-#endif
     }
 
-    AnimationResult Skeleton::outputAnimationResult()
+    bool Skeleton::sampleClip(const BlendStateWithClipData& blend_state, size_t clip_index)
     {
-        AnimationResult animation_result;
+        const std::shared_ptr<const CompressedAnimationClip>& animation_clip = blend_state.blend_clip[clip_index];
+        if (!animation_clip || !blend_state.blend_anim_skel_map[clip_index])
+            return false;
+
+        // the clip data is shared by all the characters playing it, only the sampled pose is per skeleton
+        animation_clip->sample(blend_state.blend_ratio[clip_index], m_pose);
+        return true;
+    }
+
+    void Skeleton::outputSkinningMatrices(std::vector<Matrix4x4>& out_joint_matrices) const
+    {
+        // same size every tick, the palette is only allocated the first time
+        out_joint_matrices.resize(m_bone_count + 1);
+        out_joint_matrices[0] = Matrix4x4::IDENTITY;
         for (size_t i = 0; i < m_bone_count; i++)
         {
-            std::shared_ptr<AnimationResultElement> animation_result_element =
-                std::make_shared<AnimationResultElement>();
-            Bone* bone                      = &m_bones[i];
-            animation_result_element->index = bone->getID() + 1;
-            Vector3 temp_translation        = bone->_getDerivedPosition();
+            const Bone& bone = m_bones[i];
 
             // TODO: the unit of the joint matrices is wrong
-            Vector3 temp_scale = bone->_getDerivedScale();
-
-            Quaternion temp_rotation = bone->_getDerivedOrientation();
-
-            // auto scale = bone->_getDerivedTScale();
-            // scale.x = 1.f / scale.x;
-            // scale.y = 1.f / scale.y;
-            // scale.z = 1.f / scale.z;
-
-            // auto revTmat = getMatrix(
-            //	-bone->_getDerivedTPosition(),
-            //	scale,
-            //	conjugate( bone->_getDerivedTOrientation())
-            //);
-            auto objMat =
-                Transform(bone->_getDerivedPosition(), bone->_getDerivedOrientation(), bone->_getDerivedScale())
+            const Matrix4x4 model_matrix =
+                Transform(bone._getDerivedPosition(), bone._getDerivedOrientation(), bone._getDerivedScale())
                     .getMatrix();
 
-            auto resMat = objMat * bone->_getInverseTpose();
-
-            animation_result_element->transform = resMat.toMatrix4x4_();
-
-            animation_result.node.push_back(*animation_result_element);
+            out_joint_matrices[i + 1] = model_matrix * bone._getInverseTpose();
         }
-        return animation_result;
     }
 
     const Bone* Skeleton::getBones() const
@@ -1,9 +1,14 @@
 #pragma once
 
-#include "runtime/resource/res_type/components/animation.h"
+#include "runtime/core/math/matrix4.h"
 
+#include "runtime/function/animation/animation_compression.h"
 #include "runtime/function/animation/node.h"
 
+#include <cstdint>
+#include <limits>
+#include <vector>
+
 namespace Piccolo
 {
     class SkeletonData;
@@ -16,14 +21,38 @@ namespace Piccolo
         int   m_bone_count {0};
         Bone* m_bones {nullptr};
 
+        // depth of each bone in the hierarchy, 0 for the roots
+        std::vector<uint32_t> m_bone_depths;
+        Vector3               m_bounding_center {Vector3::ZERO};
+        float                 m_bounding_radius {0.f};
+
+        // the clip being applied, indexed by channel
+        AnimationPose m_pose;
+        // the blended pose relative to the binding pose and the sum of the weights, indexed by bone
+        AnimationPose      m_local_pose;
+        std::vector<float> m_local_pose_weight;
+
+        bool sampleClip(const BlendStateWithClipData& blend_state, size_t clip_index);
+
     public:
         ~Skeleton();
 
         void            buildSkeleton(const SkeletonData& skeleton_definition);
-        void            applyAnimation(const BlendStateWithClipData& blend_state);
-        AnimationResult outputAnimationResult();
+        // the bones deeper than max_bone_depth keep their binding pose
+        void applyAnimation(const BlendStateWithClipData& blend_state,
+                            uint32_t                      max_bone_depth = std::numeric_limits<uint32_t>::max());
+        // poses the bones from a pose relative to the binding pose, indexed by bone
+        void applyLocalPose(const AnimationPose& local_pose,
+                            uint32_t             max_bone_depth = std::numeric_limits<uint32_t>::max());
+        // the pose set by the last applyAnimation, relative to the binding pose and indexed by bone
+        const AnimationPose& getLocalPose() const { return m_local_pose; }
+        void                 outputSkinningMatrices(std::vector<Matrix4x4>& out_joint_matrices) const;
         void            resetSkeleton();
         const Bone*     getBones() const;
         int32_t         getBonesCount() const;
+
+        // bounding sphere of the binding pose in model space
+        const Vector3& getBoundingCenter() const { return m_bounding_center; }
+        float          getBoundingRadius() const { return m_bounding_radius; }
     };
 } // namespace Piccolo
@@ -1,7 +1,12 @@
 #include "runtime/function/framework/component/animation/animation_component.h"
 
 #include "runtime/function/animation/animation_system.h"
+#include "runtime/function/framework/component/transform/transform_component.h"
 #include "runtime/function/framework/object/object.h"
+#include "runtime/function/global/global_context.h"
+#include "runtime/function/render/render_system.h"
+
+#include <algorithm>
 
 namespace Piccolo
 {
@@ -12,19 +17,146 @@ namespace Piccolo
         auto skeleton_res = AnimationManager::tryLoadSkeleton(m_animation_res.skeleton_file_path);
 
         m_skeleton.buildSkeleton(*skeleton_res);
+
+        m_skinning_palette = std::make_shared<SkinningPalette>();
+        for (std::vector<Matrix4x4>& joint_matrices : m_skinning_palette->m_joint_matrices)
+        {
+            joint_matrices.resize(m_skeleton.getBonesCount() + 1, Matrix4x4::IDENTITY);
+        }
+
+        // resolve the clips once, tick then only reads the shared animation data and can run on the job system
+        m_blend_state =
+            AnimationManager::getBlendStateWithClipData(m_animation_res.blend_state, m_skeleton.getBonesCount());
     }
 
     void AnimationComponent::tick(float delta_time)
     {
-        m_animation_res.blend_state.blend_ratio[0] +=
-            (delta_time / m_animation_res.blend_state.blend_clip_file_length[0]);
-        m_animation_res.blend_state.blend_ratio[0] -= floor(m_animation_res.blend_state.blend_ratio[0]);
+        // the clips keep playing when the skeleton is not evaluated
+        advanceBlendRatio(delta_time);
+
+        AnimationLod lod;
+        if (std::shared_ptr<GObject> parent_object = m_parent_object.lock())
+        {
+            if (const TransformComponent* transform_component = parent_object->tryGetComponentConst(TransformComponent))
+            {
+                const Vector3 scale  = transform_component->getScale().absoluteCopy();
+                const Vector3 center = transform_component->getMatrix().transformAffine(m_skeleton.getBoundingCenter());
+                const float   radius = m_skeleton.getBoundingRadius() * std::max({scale.x, scale.y, scale.z});
+                lod                  = AnimationManager::getLodView().selectLod(center, radius);
+            }
+        }
+
+        // the render reads the other copy of the palette meanwhile
+        const uint8_t           palette_index  = getLogicPaletteIndex();
+        std::vector<Matrix4x4>& joint_matrices = m_skinning_palette->m_joint_matrices[palette_index];
+
+        // out of the view, the palette keeps the last pose. it is copied once into the copy of the logic, the
+        // pose of this copy may be older
+        if (lod.isPaused())
+        {
+            m_is_interpolating = false;
+            if (!m_is_palette_synchronized && m_latest_palette_index != palette_index)
+            {
+                joint_matrices            = m_skinning_palette->m_joint_matrices[m_latest_palette_index];
+                m_latest_palette_index    = palette_index;
+                m_is_palette_synchronized = true;
+            }
+            return;
+        }
+        m_latest_palette_index    = palette_index;
+        m_is_palette_synchronized = false;
+
+        if (lod.update_interval == 1)
+        {
+            m_is_interpolating = false;
+            evaluate(lod, 0.f);
+            m_skeleton.outputSkinningMatrices(joint_matrices);
+            return;
+        }
+
+        if (!m_is_interpolating || m_ticks_since_update >= m_update_interval)
+        {
+            // starting, the pose of this tick is evaluated first
+            if (!m_is_interpolating)
+            {
+                evaluate(lod, 0.f);
+                m_next_pose = m_skeleton.getLocalPose();
+            }
+            std::swap(m_previous_pose, m_next_pose);
+
+            m_update_interval = lod.update_interval;
+            evaluate(lod, delta_time * m_update_interval);
+            m_next_pose          = m_skeleton.getLocalPose();
+            m_ticks_since_update = 0;
+            m_is_interpolating   = true;
+        }
+
+        interpolate(static_cast<float>(m_ticks_since_update) / m_update_interval);
+        m_skeleton.outputSkinningMatrices(joint_matrices);
+        m_ticks_since_update++;
+    }
+
+    void AnimationComponent::advanceBlendRatio(float delta_time)
+    {
+        // every clip loops at its own length
+        BlendState& blend_state = m_animation_res.blend_state;
+        for (size_t clip_index = 0; clip_index < m_blend_state.blend_ratio.size(); clip_index++)
+        {
+            if (clip_index < blend_state.blend_clip_file_length.size() &&
+                blend_state.blend_clip_file_length[clip_index] > 0.f)
+            {
+                float& blend_ratio = blend_state.blend_ratio[clip_index];
+                blend_ratio += delta_time / blend_state.blend_clip_file_length[clip_index];
+                blend_ratio -= floor(blend_ratio);
+            }
+        }
+    }
+
+    void AnimationComponent::evaluate(const AnimationLod& lod, float time_ahead)
+    {
+        const BlendState& blend_state = m_animation_res.blend_state;
+        for (size_t clip_index = 0; clip_index < m_blend_state.blend_ratio.size(); clip_index++)
+        {
+            float blend_ratio = blend_state.blend_ratio[clip_index];
+            if (clip_index < blend_state.blend_clip_file_length.size() &&
+                blend_state.blend_clip_file_length[clip_index] > 0.f)
+            {
+                blend_ratio += time_ahead / blend_state.blend_clip_file_length[clip_index];
+                blend_ratio -= floor(blend_ratio);
+            }
+            m_blend_state.blend_ratio[clip_index] = blend_ratio;
+        }
 
-        m_skeleton.applyAnimation(AnimationManager::getBlendStateWithClipData(m_animation_res.blend_state));
-        m_animation_res.animation_result = m_skeleton.outputAnimationResult();
+        m_skeleton.applyAnimation(m_blend_state, lod.max_bone_depth);
     }
 
-    const AnimationResult& AnimationComponent::getResult() const { return m_animation_res.animation_result; }
+    void AnimationComponent::interpolate(float alpha)
+    {
+        // the skinning matrices cannot be blended linearly, a turning joint would shrink the mesh in between, so
+        // the translations and scales are lerped and the rotations nlerped before the bones are posed
+        const size_t bone_count = m_previous_pose.rotation.size();
+        m_interpolated_pose.position.resize(bone_count);
+        m_interpolated_pose.rotation.resize(bone_count);
+        m_interpolated_pose.scaling.resize(bone_count);
+        for (size_t bone_index = 0; bone_index < bone_count; bone_index++)
+        {
+            m_interpolated_pose.position[bone_index] =
+                Vector3::lerp(m_previous_pose.position[bone_index], m_next_pose.position[bone_index], alpha);
+            m_interpolated_pose.rotation[bone_index] =
+                Quaternion::nLerp(alpha, m_previous_pose.rotation[bone_index], m_next_pose.rotation[bone_index], true);
+            m_interpolated_pose.scaling[bone_index] =
+                Vector3::lerp(m_previous_pose.scaling[bone_index], m_next_pose.scaling[bone_index], alpha);
+        }
+
+        m_skeleton.applyLocalPose(m_interpolated_pose);
+    }
+
+    uint8_t AnimationComponent::getLogicPaletteIndex() const
+    {
+        if (!g_runtime_global_context.m_render_system)
+            return 0;
+        return g_runtime_global_context.m_render_system->getSwapContext().getLogicSwapDataIndex();
+    }
 
     const Skeleton& AnimationComponent::getSkeleton() const { return m_skeleton; }
 } // namespace Piccolo
@@ -1,7 +1,9 @@
 #pragma once
 
+#include "runtime/function/animation/animation_system.h"
 #include "runtime/function/animation/skeleton.h"
 #include "runtime/function/framework/component/component.h"
+#include "runtime/function/render/render_object.h"
 #include "runtime/resource/res_type/components/animation.h"
 
 namespace Piccolo
@@ -18,7 +20,7 @@ namespace Piccolo
 
         void tick(float delta_time) override;
 
-        const AnimationResult& getResult() const;
+        std::shared_ptr<const SkinningPalette> getSkinningPalette() const { return m_skinning_palette; }
 
         const Skeleton& getSkeleton() const;
 
@@ -26,6 +28,28 @@ namespace Piccolo
         META(Enable)
         AnimationComponentRes m_animation_res;
 
-        Skeleton m_skeleton;
+        void advanceBlendRatio(float delta_time);
+        // poses the skeleton time_ahead seconds after the current blend ratios
+        void evaluate(const AnimationLod& lod, float time_ahead);
+        // poses the skeleton between the two last evaluations
+        void interpolate(float alpha);
+        // the copy of the skinning palette of the logic side of the render swap context
+        uint8_t getLogicPaletteIndex() const;
+
+        Skeleton                         m_skeleton;
+        BlendStateWithClipData           m_blend_state;
+        std::shared_ptr<SkinningPalette> m_skinning_palette;
+        // the copy written last, the copies are equal when synchronized
+        uint8_t m_latest_palette_index {0};
+        bool    m_is_palette_synchronized {true};
+
+        // when the clips are not sampled every tick, the local poses of the bones are interpolated between the
+        // last evaluation and one evaluated update_interval ticks ahead, then the palette is built from them
+        bool          m_is_interpolating {false};
+        uint32_t      m_ticks_since_update {0};
+        uint32_t      m_update_interval {1};
+        AnimationPose m_previous_pose;
+        AnimationPose m_next_pose;
+        AnimationPose m_interpolated_pose;
     };
 } // namespace Piccolo
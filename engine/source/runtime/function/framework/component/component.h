@@ -18,6 +18,10 @@ namespace Piccolo
         Component() = default;
         virtual ~Component() {}
 
+        // Reading the resources the component refers to, on a job system task right after the definition is
+        // loaded when the level is streamed. It must not touch the world, postLoadResource still follows
+        virtual void preloadResource() {}
+
         // Instantiating the component after definition loaded
         virtual void postLoadResource(std::weak_ptr<GObject> parent_object) { m_parent_object = parent_object; }
 
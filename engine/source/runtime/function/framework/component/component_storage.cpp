@@ -0,0 +1,150 @@
+#include "runtime/function/framework/component/component_storage.h"
+
+#include "runtime/core/job/job_system.h"
+
+#include "runtime/engine.h"
+#include "runtime/function/global/global_context.h"
+
+#include <algorithm>
+
+namespace Piccolo
+{
+    bool shouldComponentTick(Reflection::TypeId component_type_id)
+    {
+        if (g_is_editor_mode)
+        {
+            return component_type_id < g_editor_tick_component_types.size() &&
+                   g_editor_tick_component_types[component_type_id];
+        }
+        else
+        {
+            return true;
+        }
+    }
+
+    bool ComponentPoolBase::isWriting(const std::string& resource) const
+    {
+        return resource == m_type_name ||
+               std::find(m_access.m_writes.begin(), m_access.m_writes.end(), resource) != m_access.m_writes.end();
+    }
+
+    bool ComponentPoolBase::isTouching(const std::string& resource) const
+    {
+        return isWriting(resource) ||
+               std::find(m_access.m_reads.begin(), m_access.m_reads.end(), resource) != m_access.m_reads.end();
+    }
+
+    bool ComponentPoolBase::isConflictWith(const ComponentPoolBase& other) const
+    {
+        if (other.isTouching(m_type_name))
+            return true;
+        for (const std::string& resource : m_access.m_writes)
+        {
+            if (other.isTouching(resource))
+                return true;
+        }
+        for (const std::string& resource : m_access.m_reads)
+        {
+            if (other.isWriting(resource))
+                return true;
+        }
+        return false;
+    }
+
+    bool ComponentStorage::adopt(Reflection::ReflectionPtr<Component>& component, Reflection::TypeId type_id)
+    {
+        if (!component || !isPooled(type_id))
+            return false;
+
+        component.getPtrReference() = m_pools_by_type_id[type_id]->adopt(component.getPtr());
+        return true;
+    }
+
+    bool ComponentStorage::release(Reflection::ReflectionPtr<Component>& component, Reflection::TypeId type_id)
+    {
+        if (!component || !isPooled(type_id))
+            return false;
+
+        m_pools_by_type_id[type_id]->release(component.getPtr());
+        component.getPtrReference() = nullptr;
+        return true;
+    }
+
+    void ComponentStorage::tick(float delta_time)
+    {
+        std::shared_ptr<JobSystem> job_system = g_runtime_global_context.m_job_system;
+
+        for (const auto& stage : m_stages)
+        {
+            m_tick_tasks.clear();
+            for (ComponentPoolBase* pool : stage)
+            {
+                if (pool->size() == 0 || !shouldComponentTick(pool->getTypeId()))
+                    continue;
+
+                const size_t capacity = pool->capacity();
+                if (pool->getAccess().m_is_instance_parallel)
+                {
+                    for (size_t begin = 0; begin < capacity; begin += k_tick_batch_size)
+                    {
+                        m_tick_tasks.push_back({pool, begin, std::min(begin + k_tick_batch_size, capacity)});
+                    }
+                }
+                else
+                {
+                    m_tick_tasks.push_back({pool, 0, capacity});
+                }
+            }
+
+            const auto run_tasks = [this, delta_time](size_t begin, size_t end) {
+                for (size_t task_index = begin; task_index < end; ++task_index)
+                {
+                    const TickTask& task = m_tick_tasks[task_index];
+                    task.m_pool->tickRange(task.m_begin, task.m_end, delta_time);
+                }
+            };
+
+            if (job_system)
+            {
+                job_system->parallelFor(m_tick_tasks.size(), 1, run_tasks);
+            }
+            else
+            {
+                run_tasks(0, m_tick_tasks.size());
+            }
+        }
+    }
+
+    void ComponentStorage::addToStage(ComponentPoolBase* pool)
+    {
+        // a pool may only join the last stage, joining an earlier one would tick it
+        // before a pool registered ahead of it
+        if (!m_stages.empty())
+        {
+            std::vector<ComponentPoolBase*>& last_stage = m_stages.back();
+
+            const bool is_conflict =
+                std::any_of(last_stage.begin(), last_stage.end(), [pool](const ComponentPoolBase* stage_pool) {
+                    return stage_pool->isConflictWith(*pool);
+                });
+            if (!is_conflict)
+            {
+                last_stage.push_back(pool);
+                return;
+            }
+        }
+        m_stages.push_back({pool});
+    }
+
+    void ComponentStorage::clear()
+    {
+        // pools are destroyed in reverse registration order
+        while (!m_pools.empty())
+        {
+            m_pools.pop_back();
+        }
+        m_pools_by_type_id.fill(nullptr);
+        m_stages.clear();
+        m_tick_tasks.clear();
+    }
+} // namespace Piccolo
@@ -0,0 +1,265 @@
+#pragma once
+
+#include "runtime/core/meta/reflection/reflection.h"
+#include "runtime/function/framework/component/component.h"
+
+#include "_generated/reflection/all_type_id.h"
+
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <new>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Piccolo
+{
+    bool shouldComponentTick(Reflection::TypeId component_type_id);
+
+    /// What the tick of a component type touches besides the component itself.
+    /// Resources are component type names, or names of shared state outside of the level
+    /// such as "RenderCamera", "PhysicsScene", "Input" or "AnimationAsset".
+    /// A type always writes its own type name, it does not need to be listed.
+    struct ComponentTickAccess
+    {
+        std::vector<std::string> m_reads;
+        std::vector<std::string> m_writes;
+
+        // every instance only writes itself, so the instances of the type may be ticked concurrently
+        bool m_is_instance_parallel {false};
+    };
+
+    /// Type erased interface of a ComponentPool, used by ComponentStorage
+    class ComponentPoolBase
+    {
+    public:
+        ComponentPoolBase(Reflection::TypeId type_id, std::string type_name, ComponentTickAccess access) :
+            m_type_id(type_id), m_type_name(std::move(type_name)), m_access(std::move(access))
+        {}
+        virtual ~ComponentPoolBase() {}
+
+        // move a heap allocated component into the pool and delete the heap instance. the pool owns the returned
+        // instance from then on, every pointer to the heap instance must be replaced by it
+        virtual Component* adopt(Component* component) = 0;
+        // destruct a pooled component and recycle its slot
+        virtual void release(Component* component) = 0;
+        // tick the alive components in slots [begin, end), slots are numbered in memory order
+        virtual void tickRange(size_t begin, size_t end, float delta_time) = 0;
+
+        void tick(float delta_time) { tickRange(0, capacity(), delta_time); }
+
+        virtual size_t size() const     = 0;
+        virtual size_t capacity() const = 0;
+
+        Reflection::TypeId         getTypeId() const { return m_type_id; }
+        const std::string&         getTypeName() const { return m_type_name; }
+        const ComponentTickAccess& getAccess() const { return m_access; }
+
+        bool isConflictWith(const ComponentPoolBase& other) const;
+
+    protected:
+        bool isWriting(const std::string& resource) const;
+        bool isTouching(const std::string& resource) const;
+
+        Reflection::TypeId  m_type_id {Reflection::k_invalid_type_id};
+        std::string         m_type_name;
+        ComponentTickAccess m_access;
+    };
+
+    /// ComponentPool : keep all components of one type in contiguous chunks.
+    /// Chunks are never moved, so the addresses held by ReflectionPtr stay valid.
+    template<typename TComponent>
+    class ComponentPool final : public ComponentPoolBase
+    {
+        static constexpr size_t k_chunk_capacity = 256;
+
+        struct Chunk
+        {
+            typename std::aligned_storage<sizeof(TComponent), alignof(TComponent)>::type m_slots[k_chunk_capacity];
+
+            bool   m_is_alive[k_chunk_capacity] {};
+            size_t m_used_count {0};
+
+            TComponent* getSlot(size_t index) { return reinterpret_cast<TComponent*>(&m_slots[index]); }
+
+            bool owns(const TComponent* instance) const
+            {
+                const void* address = instance;
+                return address >= static_cast<const void*>(&m_slots[0]) &&
+                       address < static_cast<const void*>(&m_slots[k_chunk_capacity]);
+            }
+        };
+
+    public:
+        ComponentPool(std::string type_name, ComponentTickAccess access) :
+            ComponentPoolBase(Reflection::TypeIdOf<TComponent>::value, std::move(type_name), std::move(access))
+        {}
+        ~ComponentPool() override { clear(); }
+
+        Component* adopt(Component* component) override
+        {
+            TComponent* slot = allocateSlot();
+            new (slot) TComponent(std::move(*static_cast<TComponent*>(component)));
+            delete component;
+            return slot;
+        }
+
+        void release(Component* component) override
+        {
+            TComponent* instance = static_cast<TComponent*>(component);
+            for (auto& chunk : m_chunks)
+            {
+                if (chunk->owns(instance))
+                {
+                    instance->~TComponent();
+                    chunk->m_is_alive[instance - chunk->getSlot(0)] = false;
+                    m_free_slots.push_back(instance);
+                    --m_alive_count;
+                    return;
+                }
+            }
+        }
+
+        void tickRange(size_t begin, size_t end, float delta_time) override
+        {
+            end = std::min(end, capacity());
+            for (size_t slot_index = begin; slot_index < end;)
+            {
+                Chunk&       chunk       = *m_chunks[slot_index / k_chunk_capacity];
+                const size_t chunk_begin = slot_index % k_chunk_capacity;
+                const size_t chunk_end   = std::min(chunk.m_used_count, chunk_begin + (end - slot_index));
+                for (size_t index = chunk_begin; index < chunk_end; ++index)
+                {
+                    if (chunk.m_is_alive[index])
+                    {
+                        // the concrete type is known here, so the call is not dispatched through the vtable
+                        chunk.getSlot(index)->TComponent::tick(delta_time);
+                    }
+                }
+                slot_index += k_chunk_capacity - chunk_begin;
+            }
+        }
+
+        size_t size() const override { return m_alive_count; }
+        size_t capacity() const override
+        {
+            return m_chunks.empty() ? 0 : (m_chunks.size() - 1) * k_chunk_capacity + m_chunks.back()->m_used_count;
+        }
+
+        void clear()
+        {
+            for (auto& chunk : m_chunks)
+            {
+                for (size_t index = 0; index < chunk->m_used_count; ++index)
+                {
+                    if (chunk->m_is_alive[index])
+                    {
+                        chunk->getSlot(index)->~TComponent();
+                    }
+                }
+            }
+            m_chunks.clear();
+            m_free_slots.clear();
+            m_alive_count = 0;
+        }
+
+    private:
+        TComponent* allocateSlot()
+        {
+            TComponent* slot = nullptr;
+            if (!m_free_slots.empty())
+            {
+                slot = m_free_slots.back();
+                m_free_slots.pop_back();
+                for (auto& chunk : m_chunks)
+                {
+                    if (chunk->owns(slot))
+                    {
+                        chunk->m_is_alive[slot - chunk->getSlot(0)] = true;
+                        break;
+                    }
+                }
+            }
+            else
+            {
+                if (m_chunks.empty() || m_chunks.back()->m_used_count == k_chunk_capacity)
+                {
+                    m_chunks.emplace_back(std::make_unique<Chunk>());
+                }
+                Chunk& chunk                          = *m_chunks.back();
+                chunk.m_is_alive[chunk.m_used_count] = true;
+                slot                                  = chunk.getSlot(chunk.m_used_count++);
+            }
+            ++m_alive_count;
+            return slot;
+        }
+
+        std::vector<std::unique_ptr<Chunk>> m_chunks;
+        std::vector<TComponent*>            m_free_slots;
+        size_t                              m_alive_count {0};
+    };
+
+    /// ComponentStorage : data oriented storage of the components in one level.
+    /// Components of a registered type live in one ComponentPool and are ticked
+    /// type by type instead of object by object.
+    /// GObject still references them by ReflectionPtr, so serialization and the
+    /// editor inspector keep working on the pooled instances.
+    /// The pools are grouped into stages from their declared tick access: the pools of a stage
+    /// do not conflict and run concurrently on the job system, stages run in registration order.
+    class ComponentStorage
+    {
+        // number of slots ticked by one job of an instance parallel pool
+        static constexpr size_t k_tick_batch_size = 64;
+
+    public:
+        ~ComponentStorage() { clear(); }
+
+        template<typename TComponent>
+        void registerPool(const std::string& type_name, ComponentTickAccess access = {})
+        {
+            constexpr Reflection::TypeId type_id = Reflection::TypeIdOf<TComponent>::value;
+            static_assert(type_id < Reflection::k_component_type_count, "only component types can be pooled");
+
+            if (isPooled(type_id))
+                return;
+
+            m_pools.emplace_back(std::make_unique<ComponentPool<TComponent>>(type_name, std::move(access)));
+            m_pools_by_type_id[type_id] = m_pools.back().get();
+            addToStage(m_pools.back().get());
+        }
+
+        bool isPooled(Reflection::TypeId type_id) const
+        {
+            return type_id < m_pools_by_type_id.size() && m_pools_by_type_id[type_id] != nullptr;
+        }
+
+        // relocate the component into its pool if the type is registered, the ReflectionPtr is updated in place
+        bool adopt(Reflection::ReflectionPtr<Component>& component, Reflection::TypeId type_id);
+        // destruct a pooled component, return false if the component is not pooled
+        bool release(Reflection::ReflectionPtr<Component>& component, Reflection::TypeId type_id);
+
+        void tick(float delta_time);
+
+        void clear();
+
+    private:
+        struct TickTask
+        {
+            ComponentPoolBase* m_pool {nullptr};
+            size_t             m_begin {0};
+            size_t             m_end {0};
+        };
+
+        void addToStage(ComponentPoolBase* pool);
+
+        // pools in registration order
+        std::vector<std::unique_ptr<ComponentPoolBase>> m_pools;
+        // indexed by component type id, null for the types that are not pooled
+        std::array<ComponentPoolBase*, Reflection::k_component_type_count> m_pools_by_type_id {};
+
+        std::vector<std::vector<ComponentPoolBase*>> m_stages;
+        // reused every tick to avoid allocations
+        std::vector<TickTask> m_tick_tasks;
+    };
+} // namespace Piccolo
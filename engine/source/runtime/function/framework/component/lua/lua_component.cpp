@@ -9,13 +9,14 @@ namespace Piccolo
                               Reflection::FieldAccessor& field_accessor,
                               void*&                     target_instance)
     {
-        auto components = game_object.lock()->getComponents();
+        const auto& components = game_object.lock()->getComponents();
 
         std::istringstream iss(field_name);
         std::string        current_name;
         std::getline(iss, current_name, '.');
-        auto component_iter = std::find_if(
-            components.begin(), components.end(), [current_name](auto c) { return c.getTypeName() == current_name; });
+        auto component_iter = std::find_if(components.begin(), components.end(), [&current_name](const auto& c) {
+            return c.getTypeName() == current_name;
+        });
         if (component_iter != components.end())
         {
             auto  meta           = Reflection::TypeMeta::newMetaFromName(current_name);
@@ -24,19 +25,12 @@ namespace Piccolo
             // find target field
             while (std::getline(iss, current_name, '.'))
             {
-                Reflection::FieldAccessor* fields;
-                int                        fields_count = meta.getFieldsList(fields);
-                auto                       field_iter   = std::find_if(
-                    fields, fields + fields_count, [current_name](auto f) { return f.getFieldName() == current_name; });
-                if (field_iter == fields + fields_count) // not found
+                field_accessor = meta.getFieldByName(current_name);
+                if (!field_accessor.isValid()) // not found
                 {
-                    delete[] fields;
                     return false;
                 }
 
-                field_accessor = *field_iter;
-                delete[] fields;
-
                 target_instance = field_instance;
 
                 // for next iteration
@@ -99,10 +93,11 @@ namespace Piccolo
         if (target_name.find_first_of('.') == target_name.npos)
         {
             // target is a component
-            auto components = game_object.lock()->getComponents();
+            const auto& components = game_object.lock()->getComponents();
 
-            auto component_iter = std::find_if(
-                components.begin(), components.end(), [target_name](auto c) { return c.getTypeName() == target_name; });
+            auto component_iter = std::find_if(components.begin(), components.end(), [&target_name](const auto& c) {
+                return c.getTypeName() == target_name;
+            });
             if (component_iter != components.end())
             {
                 meta            = Reflection::TypeMeta::newMetaFromName(target_name);
@@ -130,19 +125,15 @@ namespace Piccolo
         }
 
         // invoke function
-        Reflection::MethodAccessor* methods;
-        size_t                      method_count = meta.getMethodsList(methods);
-        auto                        method_iter  = std::find_if(
-            methods, methods + method_count, [method_name](auto m) { return m.getMethodName() == method_name; });
-        if (method_iter != methods + method_count)
+        Reflection::MethodAccessor method_accessor = meta.getMethodByName(method_name);
+        if (method_accessor.isValid())
         {
-            method_iter->invoke(target_instance);
+            method_accessor.invoke(target_instance);
         }
         else
         {
             LOG_ERROR("Cand find method");
         }
-        delete[] methods;
     }
 
     void LuaComponent::postLoadResource(std::weak_ptr<GObject> parent_object)
@@ -13,10 +13,9 @@
 
 namespace Piccolo
 {
-    void MeshComponent::postLoadResource(std::weak_ptr<GObject> parent_object)
+    void MeshComponent::preloadResource()
     {
-        m_parent_object = parent_object;
-
+        // the materials are read here and the parts only need their object at instantiation
         std::shared_ptr<AssetManager> asset_manager = g_runtime_global_context.m_asset_manager;
         ASSERT(asset_manager);
 
@@ -29,23 +28,26 @@ namespace Piccolo
             meshComponent.m_mesh_desc.m_mesh_file =
                 asset_manager->getFullPath(sub_mesh.m_obj_file_ref).generic_string();
 
-            meshComponent.m_material_desc.m_with_texture = sub_mesh.m_material.empty() == false;
+            // the material files are shared by all the parts and objects using them
+            std::shared_ptr<const MaterialRes> material_res;
+            if (!sub_mesh.m_material.empty())
+            {
+                material_res = asset_manager->loadSharedAsset<MaterialRes>(sub_mesh.m_material);
+            }
+            meshComponent.m_material_desc.m_with_texture = material_res != nullptr;
 
             if (meshComponent.m_material_desc.m_with_texture)
             {
-                MaterialRes material_res;
-                asset_manager->loadAsset(sub_mesh.m_material, material_res);
-
                 meshComponent.m_material_desc.m_base_color_texture_file =
-                    asset_manager->getFullPath(material_res.m_base_colour_texture_file).generic_string();
+                    asset_manager->getFullPath(material_res->m_base_colour_texture_file).generic_string();
                 meshComponent.m_material_desc.m_metallic_roughness_texture_file =
-                    asset_manager->getFullPath(material_res.m_metallic_roughness_texture_file).generic_string();
+                    asset_manager->getFullPath(material_res->m_metallic_roughness_texture_file).generic_string();
                 meshComponent.m_material_desc.m_normal_texture_file =
-                    asset_manager->getFullPath(material_res.m_normal_texture_file).generic_string();
+                    asset_manager->getFullPath(material_res->m_normal_texture_file).generic_string();
                 meshComponent.m_material_desc.m_occlusion_texture_file =
-                    asset_manager->getFullPath(material_res.m_occlusion_texture_file).generic_string();
+                    asset_manager->getFullPath(material_res->m_occlusion_texture_file).generic_string();
                 meshComponent.m_material_desc.m_emissive_texture_file =
-                    asset_manager->getFullPath(material_res.m_emissive_texture_file).generic_string();
+                    asset_manager->getFullPath(material_res->m_emissive_texture_file).generic_string();
             }
 
             auto object_space_transform = sub_mesh.m_transform.getMatrix();
@@ -54,6 +56,18 @@ namespace Piccolo
 
             ++raw_mesh_count;
         }
+
+        m_is_resource_preloaded = true;
+    }
+
+    void MeshComponent::postLoadResource(std::weak_ptr<GObject> parent_object)
+    {
+        m_parent_object = parent_object;
+
+        if (!m_is_resource_preloaded)
+        {
+            preloadResource();
+        }
     }
 
     void MeshComponent::tick(float delta_time)
@@ -67,38 +81,47 @@ namespace Piccolo
 
         if (transform_component->isDirty())
         {
-            std::vector<GameObjectPartDesc> dirty_mesh_parts;
-            SkeletonAnimationResult         animation_result;
-            animation_result.m_transforms.push_back({Matrix4x4::IDENTITY});
-            if (animation_component != nullptr)
+            RenderCommandQueue& render_commands =
+                g_runtime_global_context.m_render_system->getSwapContext().getLogicCommands();
+            const GObjectID go_id            = m_parent_object.lock()->getID();
+            const Matrix4x4 object_transform = transform_component->getMatrix();
+
+            if (!m_is_render_object_added)
             {
-                for (auto& node : animation_component->getResult().node)
+                // the sources of the parts are sent once, the render side keeps them and later moves only send
+                // the part transforms
+                std::vector<GameObjectPartDesc> mesh_parts;
+                mesh_parts.reserve(m_raw_meshes.size());
+                for (GameObjectPartDesc& mesh_part : m_raw_meshes)
                 {
-                    animation_result.m_transforms.push_back({Matrix4x4(node.transform)});
+                    if (animation_component)
+                    {
+                        mesh_part.m_with_animation                                = true;
+                        mesh_part.m_skeleton_binding_desc.m_skeleton_binding_file = mesh_part.m_mesh_desc.m_mesh_file;
+                        // the render side reads the palette in place, only the pointer is sent
+                        mesh_part.m_skinning_palette = animation_component->getSkinningPalette();
+                    }
+                    GameObjectPartDesc& world_part = mesh_parts.emplace_back(mesh_part);
+                    world_part.m_transform_desc.m_transform_matrix =
+                        object_transform * mesh_part.m_transform_desc.m_transform_matrix;
                 }
+
+                render_commands.addGameObject(GameObjectDesc {go_id, std::move(mesh_parts)});
+                m_is_render_object_added = true;
             }
-            for (GameObjectPartDesc& mesh_part : m_raw_meshes)
+            else
             {
-                if (animation_component)
+                RenderCommandGameObjectTransform* command =
+                    render_commands.allocateGameObjectTransform(go_id, static_cast<uint32_t>(m_raw_meshes.size()));
+                Matrix4x4* part_transforms = command->getPartTransforms();
+                for (size_t part_index = 0; part_index < m_raw_meshes.size(); ++part_index)
                 {
-                    mesh_part.m_with_animation                                = true;
-                    mesh_part.m_skeleton_animation_result                     = animation_result;
-                    mesh_part.m_skeleton_binding_desc.m_skeleton_binding_file = mesh_part.m_mesh_desc.m_mesh_file;
+                    part_transforms[part_index] =
+                        object_transform * m_raw_meshes[part_index].m_transform_desc.m_transform_matrix;
                 }
-                Matrix4x4 object_transform_matrix = mesh_part.m_transform_desc.m_transform_matrix;
-
-                mesh_part.m_transform_desc.m_transform_matrix =
-                    transform_component->getMatrix() * object_transform_matrix;
-                dirty_mesh_parts.push_back(mesh_part);
-
-                mesh_part.m_transform_desc.m_transform_matrix = object_transform_matrix;
+                render_commands.submit(command);
             }
 
-            RenderSwapContext& render_swap_context = g_runtime_global_context.m_render_system->getSwapContext();
-            RenderSwapData&    logic_swap_data     = render_swap_context.getLogicSwapData();
-
-            logic_swap_data.addDirtyGameObject(GameObjectDesc {m_parent_object.lock()->getID(), dirty_mesh_parts});
-
             transform_component->setDirtyFlag(false);
         }
     }
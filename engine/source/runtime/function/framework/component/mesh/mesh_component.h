@@ -19,6 +19,7 @@ namespace Piccolo
     public:
         MeshComponent() {};
 
+        void preloadResource() override;
         void postLoadResource(std::weak_ptr<GObject> parent_object) override;
 
         const std::vector<GameObjectPartDesc>& getRawMeshes() const { return m_raw_meshes; }
@@ -30,5 +31,7 @@ namespace Piccolo
         MeshComponentRes m_mesh_res;
 
         std::vector<GameObjectPartDesc> m_raw_meshes;
+        bool                            m_is_resource_preloaded {false};
+        bool                            m_is_render_object_added {false};
     };
 } // namespace Piccolo
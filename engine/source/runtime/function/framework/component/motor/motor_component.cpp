@@ -64,7 +64,7 @@ namespace Piccolo
             return;
 
         TransformComponent* transform_component =
-            m_parent_object.lock()->tryGetComponent<TransformComponent>("TransformComponent");
+            m_parent_object.lock()->tryGetComponent(TransformComponent);
 
         Radian turn_angle_yaw = g_runtime_global_context.m_input_system->m_cursor_delta_yaw;
 
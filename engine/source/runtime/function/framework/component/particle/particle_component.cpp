@@ -28,7 +28,7 @@ namespace Piccolo
     void ParticleComponent::computeGlobalTransform()
     {
         TransformComponent* transform_component =
-            m_parent_object.lock()->tryGetComponent<TransformComponent>("TransformComponent");
+            m_parent_object.lock()->tryGetComponent(TransformComponent);
 
         Matrix4x4 global_transform_matrix = transform_component->getMatrix() * m_local_transform;
 
@@ -45,16 +45,16 @@ namespace Piccolo
     {
         RenderSwapContext& swap_context = g_runtime_global_context.m_render_system->getSwapContext();
 
-        RenderSwapData& logic_swap_data = swap_context.getLogicSwapData();
+        RenderCommandQueue& render_commands = swap_context.getLogicCommands();
 
-        logic_swap_data.addTickParticleEmitter(m_transform_desc.m_id);
+        render_commands.addTickParticleEmitter(m_transform_desc.m_id);
 
         TransformComponent* transform_component = m_parent_object.lock()->tryGetComponent(TransformComponent);
         if (transform_component->isDirty())
         {
             computeGlobalTransform();
 
-            logic_swap_data.updateParticleTransform(m_transform_desc);
+            render_commands.updateParticleTransform(m_transform_desc);
         }
     }
 }; // namespace Piccolo
\ No newline at end of file
@@ -1,17 +1,29 @@
 #include "runtime/function/framework/level/level.h"
 
 #include "runtime/core/base/macro.h"
+#include "runtime/core/job/job_system.h"
 
 #include "runtime/resource/asset_manager/asset_manager.h"
 #include "runtime/resource/res_type/common/level.h"
 
 #include "runtime/engine.h"
+#include "runtime/function/animation/animation_system.h"
 #include "runtime/function/character/character.h"
+#include "runtime/function/framework/component/animation/animation_component.h"
+#include "runtime/function/framework/component/camera/camera_component.h"
+#include "runtime/function/framework/component/component_storage.h"
+#include "runtime/function/framework/component/mesh/mesh_component.h"
+#include "runtime/function/framework/component/motor/motor_component.h"
+#include "runtime/function/framework/component/particle/particle_component.h"
+#include "runtime/function/framework/component/transform/transform_component.h"
 #include "runtime/function/framework/object/object.h"
 #include "runtime/function/particle/particle_manager.h"
 #include "runtime/function/physics/physics_manager.h"
 #include "runtime/function/physics/physics_scene.h"
+#include <algorithm>
+#include <chrono>
 #include <limits>
+#include <vector>
 
 namespace Piccolo
 {
@@ -19,12 +31,38 @@ namespace Piccolo
     {
         m_current_active_character.reset();
         m_gobjects.clear();
+        m_component_storage.reset();
 
         ASSERT(g_runtime_global_context.m_physics_manager);
         g_runtime_global_context.m_physics_manager->deletePhysicsScene(m_physics_scene);
     }
 
-    GObjectID Level::createObject(const ObjectInstanceRes& object_instance_res)
+    /// The resources of a streamed level, shared with the tasks reading them so the level can be unloaded before
+    /// they finish.
+    struct LevelLoadingData
+    {
+        AssetHandle<LevelRes> level_res;
+
+        // the definition of each object instance, shared by the instances of the same definition
+        std::vector<std::shared_ptr<const ObjectDefinitionRes>> definitions;
+        std::vector<JobHandle>                                  definition_jobs;
+
+        size_t next_object_index {0};
+        bool   is_creating_objects {false};
+    };
+
+    namespace
+    {
+        // objects whose definitions are read by one task
+        constexpr size_t k_object_definition_batch_size = 8;
+    } // namespace
+
+    GObjectID Level::createObject(ObjectInstanceRes& object_instance_res)
+    {
+        return createObject(object_instance_res, nullptr);
+    }
+
+    GObjectID Level::createObject(ObjectInstanceRes& object_instance_res, const ObjectDefinitionRes* definition_res)
     {
         GObjectID object_id = ObjectIDAllocator::alloc();
         ASSERT(object_id != k_invalid_gobject_id);
@@ -32,14 +70,14 @@ namespace Piccolo
         std::shared_ptr<GObject> gobject;
         try
         {
-            gobject = std::make_shared<GObject>(object_id);
+            gobject = std::make_shared<GObject>(object_id, m_component_storage);
         }
         catch (const std::bad_alloc&)
         {
             LOG_FATAL("cannot allocate memory for new gobject");
         }
 
-        bool is_loaded = gobject->load(object_instance_res);
+        bool is_loaded = gobject->load(object_instance_res, definition_res);
         if (is_loaded)
         {
             m_gobjects.emplace(object_id, gobject);
@@ -56,22 +94,95 @@ namespace Piccolo
     {
         LOG_INFO("loading level: {}", level_res_url);
 
-        m_level_res_url = level_res_url;
+        m_level_res_url  = level_res_url;
+        m_is_loaded      = false;
+        m_is_load_failed = false;
+
+        m_loading_data            = std::make_shared<LevelLoadingData>();
+        m_loading_data->level_res = g_runtime_global_context.m_asset_manager->loadAssetAsync<LevelRes>(level_res_url);
+
+        return true;
+    }
+
+    void Level::tickLoading(float time_budget)
+    {
+        if (m_is_loaded || m_is_load_failed || !m_loading_data)
+            return;
 
-        LevelRes   level_res;
-        const bool is_load_success = g_runtime_global_context.m_asset_manager->loadAsset(level_res_url, level_res);
-        if (is_load_success == false)
+        const auto        tick_begin   = std::chrono::steady_clock::now();
+        LevelLoadingData& loading_data = *m_loading_data;
+        if (!loading_data.level_res.isReady())
+            return;
+
+        if (!loading_data.level_res.isLoaded())
         {
-            return false;
+            LOG_ERROR("loading level {} failed", m_level_res_url);
+            m_is_load_failed = true;
+            m_loading_data.reset();
+            return;
         }
 
-        ASSERT(g_runtime_global_context.m_physics_manager);
-        m_physics_scene = g_runtime_global_context.m_physics_manager->createPhysicsScene(level_res.m_gravity);
-        ParticleEmitterIDAllocator::reset();
+        LevelRes& level_res = loading_data.level_res.get();
+        if (loading_data.definition_jobs.empty() && !level_res.m_objects.empty())
+        {
+            // the definitions are read in parallel, and their components read their own resources on the same task,
+            // a definition shared by several objects is read once
+            const size_t object_count = level_res.m_objects.size();
+            loading_data.definitions.resize(object_count);
+            for (size_t begin = 0; begin < object_count; begin += k_object_definition_batch_size)
+            {
+                const size_t end = std::min(begin + k_object_definition_batch_size, object_count);
+                loading_data.definition_jobs.push_back(
+                    g_runtime_global_context.m_job_system->submit([data = m_loading_data, begin, end] {
+                        for (size_t object_index = begin; object_index < end; ++object_index)
+                        {
+                            ObjectInstanceRes& object_instance_res = data->level_res.get().m_objects[object_index];
+                            data->definitions[object_index] = GObject::loadDefinition(object_instance_res.m_definition);
+                            if (!data->definitions[object_index])
+                                continue;
+
+                            for (auto& component : object_instance_res.m_instanced_components)
+                            {
+                                if (component)
+                                {
+                                    component->preloadResource();
+                                }
+                            }
+                        }
+                    }));
+            }
+            return;
+        }
+
+        for (const JobHandle& definition_job : loading_data.definition_jobs)
+        {
+            if (!definition_job.isDone())
+                return;
+        }
 
-        for (const ObjectInstanceRes& object_instance_res : level_res.m_objects)
+        if (!loading_data.is_creating_objects)
         {
-            createObject(object_instance_res);
+            beginCreatingObjects();
+            loading_data.is_creating_objects = true;
+        }
+
+        // the objects are registered over several ticks when there are many of them
+        while (loading_data.next_object_index < level_res.m_objects.size())
+        {
+            const size_t object_index = loading_data.next_object_index++;
+            if (loading_data.definitions[object_index])
+            {
+                createObject(level_res.m_objects[object_index], loading_data.definitions[object_index].get());
+            }
+            else
+            {
+                LOG_ERROR("loading object " + level_res.m_objects[object_index].m_name + " failed");
+            }
+
+            const std::chrono::duration<float, std::milli> loading_time =
+                std::chrono::steady_clock::now() - tick_begin;
+            if (loading_time.count() >= time_budget)
+                return;
         }
 
         // create active character
@@ -89,20 +200,57 @@ namespace Piccolo
         }
 
         m_is_loaded = true;
+        m_loading_data.reset();
 
         LOG_INFO("level load succeed");
+    }
 
-        return true;
+    void Level::beginCreatingObjects()
+    {
+        const LevelRes& level_res = m_loading_data->level_res.get();
+
+        ASSERT(g_runtime_global_context.m_physics_manager);
+        m_physics_scene = g_runtime_global_context.m_physics_manager->createPhysicsScene(level_res.m_gravity);
+        g_runtime_global_context.m_particle_manager->resetParticleEmitters();
+
+        // the registration order is the tick order of the component types, it matches the
+        // order the components are declared in the object definitions:
+        // transform -> animation -> particle -> mesh -> motor -> camera
+        // types whose accesses do not conflict are ticked concurrently. the render commands go through a lock-free
+        // queue, so with the declarations below the animations and particles run together, the other types one
+        // after another, and the animation, particle and mesh instances are ticked in parallel. the mesh clears the
+        // dirty flag of its transform, the cameras override each other's view.
+        // components of the other types stay on the heap and are ticked by their objects
+        m_component_storage = std::make_shared<ComponentStorage>();
+        m_component_storage->registerPool<TransformComponent>("TransformComponent", {{}, {"PhysicsScene"}});
+        m_component_storage->registerPool<AnimationComponent>(
+            "AnimationComponent", {{"AnimationAsset", "TransformComponent"}, {}, true});
+        m_component_storage->registerPool<ParticleComponent>("ParticleComponent", {{"TransformComponent"}, {}, true});
+        m_component_storage->registerPool<MeshComponent>(
+            "MeshComponent", {{"AnimationComponent"}, {"TransformComponent"}, true});
+        m_component_storage->registerPool<MotorComponent>("MotorComponent",
+                                                          {{"Input"}, {"TransformComponent", "PhysicsScene"}});
+        m_component_storage->registerPool<CameraComponent>("CameraComponent",
+                                                           {{"TransformComponent", "Input"}, {"RenderCamera"}});
     }
 
     void Level::unload()
     {
+        // the tasks still reading the resources keep them alive until they finish
+        m_loading_data.reset();
+        m_is_loaded = false;
         clear();
         LOG_INFO("unload level: {}", m_level_res_url);
     }
 
     bool Level::save()
     {
+        if (!m_is_loaded)
+        {
+            LOG_ERROR("save level {} failed, it is still loading", m_level_res_url);
+            return false;
+        }
+
         LOG_INFO("saving level: {}", m_level_res_url);
         LevelRes output_level_res;
 
@@ -142,6 +290,16 @@ namespace Piccolo
             return;
         }
 
+        // the animation LOD of every character is chosen against the same camera
+        AnimationManager::updateLodView();
+
+        // tick the pooled components type by type, then the components left on the heap
+        const auto component_tick_begin = std::chrono::steady_clock::now();
+        m_component_storage->tick(delta_time);
+        const std::chrono::duration<float, std::milli> component_tick_time =
+            std::chrono::steady_clock::now() - component_tick_begin;
+        m_component_tick_time += (component_tick_time.count() - m_component_tick_time) * 0.05f;
+
         for (const auto& id_object_pair : m_gobjects)
         {
             assert(id_object_pair.second);
@@ -9,9 +9,12 @@
 namespace Piccolo
 {
     class Character;
+    class ComponentStorage;
     class GObject;
+    class ObjectDefinitionRes;
     class ObjectInstanceRes;
     class PhysicsScene;
+    struct LevelLoadingData;
 
     using LevelObjectsMap = std::unordered_map<GObjectID, std::shared_ptr<GObject>>;
 
@@ -21,9 +24,16 @@ namespace Piccolo
     public:
         virtual ~Level(){};
 
+        // start streaming the level, the resources are read on the job system and the objects are then created
+        // by tickLoading, it is usable once isLoaded()
         bool load(const std::string& level_res_url);
+        // on the logic thread, creates the objects whose resources are ready for at most time_budget milliseconds
+        void tickLoading(float time_budget);
         void unload();
 
+        bool isLoaded() const { return m_is_loaded; }
+        bool isLoadFailed() const { return m_is_load_failed; }
+
         bool save();
 
         void tick(float delta_time);
@@ -35,20 +45,35 @@ namespace Piccolo
         std::weak_ptr<GObject>   getGObjectByID(GObjectID go_id) const;
         std::weak_ptr<Character> getCurrentActiveCharacter() const { return m_current_active_character; }
 
-        GObjectID createObject(const ObjectInstanceRes& object_instance_res);
+        // the instanced components of object_instance_res are handed over to the object, see GObject::load
+        GObjectID createObject(ObjectInstanceRes& object_instance_res);
         void      deleteGObjectByID(GObjectID go_id);
 
         std::weak_ptr<PhysicsScene> getPhysicsScene() const { return m_physics_scene; }
 
+        // smoothed time spent ticking the pooled components, in milliseconds
+        float getComponentTickTime() const { return m_component_tick_time; }
+
     protected:
         void clear();
 
+        GObjectID createObject(ObjectInstanceRes& object_instance_res, const ObjectDefinitionRes* definition_res);
+        void      beginCreatingObjects();
+
         bool        m_is_loaded {false};
+        bool        m_is_load_failed {false};
         std::string m_level_res_url;
 
+        // while the level is streamed
+        std::shared_ptr<LevelLoadingData> m_loading_data;
+
         // all game objects in this level, key: object id, value: object instance
         LevelObjectsMap m_gobjects;
 
+        // contiguous storage of the components owned by the game objects above
+        std::shared_ptr<ComponentStorage> m_component_storage;
+        float                             m_component_tick_time {0.f};
+
         std::shared_ptr<Character> m_current_active_character;
 
         std::weak_ptr<PhysicsScene> m_physics_scene;
@@ -1,4 +1,5 @@
 #include "level_debugger.h"
+#include "runtime/core/job/job_system.h"
 #include "runtime/core/meta/reflection/reflection.h"
 #include "runtime/engine.h"
 #include "runtime/function/character/character.h"
@@ -12,6 +13,8 @@
 #include "runtime/function/global/global_context.h"
 #include "runtime/function/render/debugdraw/debug_draw_manager.h"
 #include "runtime/function/render/render_debug_config.h"
+#include "runtime/function/render/render_scene.h"
+#include "runtime/function/render/render_system.h"
 namespace Piccolo
 {
     void LevelDebugger::tick(std::shared_ptr<Level> level) const
@@ -37,6 +40,10 @@ namespace Piccolo
         {
             showCameraInfo(level);
         }
+        if (g_runtime_global_context.m_render_debug_config->performance.show_tick_time)
+        {
+            showTickTime(level);
+        }
     }
 
     void LevelDebugger::showAllBones(std::shared_ptr<Level> level) const
@@ -89,12 +96,29 @@ namespace Piccolo
         std::shared_ptr<GObject> gobject = level->getCurrentActiveCharacter().lock()->getObject().lock();
         drawCameraInfo(gobject);
     }
+
+    void LevelDebugger::showTickTime(std::shared_ptr<Level> level) const
+    {
+        DebugDrawGroup* debug_draw_group =
+            g_runtime_global_context.m_debugdraw_manager->tryGetOrCreateDebugDrawGroup("show tick time");
+
+        std::ostringstream buffer;
+        buffer << "component tick: " << level->getComponentTickTime() << " ms" << std::endl;
+        buffer << "job workers: " << g_runtime_global_context.m_job_system->getWorkerCount() << " + main thread"
+               << std::endl;
+
+        const RenderSceneCullTime& cull_time = g_runtime_global_context.m_render_system->getCullTime();
+        buffer << "culling: main camera " << cull_time.main_camera << " ms, directional light "
+               << cull_time.directional_light << " ms, point lights " << cull_time.point_lights << " ms" << std::endl;
+        buffer << "draw list: " << cull_time.draw_list << " ms";
+        debug_draw_group->addText(buffer.str(), Vector4(1.0f, 0.0f, 0.0f, 1.0f), Vector3(-1.0f, -0.5f, 0.0f), 10, true);
+    }
     void LevelDebugger::drawBones(std::shared_ptr<GObject> object) const
     {
         const TransformComponent* transform_component =
-            object->tryGetComponentConst<TransformComponent>("TransformComponent");
+            object->tryGetComponentConst(TransformComponent);
         const AnimationComponent* animation_component =
-            object->tryGetComponentConst<AnimationComponent>("AnimationComponent");
+            object->tryGetComponentConst(AnimationComponent);
 
         if (transform_component == nullptr || animation_component == nullptr)
             return;
@@ -149,9 +173,9 @@ namespace Piccolo
     void LevelDebugger::drawBonesName(std::shared_ptr<GObject> object) const
     {
         const TransformComponent* transform_component =
-            object->tryGetComponentConst<TransformComponent>("TransformComponent");
+            object->tryGetComponentConst(TransformComponent);
         const AnimationComponent* animation_component =
-            object->tryGetComponentConst<AnimationComponent>("AnimationComponent");
+            object->tryGetComponentConst(AnimationComponent);
 
         if (transform_component == nullptr || animation_component == nullptr)
             return;
@@ -191,7 +215,7 @@ namespace Piccolo
     void LevelDebugger::drawBoundingBox(std::shared_ptr<GObject> object) const
     {
         const RigidBodyComponent* rigidbody_component =
-            object->tryGetComponentConst<RigidBodyComponent>("RigidBodyComponent");
+            object->tryGetComponentConst(RigidBodyComponent);
         if (rigidbody_component == nullptr)
             return;
 
@@ -214,7 +238,7 @@ namespace Piccolo
 
     void LevelDebugger::drawCameraInfo(std::shared_ptr<GObject> object) const
     {
-        const CameraComponent* camera_component = object->tryGetComponentConst<CameraComponent>("CameraComponent");
+        const CameraComponent* camera_component = object->tryGetComponentConst(CameraComponent);
         if (camera_component == nullptr)
             return;
 
@@ -23,6 +23,8 @@ namespace Piccolo
         void showBoundingBox(std::shared_ptr<Level> level, GObjectID go_id) const;
         // show camera info
         void showCameraInfo(std::shared_ptr<Level> level) const;
+        // show the time spent ticking components
+        void showTickTime(std::shared_ptr<Level> level) const;
 
     private:
         void drawBones(std::shared_ptr<GObject> object) const;
@@ -1,5 +1,6 @@
 #include "runtime/function/framework/object/object.h"
 
+#include "runtime/core/base/macro.h"
 #include "runtime/engine.h"
 
 #include "runtime/core/meta/reflection/reflection.h"
@@ -17,90 +18,168 @@
 
 namespace Piccolo
 {
-    bool shouldComponentTick(std::string component_type_name)
+    namespace
     {
-        if (g_is_editor_mode)
+        void deleteObjectDefinition(ObjectDefinitionRes* definition_res)
         {
-            return g_editor_tick_component_types.find(component_type_name) != g_editor_tick_component_types.end();
-        }
-        else
-        {
-            return true;
+            for (auto& component : definition_res->m_components)
+            {
+                PICCOLO_REFLECTION_DELETE(component);
+            }
+            delete definition_res;
         }
-    }
+    } // namespace
 
     GObject::~GObject()
     {
-        for (auto& component : m_components)
+        for (size_t component_index = 0; component_index < m_components.size(); ++component_index)
         {
+            auto& component = m_components[component_index];
+            if (m_component_storage && m_component_storage->release(component, m_component_type_ids[component_index]))
+                continue;
+
             PICCOLO_REFLECTION_DELETE(component);
         }
         m_components.clear();
+        m_component_type_ids.clear();
+        m_unpooled_component_indices.clear();
     }
 
     void GObject::tick(float delta_time)
     {
-        for (auto& component : m_components)
+        for (size_t component_index : m_unpooled_component_indices)
         {
-            if (shouldComponentTick(component.getTypeName()))
+            if (shouldComponentTick(m_component_type_ids[component_index]))
             {
-                component->tick(delta_time);
+                m_components[component_index]->tick(delta_time);
             }
         }
     }
 
-    bool GObject::hasComponent(const std::string& compenent_type_name) const
+    Reflection::ReflectionPtr<Component> GObject::addComponent(Reflection::ReflectionPtr<Component> component)
     {
-        for (const auto& component : m_components)
+        // the type name is only resolved here, the typed lookups use the index built below
+        const Reflection::TypeId type_id = Reflection::getTypeIdByName(component.getTypeName());
+        ASSERT(type_id < Reflection::k_component_type_count);
+        // the typed lookups index the components with a uint8_t
+        if (m_components.size() >= k_invalid_component_index)
         {
-            if (component.getTypeName() == compenent_type_name)
-                return true;
+            LOG_ERROR("object {} already has {} components, {} is not added",
+                      m_name,
+                      m_components.size(),
+                      component.getTypeName());
+            PICCOLO_REFLECTION_DELETE(component);
+            return component;
         }
 
-        return false;
+        // relocate the component into the level's storage before it is instantiated,
+        // at this point it only holds deserialized data
+        const bool is_pooled = m_component_storage && m_component_storage->adopt(component, type_id);
+        if (!is_pooled)
+        {
+            m_unpooled_component_indices.push_back(m_components.size());
+        }
+
+        // the typed lookups return the first component of a type, like the scan of the names did
+        if (type_id < m_component_indices.size() && m_component_indices[type_id] == k_invalid_component_index)
+        {
+            m_component_indices[type_id] = static_cast<uint8_t>(m_components.size());
+        }
+        m_component_type_ids.push_back(type_id);
+        m_components.push_back(component);
+        return component;
+    }
+
+    bool GObject::hasComponent(const std::string& compenent_type_name) const
+    {
+        return getComponentIndex(Reflection::getTypeIdByName(compenent_type_name)) != k_invalid_component_index;
     }
 
-    bool GObject::load(const ObjectInstanceRes& object_instance_res)
+    bool GObject::load(ObjectInstanceRes& object_instance_res, const ObjectDefinitionRes* definition_res)
     {
         // clear old components
         m_components.clear();
+        m_component_type_ids.clear();
+        m_component_indices.fill(k_invalid_component_index);
+        m_unpooled_component_indices.clear();
 
         setName(object_instance_res.m_name);
 
-        // load object instanced components
-        m_components = object_instance_res.m_instanced_components;
-        for (auto component : m_components)
+        // load object instanced components, the pool may move them, so the res follows the moved instance
+        for (auto& component : object_instance_res.m_instanced_components)
         {
             if (component)
             {
-                component->postLoadResource(weak_from_this());
+                component = addComponent(component);
             }
         }
+        for (auto& component : m_components)
+        {
+            component->postLoadResource(weak_from_this());
+        }
 
         // load object definition components
         m_definition_url = object_instance_res.m_definition;
 
-        ObjectDefinitionRes definition_res;
+        std::shared_ptr<const ObjectDefinitionRes> loaded_definition_res;
+        if (definition_res == nullptr)
+        {
+            loaded_definition_res = loadDefinition(m_definition_url);
+            if (!loaded_definition_res)
+                return false;
 
-        const bool is_loaded_success = g_runtime_global_context.m_asset_manager->loadAsset(m_definition_url, definition_res);
-        if (!is_loaded_success)
-            return false;
+            definition_res = loaded_definition_res.get();
+        }
 
-        for (auto loaded_component : definition_res.m_components)
+        for (const auto& loaded_component : definition_res->m_components)
         {
-            const std::string type_name = loaded_component.getTypeName();
             // don't create component if it has been instanced
-            if (hasComponent(type_name))
+            if (!loaded_component || hasComponent(loaded_component.getTypeName()))
                 continue;
 
-            loaded_component->postLoadResource(weak_from_this());
-
-            m_components.push_back(loaded_component);
+            // the definition is shared, the object owns a copy of its components
+            const std::string                    type_name = loaded_component.getTypeName();
+            Reflection::ReflectionPtr<Component> component(
+                type_name,
+                static_cast<Component*>(
+                    Reflection::TypeMeta::newCopyFromName(type_name, loaded_component.operator->()).m_instance));
+            if (!component)
+            {
+                LOG_ERROR("copying component {} of {} failed", type_name, m_definition_url);
+                continue;
+            }
+            Reflection::ReflectionPtr<Component> added_component = addComponent(component);
+            if (added_component)
+            {
+                added_component->postLoadResource(weak_from_this());
+            }
         }
 
         return true;
     }
 
+    std::shared_ptr<const ObjectDefinitionRes> GObject::loadDefinition(const std::string& definition_url)
+    {
+        std::shared_ptr<AssetManager> asset_manager = g_runtime_global_context.m_asset_manager;
+        ASSERT(asset_manager);
+
+        return asset_manager->getOrCreateSharedAsset<ObjectDefinitionRes>(definition_url, [&] {
+            // the definition owns its components, the objects only get copies of them
+            std::shared_ptr<ObjectDefinitionRes> definition_res(new ObjectDefinitionRes, deleteObjectDefinition);
+            if (!asset_manager->loadAsset(definition_url, *definition_res))
+                return std::shared_ptr<ObjectDefinitionRes>();
+
+            for (auto& component : definition_res->m_components)
+            {
+                if (component)
+                {
+                    component->preloadResource();
+                }
+            }
+            return definition_res;
+        });
+    }
+
     void GObject::save(ObjectInstanceRes& out_object_instance_res)
     {
         out_object_instance_res.m_name       = m_name;
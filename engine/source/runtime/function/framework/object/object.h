@@ -1,12 +1,18 @@
 #pragma once
 
 #include "runtime/function/framework/component/component.h"
+#include "runtime/function/framework/component/component_storage.h"
 #include "runtime/function/framework/object/object_id_allocator.h"
 
 #include "runtime/resource/res_type/common/object.h"
 
+#include "_generated/reflection/all_type_id.h"
+
+#include <array>
+#include <cstdint>
 #include <memory>
 #include <string>
+#include <type_traits>
 #include <unordered_set>
 #include <vector>
 
@@ -18,12 +24,22 @@ namespace Piccolo
         typedef std::unordered_set<std::string> TypeNameSet;
 
     public:
-        GObject(GObjectID id) : m_id {id} {}
+        GObject(GObjectID id, std::shared_ptr<ComponentStorage> component_storage = nullptr) :
+            m_id {id}, m_component_storage {component_storage}
+        {
+            m_component_indices.fill(k_invalid_component_index);
+        }
         virtual ~GObject();
 
         virtual void tick(float delta_time);
 
-        bool load(const ObjectInstanceRes& object_instance_res);
+        // the definition is read from its url when it is not already loaded, its components are copied. the instanced
+        // components are handed over to the object, their entries in object_instance_res are re-pointed to the
+        // components the object owns and stay valid as long as the object lives
+        bool load(ObjectInstanceRes& object_instance_res, const ObjectDefinitionRes* definition_res = nullptr);
+
+        // the definition shared by all the objects instancing it, its components are preloaded once
+        static std::shared_ptr<const ObjectDefinitionRes> loadDefinition(const std::string& definition_url);
         void save(ObjectInstanceRes& out_object_instance_res);
 
         GObjectID getID() const { return m_id; }
@@ -33,39 +49,58 @@ namespace Piccolo
 
         bool hasComponent(const std::string& compenent_type_name) const;
 
-        std::vector<Reflection::ReflectionPtr<Component>> getComponents() { return m_components; }
+        template<typename TComponent>
+        bool hasComponent() const
+        {
+            return getComponentIndex(getComponentTypeId<TComponent>()) != k_invalid_component_index;
+        }
+
+        const std::vector<Reflection::ReflectionPtr<Component>>& getComponents() const { return m_components; }
 
         template<typename TComponent>
-        TComponent* tryGetComponent(const std::string& compenent_type_name)
+        TComponent* tryGetComponent()
         {
-            for (auto& component : m_components)
-            {
-                if (component.getTypeName() == compenent_type_name)
-                {
-                    return static_cast<TComponent*>(component.operator->());
-                }
-            }
-
-            return nullptr;
+            const size_t component_index = getComponentIndex(getComponentTypeId<TComponent>());
+            if (component_index == k_invalid_component_index)
+                return nullptr;
+
+            return static_cast<TComponent*>(m_components[component_index].getPtr());
         }
 
         template<typename TComponent>
-        const TComponent* tryGetComponentConst(const std::string& compenent_type_name) const
+        const TComponent* tryGetComponentConst() const
         {
-            for (const auto& component : m_components)
-            {
-                if (component.getTypeName() == compenent_type_name)
-                {
-                    return static_cast<const TComponent*>(component.operator->());
-                }
-            }
-            return nullptr;
+            const size_t component_index = getComponentIndex(getComponentTypeId<TComponent>());
+            if (component_index == k_invalid_component_index)
+                return nullptr;
+
+            return static_cast<const TComponent*>(m_components[component_index].getPtr());
         }
 
-#define tryGetComponent(COMPONENT_TYPE) tryGetComponent<COMPONENT_TYPE>(#COMPONENT_TYPE)
-#define tryGetComponentConst(COMPONENT_TYPE) tryGetComponentConst<const COMPONENT_TYPE>(#COMPONENT_TYPE)
+#define tryGetComponent(COMPONENT_TYPE) tryGetComponent<COMPONENT_TYPE>()
+#define tryGetComponentConst(COMPONENT_TYPE) tryGetComponentConst<const COMPONENT_TYPE>()
 
     protected:
+        static constexpr uint8_t k_invalid_component_index = 0xff;
+
+        template<typename TComponent>
+        static constexpr Reflection::TypeId getComponentTypeId()
+        {
+            constexpr Reflection::TypeId type_id = Reflection::TypeIdOf<std::remove_const_t<TComponent>>::value;
+            static_assert(type_id < Reflection::k_component_type_count, "not a component type");
+            return type_id;
+        }
+
+        size_t getComponentIndex(Reflection::TypeId component_type_id) const
+        {
+            return component_type_id < m_component_indices.size() ? m_component_indices[component_type_id] :
+                                                                     k_invalid_component_index;
+        }
+
+        // the object takes the component over, the returned pointer replaces the given one, which is deleted when
+        // the component is moved into the pool
+        Reflection::ReflectionPtr<Component> addComponent(Reflection::ReflectionPtr<Component> component);
+
         GObjectID   m_id {k_invalid_gobject_id};
         std::string m_name;
         std::string m_definition_url;
@@ -73,5 +108,14 @@ namespace Piccolo
         // we have to use the ReflectionPtr due to that the components need to be reflected 
         // in editor, and it's polymorphism
         std::vector<Reflection::ReflectionPtr<Component>> m_components;
+        // type id of each component in m_components
+        std::vector<Reflection::TypeId> m_component_type_ids;
+        // index into m_components by component type id, so the typed lookups do not compare type names
+        std::array<uint8_t, Reflection::k_component_type_count> m_component_indices;
+
+        // components of pooled types are ticked by the level's component storage,
+        // the object itself only ticks the remaining ones
+        std::shared_ptr<ComponentStorage> m_component_storage;
+        std::vector<size_t>               m_unpooled_component_indices;
     };
 } // namespace Piccolo
@@ -13,6 +13,12 @@
 
 namespace Piccolo
 {
+    namespace
+    {
+        // logic thread time spent creating the objects of a streamed level per tick, in milliseconds
+        constexpr float k_level_loading_time_budget = 4.f;
+    } // namespace
+
     WorldManager::~WorldManager() { clear(); }
 
     void WorldManager::initialize()
@@ -27,6 +33,11 @@ namespace Piccolo
     void WorldManager::clear()
     {
         // unload all loaded levels
+        if (m_loading_level)
+        {
+            m_loading_level->unload();
+            m_loading_level.reset();
+        }
         for (auto level_pair : m_loaded_levels)
         {
             level_pair.second->unload();
@@ -34,6 +45,10 @@ namespace Piccolo
         m_loaded_levels.clear();
 
         m_current_active_level.reset();
+        if (g_runtime_global_context.m_asset_manager)
+        {
+            g_runtime_global_context.m_asset_manager->releaseUnusedAssets();
+        }
 
         // clear world
         m_current_world_resource.reset();
@@ -51,6 +66,32 @@ namespace Piccolo
             loadWorld(m_current_world_url);
         }
 
+        if (m_loading_level)
+        {
+            m_loading_level->tickLoading(k_level_loading_time_budget);
+            if (m_loading_level->isLoaded())
+            {
+                const AssetCacheStats cache_stats = g_runtime_global_context.m_asset_manager->getAssetCacheStats();
+                LOG_INFO("asset cache: {} assets, {} KB, {} hits, {} misses, {} evictions",
+                         cache_stats.entry_count,
+                         cache_stats.memory_size / 1024,
+                         cache_stats.hit_count,
+                         cache_stats.miss_count,
+                         cache_stats.eviction_count);
+
+                m_loaded_levels.emplace(m_loading_level->getLevelResUrl(), m_loading_level);
+                m_current_active_level = m_loading_level;
+                m_loading_level.reset();
+            }
+            else if (m_loading_level->isLoadFailed())
+            {
+                LOG_ERROR("load level failed {}", m_loading_level->getLevelResUrl());
+                m_loading_level->unload();
+                m_loading_level.reset();
+                m_current_active_level.reset();
+            }
+        }
+
         // tick the active level
         std::shared_ptr<Level> active_level = m_current_active_level.lock();
         if (active_level)
@@ -83,18 +124,13 @@ namespace Piccolo
 
         m_current_world_resource = std::make_shared<WorldRes>(world_res);
 
+        // the default level becomes the active level once it is streamed in
         const bool is_level_load_success = loadLevel(world_res.m_default_level_url);
         if (!is_level_load_success)
         {
             return false;
         }
 
-        // set the default level to be active level
-        auto iter = m_loaded_levels.find(world_res.m_default_level_url);
-        ASSERT(iter != m_loaded_levels.end());
-
-        m_current_active_level = iter->second;
-
         m_is_world_loaded = true;
 
         LOG_INFO("world load succeed!");
@@ -104,7 +140,7 @@ namespace Piccolo
     bool WorldManager::loadLevel(const std::string& level_url)
     {
         std::shared_ptr<Level> level = std::make_shared<Level>();
-        // set current level temporary
+        // set current level temporary, the components look their level up while they are loaded
         m_current_active_level       = level;
 
         const bool is_level_load_success = level->load(level_url);
@@ -113,13 +149,19 @@ namespace Piccolo
             return false;
         }
 
-        m_loaded_levels.emplace(level_url, level);
+        m_loading_level = level;
 
         return true;
     }
 
     void WorldManager::reloadCurrentLevel()
     {
+        if (m_loading_level)
+        {
+            LOG_WARN("level {} is still loading", m_loading_level->getLevelResUrl());
+            return;
+        }
+
         auto active_level = m_current_active_level.lock();
         if (active_level == nullptr)
         {
@@ -130,6 +172,8 @@ namespace Piccolo
         const std::string level_url = active_level->getLevelResUrl();
         active_level->unload();
         m_loaded_levels.erase(level_url);
+        // the level reads its files again, they may have been edited
+        g_runtime_global_context.m_asset_manager->releaseUnusedAssets();
 
         const bool is_load_success = loadLevel(level_url);
         if (!is_load_success)
@@ -138,13 +182,7 @@ namespace Piccolo
             return;
         }
 
-        // update the active level instance
-        auto iter = m_loaded_levels.find(level_url);
-        ASSERT(iter != m_loaded_levels.end());
-
-        m_current_active_level = iter->second;
-
-        LOG_INFO("reload current evel succeed");
+        LOG_INFO("reloading current level {}", level_url);
     }
 
     void WorldManager::saveCurrentLevel()
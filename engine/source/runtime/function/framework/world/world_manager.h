@@ -21,6 +21,7 @@ namespace Piccolo
         void initialize();
         void clear();
 
+        // the level is streamed back in, the tick goes on meanwhile
         void reloadCurrentLevel();
         void saveCurrentLevel();
 
@@ -33,6 +34,9 @@ namespace Piccolo
         bool loadWorld(const std::string& world_url);
         bool loadLevel(const std::string& level_url);
 
+        // the level being streamed in, it becomes active once all its objects are created
+        std::shared_ptr<Level> m_loading_level;
+
         bool                      m_is_world_loaded {false};
         std::string               m_current_world_url;
         std::shared_ptr<WorldRes> m_current_world_resource;
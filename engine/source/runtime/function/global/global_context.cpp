@@ -1,5 +1,6 @@
 #include "runtime/function/global/global_context.h"
 
+#include "core/job/job_system.h"
 #include "core/log/log_system.h"
 
 #include "runtime/engine.h"
@@ -32,6 +33,9 @@ namespace Piccolo
 
         m_logger_system = std::make_shared<LogSystem>();
 
+        m_job_system = std::make_shared<JobSystem>();
+        m_job_system->initialize(m_config_manager->getJobWorkerCount());
+
         m_asset_manager = std::make_shared<AssetManager>();
 
         m_physics_manager = std::make_shared<PhysicsManager>();
@@ -83,6 +87,9 @@ namespace Piccolo
 
         m_asset_manager.reset();
 
+        m_job_system->clear();
+        m_job_system.reset();
+
         m_logger_system.reset();
 
         m_file_system.reset();
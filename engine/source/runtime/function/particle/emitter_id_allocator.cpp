@@ -8,9 +8,9 @@ namespace Piccolo
 
     ParticleEmitterID ParticleEmitterIDAllocator::alloc()
     {
-        std::atomic<ParticleEmitterID> new_emitter_ret = m_next_id.load();
-        m_next_id++;
-        if (m_next_id >= k_invalid_particke_emmiter_id)
+        // the emitters of concurrently loaded objects take their ids at the same time
+        ParticleEmitterID new_emitter_ret = m_next_id.fetch_add(1);
+        if (new_emitter_ret + 1 >= k_invalid_particke_emmiter_id)
         {
             LOG_FATAL("particle emitter id overflow");
         }
@@ -55,12 +55,17 @@ namespace Piccolo
                                                 ParticleEmitterTransformDesc& transform_desc)
     {
         RenderSwapContext& swap_context = g_runtime_global_context.m_render_system->getSwapContext();
-        RenderSwapData&    swap_data    = swap_context.getLogicSwapData();
+
+        transform_desc.m_id = ParticleEmitterIDAllocator::alloc();
 
         ParticleEmitterDesc desc(particle_res, transform_desc);
-        swap_data.addNewParticleEmitter(desc);
+        swap_context.getLogicCommands().addNewParticleEmitter(transform_desc.m_id, desc);
+    }
 
-        transform_desc.m_id = ParticleEmitterIDAllocator::alloc();
+    void ParticleManager::resetParticleEmitters()
+    {
+        ParticleEmitterIDAllocator::reset();
+        g_runtime_global_context.m_render_system->getSwapContext().getLogicCommands().resetParticleEmitters();
     }
 
     const GlobalParticleRes& ParticleManager::getGlobalParticleRes() { return m_global_particle_res; }
@@ -30,6 +30,9 @@ namespace Piccolo
         void createParticleEmitter(const ParticleComponentRes&   particle_res,
                                    ParticleEmitterTransformDesc& transform_desc);
 
+        // before the emitters of a level are created, the ids start over and the render drops the previous ones
+        void resetParticleEmitters();
+
     private:
         GlobalParticleRes m_global_particle_res;
     };
@@ -27,6 +27,8 @@ namespace Piccolo
         virtual void prepareContext() = 0;
 
         virtual bool isPointLightShadowEnabled() = 0;
+        // whether the cooked BCn textures can be sampled, the source images are loaded otherwise
+        virtual bool isTextureCompressionBCSupported() = 0;
         // allocate and create
         virtual bool allocateCommandBuffers(const RHICommandBufferAllocateInfo* pAllocateInfo, RHICommandBuffer* &pCommandBuffers) = 0;
         virtual bool allocateDescriptorSets(const RHIDescriptorSetAllocateInfo* pAllocateInfo, RHIDescriptorSet* &pDescriptorSets) = 0;
@@ -58,8 +60,10 @@ namespace Piccolo
             RHIImage* &image, RHIDeviceMemory* &memory, RHIImageCreateFlags image_create_flags, uint32_t array_layers, uint32_t miplevels) = 0;
         virtual void createImageView(RHIImage* image, RHIFormat format, RHIImageAspectFlags image_aspect_flags, RHIImageViewType view_type, uint32_t layout_count, uint32_t miplevels,
             RHIImageView* &image_view) = 0;
-        virtual void createGlobalImage(RHIImage* &image, RHIImageView* &image_view, VmaAllocation& image_allocation, uint32_t texture_image_width, uint32_t texture_image_height, void* texture_image_pixels, RHIFormat texture_image_format, uint32_t miplevels = 0) = 0;
-        virtual void createCubeMap(RHIImage* &image, RHIImageView* &image_view, VmaAllocation& image_allocation, uint32_t texture_image_width, uint32_t texture_image_height, std::array<void*, 6> texture_image_pixels, RHIFormat texture_image_format, uint32_t miplevels) = 0;
+        // pixel_miplevels levels are stored one after the other in the pixels. with more than one, or in a block compressed format, they are uploaded as they are
+        // and the image has just these levels, otherwise the miplevels are generated from the first one
+        virtual void createGlobalImage(RHIImage* &image, RHIImageView* &image_view, VmaAllocation& image_allocation, uint32_t texture_image_width, uint32_t texture_image_height, void* texture_image_pixels, RHIFormat texture_image_format, uint32_t miplevels = 0, uint32_t pixel_miplevels = 1) = 0;
+        virtual void createCubeMap(RHIImage* &image, RHIImageView* &image_view, VmaAllocation& image_allocation, uint32_t texture_image_width, uint32_t texture_image_height, std::array<void*, 6> texture_image_pixels, RHIFormat texture_image_format, uint32_t miplevels, uint32_t pixel_miplevels = 1) = 0;
         virtual void createCommandPool() = 0;
         virtual bool createCommandPool(const RHICommandPoolCreateInfo* pCreateInfo, RHICommandPool*& pCommandPool) = 0;
         virtual bool createDescriptorPool(const RHIDescriptorPoolCreateInfo* pCreateInfo, RHIDescriptorPool* &pDescriptorPool) = 0;
@@ -116,6 +120,8 @@ namespace Piccolo
         virtual void updateDescriptorSets(uint32_t descriptorWriteCount, const RHIWriteDescriptorSet* pDescriptorWrites, uint32_t descriptorCopyCount, const RHICopyDescriptorSet* pDescriptorCopies) = 0;
         virtual bool queueSubmit(RHIQueue* queue, uint32_t submitCount, const RHISubmitInfo* pSubmits, RHIFence* fence) = 0;
         virtual bool queueWaitIdle(RHIQueue* queue) = 0;
+        // true once the fence is signaled, without waiting
+        virtual bool getFenceStatus(RHIFence* fence) = 0;
         virtual void resetCommandPool() = 0;
         virtual void waitForFences() = 0;
 
@@ -129,6 +135,8 @@ namespace Piccolo
         virtual QueueFamilyIndices getQueueFamilyIndices() const = 0;
         virtual RHIQueue* getGraphicsQueue() const = 0;
         virtual RHIQueue* getComputeQueue() const = 0;
+        // a queue of the dedicated transfer family when there is one, the graphics queue otherwise
+        virtual RHIQueue* getTransferQueue() const = 0;
         virtual RHISwapChainDesc getSwapchainInfo() = 0;
         virtual RHIDepthImageDesc getDepthImageInfo() const = 0;
         virtual uint8_t getMaxFramesInFlight() const = 0;
@@ -138,6 +146,8 @@ namespace Piccolo
         // command write
         virtual RHICommandBuffer* beginSingleTimeCommands() = 0;
         virtual void            endSingleTimeCommands(RHICommandBuffer* command_buffer) = 0;
+        // the next submitRendering waits for the semaphore before the stages
+        virtual void addRenderingWaitSemaphore(RHISemaphore* semaphore, RHIPipelineStageFlags wait_stage_mask) = 0;
         virtual bool prepareBeforePass(std::function<void()> passUpdateAfterRecreateSwapchain) = 0;
         virtual void submitRendering(std::function<void()> passUpdateAfterRecreateSwapchain) = 0;
         virtual void pushEvent(RHICommandBuffer* commond_buffer, const char* name, const float* color) = 0;
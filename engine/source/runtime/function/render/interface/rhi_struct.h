@@ -1121,6 +1121,8 @@ namespace Piccolo
         std::optional<uint32_t> graphics_family;
         std::optional<uint32_t> present_family;
         std::optional<uint32_t> m_compute_family;
+        // the graphics family when the device has no family only for transfers
+        std::optional<uint32_t> m_transfer_family;
 
         bool isComplete() { return graphics_family.has_value() && present_family.has_value() && m_compute_family.has_value();; }
     };
@@ -453,13 +453,21 @@ namespace Piccolo
         VkSemaphore semaphores[2] = { ((VulkanSemaphore*)m_image_available_for_texturescopy_semaphores[m_current_frame_index])->getResource(),
                                      m_image_finished_for_presentation_semaphores[m_current_frame_index] };
 
+        // the swapchain image, then the uploads the frame draws with
+        std::vector<VkSemaphore> wait_semaphores = {m_image_available_for_render_semaphores[m_current_frame_index]};
+        std::vector<VkPipelineStageFlags> wait_stages = {VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT};
+        wait_semaphores.insert(
+            wait_semaphores.end(), m_rendering_wait_semaphores.begin(), m_rendering_wait_semaphores.end());
+        wait_stages.insert(wait_stages.end(), m_rendering_wait_stages.begin(), m_rendering_wait_stages.end());
+        m_rendering_wait_semaphores.clear();
+        m_rendering_wait_stages.clear();
+
         // submit command buffer
-        VkPipelineStageFlags wait_stages[] = {VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT};
         VkSubmitInfo         submit_info   = {};
         submit_info.sType                  = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-        submit_info.waitSemaphoreCount     = 1;
-        submit_info.pWaitSemaphores        = &m_image_available_for_render_semaphores[m_current_frame_index];
-        submit_info.pWaitDstStageMask      = wait_stages;
+        submit_info.waitSemaphoreCount     = static_cast<uint32_t>(wait_semaphores.size());
+        submit_info.pWaitSemaphores        = wait_semaphores.data();
+        submit_info.pWaitDstStageMask      = wait_stages.data();
         submit_info.commandBufferCount     = 1;
         submit_info.pCommandBuffers        = &m_vk_command_buffers[m_current_frame_index];
         submit_info.signalSemaphoreCount = 2;
@@ -547,6 +555,12 @@ namespace Piccolo
         delete(command_buffer);
     }
 
+    void VulkanRHI::addRenderingWaitSemaphore(RHISemaphore* semaphore, RHIPipelineStageFlags wait_stage_mask)
+    {
+        m_rendering_wait_semaphores.push_back(((VulkanSemaphore*)semaphore)->getResource());
+        m_rendering_wait_stages.push_back((VkPipelineStageFlags)wait_stage_mask);
+    }
+
     // validation layers
     bool VulkanRHI::checkValidationLayerSupport()
     {
@@ -755,7 +769,7 @@ namespace Piccolo
     }
 
     // logical device (m_vulkan_context._device : graphic queue, present queue,
-    // feature:samplerAnisotropy)
+    // feature:samplerAnisotropy, textureCompressionBC when supported)
     void VulkanRHI::createLogicalDevice()
     {
         m_queue_indices = findQueueFamilies(m_physical_device);
@@ -763,7 +777,8 @@ namespace Piccolo
         std::vector<VkDeviceQueueCreateInfo> queue_create_infos; // all queues that need to be created
         std::set<uint32_t>                   queue_families = {m_queue_indices.graphics_family.value(),
                                              m_queue_indices.present_family.value(),
-                                             m_queue_indices.m_compute_family.value()};
+                                             m_queue_indices.m_compute_family.value(),
+                                             m_queue_indices.m_transfer_family.value()};
 
         float queue_priority = 1.0f;
         for (uint32_t queue_family : queue_families) // for every queue family
@@ -782,6 +797,12 @@ namespace Piccolo
 
         physical_device_features.samplerAnisotropy = VK_TRUE;
 
+        // the cooked textures are block compressed, they are only used when the device can sample them
+        VkPhysicalDeviceFeatures supported_features;
+        vkGetPhysicalDeviceFeatures(m_physical_device, &supported_features);
+        m_is_texture_compression_bc_supported         = supported_features.textureCompressionBC == VK_TRUE;
+        physical_device_features.textureCompressionBC = supported_features.textureCompressionBC;
+
         // support inefficient readback storage buffer
         physical_device_features.fragmentStoresAndAtomics = VK_TRUE;
 
@@ -822,6 +843,11 @@ namespace Piccolo
         m_compute_queue = new VulkanQueue();
         ((VulkanQueue*)m_compute_queue)->setResource(vk_compute_queue);
 
+        VkQueue vk_transfer_queue;
+        vkGetDeviceQueue(m_device, m_queue_indices.m_transfer_family.value(), 0, &vk_transfer_queue);
+        m_transfer_queue = new VulkanQueue();
+        ((VulkanQueue*)m_transfer_queue)->setResource(vk_transfer_queue);
+
         // more efficient pointer
         _vkResetCommandPool      = (PFN_vkResetCommandPool)vkGetDeviceProcAddr(m_device, "vkResetCommandPool");
         _vkBeginCommandBuffer    = (PFN_vkBeginCommandBuffer)vkGetDeviceProcAddr(m_device, "vkBeginCommandBuffer");
@@ -2408,6 +2434,16 @@ namespace Piccolo
         }
     }
 
+    bool VulkanRHI::getFenceStatus(RHIFence* fence)
+    {
+        VkResult result = vkGetFenceStatus(m_device, ((VulkanFence*)fence)->getResource());
+        if (VK_SUCCESS != result && VK_NOT_READY != result)
+        {
+            LOG_ERROR("vkGetFenceStatus failed!");
+        }
+        return VK_SUCCESS == result;
+    }
+
     void VulkanRHI::cmdPipelineBarrier(RHICommandBuffer* commandBuffer,
         RHIPipelineStageFlags srcStageMask,
         RHIPipelineStageFlags dstStageMask,
@@ -2586,16 +2622,19 @@ namespace Piccolo
 
     void VulkanRHI::cmdCopyBuffer(RHICommandBuffer* commandBuffer, RHIBuffer* srcBuffer, RHIBuffer* dstBuffer, uint32_t regionCount, RHIBufferCopy* pRegions)
     {
-        VkBufferCopy copyRegion{};
-        copyRegion.srcOffset = pRegions->srcOffset;
-        copyRegion.dstOffset = pRegions->dstOffset;
-        copyRegion.size = pRegions->size;
+        std::vector<VkBufferCopy> vk_buffer_copy_list(regionCount);
+        for (uint32_t i = 0; i < regionCount; ++i)
+        {
+            vk_buffer_copy_list[i].srcOffset = pRegions[i].srcOffset;
+            vk_buffer_copy_list[i].dstOffset = pRegions[i].dstOffset;
+            vk_buffer_copy_list[i].size      = pRegions[i].size;
+        }
 
         vkCmdCopyBuffer(((VulkanCommandBuffer*)commandBuffer)->getResource(),
             ((VulkanBuffer*)srcBuffer)->getResource(),
             ((VulkanBuffer*)dstBuffer)->getResource(),
             regionCount,
-            &copyRegion);
+            vk_buffer_copy_list.data());
     }
 
     void VulkanRHI::createCommandBuffers()
@@ -2917,12 +2956,12 @@ namespace Piccolo
         ((VulkanImageView*)image_view)->setResource(vk_image_view);
     }
 
-    void VulkanRHI::createGlobalImage(RHIImage* &image, RHIImageView* &image_view, VmaAllocation& image_allocation, uint32_t texture_image_width, uint32_t texture_image_height, void* texture_image_pixels, RHIFormat texture_image_format, uint32_t miplevels)
+    void VulkanRHI::createGlobalImage(RHIImage* &image, RHIImageView* &image_view, VmaAllocation& image_allocation, uint32_t texture_image_width, uint32_t texture_image_height, void* texture_image_pixels, RHIFormat texture_image_format, uint32_t miplevels, uint32_t pixel_miplevels)
     {
         VkImage vk_image;
         VkImageView vk_image_view;
         
-        VulkanUtil::createGlobalImage(this, vk_image, vk_image_view,image_allocation,texture_image_width,texture_image_height,texture_image_pixels,texture_image_format,miplevels);
+        VulkanUtil::createGlobalImage(this, vk_image, vk_image_view,image_allocation,texture_image_width,texture_image_height,texture_image_pixels,texture_image_format,miplevels,pixel_miplevels);
         
         image = new VulkanImage();
         image_view = new VulkanImageView();
@@ -2930,12 +2969,12 @@ namespace Piccolo
         ((VulkanImageView*)image_view)->setResource(vk_image_view);
     }
 
-    void VulkanRHI::createCubeMap(RHIImage* &image, RHIImageView* &image_view, VmaAllocation& image_allocation, uint32_t texture_image_width, uint32_t texture_image_height, std::array<void*, 6> texture_image_pixels, RHIFormat texture_image_format, uint32_t miplevels)
+    void VulkanRHI::createCubeMap(RHIImage* &image, RHIImageView* &image_view, VmaAllocation& image_allocation, uint32_t texture_image_width, uint32_t texture_image_height, std::array<void*, 6> texture_image_pixels, RHIFormat texture_image_format, uint32_t miplevels, uint32_t pixel_miplevels)
     {
         VkImage vk_image;
         VkImageView vk_image_view;
 
-        VulkanUtil::createCubeMap(this, vk_image, vk_image_view, image_allocation, texture_image_width, texture_image_height, texture_image_pixels, texture_image_format, miplevels);
+        VulkanUtil::createCubeMap(this, vk_image, vk_image_view, image_allocation, texture_image_width, texture_image_height, texture_image_pixels, texture_image_format, miplevels, pixel_miplevels);
 
         image = new VulkanImage();
         image_view = new VulkanImageView();
@@ -3030,7 +3069,7 @@ namespace Piccolo
         command_buffer_allocate_info.commandBufferCount = pAllocateInfo->commandBufferCount;
 
         VkCommandBuffer vk_command_buffer;
-        pCommandBuffers = new RHICommandBuffer();
+        pCommandBuffers = new VulkanCommandBuffer();
         VkResult result = vkAllocateCommandBuffers(m_device, &command_buffer_allocate_info, &vk_command_buffer);
         ((VulkanCommandBuffer*)pCommandBuffers)->setResource(vk_command_buffer);
 
@@ -3366,6 +3405,21 @@ namespace Piccolo
             }
             i++;
         }
+
+        // a family only for transfers is the copy engine of the gpu, the uploads run on the graphics queue without it
+        for (uint32_t family_index = 0; family_index < queue_family_count; ++family_index)
+        {
+            VkQueueFlags queue_flags = queue_families[family_index].queueFlags;
+            if ((queue_flags & VK_QUEUE_TRANSFER_BIT) && !(queue_flags & (VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT)))
+            {
+                indices.m_transfer_family = family_index;
+                break;
+            }
+        }
+        if (!indices.m_transfer_family.has_value())
+        {
+            indices.m_transfer_family = indices.graphics_family;
+        }
         return indices;
     }
 
@@ -3544,6 +3598,8 @@ namespace Piccolo
     }
     bool VulkanRHI::isPointLightShadowEnabled(){ return m_enable_point_light_shadow; }
 
+    bool VulkanRHI::isTextureCompressionBCSupported() { return m_is_texture_compression_bc_supported; }
+
     RHICommandBuffer* VulkanRHI::getCurrentCommandBuffer() const
     {
         return m_current_command_buffer;
@@ -3576,6 +3632,10 @@ namespace Piccolo
     {
         return m_compute_queue;
     }
+    RHIQueue* VulkanRHI::getTransferQueue() const
+    {
+        return m_transfer_queue;
+    }
     RHISwapChainDesc VulkanRHI::getSwapchainInfo()
     {
         RHISwapChainDesc desc;
@@ -52,8 +52,8 @@ namespace Piccolo
             RHIImage* &image, RHIDeviceMemory* &memory, RHIImageCreateFlags image_create_flags, uint32_t array_layers, uint32_t miplevels) override;
         void createImageView(RHIImage* image, RHIFormat format, RHIImageAspectFlags image_aspect_flags, RHIImageViewType view_type, uint32_t layout_count, uint32_t miplevels,
             RHIImageView* &image_view) override;
-        void createGlobalImage(RHIImage* &image, RHIImageView* &image_view, VmaAllocation& image_allocation, uint32_t texture_image_width, uint32_t texture_image_height, void* texture_image_pixels, RHIFormat texture_image_format, uint32_t miplevels = 0) override;
-        void createCubeMap(RHIImage* &image, RHIImageView* &image_view, VmaAllocation& image_allocation, uint32_t texture_image_width, uint32_t texture_image_height, std::array<void*, 6> texture_image_pixels, RHIFormat texture_image_format, uint32_t miplevels) override;
+        void createGlobalImage(RHIImage* &image, RHIImageView* &image_view, VmaAllocation& image_allocation, uint32_t texture_image_width, uint32_t texture_image_height, void* texture_image_pixels, RHIFormat texture_image_format, uint32_t miplevels = 0, uint32_t pixel_miplevels = 1) override;
+        void createCubeMap(RHIImage* &image, RHIImageView* &image_view, VmaAllocation& image_allocation, uint32_t texture_image_width, uint32_t texture_image_height, std::array<void*, 6> texture_image_pixels, RHIFormat texture_image_format, uint32_t miplevels, uint32_t pixel_miplevels = 1) override;
         bool createCommandPool(const RHICommandPoolCreateInfo* pCreateInfo, RHICommandPool* &pCommandPool) override;
         bool createDescriptorPool(const RHIDescriptorPoolCreateInfo* pCreateInfo, RHIDescriptorPool* &pDescriptorPool) override;
         bool createDescriptorSetLayout(const RHIDescriptorSetLayoutCreateInfo* pCreateInfo, RHIDescriptorSetLayout* &pSetLayout) override;
@@ -109,6 +109,7 @@ namespace Piccolo
         void updateDescriptorSets(uint32_t descriptorWriteCount, const RHIWriteDescriptorSet* pDescriptorWrites, uint32_t descriptorCopyCount, const RHICopyDescriptorSet* pDescriptorCopies) override;
         bool queueSubmit(RHIQueue* queue, uint32_t submitCount, const RHISubmitInfo* pSubmits, RHIFence* fence) override;
         bool queueWaitIdle(RHIQueue* queue) override;
+        bool getFenceStatus(RHIFence* fence) override;
         void resetCommandPool() override;
         void waitForFences() override;
         bool waitForFences(uint32_t fenceCount, const RHIFence* const* pFences, RHIBool32 waitAll, uint64_t timeout);
@@ -123,6 +124,7 @@ namespace Piccolo
         QueueFamilyIndices getQueueFamilyIndices() const override;
         RHIQueue* getGraphicsQueue() const override;
         RHIQueue* getComputeQueue() const override;
+        RHIQueue* getTransferQueue() const override;
         RHISwapChainDesc getSwapchainInfo() override;
         RHIDepthImageDesc getDepthImageInfo() const override;
         uint8_t getMaxFramesInFlight() const override;
@@ -132,6 +134,7 @@ namespace Piccolo
         // command write
         RHICommandBuffer* beginSingleTimeCommands() override;
         void            endSingleTimeCommands(RHICommandBuffer* command_buffer) override;
+        void addRenderingWaitSemaphore(RHISemaphore* semaphore, RHIPipelineStageFlags wait_stage_mask) override;
         bool prepareBeforePass(std::function<void()> passUpdateAfterRecreateSwapchain) override;
         void submitRendering(std::function<void()> passUpdateAfterRecreateSwapchain) override;
         void pushEvent(RHICommandBuffer* commond_buffer, const char* name, const float* color) override;
@@ -171,6 +174,7 @@ namespace Piccolo
         
         RHIQueue* m_graphics_queue{ nullptr };
         RHIQueue* m_compute_queue{ nullptr };
+        RHIQueue* m_transfer_queue{ nullptr };
 
         RHIFormat m_swapchain_image_format{ RHI_FORMAT_UNDEFINED };
         std::vector<RHIImageView*> m_swapchain_imageviews;
@@ -242,6 +246,10 @@ namespace Piccolo
         RHISemaphore*        m_image_available_for_texturescopy_semaphores[k_max_frames_in_flight];
         VkFence              m_is_frame_in_flight_fences[k_max_frames_in_flight];
 
+        // waited for by the next rendering submit
+        std::vector<VkSemaphore>          m_rendering_wait_semaphores;
+        std::vector<VkPipelineStageFlags> m_rendering_wait_stages;
+
         // TODO: set
         VkCommandBuffer   m_vk_current_command_buffer;
 
@@ -272,11 +280,13 @@ namespace Piccolo
 
     public:
         bool isPointLightShadowEnabled() override;
+        bool isTextureCompressionBCSupported() override;
 
     private:
         bool m_enable_validation_Layers{ true };
         bool m_enable_debug_utils_label{ true };
         bool m_enable_point_light_shadow{ true };
+        bool m_is_texture_compression_bc_supported{ false };
 
         // used in descriptor pool creation
         uint32_t m_max_vertex_blending_mesh_count{ 256 };
@@ -1,5 +1,6 @@
 #include "runtime/function/render/interface/vulkan/vulkan_util.h"
 #include "runtime/function/render/interface/vulkan/vulkan_rhi.h"
+#include "runtime/function/render/texture_compressor.h"
 #include "runtime/core/base/macro.h"
 
 #include <algorithm>
@@ -9,6 +10,45 @@
 
 namespace Piccolo
 {
+    namespace
+    {
+        // the formats the textures are loaded in, VK_FORMAT_UNDEFINED for the others
+        VkFormat getTextureImageFormat(RHIFormat format)
+        {
+            switch (format)
+            {
+                case RHIFormat::RHI_FORMAT_R8G8B8_UNORM:
+                    return VK_FORMAT_R8G8B8_UNORM;
+                case RHIFormat::RHI_FORMAT_R8G8B8_SRGB:
+                    return VK_FORMAT_R8G8B8_SRGB;
+                case RHIFormat::RHI_FORMAT_R8G8B8A8_UNORM:
+                    return VK_FORMAT_R8G8B8A8_UNORM;
+                case RHIFormat::RHI_FORMAT_R8G8B8A8_SRGB:
+                    return VK_FORMAT_R8G8B8A8_SRGB;
+                case RHIFormat::RHI_FORMAT_R32_SFLOAT:
+                    return VK_FORMAT_R32_SFLOAT;
+                case RHIFormat::RHI_FORMAT_R32G32_SFLOAT:
+                    return VK_FORMAT_R32G32_SFLOAT;
+                case RHIFormat::RHI_FORMAT_R32G32B32_SFLOAT:
+                    return VK_FORMAT_R32G32B32_SFLOAT;
+                case RHIFormat::RHI_FORMAT_R32G32B32A32_SFLOAT:
+                    return VK_FORMAT_R32G32B32A32_SFLOAT;
+                case RHIFormat::RHI_FORMAT_BC1_RGB_UNORM_BLOCK:
+                    return VK_FORMAT_BC1_RGB_UNORM_BLOCK;
+                case RHIFormat::RHI_FORMAT_BC1_RGB_SRGB_BLOCK:
+                    return VK_FORMAT_BC1_RGB_SRGB_BLOCK;
+                case RHIFormat::RHI_FORMAT_BC3_UNORM_BLOCK:
+                    return VK_FORMAT_BC3_UNORM_BLOCK;
+                case RHIFormat::RHI_FORMAT_BC3_SRGB_BLOCK:
+                    return VK_FORMAT_BC3_SRGB_BLOCK;
+                case RHIFormat::RHI_FORMAT_BC6H_UFLOAT_BLOCK:
+                    return VK_FORMAT_BC6H_UFLOAT_BLOCK;
+                default:
+                    return VK_FORMAT_UNDEFINED;
+            }
+        }
+    } // namespace
+
     std::unordered_map<uint32_t, VkSampler> VulkanUtil::m_mipmap_sampler_map;
     VkSampler                               VulkanUtil::m_nearest_sampler = VK_NULL_HANDLE;
     VkSampler                               VulkanUtil::m_linear_sampler  = VK_NULL_HANDLE;
@@ -274,54 +314,30 @@ namespace Piccolo
                                        uint32_t           texture_image_height,
                                        void*              texture_image_pixels,
                                        RHIFormat texture_image_format,
-                                       uint32_t           miplevels)
+                                       uint32_t           miplevels,
+                                       uint32_t           pixel_miplevels)
     {
         if (!texture_image_pixels)
         {
             return;
         }
 
-        VkDeviceSize texture_byte_size;
-        VkFormat     vulkan_image_format;
-        switch (texture_image_format)
+        const VkFormat vulkan_image_format = getTextureImageFormat(texture_image_format);
+        if (vulkan_image_format == VK_FORMAT_UNDEFINED)
         {
-            case RHIFormat::RHI_FORMAT_R8G8B8_UNORM:
-                texture_byte_size   = texture_image_width * texture_image_height * 3;
-                vulkan_image_format = VK_FORMAT_R8G8B8_UNORM;
-                break;
-            case RHIFormat::RHI_FORMAT_R8G8B8_SRGB:
-                texture_byte_size   = texture_image_width * texture_image_height * 3;
-                vulkan_image_format = VK_FORMAT_R8G8B8_SRGB;
-                break;
-            case RHIFormat::RHI_FORMAT_R8G8B8A8_UNORM:
-                texture_byte_size   = texture_image_width * texture_image_height * 4;
-                vulkan_image_format = VK_FORMAT_R8G8B8A8_UNORM;
-                break;
-            case RHIFormat::RHI_FORMAT_R8G8B8A8_SRGB:
-                texture_byte_size   = texture_image_width * texture_image_height * 4;
-                vulkan_image_format = VK_FORMAT_R8G8B8A8_SRGB;
-                break;
-            case RHIFormat::RHI_FORMAT_R32_SFLOAT:
-                texture_byte_size = texture_image_width * texture_image_height * 4;
-                vulkan_image_format = VK_FORMAT_R32_SFLOAT;
-                break;
-            case RHIFormat::RHI_FORMAT_R32G32_SFLOAT:
-                texture_byte_size   = texture_image_width * texture_image_height * 4 * 2;
-                vulkan_image_format = VK_FORMAT_R32G32_SFLOAT;
-                break;
-            case RHIFormat::RHI_FORMAT_R32G32B32_SFLOAT:
-                texture_byte_size   = texture_image_width * texture_image_height * 4 * 3;
-                vulkan_image_format = VK_FORMAT_R32G32B32_SFLOAT;
-                break;
-            case RHIFormat::RHI_FORMAT_R32G32B32A32_SFLOAT:
-                texture_byte_size   = texture_image_width * texture_image_height * 4 * 4;
-                vulkan_image_format = VK_FORMAT_R32G32B32A32_SFLOAT;
-                break;
-            default:
-                LOG_ERROR("invalid texture_byte_size");
-                break;
+            LOG_ERROR("invalid texture_image_format");
+            return;
         }
 
+        // a cooked mip chain is uploaded as it is, the block compressed levels cannot be blitted anyway
+        const bool is_mip_chain_uploaded =
+            pixel_miplevels > 1 || TextureCompressor::isBlockCompressed(texture_image_format);
+        const VkDeviceSize texture_byte_size =
+            TextureCompressor::getMipChainSize(texture_image_format,
+                                               texture_image_width,
+                                               texture_image_height,
+                                               is_mip_chain_uploaded ? pixel_miplevels : 1);
+
         // use staging buffer
         VkBuffer       inefficient_staging_buffer;
         VkDeviceMemory inefficient_staging_buffer_memory;
@@ -342,6 +358,10 @@ namespace Piccolo
         // generate mipmapped image
         uint32_t mip_levels =
             (miplevels != 0) ? miplevels : floor(log2(std::max(texture_image_width, texture_image_height))) + 1;
+        if (is_mip_chain_uploaded)
+        {
+            mip_levels = pixel_miplevels;
+        }
 
         // use the vmaAllocator to allocate asset texture image
         VkImageCreateInfo image_create_info {};
@@ -371,30 +391,61 @@ namespace Piccolo
                        &image_allocation,
                        NULL);
 
-        // layout transitions -- image layout is set from none to destination
-        transitionImageLayout(rhi,
-                              image,
-                              VK_IMAGE_LAYOUT_UNDEFINED,
-                              VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-                              1,
-                              1,
-                              VK_IMAGE_ASPECT_COLOR_BIT);
-        // copy from staging buffer as destination
-        copyBufferToImage(rhi, inefficient_staging_buffer, image, texture_image_width, texture_image_height, 1);
-        // layout transitions -- image layout is set from destination to shader_read
-        transitionImageLayout(rhi,
-                              image,
-                              VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-                              VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
-                              1,
-                              1,
-                              VK_IMAGE_ASPECT_COLOR_BIT);
-
-        vkDestroyBuffer(static_cast<VulkanRHI*>(rhi)->m_device, inefficient_staging_buffer, nullptr);
-        vkFreeMemory(static_cast<VulkanRHI*>(rhi)->m_device, inefficient_staging_buffer_memory, nullptr);
-
-        // generate mipmapped image
-        genMipmappedImage(rhi, image, texture_image_width, texture_image_height, mip_levels);
+        if (is_mip_chain_uploaded)
+        {
+            transitionImageLayout(rhi,
+                                  image,
+                                  VK_IMAGE_LAYOUT_UNDEFINED,
+                                  VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                                  1,
+                                  mip_levels,
+                                  VK_IMAGE_ASPECT_COLOR_BIT);
+            copyBufferToImageMipLevels(rhi,
+                                       inefficient_staging_buffer,
+                                       image,
+                                       texture_image_format,
+                                       texture_image_width,
+                                       texture_image_height,
+                                       1,
+                                       mip_levels);
+            transitionImageLayout(rhi,
+                                  image,
+                                  VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                                  VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                                  1,
+                                  mip_levels,
+                                  VK_IMAGE_ASPECT_COLOR_BIT);
+
+            vkDestroyBuffer(static_cast<VulkanRHI*>(rhi)->m_device, inefficient_staging_buffer, nullptr);
+            vkFreeMemory(static_cast<VulkanRHI*>(rhi)->m_device, inefficient_staging_buffer_memory, nullptr);
+        }
+        else
+        {
+            // layout transitions -- image layout is set from none to destination
+            transitionImageLayout(rhi,
+                                  image,
+                                  VK_IMAGE_LAYOUT_UNDEFINED,
+                                  VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                                  1,
+                                  1,
+                                  VK_IMAGE_ASPECT_COLOR_BIT);
+            // copy from staging buffer as destination
+            copyBufferToImage(rhi, inefficient_staging_buffer, image, texture_image_width, texture_image_height, 1);
+            // layout transitions -- image layout is set from destination to shader_read
+            transitionImageLayout(rhi,
+                                  image,
+                                  VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                                  VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                                  1,
+                                  1,
+                                  VK_IMAGE_ASPECT_COLOR_BIT);
+
+            vkDestroyBuffer(static_cast<VulkanRHI*>(rhi)->m_device, inefficient_staging_buffer, nullptr);
+            vkFreeMemory(static_cast<VulkanRHI*>(rhi)->m_device, inefficient_staging_buffer_memory, nullptr);
+
+            // generate mipmapped image
+            genMipmappedImage(rhi, image, texture_image_width, texture_image_height, mip_levels);
+        }
 
         image_view = createImageView(static_cast<VulkanRHI*>(rhi)->m_device,
                                      image,
@@ -413,49 +464,29 @@ namespace Piccolo
                                    uint32_t             texture_image_height,
                                    std::array<void*, 6> texture_image_pixels,
                                    RHIFormat   texture_image_format,
-                                   uint32_t             miplevels)
+                                   uint32_t             miplevels,
+                                   uint32_t             pixel_miplevels)
     {
-        VkDeviceSize texture_layer_byte_size;
-        VkDeviceSize cube_byte_size;
-        VkFormat     vulkan_image_format;
-        switch (texture_image_format)
+        const VkFormat vulkan_image_format = getTextureImageFormat(texture_image_format);
+        if (vulkan_image_format == VK_FORMAT_UNDEFINED)
         {
-            case RHIFormat::RHI_FORMAT_R8G8B8_UNORM:
-                texture_layer_byte_size = texture_image_width * texture_image_height * 3;
-                vulkan_image_format     = VK_FORMAT_R8G8B8_UNORM;
-                break;
-            case RHIFormat::RHI_FORMAT_R8G8B8_SRGB:
-                texture_layer_byte_size = texture_image_width * texture_image_height * 3;
-                vulkan_image_format     = VK_FORMAT_R8G8B8_SRGB;
-                break;
-            case RHIFormat::RHI_FORMAT_R8G8B8A8_UNORM:
-                texture_layer_byte_size = texture_image_width * texture_image_height * 4;
-                vulkan_image_format     = VK_FORMAT_R8G8B8A8_UNORM;
-                break;
-            case RHIFormat::RHI_FORMAT_R8G8B8A8_SRGB:
-                texture_layer_byte_size = texture_image_width * texture_image_height * 4;
-                vulkan_image_format     = VK_FORMAT_R8G8B8A8_SRGB;
-                break;
-            case RHIFormat::RHI_FORMAT_R32G32_SFLOAT:
-                texture_layer_byte_size = texture_image_width * texture_image_height * 4 * 2;
-                vulkan_image_format     = VK_FORMAT_R32G32_SFLOAT;
-                break;
-            case RHIFormat::RHI_FORMAT_R32G32B32_SFLOAT:
-                texture_layer_byte_size = texture_image_width * texture_image_height * 4 * 3;
-                vulkan_image_format     = VK_FORMAT_R32G32B32_SFLOAT;
-                break;
-            case RHIFormat::RHI_FORMAT_R32G32B32A32_SFLOAT:
-                texture_layer_byte_size = texture_image_width * texture_image_height * 4 * 4;
-                vulkan_image_format     = VK_FORMAT_R32G32B32A32_SFLOAT;
-                break;
-            default:
-                texture_layer_byte_size = VkDeviceSize(-1);
-                LOG_ERROR("invalid texture_layer_byte_size");
-                return;
-                break;
+            LOG_ERROR("invalid texture_image_format");
+            return;
         }
 
-        cube_byte_size = texture_layer_byte_size * 6;
+        // like createGlobalImage, every face holds its whole mip chain
+        const bool is_mip_chain_uploaded =
+            pixel_miplevels > 1 || TextureCompressor::isBlockCompressed(texture_image_format);
+        if (is_mip_chain_uploaded)
+        {
+            miplevels = pixel_miplevels;
+        }
+        const VkDeviceSize texture_layer_byte_size =
+            TextureCompressor::getMipChainSize(texture_image_format,
+                                               texture_image_width,
+                                               texture_image_height,
+                                               is_mip_chain_uploaded ? pixel_miplevels : 1);
+        const VkDeviceSize cube_byte_size = texture_layer_byte_size * 6;
 
         // create cubemap texture image
         // use the vmaAllocator to allocate asset texture image
@@ -516,18 +547,42 @@ namespace Piccolo
                               miplevels,
                               VK_IMAGE_ASPECT_COLOR_BIT);
         // copy from staging buffer as destination
-        copyBufferToImage(rhi,
-                          inefficient_staging_buffer,
-                          image,
-                          static_cast<uint32_t>(texture_image_width),
-                          static_cast<uint32_t>(texture_image_height),
-                          6);
+        if (is_mip_chain_uploaded)
+        {
+            copyBufferToImageMipLevels(rhi,
+                                       inefficient_staging_buffer,
+                                       image,
+                                       texture_image_format,
+                                       texture_image_width,
+                                       texture_image_height,
+                                       6,
+                                       miplevels);
+            transitionImageLayout(rhi,
+                                  image,
+                                  VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                                  VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                                  6,
+                                  miplevels,
+                                  VK_IMAGE_ASPECT_COLOR_BIT);
+        }
+        else
+        {
+            copyBufferToImage(rhi,
+                              inefficient_staging_buffer,
+                              image,
+                              static_cast<uint32_t>(texture_image_width),
+                              static_cast<uint32_t>(texture_image_height),
+                              6);
+        }
 
         vkDestroyBuffer(static_cast<VulkanRHI*>(rhi)->m_device, inefficient_staging_buffer, nullptr);
         vkFreeMemory(static_cast<VulkanRHI*>(rhi)->m_device, inefficient_staging_buffer_memory, nullptr);
 
-        generateTextureMipMaps(
-            rhi, image, vulkan_image_format, texture_image_width, texture_image_height, 6, miplevels);
+        if (!is_mip_chain_uploaded)
+        {
+            generateTextureMipMaps(
+                rhi, image, vulkan_image_format, texture_image_width, texture_image_height, 6, miplevels);
+        }
 
         image_view = createImageView(static_cast<VulkanRHI*>(rhi)->m_device,
                                      image,
@@ -778,6 +833,61 @@ namespace Piccolo
         static_cast<VulkanRHI*>(rhi)->endSingleTimeCommands(rhi_command_buffer);
     }
 
+    void VulkanUtil::copyBufferToImageMipLevels(RHI*      rhi,
+                                                VkBuffer  buffer,
+                                                VkImage   image,
+                                                RHIFormat format,
+                                                uint32_t  width,
+                                                uint32_t  height,
+                                                uint32_t  layer_count,
+                                                uint32_t  miplevels)
+    {
+        if (rhi == nullptr)
+        {
+            LOG_ERROR("rhi is nullptr");
+            return;
+        }
+
+        RHICommandBuffer* rhi_command_buffer = static_cast<VulkanRHI*>(rhi)->beginSingleTimeCommands();
+        VkCommandBuffer command_buffer = ((VulkanCommandBuffer*)rhi_command_buffer)->getResource();
+
+        // the buffer holds the whole mip chain of a layer before the next layer
+        std::vector<VkBufferImageCopy> regions;
+        regions.reserve(layer_count * miplevels);
+        VkDeviceSize buffer_offset = 0;
+        for (uint32_t layer = 0; layer < layer_count; layer++)
+        {
+            for (uint32_t level = 0; level < miplevels; level++)
+            {
+                const uint32_t level_width  = std::max(width >> level, 1u);
+                const uint32_t level_height = std::max(height >> level, 1u);
+
+                VkBufferImageCopy region {};
+                region.bufferOffset                    = buffer_offset;
+                region.bufferRowLength                 = 0;
+                region.bufferImageHeight               = 0;
+                region.imageSubresource.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
+                region.imageSubresource.mipLevel       = level;
+                region.imageSubresource.baseArrayLayer = layer;
+                region.imageSubresource.layerCount     = 1;
+                region.imageOffset                     = {0, 0, 0};
+                region.imageExtent                     = {level_width, level_height, 1};
+                regions.push_back(region);
+
+                buffer_offset += TextureCompressor::getLevelSize(format, level_width, level_height);
+            }
+        }
+
+        vkCmdCopyBufferToImage(command_buffer,
+                               buffer,
+                               image,
+                               VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                               static_cast<uint32_t>(regions.size()),
+                               regions.data());
+
+        static_cast<VulkanRHI*>(rhi)->endSingleTimeCommands(rhi_command_buffer);
+    }
+
     void VulkanUtil::genMipmappedImage(RHI* rhi, VkImage image, uint32_t width, uint32_t height, uint32_t mip_levels)
     {
         if (rhi == nullptr)
@@ -67,7 +67,8 @@ namespace Piccolo
                                                 uint32_t           texture_image_height,
                                                 void*              texture_image_pixels,
                                                 RHIFormat texture_image_format,
-                                                uint32_t           miplevels = 0);
+                                                uint32_t           miplevels       = 0,
+                                                uint32_t           pixel_miplevels = 1);
         static void           createCubeMap(RHI*                 rhi,
                                             VkImage&             image,
                                             VkImageView&         image_view,
@@ -76,7 +77,8 @@ namespace Piccolo
                                             uint32_t             texture_image_height,
                                             std::array<void*, 6> texture_image_pixels,
                                             RHIFormat   texture_image_format,
-                                            uint32_t             miplevels);
+                                            uint32_t             miplevels,
+                                            uint32_t             pixel_miplevels = 1);
         static void           generateTextureMipMaps(RHI*     rhi,
                                                      VkImage  image,
                                                      VkFormat image_format,
@@ -97,6 +99,15 @@ namespace Piccolo
                                                 uint32_t width,
                                                 uint32_t height,
                                                 uint32_t layer_count);
+        // every layer with its whole mip chain, one after the other in the buffer
+        static void           copyBufferToImageMipLevels(RHI*      rhi,
+                                                         VkBuffer  buffer,
+                                                         VkImage   image,
+                                                         RHIFormat format,
+                                                         uint32_t  width,
+                                                         uint32_t  height,
+                                                         uint32_t  layer_count,
+                                                         uint32_t  miplevels);
         static void genMipmappedImage(RHI* rhi, VkImage image, uint32_t width, uint32_t height, uint32_t mip_levels);
 
         static VkSampler
@@ -0,0 +1,169 @@
+#include "runtime/function/render/mesh_blob.h"
+
+#include "runtime/core/base/macro.h"
+
+#include "runtime/function/render/mesh_optimizer.h"
+
+#include "runtime/platform/file_service/mapped_file.h"
+
+#include <cstring>
+#include <fstream>
+#include <system_error>
+#include <vector>
+
+namespace Piccolo
+{
+    namespace
+    {
+        // the sections start aligned for the vertex attributes and for the staging copy
+        constexpr size_t k_section_alignment = 16;
+
+        size_t alignSection(size_t offset) { return (offset + k_section_alignment - 1) & ~(k_section_alignment - 1); }
+
+        bool readHeader(const std::filesystem::path& blob_path, MeshBlobHeader& out_header)
+        {
+            std::ifstream blob_file(blob_path, std::ios::binary);
+            blob_file.read(reinterpret_cast<char*>(&out_header), sizeof(out_header));
+            return blob_file && out_header.magic == MeshBlob::k_magic && out_header.version == MeshBlob::k_version;
+        }
+
+        bool isSectionInFile(size_t offset, size_t size, size_t file_size)
+        {
+            return offset % k_section_alignment == 0 && offset <= file_size && size <= file_size - offset;
+        }
+    } // namespace
+
+    std::filesystem::path MeshBlob::getBlobPath(const std::filesystem::path& mesh_file)
+    {
+        // foo.obj and foo.mesh_bind.json get their own blob
+        std::filesystem::path blob_path = mesh_file;
+        blob_path += k_extension;
+        return blob_path;
+    }
+
+    bool MeshBlob::isUpToDate(const std::filesystem::path& mesh_file, const std::filesystem::path& blob_path)
+    {
+        std::error_code error;
+        const auto      blob_time = std::filesystem::last_write_time(blob_path, error);
+        if (error)
+            return false;
+        const auto mesh_time = std::filesystem::last_write_time(mesh_file, error);
+        if (!error && blob_time < mesh_time)
+            return false;
+
+        MeshBlobHeader header;
+        return readHeader(blob_path, header);
+    }
+
+    bool MeshBlob::load(const std::filesystem::path& blob_path,
+                        RenderMeshData&              out_mesh_data,
+                        AxisAlignedBox&              out_bounding_box)
+    {
+        std::shared_ptr<MappedFile> mapped_file = MappedFile::open(blob_path);
+        if (!mapped_file || mapped_file->size() < sizeof(MeshBlobHeader))
+        {
+            LOG_ERROR("map mesh blob {} failed!", blob_path.generic_string());
+            return false;
+        }
+
+        MeshBlobHeader header;
+        std::memcpy(&header, mapped_file->data(), sizeof(header));
+
+        const RHIIndexType index_type   = static_cast<RHIIndexType>(header.index_type);
+        const size_t       vertex_size  = size_t(header.vertex_count) * sizeof(MeshVertexDataDefinition);
+        const size_t       index_size   = size_t(header.index_count) * MeshOptimizer::getIndexSize(index_type);
+        const size_t       binding_size = size_t(header.binding_count) * sizeof(MeshVertexBindingDataDefinition);
+        const size_t       meshlet_size = size_t(header.meshlet_count) * sizeof(MeshletDataDefinition);
+        if (header.magic != k_magic || header.version != k_version ||
+            (index_type != RHI_INDEX_TYPE_UINT16 && index_type != RHI_INDEX_TYPE_UINT32) ||
+            !isSectionInFile(header.vertex_offset, vertex_size, mapped_file->size()) ||
+            !isSectionInFile(header.index_offset, index_size, mapped_file->size()) ||
+            !isSectionInFile(header.binding_offset, binding_size, mapped_file->size()) ||
+            !isSectionInFile(header.meshlet_offset, meshlet_size, mapped_file->size()))
+        {
+            LOG_ERROR("mesh blob {} is corrupted or outdated!", blob_path.generic_string());
+            return false;
+        }
+
+        uint8_t* data = mapped_file->data();
+        out_mesh_data.m_static_mesh_data.m_vertex_buffer =
+            std::make_shared<BufferData>(mapped_file, data + header.vertex_offset, vertex_size);
+        out_mesh_data.m_static_mesh_data.m_index_buffer =
+            std::make_shared<BufferData>(mapped_file, data + header.index_offset, index_size);
+        out_mesh_data.m_static_mesh_data.m_index_type = index_type;
+        out_mesh_data.m_static_mesh_data.m_meshlet_buffer =
+            std::make_shared<BufferData>(mapped_file, data + header.meshlet_offset, meshlet_size);
+        if (header.binding_count > 0)
+        {
+            out_mesh_data.m_skeleton_binding_buffer =
+                std::make_shared<BufferData>(mapped_file, data + header.binding_offset, binding_size);
+        }
+
+        out_bounding_box.merge(
+            Vector3(header.bounding_box_min[0], header.bounding_box_min[1], header.bounding_box_min[2]));
+        out_bounding_box.merge(
+            Vector3(header.bounding_box_max[0], header.bounding_box_max[1], header.bounding_box_max[2]));
+        return true;
+    }
+
+    bool MeshBlob::save(const std::filesystem::path& blob_path,
+                        const RenderMeshData&        mesh_data,
+                        const AxisAlignedBox&        bounding_box)
+    {
+        const std::shared_ptr<BufferData>& vertex_buffer  = mesh_data.m_static_mesh_data.m_vertex_buffer;
+        const std::shared_ptr<BufferData>& index_buffer   = mesh_data.m_static_mesh_data.m_index_buffer;
+        const std::shared_ptr<BufferData>& binding_buffer = mesh_data.m_skeleton_binding_buffer;
+        const std::shared_ptr<BufferData>& meshlet_buffer = mesh_data.m_static_mesh_data.m_meshlet_buffer;
+        if (!vertex_buffer || !index_buffer)
+        {
+            LOG_ERROR("mesh blob {} has no vertex or index buffer!", blob_path.generic_string());
+            return false;
+        }
+        const size_t binding_size = binding_buffer ? binding_buffer->m_size : 0;
+        const size_t meshlet_size = meshlet_buffer ? meshlet_buffer->m_size : 0;
+        const size_t index_size   = MeshOptimizer::getIndexSize(mesh_data.m_static_mesh_data.m_index_type);
+
+        MeshBlobHeader header;
+        header.magic          = k_magic;
+        header.version        = k_version;
+        header.vertex_count   = static_cast<uint32_t>(vertex_buffer->m_size / sizeof(MeshVertexDataDefinition));
+        header.index_count    = static_cast<uint32_t>(index_buffer->m_size / index_size);
+        header.index_type     = static_cast<uint32_t>(mesh_data.m_static_mesh_data.m_index_type);
+        header.binding_count  = static_cast<uint32_t>(binding_size / sizeof(MeshVertexBindingDataDefinition));
+        header.meshlet_count  = static_cast<uint32_t>(meshlet_size / sizeof(MeshletDataDefinition));
+        header.vertex_offset  = static_cast<uint32_t>(alignSection(sizeof(header)));
+        header.index_offset   = static_cast<uint32_t>(alignSection(header.vertex_offset + vertex_buffer->m_size));
+        header.binding_offset = static_cast<uint32_t>(alignSection(header.index_offset + index_buffer->m_size));
+        header.meshlet_offset = static_cast<uint32_t>(alignSection(header.binding_offset + binding_size));
+
+        const Vector3& min_corner = bounding_box.getMinCorner();
+        const Vector3& max_corner = bounding_box.getMaxCorner();
+        for (size_t axis = 0; axis < 3; axis++)
+        {
+            header.bounding_box_min[axis] = min_corner[axis];
+            header.bounding_box_max[axis] = max_corner[axis];
+        }
+
+        std::vector<uint8_t> blob(header.meshlet_offset + meshlet_size, 0);
+        std::memcpy(blob.data(), &header, sizeof(header));
+        std::memcpy(blob.data() + header.vertex_offset, vertex_buffer->m_data, vertex_buffer->m_size);
+        std::memcpy(blob.data() + header.index_offset, index_buffer->m_data, index_buffer->m_size);
+        if (binding_size > 0)
+        {
+            std::memcpy(blob.data() + header.binding_offset, binding_buffer->m_data, binding_size);
+        }
+        if (meshlet_size > 0)
+        {
+            std::memcpy(blob.data() + header.meshlet_offset, meshlet_buffer->m_data, meshlet_size);
+        }
+
+        std::ofstream blob_file(blob_path, std::ios::binary);
+        if (!blob_file)
+        {
+            LOG_ERROR("open file {} failed!", blob_path.generic_string());
+            return false;
+        }
+        blob_file.write(reinterpret_cast<const char*>(blob.data()), blob.size());
+        return static_cast<bool>(blob_file);
+    }
+} // namespace Piccolo
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "runtime/core/math/axis_aligned.h"
+#include "runtime/function/render/render_type.h"
+
+#include <cstdint>
+#include <filesystem>
+
+namespace Piccolo
+{
+    /// Cooked mesh, written next to its .obj or .json source after MeshOptimizer. The vertex, index, joint binding
+    /// and meshlet sections are stored in the layout of MeshVertexDataDefinition, uint16_t or uint32_t,
+    /// MeshVertexBindingDataDefinition and MeshletDataDefinition, so a loaded blob is the mapped file itself and the
+    /// buffers point into it.
+    struct MeshBlobHeader
+    {
+        uint32_t magic {0};
+        uint32_t version {0};
+        uint32_t vertex_count {0};
+        uint32_t index_count {0};
+        // RHI_INDEX_TYPE_UINT16 or RHI_INDEX_TYPE_UINT32
+        uint32_t index_type {0};
+        // 0 for a mesh without skeleton binding
+        uint32_t binding_count {0};
+        uint32_t meshlet_count {0};
+        // byte offsets of the sections from the start of the file
+        uint32_t vertex_offset {0};
+        uint32_t index_offset {0};
+        uint32_t binding_offset {0};
+        uint32_t meshlet_offset {0};
+        float    bounding_box_min[3] {};
+        float    bounding_box_max[3] {};
+    };
+
+    class MeshBlob
+    {
+    public:
+        static constexpr uint32_t    k_magic     = 0x48534D50; // "PMSH"
+        static constexpr uint32_t    k_version   = 2;
+        static constexpr const char* k_extension = ".mesh";
+
+        // asset/foo.obj -> asset/foo.obj.mesh
+        static std::filesystem::path getBlobPath(const std::filesystem::path& mesh_file);
+        // written after the last change of mesh_file and by this version
+        static bool isUpToDate(const std::filesystem::path& mesh_file, const std::filesystem::path& blob_path);
+
+        // the bounding box is merged into out_bounding_box, like when the source mesh is loaded
+        static bool load(const std::filesystem::path& blob_path,
+                         RenderMeshData&              out_mesh_data,
+                         AxisAlignedBox&              out_bounding_box);
+        static bool save(const std::filesystem::path& blob_path,
+                         const RenderMeshData&        mesh_data,
+                         const AxisAlignedBox&        bounding_box);
+    };
+} // namespace Piccolo
@@ -0,0 +1,735 @@
+#include "runtime/function/render/mesh_optimizer.h"
+
+#include "runtime/core/math/vector3.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace Piccolo
+{
+    namespace
+    {
+        constexpr uint32_t k_invalid_index = std::numeric_limits<uint32_t>::max();
+
+        // "Linear-Speed Vertex Cache Optimisation", Tom Forsyth. the scores assume a larger lru cache than the fifo
+        // the orders are measured with, which keeps the order good for any cache size
+        constexpr uint32_t k_score_cache_size    = 32;
+        constexpr float    k_cache_decay_power   = 1.5f;
+        constexpr float    k_last_triangle_score = 0.75f;
+        constexpr float    k_valence_boost_scale = 2.0f;
+        constexpr uint32_t k_valence_table_size  = 64;
+
+        // a meshlet whose normals spread further than this from their axis is never back facing as a whole
+        constexpr float k_min_cone_spread = 0.1f;
+
+        struct VertexScoreTable
+        {
+            float cache_scores[k_score_cache_size];
+            float valence_scores[k_valence_table_size];
+
+            VertexScoreTable()
+            {
+                for (uint32_t position = 0; position < k_score_cache_size; ++position)
+                {
+                    // the vertices of the last triangle get the same score, whatever order they were used in
+                    cache_scores[position] =
+                        position < 3 ? k_last_triangle_score :
+                                       std::pow(1.0f - float(position - 3) / float(k_score_cache_size - 3),
+                                                k_cache_decay_power);
+                }
+                valence_scores[0] = 0.0f;
+                for (uint32_t valence = 1; valence < k_valence_table_size; ++valence)
+                {
+                    valence_scores[valence] = k_valence_boost_scale / std::sqrt(float(valence));
+                }
+            }
+
+            float getScore(int32_t cache_position, uint32_t live_triangle_count) const
+            {
+                if (live_triangle_count == 0)
+                    return -1.0f;
+
+                float score = cache_position >= 0 ? cache_scores[cache_position] : 0.0f;
+                score += live_triangle_count < k_valence_table_size ?
+                             valence_scores[live_triangle_count] :
+                             k_valence_boost_scale / std::sqrt(float(live_triangle_count));
+                return score;
+            }
+        };
+
+        uint32_t hashVertex(const MeshVertexDataDefinition& vertex, const MeshVertexBindingDataDefinition* binding)
+        {
+            auto hash_words = [](uint32_t hash, const void* data, size_t size) {
+                const uint8_t* bytes = static_cast<const uint8_t*>(data);
+                for (size_t offset = 0; offset + sizeof(uint32_t) <= size; offset += sizeof(uint32_t))
+                {
+                    uint32_t word;
+                    std::memcpy(&word, bytes + offset, sizeof(word));
+                    hash ^= word;
+                    hash *= 0x5bd1e995;
+                    hash ^= hash >> 15;
+                }
+                return hash;
+            };
+
+            uint32_t hash = hash_words(0x811c9dc5, &vertex, sizeof(vertex));
+            if (binding)
+            {
+                hash = hash_words(hash, binding, sizeof(*binding));
+            }
+            return hash;
+        }
+
+        // fifo cache, a vertex is in it while fewer than cache_size vertices were added after it
+        struct CacheSimulation
+        {
+            std::vector<uint32_t> timestamps;
+            uint32_t              time;
+            uint32_t              cache_size;
+
+            CacheSimulation(size_t vertex_count, uint32_t size) :
+                timestamps(vertex_count, 0), time(size + 1), cache_size(size)
+            {}
+
+            void reset() { time += cache_size + 1; }
+
+            uint32_t addTriangle(const uint32_t* triangle)
+            {
+                uint32_t misses = 0;
+                for (uint32_t corner = 0; corner < 3; ++corner)
+                {
+                    if (time - timestamps[triangle[corner]] > cache_size)
+                    {
+                        timestamps[triangle[corner]] = time++;
+                        ++misses;
+                    }
+                }
+                return misses;
+            }
+        };
+
+        Vector3 getPosition(const MeshVertexDataDefinition& vertex) { return Vector3(vertex.x, vertex.y, vertex.z); }
+
+        // ritter's sphere, a few percent larger than the smallest one
+        void computeBoundingSphere(const std::vector<uint32_t>&                 meshlet_vertices,
+                                   const std::vector<MeshVertexDataDefinition>& vertices,
+                                   Vector3&                                     out_center,
+                                   float&                                       out_radius)
+        {
+            auto farthest_from = [&](const Vector3& point) {
+                Vector3 farthest      = point;
+                float   farthest_dist = -1.0f;
+                for (uint32_t vertex : meshlet_vertices)
+                {
+                    const Vector3 position = getPosition(vertices[vertex]);
+                    const float   dist     = (position - point).squaredLength();
+                    if (dist > farthest_dist)
+                    {
+                        farthest      = position;
+                        farthest_dist = dist;
+                    }
+                }
+                return farthest;
+            };
+
+            const Vector3 first  = farthest_from(getPosition(vertices[meshlet_vertices[0]]));
+            const Vector3 second = farthest_from(first);
+
+            Vector3 center = (first + second) * 0.5f;
+            float   radius = (second - first).length() * 0.5f;
+            for (uint32_t vertex : meshlet_vertices)
+            {
+                const Vector3 position = getPosition(vertices[vertex]);
+                const float   dist     = (position - center).length();
+                if (dist > radius)
+                {
+                    // grow the sphere just enough to hold the point
+                    const float new_radius = (radius + dist) * 0.5f;
+                    center += (position - center) * ((new_radius - radius) / dist);
+                    radius = new_radius;
+                }
+            }
+            // moving the center rounds, measure the sphere again around where it ended up
+            radius = 0.0f;
+            for (uint32_t vertex : meshlet_vertices)
+            {
+                radius = std::max(radius, (getPosition(vertices[vertex]) - center).length());
+            }
+
+            out_center = center;
+            out_radius = radius;
+        }
+
+        MeshletDataDefinition makeMeshlet(const std::vector<uint32_t>&                 indices,
+                                          uint32_t                                     first_triangle,
+                                          uint32_t                                     triangle_count,
+                                          const std::vector<uint32_t>&                 meshlet_vertices,
+                                          const std::vector<MeshVertexDataDefinition>& vertices)
+        {
+            MeshletDataDefinition meshlet;
+            meshlet.m_first_index = first_triangle * 3;
+            meshlet.m_index_count = triangle_count * 3;
+
+            Vector3 center;
+            float   radius;
+            computeBoundingSphere(meshlet_vertices, vertices, center, radius);
+            for (size_t axis = 0; axis < 3; ++axis)
+            {
+                meshlet.m_center[axis] = center[axis];
+            }
+            // the bounds are tested against the frustum planes and the cone in floats, which round relative to the
+            // position of the meshlet and not to its size
+            const float magnitude = std::max({std::abs(center.x), std::abs(center.y), std::abs(center.z)});
+            meshlet.m_radius = radius + (magnitude + radius) * std::numeric_limits<float>::epsilon() * 4.0f;
+
+            Vector3  normals[MeshOptimizer::k_meshlet_max_triangles];
+            uint32_t normal_count = 0;
+            Vector3  cone_axis    = Vector3::ZERO;
+            for (uint32_t triangle = first_triangle; triangle < first_triangle + triangle_count; ++triangle)
+            {
+                const Vector3 p0 = getPosition(vertices[indices[triangle * 3 + 0]]);
+                const Vector3 p1 = getPosition(vertices[indices[triangle * 3 + 1]]);
+                const Vector3 p2 = getPosition(vertices[indices[triangle * 3 + 2]]);
+
+                Vector3     normal = (p1 - p0).crossProduct(p2 - p0);
+                const float length = normal.length();
+                // a degenerate triangle is never drawn and does not widen the cone
+                if (length == 0.0f)
+                    continue;
+                normal /= length;
+                normals[normal_count++] = normal;
+                cone_axis += normal;
+            }
+
+            const float axis_length = cone_axis.length();
+            if (normal_count == 0 || axis_length == 0.0f)
+                return meshlet;
+            cone_axis /= axis_length;
+
+            float min_dot = 1.0f;
+            for (uint32_t i = 0; i < normal_count; ++i)
+            {
+                min_dot = std::min(min_dot, cone_axis.dotProduct(normals[i]));
+            }
+            if (min_dot <= k_min_cone_spread)
+                return meshlet;
+
+            for (size_t axis = 0; axis < 3; ++axis)
+            {
+                meshlet.m_cone_axis[axis] = cone_axis[axis];
+            }
+            // sine of the angle between the spread of the normals and the plane orthogonal to the axis
+            meshlet.m_cone_cutoff = std::sqrt(1.0f - min_dot * min_dot);
+            return meshlet;
+        }
+    } // namespace
+
+    RenderMeshData MeshOptimizer::optimizeMesh(std::vector<MeshVertexDataDefinition>        vertices,
+                                               std::vector<uint32_t>                        indices,
+                                               std::vector<MeshVertexBindingDataDefinition> bindings)
+    {
+        // a triangle with an index out of range is dropped instead of reading past the vertices
+        size_t valid_index_count = 0;
+        for (size_t i = 0; i + 3 <= indices.size(); i += 3)
+        {
+            if (indices[i] < vertices.size() && indices[i + 1] < vertices.size() && indices[i + 2] < vertices.size())
+            {
+                std::copy(&indices[i], &indices[i] + 3, &indices[valid_index_count]);
+                valid_index_count += 3;
+            }
+        }
+        indices.resize(valid_index_count);
+
+        std::vector<uint32_t> remap;
+
+        // weld, and drop the vertices the welding made unused
+        const size_t welded_count = weldVertices(vertices, bindings, remap);
+        for (uint32_t& index : indices)
+        {
+            index = remap[index];
+        }
+        for (size_t vertex = 0; vertex < vertices.size(); ++vertex)
+        {
+            vertices[remap[vertex]] = vertices[vertex];
+            if (!bindings.empty())
+            {
+                bindings[remap[vertex]] = bindings[vertex];
+            }
+        }
+        vertices.resize(welded_count);
+        if (!bindings.empty())
+        {
+            bindings.resize(welded_count);
+        }
+
+        optimizeVertexCache(indices, vertices.size());
+        optimizeOverdraw(indices, vertices);
+
+        const size_t used_count = optimizeVertexFetch(indices, vertices.size(), remap);
+
+        RenderMeshData mesh_data;
+        StaticMeshData& static_mesh_data = mesh_data.m_static_mesh_data;
+
+        static_mesh_data.m_vertex_buffer =
+            std::make_shared<BufferData>(used_count * sizeof(MeshVertexDataDefinition));
+        MeshVertexDataDefinition* vertex_data =
+            static_cast<MeshVertexDataDefinition*>(static_mesh_data.m_vertex_buffer->m_data);
+        MeshVertexBindingDataDefinition* binding_data = nullptr;
+        if (!bindings.empty())
+        {
+            mesh_data.m_skeleton_binding_buffer =
+                std::make_shared<BufferData>(used_count * sizeof(MeshVertexBindingDataDefinition));
+            binding_data = static_cast<MeshVertexBindingDataDefinition*>(mesh_data.m_skeleton_binding_buffer->m_data);
+        }
+        std::vector<MeshVertexDataDefinition> fetched_vertices(used_count);
+        for (size_t vertex = 0; vertex < vertices.size(); ++vertex)
+        {
+            if (remap[vertex] == k_invalid_index)
+                continue;
+            fetched_vertices[remap[vertex]] = vertices[vertex];
+            if (binding_data)
+            {
+                binding_data[remap[vertex]] = bindings[vertex];
+            }
+        }
+        std::memcpy(vertex_data, fetched_vertices.data(), used_count * sizeof(MeshVertexDataDefinition));
+
+        static_mesh_data.m_index_type   = getIndexType(used_count);
+        static_mesh_data.m_index_buffer =
+            std::make_shared<BufferData>(indices.size() * getIndexSize(static_mesh_data.m_index_type));
+        if (static_mesh_data.m_index_type == RHI_INDEX_TYPE_UINT16)
+        {
+            uint16_t* index_data = static_cast<uint16_t*>(static_mesh_data.m_index_buffer->m_data);
+            for (size_t i = 0; i < indices.size(); ++i)
+            {
+                index_data[i] = static_cast<uint16_t>(indices[i]);
+            }
+        }
+        else
+        {
+            std::memcpy(static_mesh_data.m_index_buffer->m_data, indices.data(), indices.size() * sizeof(uint32_t));
+        }
+
+        const std::vector<MeshletDataDefinition> meshlets = buildMeshlets(indices, fetched_vertices);
+        static_mesh_data.m_meshlet_buffer =
+            std::make_shared<BufferData>(meshlets.size() * sizeof(MeshletDataDefinition));
+        std::memcpy(static_mesh_data.m_meshlet_buffer->m_data,
+                    meshlets.data(),
+                    meshlets.size() * sizeof(MeshletDataDefinition));
+
+        return mesh_data;
+    }
+
+    RHIIndexType MeshOptimizer::getIndexType(size_t vertex_count)
+    {
+        return vertex_count <= std::numeric_limits<uint16_t>::max() ? RHI_INDEX_TYPE_UINT16 : RHI_INDEX_TYPE_UINT32;
+    }
+
+    size_t MeshOptimizer::getIndexSize(RHIIndexType index_type)
+    {
+        return index_type == RHI_INDEX_TYPE_UINT32 ? sizeof(uint32_t) : sizeof(uint16_t);
+    }
+
+    size_t MeshOptimizer::weldVertices(const std::vector<MeshVertexDataDefinition>&        vertices,
+                                       const std::vector<MeshVertexBindingDataDefinition>& bindings,
+                                       std::vector<uint32_t>&                              out_remap)
+    {
+        const bool has_bindings = !bindings.empty();
+        out_remap.assign(vertices.size(), k_invalid_index);
+
+        // open addressing on the bytes of the vertices, at most half full
+        size_t table_size = 1;
+        while (table_size < vertices.size() * 2)
+        {
+            table_size <<= 1;
+        }
+        std::vector<uint32_t> table(table_size, k_invalid_index);
+
+        size_t unique_count = 0;
+        for (uint32_t vertex = 0; vertex < vertices.size(); ++vertex)
+        {
+            const MeshVertexBindingDataDefinition* binding = has_bindings ? &bindings[vertex] : nullptr;
+
+            size_t slot = hashVertex(vertices[vertex], binding) & (table_size - 1);
+            while (true)
+            {
+                const uint32_t other = table[slot];
+                if (other == k_invalid_index)
+                {
+                    table[slot]       = vertex;
+                    out_remap[vertex] = static_cast<uint32_t>(unique_count++);
+                    break;
+                }
+                if (std::memcmp(&vertices[vertex], &vertices[other], sizeof(MeshVertexDataDefinition)) == 0 &&
+                    (!has_bindings ||
+                     std::memcmp(binding, &bindings[other], sizeof(MeshVertexBindingDataDefinition)) == 0))
+                {
+                    out_remap[vertex] = out_remap[other];
+                    break;
+                }
+                slot = (slot + 1) & (table_size - 1);
+            }
+        }
+        return unique_count;
+    }
+
+    void MeshOptimizer::optimizeVertexCache(std::vector<uint32_t>& indices, size_t vertex_count)
+    {
+        static const VertexScoreTable score_table;
+
+        const size_t triangle_count = indices.size() / 3;
+        if (triangle_count == 0)
+            return;
+
+        // the triangles not emitted yet of each vertex, at [offset, offset + live count)
+        std::vector<uint32_t> live_triangle_counts(vertex_count, 0);
+        for (uint32_t index : indices)
+        {
+            ++live_triangle_counts[index];
+        }
+        std::vector<uint32_t> triangle_offsets(vertex_count + 1, 0);
+        for (size_t vertex = 0; vertex < vertex_count; ++vertex)
+        {
+            triangle_offsets[vertex + 1] = triangle_offsets[vertex] + live_triangle_counts[vertex];
+        }
+        std::vector<uint32_t> vertex_triangles(indices.size());
+        {
+            std::vector<uint32_t> fill_offsets(triangle_offsets.begin(), triangle_offsets.end() - 1);
+            for (uint32_t triangle = 0; triangle < triangle_count; ++triangle)
+            {
+                for (uint32_t corner = 0; corner < 3; ++corner)
+                {
+                    vertex_triangles[fill_offsets[indices[triangle * 3 + corner]]++] = triangle;
+                }
+            }
+        }
+
+        std::vector<float> vertex_scores(vertex_count);
+        for (size_t vertex = 0; vertex < vertex_count; ++vertex)
+        {
+            vertex_scores[vertex] = score_table.getScore(-1, live_triangle_counts[vertex]);
+        }
+
+        std::vector<float> triangle_scores(triangle_count);
+        uint32_t           best_triangle = 0;
+        for (uint32_t triangle = 0; triangle < triangle_count; ++triangle)
+        {
+            triangle_scores[triangle] = vertex_scores[indices[triangle * 3 + 0]] +
+                                        vertex_scores[indices[triangle * 3 + 1]] +
+                                        vertex_scores[indices[triangle * 3 + 2]];
+            if (triangle_scores[triangle] > triangle_scores[best_triangle])
+            {
+                best_triangle = triangle;
+            }
+        }
+
+        std::vector<uint8_t>  is_emitted(triangle_count, 0);
+        std::vector<uint32_t> result;
+        result.reserve(indices.size());
+
+        uint32_t cache[k_score_cache_size + 3];
+        uint32_t cache_count         = 0;
+        uint32_t next_input_triangle = 0;
+
+        for (size_t emitted_count = 0; emitted_count < triangle_count; ++emitted_count)
+        {
+            if (best_triangle == k_invalid_index)
+            {
+                // nothing left around the cache, restart from the input order
+                while (is_emitted[next_input_triangle])
+                {
+                    ++next_input_triangle;
+                }
+                best_triangle = next_input_triangle;
+            }
+
+            const uint32_t* triangle = &indices[best_triangle * 3];
+            result.insert(result.end(), triangle, triangle + 3);
+            is_emitted[best_triangle] = 1;
+
+            for (uint32_t corner = 0; corner < 3; ++corner)
+            {
+                const uint32_t vertex = triangle[corner];
+                uint32_t*      begin  = &vertex_triangles[triangle_offsets[vertex]];
+                uint32_t*      end    = begin + live_triangle_counts[vertex];
+                uint32_t*      found  = std::find(begin, end, best_triangle);
+                // a degenerate triangle has already been removed from its repeated vertex
+                if (found != end)
+                {
+                    *found = *(end - 1);
+                    --live_triangle_counts[vertex];
+                }
+            }
+
+            // the vertices of the triangle move to the front of the cache
+            uint32_t new_cache[k_score_cache_size + 3];
+            uint32_t new_cache_count = 0;
+            for (uint32_t corner = 0; corner < 3; ++corner)
+            {
+                if (std::find(new_cache, new_cache + new_cache_count, triangle[corner]) == new_cache + new_cache_count)
+                {
+                    new_cache[new_cache_count++] = triangle[corner];
+                }
+            }
+            for (uint32_t i = 0; i < cache_count; ++i)
+            {
+                if (cache[i] != triangle[0] && cache[i] != triangle[1] && cache[i] != triangle[2])
+                {
+                    new_cache[new_cache_count++] = cache[i];
+                }
+            }
+
+            // rescore the vertices whose position changed, including the ones pushed out of the cache
+            for (uint32_t i = 0; i < new_cache_count; ++i)
+            {
+                const uint32_t vertex   = new_cache[i];
+                const int32_t  position = i < k_score_cache_size ? static_cast<int32_t>(i) : -1;
+
+                const float score = score_table.getScore(position, live_triangle_counts[vertex]);
+                const float delta = score - vertex_scores[vertex];
+                vertex_scores[vertex] = score;
+
+                const uint32_t* begin = &vertex_triangles[triangle_offsets[vertex]];
+                for (uint32_t t = 0; t < live_triangle_counts[vertex]; ++t)
+                {
+                    triangle_scores[begin[t]] += delta;
+                }
+            }
+            cache_count = std::min<uint32_t>(new_cache_count, k_score_cache_size);
+            std::copy(new_cache, new_cache + cache_count, cache);
+
+            // the next triangle is the best one using a vertex of the cache
+            best_triangle    = k_invalid_index;
+            float best_score = -std::numeric_limits<float>::max();
+            for (uint32_t i = 0; i < cache_count; ++i)
+            {
+                const uint32_t  vertex = cache[i];
+                const uint32_t* begin  = &vertex_triangles[triangle_offsets[vertex]];
+                for (uint32_t t = 0; t < live_triangle_counts[vertex]; ++t)
+                {
+                    if (triangle_scores[begin[t]] > best_score)
+                    {
+                        best_triangle = begin[t];
+                        best_score    = triangle_scores[begin[t]];
+                    }
+                }
+            }
+        }
+
+        indices.swap(result);
+    }
+
+    void MeshOptimizer::optimizeOverdraw(std::vector<uint32_t>&                       indices,
+                                         const std::vector<MeshVertexDataDefinition>& vertices,
+                                         float                                        acmr_threshold)
+    {
+        // "Fast Triangle Reordering for Vertex Locality and Reduced Overdraw", Sander, Nehab and Barczak
+        const uint32_t triangle_count = static_cast<uint32_t>(indices.size() / 3);
+        if (triangle_count < 2)
+            return;
+
+        CacheSimulation cache(vertices.size(), k_cache_size);
+
+        // hard boundaries: a triangle missing the cache with all its vertices starts a disjoint patch
+        std::vector<uint32_t> hard_clusters;
+        for (uint32_t triangle = 0; triangle < triangle_count; ++triangle)
+        {
+            if (cache.addTriangle(&indices[triangle * 3]) == 3 || triangle == 0)
+            {
+                hard_clusters.push_back(triangle);
+            }
+        }
+
+        // soft boundaries: a patch is cut again wherever the part before the cut, drawn from an empty cache, is
+        // within the threshold of the acmr of the whole patch
+        std::vector<uint32_t> clusters;
+        for (size_t i = 0; i < hard_clusters.size(); ++i)
+        {
+            const uint32_t begin = hard_clusters[i];
+            const uint32_t end   = i + 1 < hard_clusters.size() ? hard_clusters[i + 1] : triangle_count;
+
+            cache.reset();
+            uint32_t cluster_misses = 0;
+            for (uint32_t triangle = begin; triangle < end; ++triangle)
+            {
+                cluster_misses += cache.addTriangle(&indices[triangle * 3]);
+            }
+            const float cluster_threshold = acmr_threshold * float(cluster_misses) / float(end - begin);
+
+            const size_t first_cluster = clusters.size();
+            clusters.push_back(begin);
+
+            cache.reset();
+            uint32_t running_misses    = 0;
+            uint32_t running_triangles = 0;
+            for (uint32_t triangle = begin; triangle < end; ++triangle)
+            {
+                running_misses += cache.addTriangle(&indices[triangle * 3]);
+                ++running_triangles;
+                if (float(running_misses) <= cluster_threshold * float(running_triangles))
+                {
+                    clusters.push_back(triangle + 1);
+                    cache.reset();
+                    running_misses    = 0;
+                    running_triangles = 0;
+                }
+            }
+            // the last cut is at the end of the patch or before a tail that did not reach the threshold, the tail
+            // is merged into the previous cluster
+            if (clusters.size() > first_cluster + 1)
+            {
+                clusters.pop_back();
+            }
+        }
+
+        // the clusters facing out from the center of the mesh are drawn first, they hide the ones behind them
+        Vector3 mesh_centroid = Vector3::ZERO;
+        for (uint32_t index : indices)
+        {
+            mesh_centroid += getPosition(vertices[index]);
+        }
+        mesh_centroid /= float(indices.size());
+
+        std::vector<float> cluster_keys(clusters.size());
+        for (size_t i = 0; i < clusters.size(); ++i)
+        {
+            const uint32_t begin = clusters[i];
+            const uint32_t end   = i + 1 < clusters.size() ? clusters[i + 1] : triangle_count;
+
+            Vector3 centroid = Vector3::ZERO;
+            Vector3 normal   = Vector3::ZERO;
+            float   area     = 0.0f;
+            for (uint32_t triangle = begin; triangle < end; ++triangle)
+            {
+                const Vector3 p0 = getPosition(vertices[indices[triangle * 3 + 0]]);
+                const Vector3 p1 = getPosition(vertices[indices[triangle * 3 + 1]]);
+                const Vector3 p2 = getPosition(vertices[indices[triangle * 3 + 2]]);
+
+                // the cross product is twice the area along the normal
+                const Vector3 weighted_normal = (p1 - p0).crossProduct(p2 - p0);
+                const float   triangle_area   = weighted_normal.length();
+
+                centroid += (p0 + p1 + p2) * (triangle_area / 3.0f);
+                normal += weighted_normal;
+                area += triangle_area;
+            }
+
+            const float normal_length = normal.length();
+            cluster_keys[i]           = area > 0.0f && normal_length > 0.0f ?
+                                            (centroid / area - mesh_centroid).dotProduct(normal / normal_length) :
+                                            0.0f;
+        }
+
+        std::vector<uint32_t> cluster_order(clusters.size());
+        for (uint32_t i = 0; i < cluster_order.size(); ++i)
+        {
+            cluster_order[i] = i;
+        }
+        std::stable_sort(cluster_order.begin(), cluster_order.end(), [&](uint32_t lhs, uint32_t rhs) {
+            return cluster_keys[lhs] > cluster_keys[rhs];
+        });
+
+        std::vector<uint32_t> result;
+        result.reserve(indices.size());
+        for (uint32_t cluster : cluster_order)
+        {
+            const uint32_t begin = clusters[cluster];
+            const uint32_t end   = cluster + 1 < clusters.size() ? clusters[cluster + 1] : triangle_count;
+            result.insert(result.end(), indices.begin() + begin * 3, indices.begin() + end * 3);
+        }
+        indices.swap(result);
+    }
+
+    size_t MeshOptimizer::optimizeVertexFetch(std::vector<uint32_t>& indices,
+                                              size_t                 vertex_count,
+                                              std::vector<uint32_t>& out_remap)
+    {
+        out_remap.assign(vertex_count, k_invalid_index);
+
+        uint32_t used_count = 0;
+        for (uint32_t& index : indices)
+        {
+            if (out_remap[index] == k_invalid_index)
+            {
+                out_remap[index] = used_count++;
+            }
+            index = out_remap[index];
+        }
+        return used_count;
+    }
+
+    std::vector<MeshletDataDefinition> MeshOptimizer::buildMeshlets(const std::vector<uint32_t>& indices,
+                                                                    const std::vector<MeshVertexDataDefinition>& vertices)
+    {
+        std::vector<MeshletDataDefinition> meshlets;
+
+        const uint32_t triangle_count = static_cast<uint32_t>(indices.size() / 3);
+
+        // the meshlet each vertex was last added to
+        std::vector<uint32_t> vertex_meshlets(vertices.size(), k_invalid_index);
+        std::vector<uint32_t> meshlet_vertices;
+        meshlet_vertices.reserve(k_meshlet_max_vertices);
+
+        uint32_t first_triangle = 0;
+        for (uint32_t triangle = 0; triangle < triangle_count; ++triangle)
+        {
+            const uint32_t* corners         = &indices[triangle * 3];
+            const uint32_t  current_meshlet = static_cast<uint32_t>(meshlets.size());
+
+            uint32_t new_vertex_count = 0;
+            for (uint32_t corner = 0; corner < 3; ++corner)
+            {
+                if (vertex_meshlets[corners[corner]] != current_meshlet &&
+                    (corner < 1 || corners[corner] != corners[0]) && (corner < 2 || corners[corner] != corners[1]))
+                {
+                    ++new_vertex_count;
+                }
+            }
+
+            // the triangles stay in the order of the index buffer, a meshlet is closed when the next one does not fit
+            if (triangle - first_triangle == k_meshlet_max_triangles ||
+                meshlet_vertices.size() + new_vertex_count > k_meshlet_max_vertices)
+            {
+                meshlets.push_back(
+                    makeMeshlet(indices, first_triangle, triangle - first_triangle, meshlet_vertices, vertices));
+                meshlet_vertices.clear();
+                first_triangle = triangle;
+            }
+
+            for (uint32_t corner = 0; corner < 3; ++corner)
+            {
+                if (vertex_meshlets[corners[corner]] != meshlets.size())
+                {
+                    vertex_meshlets[corners[corner]] = static_cast<uint32_t>(meshlets.size());
+                    meshlet_vertices.push_back(corners[corner]);
+                }
+            }
+        }
+        if (triangle_count > first_triangle)
+        {
+            meshlets.push_back(
+                makeMeshlet(indices, first_triangle, triangle_count - first_triangle, meshlet_vertices, vertices));
+        }
+
+        return meshlets;
+    }
+
+    float MeshOptimizer::getAverageCacheMissRatio(const std::vector<uint32_t>& indices,
+                                                  size_t                       vertex_count,
+                                                  uint32_t                     cache_size)
+    {
+        const size_t triangle_count = indices.size() / 3;
+        if (triangle_count == 0)
+            return 0.0f;
+
+        CacheSimulation cache(vertex_count, cache_size);
+        uint32_t        misses = 0;
+        for (size_t triangle = 0; triangle < triangle_count; ++triangle)
+        {
+            misses += cache.addTriangle(&indices[triangle * 3]);
+        }
+        return float(misses) / float(triangle_count);
+    }
+} // namespace Piccolo
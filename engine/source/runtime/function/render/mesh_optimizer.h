@@ -0,0 +1,54 @@
+#pragma once
+
+#include "runtime/function/render/render_type.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Piccolo
+{
+    /// Turns the triangle lists of the mesh loaders into the meshes the renderer draws, for the loaders and the mesh
+    /// cooker. The identical vertices are welded, the triangles are ordered for the post-transform vertex cache and
+    /// then, in clusters that keep most of that order, from the outside of the mesh in to reduce overdraw. The
+    /// vertices are stored in the order the triangles first use them and the index buffer is cut into meshlets with
+    /// their bounding sphere and normal cone. The indices are 16 bit unless the mesh has too many vertices for them.
+    class MeshOptimizer
+    {
+    public:
+        // fifo cache the orders are measured with, the smallest of the current gpus
+        static constexpr uint32_t k_cache_size              = 16;
+        static constexpr uint32_t k_meshlet_max_vertices    = 64;
+        static constexpr uint32_t k_meshlet_max_triangles   = 124;
+        // how much worse than the vertex cache order a cluster reordered for overdraw may get
+        static constexpr float    k_overdraw_acmr_threshold = 1.05f;
+
+        // bindings has one entry per vertex, or none for a mesh without skeleton binding
+        static RenderMeshData optimizeMesh(std::vector<MeshVertexDataDefinition>        vertices,
+                                           std::vector<uint32_t>                        indices,
+                                           std::vector<MeshVertexBindingDataDefinition> bindings);
+
+        static RHIIndexType getIndexType(size_t vertex_count);
+        static size_t       getIndexSize(RHIIndexType index_type);
+
+        // the steps of optimizeMesh, each remap gives the new index of every vertex
+        static size_t weldVertices(const std::vector<MeshVertexDataDefinition>&        vertices,
+                                   const std::vector<MeshVertexBindingDataDefinition>& bindings,
+                                   std::vector<uint32_t>&                              out_remap);
+        static void   optimizeVertexCache(std::vector<uint32_t>& indices, size_t vertex_count);
+        static void   optimizeOverdraw(std::vector<uint32_t>&                       indices,
+                                       const std::vector<MeshVertexDataDefinition>& vertices,
+                                       float acmr_threshold = k_overdraw_acmr_threshold);
+        // the vertices no triangle uses are remapped to UINT32_MAX
+        static size_t optimizeVertexFetch(std::vector<uint32_t>& indices,
+                                          size_t                 vertex_count,
+                                          std::vector<uint32_t>& out_remap);
+        static std::vector<MeshletDataDefinition> buildMeshlets(const std::vector<uint32_t>&                 indices,
+                                                                const std::vector<MeshVertexDataDefinition>& vertices);
+
+        // vertices transformed per triangle with a fifo cache of cache_size, 3 at worst
+        static float getAverageCacheMissRatio(const std::vector<uint32_t>& indices,
+                                              size_t                       vertex_count,
+                                              uint32_t                     cache_size = k_cache_size);
+    };
+} // namespace Piccolo
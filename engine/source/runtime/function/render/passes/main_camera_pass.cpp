@@ -6,7 +6,6 @@
 #include "runtime/function/render/interface/vulkan/vulkan_rhi.h"
 #include "runtime/function/render/interface/vulkan/vulkan_util.h"
 
-#include <map>
 #include <stdexcept>
 
 #include <axis_frag.h>
@@ -2102,31 +2101,7 @@ namespace Piccolo
 
     void MainCameraPass::drawMeshGbuffer()
     {
-        struct MeshNode
-        {
-            const Matrix4x4* model_matrix {nullptr};
-            const Matrix4x4* joint_matrices {nullptr};
-            uint32_t         joint_count {0};
-        };
-
-        std::map<VulkanPBRMaterial*, std::map<VulkanMesh*, std::vector<MeshNode>>> main_camera_mesh_drawcall_batch;
-
-        // reorganize mesh
-        for (RenderMeshNode& node : *(m_visiable_nodes.p_main_camera_visible_mesh_nodes))
-        {
-            auto& mesh_instanced = main_camera_mesh_drawcall_batch[node.ref_material];
-            auto& mesh_nodes     = mesh_instanced[node.ref_mesh];
-
-            MeshNode temp;
-            temp.model_matrix = node.model_matrix;
-            if (node.enable_vertex_blending)
-            {
-                temp.joint_matrices = node.joint_matrices;
-                temp.joint_count    = node.joint_count;
-            }
-
-            mesh_nodes.push_back(temp);
-        }
+        const RenderDrawList& draw_list = *m_visiable_nodes.p_draw_list;
 
         float color[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
         m_rhi->pushEvent(m_rhi->getCurrentCommandBuffer(), "Mesh GBuffer", color);
@@ -2157,173 +2132,151 @@ namespace Piccolo
                 m_global_render_resource->_storage_buffer._global_upload_ringbuffer_memory_pointer) +
             perframe_dynamic_offset)) = m_mesh_perframe_storage_buffer_object;
 
-        for (auto& pair1 : main_camera_mesh_drawcall_batch)
+        // the batches are sorted by material and then mesh, which are only bound when they change
+        VulkanPBRMaterial* bound_material = nullptr;
+        VulkanMesh*        bound_mesh     = nullptr;
+        for (const RenderDrawBatch& batch : draw_list.getBatches(_draw_list_pass_main_camera))
         {
-            VulkanPBRMaterial& material       = (*pair1.first);
-            auto&              mesh_instanced = pair1.second;
+            VulkanPBRMaterial& material = *batch.ref_material;
+            VulkanMesh&        mesh     = *batch.ref_mesh;
 
-            // bind per material
-            m_rhi->cmdBindDescriptorSetsPFN(m_rhi->getCurrentCommandBuffer(),
-                                            RHI_PIPELINE_BIND_POINT_GRAPHICS,
-                                            m_render_pipelines[_render_pipeline_type_mesh_gbuffer].layout,
-                                            2,
-                                            1,
-                                            &material.material_descriptor_set,
-                                            0,
-                                            NULL);
+            if (&material != bound_material)
+            {
+                // bind per material
+                m_rhi->cmdBindDescriptorSetsPFN(m_rhi->getCurrentCommandBuffer(),
+                                                RHI_PIPELINE_BIND_POINT_GRAPHICS,
+                                                m_render_pipelines[_render_pipeline_type_mesh_gbuffer].layout,
+                                                2,
+                                                1,
+                                                &material.material_descriptor_set,
+                                                0,
+                                                NULL);
+                bound_material = &material;
+            }
 
-            // TODO: render from near to far
+            if (&mesh != bound_mesh)
+            {
+                // bind per mesh
+                m_rhi->cmdBindDescriptorSetsPFN(m_rhi->getCurrentCommandBuffer(),
+                                                RHI_PIPELINE_BIND_POINT_GRAPHICS,
+                                                m_render_pipelines[_render_pipeline_type_mesh_gbuffer].layout,
+                                                1,
+                                                1,
+                                                &mesh.mesh_vertex_blending_descriptor_set,
+                                                0,
+                                                NULL);
+
+                RHIBuffer*    vertex_buffers[] = {mesh.mesh_vertex_position_buffer,
+                                                  mesh.mesh_vertex_varying_enable_blending_buffer,
+                                                  mesh.mesh_vertex_varying_buffer};
+                RHIDeviceSize offsets[]        = {0, 0, 0};
+                m_rhi->cmdBindVertexBuffersPFN(m_rhi->getCurrentCommandBuffer(),
+                                               0,
+                                               (sizeof(vertex_buffers) / sizeof(vertex_buffers[0])),
+                                               vertex_buffers,
+                                               offsets);
+                m_rhi->cmdBindIndexBufferPFN(
+                    m_rhi->getCurrentCommandBuffer(), mesh.mesh_index_buffer, 0, mesh.mesh_index_type);
+                bound_mesh = &mesh;
+            }
 
-            for (auto& pair2 : mesh_instanced)
+            // per drawcall storage buffer
+            uint32_t perdrawcall_dynamic_offset =
+                roundUp(m_global_render_resource->_storage_buffer
+                            ._global_upload_ringbuffers_end[m_rhi->getCurrentFrameIndex()],
+                        m_global_render_resource->_storage_buffer._min_storage_buffer_offset_alignment);
+            m_global_render_resource->_storage_buffer._global_upload_ringbuffers_end[m_rhi->getCurrentFrameIndex()] =
+                perdrawcall_dynamic_offset + sizeof(MeshPerdrawcallStorageBufferObject);
+            assert(m_global_render_resource->_storage_buffer
+                       ._global_upload_ringbuffers_end[m_rhi->getCurrentFrameIndex()] <=
+                   (m_global_render_resource->_storage_buffer
+                        ._global_upload_ringbuffers_begin[m_rhi->getCurrentFrameIndex()] +
+                    m_global_render_resource->_storage_buffer
+                        ._global_upload_ringbuffers_size[m_rhi->getCurrentFrameIndex()]));
+
+            MeshPerdrawcallStorageBufferObject& perdrawcall_storage_buffer_object =
+                (*reinterpret_cast<MeshPerdrawcallStorageBufferObject*>(
+                    reinterpret_cast<uintptr_t>(
+                        m_global_render_resource->_storage_buffer._global_upload_ringbuffer_memory_pointer) +
+                    perdrawcall_dynamic_offset));
+            for (uint32_t i = 0; i < batch.instance_count; ++i)
             {
-                VulkanMesh& mesh       = (*pair2.first);
-                auto&       mesh_nodes = pair2.second;
+                perdrawcall_storage_buffer_object.mesh_instances[i].model_matrix =
+                    *draw_list.getInstance(batch.first_instance + i).model_matrix;
+                perdrawcall_storage_buffer_object.mesh_instances[i].enable_vertex_blending =
+                    batch.enable_vertex_blending ? 1.0 : -1.0;
+            }
 
-                uint32_t total_instance_count = static_cast<uint32_t>(mesh_nodes.size());
-                if (total_instance_count > 0)
+            // per drawcall vertex blending storage buffer
+            uint32_t per_drawcall_vertex_blending_dynamic_offset;
+            if (batch.enable_vertex_blending)
+            {
+                per_drawcall_vertex_blending_dynamic_offset =
+                    roundUp(m_global_render_resource->_storage_buffer
+                                ._global_upload_ringbuffers_end[m_rhi->getCurrentFrameIndex()],
+                            m_global_render_resource->_storage_buffer._min_storage_buffer_offset_alignment);
+                m_global_render_resource->_storage_buffer
+                    ._global_upload_ringbuffers_end[m_rhi->getCurrentFrameIndex()] =
+                    per_drawcall_vertex_blending_dynamic_offset +
+                    sizeof(MeshPerdrawcallVertexBlendingStorageBufferObject);
+                assert(m_global_render_resource->_storage_buffer
+                           ._global_upload_ringbuffers_end[m_rhi->getCurrentFrameIndex()] <=
+                       (m_global_render_resource->_storage_buffer
+                            ._global_upload_ringbuffers_begin[m_rhi->getCurrentFrameIndex()] +
+                        m_global_render_resource->_storage_buffer
+                            ._global_upload_ringbuffers_size[m_rhi->getCurrentFrameIndex()]));
+
+                MeshPerdrawcallVertexBlendingStorageBufferObject& per_drawcall_vertex_blending_storage_buffer_object =
+                    (*reinterpret_cast<MeshPerdrawcallVertexBlendingStorageBufferObject*>(
+                        reinterpret_cast<uintptr_t>(
+                            m_global_render_resource->_storage_buffer._global_upload_ringbuffer_memory_pointer) +
+                        per_drawcall_vertex_blending_dynamic_offset));
+                for (uint32_t i = 0; i < batch.instance_count; ++i)
                 {
-                    // bind per mesh
-                    m_rhi->cmdBindDescriptorSetsPFN(m_rhi->getCurrentCommandBuffer(),
-                                                    RHI_PIPELINE_BIND_POINT_GRAPHICS,
-                                                    m_render_pipelines[_render_pipeline_type_mesh_gbuffer].layout,
-                                                    1,
-                                                    1,
-                                                    &mesh.mesh_vertex_blending_descriptor_set,
-                                                    0,
-                                                    NULL);
-
-
-                    RHIBuffer* vertex_buffers[] = {mesh.mesh_vertex_position_buffer,
-                                                 mesh.mesh_vertex_varying_enable_blending_buffer,
-                                                 mesh.mesh_vertex_varying_buffer};
-                    RHIDeviceSize offsets[]        = {0, 0, 0};
-                    m_rhi->cmdBindVertexBuffersPFN(m_rhi->getCurrentCommandBuffer(),
-                                                   0,
-                                                   (sizeof(vertex_buffers) / sizeof(vertex_buffers[0])),
-                                                   vertex_buffers,
-                                                   offsets);
-                    m_rhi->cmdBindIndexBufferPFN(m_rhi->getCurrentCommandBuffer(), mesh.mesh_index_buffer, 0, RHI_INDEX_TYPE_UINT16);
-
-                    uint32_t drawcall_max_instance_count =
-                        (sizeof(MeshPerdrawcallStorageBufferObject::mesh_instances) /
-                         sizeof(MeshPerdrawcallStorageBufferObject::mesh_instances[0]));
-                    uint32_t drawcall_count =
-                        roundUp(total_instance_count, drawcall_max_instance_count) / drawcall_max_instance_count;
-
-                    for (uint32_t drawcall_index = 0; drawcall_index < drawcall_count; ++drawcall_index)
+                    const RenderMeshNode& node = draw_list.getInstance(batch.first_instance + i);
+                    for (uint32_t j = 0; j < node.joint_count; ++j)
                     {
-                        uint32_t current_instance_count =
-                            ((total_instance_count - drawcall_max_instance_count * drawcall_index) <
-                             drawcall_max_instance_count) ?
-                                (total_instance_count - drawcall_max_instance_count * drawcall_index) :
-                                drawcall_max_instance_count;
-
-                        // per drawcall storage buffer
-                        uint32_t perdrawcall_dynamic_offset =
-                            roundUp(m_global_render_resource->_storage_buffer
-                                        ._global_upload_ringbuffers_end[m_rhi->getCurrentFrameIndex()],
-                                    m_global_render_resource->_storage_buffer._min_storage_buffer_offset_alignment);
-                        m_global_render_resource->_storage_buffer
-                            ._global_upload_ringbuffers_end[m_rhi->getCurrentFrameIndex()] =
-                            perdrawcall_dynamic_offset + sizeof(MeshPerdrawcallStorageBufferObject);
-                        assert(m_global_render_resource->_storage_buffer
-                                   ._global_upload_ringbuffers_end[m_rhi->getCurrentFrameIndex()] <=
-                               (m_global_render_resource->_storage_buffer
-                                    ._global_upload_ringbuffers_begin[m_rhi->getCurrentFrameIndex()] +
-                                m_global_render_resource->_storage_buffer
-                                    ._global_upload_ringbuffers_size[m_rhi->getCurrentFrameIndex()]));
-
-                        MeshPerdrawcallStorageBufferObject& perdrawcall_storage_buffer_object =
-                            (*reinterpret_cast<MeshPerdrawcallStorageBufferObject*>(
-                                reinterpret_cast<uintptr_t>(m_global_render_resource->_storage_buffer
-                                                                ._global_upload_ringbuffer_memory_pointer) +
-                                perdrawcall_dynamic_offset));
-                        for (uint32_t i = 0; i < current_instance_count; ++i)
-                        {
-                            perdrawcall_storage_buffer_object.mesh_instances[i].model_matrix =
-                                *mesh_nodes[drawcall_max_instance_count * drawcall_index + i].model_matrix;
-                            perdrawcall_storage_buffer_object.mesh_instances[i].enable_vertex_blending =
-                                mesh_nodes[drawcall_max_instance_count * drawcall_index + i].joint_matrices ? 1.0 :
-                                                                                                              -1.0;
-                        }
-
-                        // per drawcall vertex blending storage buffer
-                        uint32_t per_drawcall_vertex_blending_dynamic_offset;
-                        bool     least_one_enable_vertex_blending = true;
-                        for (uint32_t i = 0; i < current_instance_count; ++i)
-                        {
-                            if (!mesh_nodes[drawcall_max_instance_count * drawcall_index + i].joint_matrices)
-                            {
-                                least_one_enable_vertex_blending = false;
-                                break;
-                            }
-                        }
-                        if (least_one_enable_vertex_blending)
-                        {
-                            per_drawcall_vertex_blending_dynamic_offset =
-                                roundUp(m_global_render_resource->_storage_buffer
-                                            ._global_upload_ringbuffers_end[m_rhi->getCurrentFrameIndex()],
-                                        m_global_render_resource->_storage_buffer._min_storage_buffer_offset_alignment);
-                            m_global_render_resource->_storage_buffer
-                                ._global_upload_ringbuffers_end[m_rhi->getCurrentFrameIndex()] =
-                                per_drawcall_vertex_blending_dynamic_offset +
-                                sizeof(MeshPerdrawcallVertexBlendingStorageBufferObject);
-                            assert(m_global_render_resource->_storage_buffer
-                                       ._global_upload_ringbuffers_end[m_rhi->getCurrentFrameIndex()] <=
-                                   (m_global_render_resource->_storage_buffer
-                                        ._global_upload_ringbuffers_begin[m_rhi->getCurrentFrameIndex()] +
-                                    m_global_render_resource->_storage_buffer
-                                        ._global_upload_ringbuffers_size[m_rhi->getCurrentFrameIndex()]));
-
-                            MeshPerdrawcallVertexBlendingStorageBufferObject&
-                                per_drawcall_vertex_blending_storage_buffer_object =
-                                    (*reinterpret_cast<MeshPerdrawcallVertexBlendingStorageBufferObject*>(
-                                        reinterpret_cast<uintptr_t>(m_global_render_resource->_storage_buffer
-                                                                        ._global_upload_ringbuffer_memory_pointer) +
-                                        per_drawcall_vertex_blending_dynamic_offset));
-                            for (uint32_t i = 0; i < current_instance_count; ++i)
-                            {
-                                if (mesh_nodes[drawcall_max_instance_count * drawcall_index + i].joint_matrices)
-                                {
-                                    for (uint32_t j = 0;
-                                         j < mesh_nodes[drawcall_max_instance_count * drawcall_index + i].joint_count;
-                                         ++j)
-                                    {
-                                        per_drawcall_vertex_blending_storage_buffer_object
-                                            .joint_matrices[s_mesh_vertex_blending_max_joint_count * i + j] =
-                                            mesh_nodes[drawcall_max_instance_count * drawcall_index + i]
-                                                .joint_matrices[j];
-                                    }
-                                }
-                            }
-                        }
-                        else
-                        {
-                            per_drawcall_vertex_blending_dynamic_offset = 0;
-                        }
-
-                        // bind perdrawcall
-                        uint32_t dynamic_offsets[3] = {perframe_dynamic_offset,
-                                                       perdrawcall_dynamic_offset,
-                                                       per_drawcall_vertex_blending_dynamic_offset};
-                        m_rhi->cmdBindDescriptorSetsPFN(m_rhi->getCurrentCommandBuffer(),
-                                                        RHI_PIPELINE_BIND_POINT_GRAPHICS,
-                                                        m_render_pipelines[_render_pipeline_type_mesh_gbuffer].layout,
-                                                        0,
-                                                        1,
-                                                        &m_descriptor_infos[_mesh_global].descriptor_set,
-                                                        3,
-                                                        dynamic_offsets);
-
-                        m_rhi->cmdDrawIndexedPFN(m_rhi->getCurrentCommandBuffer(),
-                                                 mesh.mesh_index_count,
-                                                 current_instance_count,
-                                                 0,
-                                                 0,
-                                                 0);
+                        per_drawcall_vertex_blending_storage_buffer_object
+                            .joint_matrices[s_mesh_vertex_blending_max_joint_count * i + j] = node.joint_matrices[j];
                     }
                 }
             }
+            else
+            {
+                per_drawcall_vertex_blending_dynamic_offset = 0;
+            }
+
+            // bind perdrawcall
+            uint32_t dynamic_offsets[3] = {
+                perframe_dynamic_offset, perdrawcall_dynamic_offset, per_drawcall_vertex_blending_dynamic_offset};
+            m_rhi->cmdBindDescriptorSetsPFN(m_rhi->getCurrentCommandBuffer(),
+                                            RHI_PIPELINE_BIND_POINT_GRAPHICS,
+                                            m_render_pipelines[_render_pipeline_type_mesh_gbuffer].layout,
+                                            0,
+                                            1,
+                                            &m_descriptor_infos[_mesh_global].descriptor_set,
+                                            3,
+                                            dynamic_offsets);
+
+            const RenderMeshNode& first_node = draw_list.getInstance(batch.first_instance);
+            if (batch.instance_count == 1 && first_node.draw_range_count > 0)
+            {
+                // a single instance only draws the meshlets left by the culling
+                for (uint32_t i = 0; i < first_node.draw_range_count; ++i)
+                {
+                    m_rhi->cmdDrawIndexedPFN(m_rhi->getCurrentCommandBuffer(),
+                                             first_node.draw_ranges[i].index_count,
+                                             1,
+                                             first_node.draw_ranges[i].first_index,
+                                             0,
+                                             0);
+                }
+            }
+            else
+            {
+                m_rhi->cmdDrawIndexedPFN(
+                    m_rhi->getCurrentCommandBuffer(), mesh.mesh_index_count, batch.instance_count, 0, 0, 0);
+            }
         }
 
         m_rhi->popEvent(m_rhi->getCurrentCommandBuffer());
@@ -2375,31 +2328,7 @@ namespace Piccolo
 
     void MainCameraPass::drawMeshLighting()
     {
-        struct MeshNode
-        {
-            const Matrix4x4* model_matrix {nullptr};
-            const Matrix4x4* joint_matrices {nullptr};
-            uint32_t         joint_count {0};
-        };
-
-        std::map<VulkanPBRMaterial*, std::map<VulkanMesh*, std::vector<MeshNode>>> main_camera_mesh_drawcall_batch;
-
-        // reorganize mesh
-        for (RenderMeshNode& node : *(m_visiable_nodes.p_main_camera_visible_mesh_nodes))
-        {
-            auto& mesh_instanced = main_camera_mesh_drawcall_batch[node.ref_material];
-            auto& mesh_nodes     = mesh_instanced[node.ref_mesh];
-
-            MeshNode temp;
-            temp.model_matrix = node.model_matrix;
-            if (node.enable_vertex_blending)
-            {
-                temp.joint_matrices = node.joint_matrices;
-                temp.joint_count    = node.joint_count;
-            }
-
-            mesh_nodes.push_back(temp);
-        }
+        const RenderDrawList& draw_list = *m_visiable_nodes.p_draw_list;
 
         float color[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
         m_rhi->pushEvent(m_rhi->getCurrentCommandBuffer(), "Model", color);
@@ -2430,172 +2359,151 @@ namespace Piccolo
                 m_global_render_resource->_storage_buffer._global_upload_ringbuffer_memory_pointer) +
             perframe_dynamic_offset)) = m_mesh_perframe_storage_buffer_object;
 
-        for (auto& pair1 : main_camera_mesh_drawcall_batch)
+        // the batches are sorted by material and then mesh, which are only bound when they change
+        VulkanPBRMaterial* bound_material = nullptr;
+        VulkanMesh*        bound_mesh     = nullptr;
+        for (const RenderDrawBatch& batch : draw_list.getBatches(_draw_list_pass_main_camera))
         {
-            VulkanPBRMaterial& material       = (*pair1.first);
-            auto&              mesh_instanced = pair1.second;
+            VulkanPBRMaterial& material = *batch.ref_material;
+            VulkanMesh&        mesh     = *batch.ref_mesh;
 
-            // bind per material
-            m_rhi->cmdBindDescriptorSetsPFN(m_rhi->getCurrentCommandBuffer(),
-                                            RHI_PIPELINE_BIND_POINT_GRAPHICS,
-                                            m_render_pipelines[_render_pipeline_type_mesh_lighting].layout,
-                                            2,
-                                            1,
-                                            &material.material_descriptor_set,
-                                            0,
-                                            NULL);
+            if (&material != bound_material)
+            {
+                // bind per material
+                m_rhi->cmdBindDescriptorSetsPFN(m_rhi->getCurrentCommandBuffer(),
+                                                RHI_PIPELINE_BIND_POINT_GRAPHICS,
+                                                m_render_pipelines[_render_pipeline_type_mesh_lighting].layout,
+                                                2,
+                                                1,
+                                                &material.material_descriptor_set,
+                                                0,
+                                                NULL);
+                bound_material = &material;
+            }
 
-            // TODO: render from near to far
+            if (&mesh != bound_mesh)
+            {
+                // bind per mesh
+                m_rhi->cmdBindDescriptorSetsPFN(m_rhi->getCurrentCommandBuffer(),
+                                                RHI_PIPELINE_BIND_POINT_GRAPHICS,
+                                                m_render_pipelines[_render_pipeline_type_mesh_lighting].layout,
+                                                1,
+                                                1,
+                                                &mesh.mesh_vertex_blending_descriptor_set,
+                                                0,
+                                                NULL);
+
+                RHIBuffer*    vertex_buffers[] = {mesh.mesh_vertex_position_buffer,
+                                                  mesh.mesh_vertex_varying_enable_blending_buffer,
+                                                  mesh.mesh_vertex_varying_buffer};
+                RHIDeviceSize offsets[]        = {0, 0, 0};
+                m_rhi->cmdBindVertexBuffersPFN(m_rhi->getCurrentCommandBuffer(),
+                                               0,
+                                               (sizeof(vertex_buffers) / sizeof(vertex_buffers[0])),
+                                               vertex_buffers,
+                                               offsets);
+                m_rhi->cmdBindIndexBufferPFN(
+                    m_rhi->getCurrentCommandBuffer(), mesh.mesh_index_buffer, 0, mesh.mesh_index_type);
+                bound_mesh = &mesh;
+            }
 
-            for (auto& pair2 : mesh_instanced)
+            // per drawcall storage buffer
+            uint32_t perdrawcall_dynamic_offset =
+                roundUp(m_global_render_resource->_storage_buffer
+                            ._global_upload_ringbuffers_end[m_rhi->getCurrentFrameIndex()],
+                        m_global_render_resource->_storage_buffer._min_storage_buffer_offset_alignment);
+            m_global_render_resource->_storage_buffer._global_upload_ringbuffers_end[m_rhi->getCurrentFrameIndex()] =
+                perdrawcall_dynamic_offset + sizeof(MeshPerdrawcallStorageBufferObject);
+            assert(m_global_render_resource->_storage_buffer
+                       ._global_upload_ringbuffers_end[m_rhi->getCurrentFrameIndex()] <=
+                   (m_global_render_resource->_storage_buffer
+                        ._global_upload_ringbuffers_begin[m_rhi->getCurrentFrameIndex()] +
+                    m_global_render_resource->_storage_buffer
+                        ._global_upload_ringbuffers_size[m_rhi->getCurrentFrameIndex()]));
+
+            MeshPerdrawcallStorageBufferObject& perdrawcall_storage_buffer_object =
+                (*reinterpret_cast<MeshPerdrawcallStorageBufferObject*>(
+                    reinterpret_cast<uintptr_t>(
+                        m_global_render_resource->_storage_buffer._global_upload_ringbuffer_memory_pointer) +
+                    perdrawcall_dynamic_offset));
+            for (uint32_t i = 0; i < batch.instance_count; ++i)
             {
-                VulkanMesh& mesh       = (*pair2.first);
-                auto&       mesh_nodes = pair2.second;
+                perdrawcall_storage_buffer_object.mesh_instances[i].model_matrix =
+                    *draw_list.getInstance(batch.first_instance + i).model_matrix;
+                perdrawcall_storage_buffer_object.mesh_instances[i].enable_vertex_blending =
+                    batch.enable_vertex_blending ? 1.0 : -1.0;
+            }
 
-                uint32_t total_instance_count = static_cast<uint32_t>(mesh_nodes.size());
-                if (total_instance_count > 0)
+            // per drawcall vertex blending storage buffer
+            uint32_t per_drawcall_vertex_blending_dynamic_offset;
+            if (batch.enable_vertex_blending)
+            {
+                per_drawcall_vertex_blending_dynamic_offset =
+                    roundUp(m_global_render_resource->_storage_buffer
+                                ._global_upload_ringbuffers_end[m_rhi->getCurrentFrameIndex()],
+                            m_global_render_resource->_storage_buffer._min_storage_buffer_offset_alignment);
+                m_global_render_resource->_storage_buffer
+                    ._global_upload_ringbuffers_end[m_rhi->getCurrentFrameIndex()] =
+                    per_drawcall_vertex_blending_dynamic_offset +
+                    sizeof(MeshPerdrawcallVertexBlendingStorageBufferObject);
+                assert(m_global_render_resource->_storage_buffer
+                           ._global_upload_ringbuffers_end[m_rhi->getCurrentFrameIndex()] <=
+                       (m_global_render_resource->_storage_buffer
+                            ._global_upload_ringbuffers_begin[m_rhi->getCurrentFrameIndex()] +
+                        m_global_render_resource->_storage_buffer
+                            ._global_upload_ringbuffers_size[m_rhi->getCurrentFrameIndex()]));
+
+                MeshPerdrawcallVertexBlendingStorageBufferObject& per_drawcall_vertex_blending_storage_buffer_object =
+                    (*reinterpret_cast<MeshPerdrawcallVertexBlendingStorageBufferObject*>(
+                        reinterpret_cast<uintptr_t>(
+                            m_global_render_resource->_storage_buffer._global_upload_ringbuffer_memory_pointer) +
+                        per_drawcall_vertex_blending_dynamic_offset));
+                for (uint32_t i = 0; i < batch.instance_count; ++i)
                 {
-                    // bind per mesh
-                    m_rhi->cmdBindDescriptorSetsPFN(m_rhi->getCurrentCommandBuffer(),
-                                                    RHI_PIPELINE_BIND_POINT_GRAPHICS,
-                                                    m_render_pipelines[_render_pipeline_type_mesh_lighting].layout,
-                                                    1,
-                                                    1,
-                                                    &mesh.mesh_vertex_blending_descriptor_set,
-                                                    0,
-                                                    NULL);
-
-                    RHIBuffer*     vertex_buffers[3] = {mesh.mesh_vertex_position_buffer,
-                                                 mesh.mesh_vertex_varying_enable_blending_buffer,
-                                                 mesh.mesh_vertex_varying_buffer};
-                    RHIDeviceSize offsets[]        = {0, 0, 0};
-                    m_rhi->cmdBindVertexBuffersPFN(m_rhi->getCurrentCommandBuffer(),
-                                                   0,
-                                                   (sizeof(vertex_buffers) / sizeof(vertex_buffers[0])),
-                                                   vertex_buffers,
-                                                   offsets);
-                    m_rhi->cmdBindIndexBufferPFN(m_rhi->getCurrentCommandBuffer(), mesh.mesh_index_buffer, 0, RHI_INDEX_TYPE_UINT16);
-
-                    uint32_t drawcall_max_instance_count =
-                        (sizeof(MeshPerdrawcallStorageBufferObject::mesh_instances) /
-                         sizeof(MeshPerdrawcallStorageBufferObject::mesh_instances[0]));
-                    uint32_t drawcall_count =
-                        roundUp(total_instance_count, drawcall_max_instance_count) / drawcall_max_instance_count;
-
-                    for (uint32_t drawcall_index = 0; drawcall_index < drawcall_count; ++drawcall_index)
+                    const RenderMeshNode& node = draw_list.getInstance(batch.first_instance + i);
+                    for (uint32_t j = 0; j < node.joint_count; ++j)
                     {
-                        uint32_t current_instance_count =
-                            ((total_instance_count - drawcall_max_instance_count * drawcall_index) <
-                             drawcall_max_instance_count) ?
-                                (total_instance_count - drawcall_max_instance_count * drawcall_index) :
-                                drawcall_max_instance_count;
-
-                        // per drawcall storage buffer
-                        uint32_t perdrawcall_dynamic_offset =
-                            roundUp(m_global_render_resource->_storage_buffer
-                                        ._global_upload_ringbuffers_end[m_rhi->getCurrentFrameIndex()],
-                                    m_global_render_resource->_storage_buffer._min_storage_buffer_offset_alignment);
-                        m_global_render_resource->_storage_buffer
-                            ._global_upload_ringbuffers_end[m_rhi->getCurrentFrameIndex()] =
-                            perdrawcall_dynamic_offset + sizeof(MeshPerdrawcallStorageBufferObject);
-                        assert(m_global_render_resource->_storage_buffer
-                                   ._global_upload_ringbuffers_end[m_rhi->getCurrentFrameIndex()] <=
-                               (m_global_render_resource->_storage_buffer
-                                    ._global_upload_ringbuffers_begin[m_rhi->getCurrentFrameIndex()] +
-                                m_global_render_resource->_storage_buffer
-                                    ._global_upload_ringbuffers_size[m_rhi->getCurrentFrameIndex()]));
-
-                        MeshPerdrawcallStorageBufferObject& perdrawcall_storage_buffer_object =
-                            (*reinterpret_cast<MeshPerdrawcallStorageBufferObject*>(
-                                reinterpret_cast<uintptr_t>(m_global_render_resource->_storage_buffer
-                                                                ._global_upload_ringbuffer_memory_pointer) +
-                                perdrawcall_dynamic_offset));
-                        for (uint32_t i = 0; i < current_instance_count; ++i)
-                        {
-                            perdrawcall_storage_buffer_object.mesh_instances[i].model_matrix =
-                                *mesh_nodes[drawcall_max_instance_count * drawcall_index + i].model_matrix;
-                            perdrawcall_storage_buffer_object.mesh_instances[i].enable_vertex_blending =
-                                mesh_nodes[drawcall_max_instance_count * drawcall_index + i].joint_matrices ? 1.0 :
-                                                                                                              -1.0;
-                        }
-
-                        // per drawcall vertex blending storage buffer
-                        uint32_t per_drawcall_vertex_blending_dynamic_offset;
-                        bool     least_one_enable_vertex_blending = true;
-                        for (uint32_t i = 0; i < current_instance_count; ++i)
-                        {
-                            if (!mesh_nodes[drawcall_max_instance_count * drawcall_index + i].joint_matrices)
-                            {
-                                least_one_enable_vertex_blending = false;
-                                break;
-                            }
-                        }
-                        if (least_one_enable_vertex_blending)
-                        {
-                            per_drawcall_vertex_blending_dynamic_offset =
-                                roundUp(m_global_render_resource->_storage_buffer
-                                            ._global_upload_ringbuffers_end[m_rhi->getCurrentFrameIndex()],
-                                        m_global_render_resource->_storage_buffer._min_storage_buffer_offset_alignment);
-                            m_global_render_resource->_storage_buffer
-                                ._global_upload_ringbuffers_end[m_rhi->getCurrentFrameIndex()] =
-                                per_drawcall_vertex_blending_dynamic_offset +
-                                sizeof(MeshPerdrawcallVertexBlendingStorageBufferObject);
-                            assert(m_global_render_resource->_storage_buffer
-                                       ._global_upload_ringbuffers_end[m_rhi->getCurrentFrameIndex()] <=
-                                   (m_global_render_resource->_storage_buffer
-                                        ._global_upload_ringbuffers_begin[m_rhi->getCurrentFrameIndex()] +
-                                    m_global_render_resource->_storage_buffer
-                                        ._global_upload_ringbuffers_size[m_rhi->getCurrentFrameIndex()]));
-
-                            MeshPerdrawcallVertexBlendingStorageBufferObject&
-                                per_drawcall_vertex_blending_storage_buffer_object =
-                                    (*reinterpret_cast<MeshPerdrawcallVertexBlendingStorageBufferObject*>(
-                                        reinterpret_cast<uintptr_t>(m_global_render_resource->_storage_buffer
-                                                                        ._global_upload_ringbuffer_memory_pointer) +
-                                        per_drawcall_vertex_blending_dynamic_offset));
-                            for (uint32_t i = 0; i < current_instance_count; ++i)
-                            {
-                                if (mesh_nodes[drawcall_max_instance_count * drawcall_index + i].joint_matrices)
-                                {
-                                    for (uint32_t j = 0;
-                                         j < mesh_nodes[drawcall_max_instance_count * drawcall_index + i].joint_count;
-                                         ++j)
-                                    {
-                                        per_drawcall_vertex_blending_storage_buffer_object
-                                            .joint_matrices[s_mesh_vertex_blending_max_joint_count * i + j] =
-                                            mesh_nodes[drawcall_max_instance_count * drawcall_index + i]
-                                                .joint_matrices[j];
-                                    }
-                                }
-                            }
-                        }
-                        else
-                        {
-                            per_drawcall_vertex_blending_dynamic_offset = 0;
-                        }
-
-                        // bind perdrawcall
-                        uint32_t dynamic_offsets[3] = {perframe_dynamic_offset,
-                                                       perdrawcall_dynamic_offset,
-                                                       per_drawcall_vertex_blending_dynamic_offset};
-                        m_rhi->cmdBindDescriptorSetsPFN(m_rhi->getCurrentCommandBuffer(),
-                                                        RHI_PIPELINE_BIND_POINT_GRAPHICS,
-                                                        m_render_pipelines[_render_pipeline_type_mesh_lighting].layout,
-                                                        0,
-                                                        1,
-                                                        &m_descriptor_infos[_mesh_global].descriptor_set,
-                                                        3,
-                                                        dynamic_offsets);
-
-                        m_rhi->cmdDrawIndexedPFN(m_rhi->getCurrentCommandBuffer(),
-                                                 mesh.mesh_index_count,
-                                                 current_instance_count,
-                                                 0,
-                                                 0,
-                                                 0);
+                        per_drawcall_vertex_blending_storage_buffer_object
+                            .joint_matrices[s_mesh_vertex_blending_max_joint_count * i + j] = node.joint_matrices[j];
                     }
                 }
             }
+            else
+            {
+                per_drawcall_vertex_blending_dynamic_offset = 0;
+            }
+
+            // bind perdrawcall
+            uint32_t dynamic_offsets[3] = {
+                perframe_dynamic_offset, perdrawcall_dynamic_offset, per_drawcall_vertex_blending_dynamic_offset};
+            m_rhi->cmdBindDescriptorSetsPFN(m_rhi->getCurrentCommandBuffer(),
+                                            RHI_PIPELINE_BIND_POINT_GRAPHICS,
+                                            m_render_pipelines[_render_pipeline_type_mesh_lighting].layout,
+                                            0,
+                                            1,
+                                            &m_descriptor_infos[_mesh_global].descriptor_set,
+                                            3,
+                                            dynamic_offsets);
+
+            const RenderMeshNode& first_node = draw_list.getInstance(batch.first_instance);
+            if (batch.instance_count == 1 && first_node.draw_range_count > 0)
+            {
+                // a single instance only draws the meshlets left by the culling
+                for (uint32_t i = 0; i < first_node.draw_range_count; ++i)
+                {
+                    m_rhi->cmdDrawIndexedPFN(m_rhi->getCurrentCommandBuffer(),
+                                             first_node.draw_ranges[i].index_count,
+                                             1,
+                                             first_node.draw_ranges[i].first_index,
+                                             0,
+                                             0);
+                }
+            }
+            else
+            {
+                m_rhi->cmdDrawIndexedPFN(
+                    m_rhi->getCurrentCommandBuffer(), mesh.mesh_index_count, batch.instance_count, 0, 0, 0);
+            }
         }
 
         m_rhi->popEvent(m_rhi->getCurrentCommandBuffer());
@@ -2697,7 +2605,7 @@ namespace Piccolo
         m_rhi->cmdBindIndexBufferPFN(m_rhi->getCurrentCommandBuffer(),
                                      m_visiable_nodes.p_axis_node->ref_mesh->mesh_index_buffer,
                                      0,
-                                     RHI_INDEX_TYPE_UINT16);
+                                     m_visiable_nodes.p_axis_node->ref_mesh->mesh_index_type);
         (*reinterpret_cast<AxisStorageBufferObject*>(reinterpret_cast<uintptr_t>(
             m_global_render_resource->_storage_buffer._axis_inefficient_storage_buffer_memory_pointer))) =
             m_axis_storage_buffer_object;
@@ -8,6 +8,7 @@
 #include "runtime/function/render/render_system.h"
 
 #include "core/base/macro.h"
+#include <algorithm>
 #include <fstream>
 
 #include "particle_emit_comp.h"
@@ -303,13 +304,16 @@ namespace Piccolo
                                1,
                                m_src_normal_image_view);
 
-        updateDescriptorSet();
+        updateDescriptorSet(getCreatedEmitterIds());
     }
 
     void ParticlePass::draw()
     {
         for (int i = 0; i < m_emitter_count; ++i)
         {
+            if (!m_emitter_buffer_batches[i].m_is_created)
+                continue;
+
             float color[4] = {1.0f, 1.0f, 1.0f, 1.0f};
             m_rhi->pushEvent(m_render_command_buffer, "ParticleBillboard", color);
 
@@ -344,7 +348,9 @@ namespace Piccolo
                                      m_particle_billboard_texture_resource->m_width,
                                      m_particle_billboard_texture_resource->m_height,
                                      m_particle_billboard_texture_resource->m_pixels,
-                                     m_particle_billboard_texture_resource->m_format);
+                                     m_particle_billboard_texture_resource->m_format,
+                                     0,
+                                     m_particle_billboard_texture_resource->m_mip_levels);
         }
 
         // piccolo texture
@@ -357,7 +363,9 @@ namespace Piccolo
                                      m_piccolo_logo_texture_resource->m_width,
                                      m_piccolo_logo_texture_resource->m_height,
                                      m_piccolo_logo_texture_resource->m_pixels,
-                                     m_piccolo_logo_texture_resource->m_format);
+                                     m_piccolo_logo_texture_resource->m_format,
+                                     0,
+                                     m_piccolo_logo_texture_resource->m_mip_levels);
         }
 
         m_rhi->createImage(m_rhi->getSwapchainInfo().extent.width,
@@ -401,10 +409,14 @@ namespace Piccolo
                                m_src_normal_image_view);
     }
 
-    void ParticlePass::setupParticleDescriptorSet()
+    void ParticlePass::setupParticleDescriptorSet(const std::vector<int>& emitter_ids)
     {
-        for (int eid = 0; eid < m_emitter_count; ++eid)
+        for (int eid : emitter_ids)
         {
+            // the descriptor sets of an id are reused by the emitters of the next levels
+            if (m_descriptor_infos[eid * 3 + 2].descriptor_set != nullptr)
+                continue;
+
             RHIDescriptorSetAllocateInfo particlebillboard_global_descriptor_set_alloc_info;
             particlebillboard_global_descriptor_set_alloc_info.sType = RHI_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
             particlebillboard_global_descriptor_set_alloc_info.pNext = NULL;
@@ -491,17 +503,57 @@ namespace Piccolo
 
     void ParticlePass::setEmitterCount(int count)
     {
-        for (int i = 0; i < m_emitter_buffer_batches.size(); ++i)
-        {
-            m_emitter_buffer_batches[i].freeUpBatch(m_rhi);
-        }
+        if (count <= m_emitter_count)
+            return;
 
         m_emitter_count = count;
         m_emitter_buffer_batches.resize(m_emitter_count);
     }
 
+    void ParticlePass::clearEmitters()
+    {
+        for (ParticleEmitterBufferBatch& batch : m_emitter_buffer_batches)
+        {
+            if (batch.m_is_created)
+            {
+                batch.freeUpBatch(m_rhi);
+            }
+        }
+
+        m_emitter_count = 0;
+        m_emitter_buffer_batches.clear();
+        m_uninitialized_emitter_ids.clear();
+        m_emitter_tick_indices.clear();
+        m_emitter_transform_indices.clear();
+    }
+
+    std::vector<int> ParticlePass::getCreatedEmitterIds() const
+    {
+        std::vector<int> emitter_ids;
+        for (int eid = 0; eid < m_emitter_count; ++eid)
+        {
+            if (m_emitter_buffer_batches[eid].m_is_created)
+            {
+                emitter_ids.push_back(eid);
+            }
+        }
+        return emitter_ids;
+    }
+
     void ParticlePass::createEmitter(int id, const ParticleEmitterDesc& desc)
     {
+        if (m_emitter_buffer_batches[id].m_is_created)
+        {
+            // sent again, the emitter starts over
+            m_emitter_buffer_batches[id].freeUpBatch(m_rhi);
+            m_emitter_buffer_batches[id] = ParticleEmitterBufferBatch();
+        }
+        else
+        {
+            m_uninitialized_emitter_ids.push_back(id);
+        }
+        m_emitter_buffer_batches[id].m_is_created = true;
+
         const VkDeviceSize counterBufferSize = sizeof(ParticleCounter);
         ParticleCounter    counter;
         counter.alive_count           = m_emitter_buffer_batches[id].m_num_particle;
@@ -769,9 +821,11 @@ namespace Piccolo
 
     void ParticlePass::initializeEmitters()
     {
-        allocateDescriptorSet();
-        updateDescriptorSet();
-        setupParticleDescriptorSet();
+        // the descriptor sets of the emitters already drawn may be in use by the frames in flight
+        allocateDescriptorSet(m_uninitialized_emitter_ids);
+        updateDescriptorSet(m_uninitialized_emitter_ids);
+        setupParticleDescriptorSet(m_uninitialized_emitter_ids);
+        m_uninitialized_emitter_ids.clear();
     }
 
     void ParticlePass::setupParticlePass()
@@ -1221,15 +1275,19 @@ namespace Piccolo
         }
     }
 
-    void ParticlePass::allocateDescriptorSet()
+    void ParticlePass::allocateDescriptorSet(const std::vector<int>& emitter_ids)
     {
         RHIDescriptorSetAllocateInfo particle_descriptor_set_alloc_info;
         particle_descriptor_set_alloc_info.sType          = RHI_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
         particle_descriptor_set_alloc_info.descriptorPool = m_rhi->getDescriptorPoor();
 
-        m_descriptor_infos.resize(3 * m_emitter_count);
-        for (int eid = 0; eid < m_emitter_count; ++eid)
+        // the first three hold the layouts
+        m_descriptor_infos.resize(std::max<size_t>(m_descriptor_infos.size(), 3 * m_emitter_count));
+        for (int eid : emitter_ids)
         {
+            if (m_descriptor_infos[eid * 3].descriptor_set != nullptr)
+                continue;
+
             particle_descriptor_set_alloc_info.pSetLayouts        = &m_descriptor_infos[0].layout;
             particle_descriptor_set_alloc_info.descriptorSetCount = 1;
             particle_descriptor_set_alloc_info.pNext              = NULL;
@@ -1247,9 +1305,9 @@ namespace Piccolo
         }
     }
 
-    void ParticlePass::updateDescriptorSet()
+    void ParticlePass::updateDescriptorSet(const std::vector<int>& emitter_ids)
     {
-        for (int eid = 0; eid < m_emitter_count; ++eid)
+        for (int eid : emitter_ids)
         {
             // compute part
             {
@@ -1496,6 +1554,10 @@ namespace Piccolo
     {
         for (auto i : m_emitter_tick_indices)
         {
+            // ticked before the emitter arrived
+            if (i >= m_emitter_buffer_batches.size() || !m_emitter_buffer_batches[i].m_is_created)
+                continue;
+
             RHICommandBufferBeginInfo cmdBufInfo {};
             cmdBufInfo.sType = RHI_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
 
@@ -1895,7 +1957,10 @@ namespace Piccolo
     {
         for (ParticleEmitterTransformDesc& transform_desc : m_emitter_transform_indices)
         {
-            int index                                                 = transform_desc.m_id;
+            int index = transform_desc.m_id;
+            if (index >= m_emitter_count || !m_emitter_buffer_batches[index].m_is_created)
+                continue;
+
             m_emitter_buffer_batches[index].m_emitter_desc.m_position = transform_desc.m_position;
             m_emitter_buffer_batches[index].m_emitter_desc.m_rotation = transform_desc.m_rotation;
 
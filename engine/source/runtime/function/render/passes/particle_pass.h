@@ -42,7 +42,9 @@ namespace Piccolo
         ParticleEmitterDesc m_emitter_desc;
 
         uint32_t m_num_particle {0};
-        void     freeUpBatch(std::shared_ptr<RHI> rhi);
+        // the batches are indexed by emitter id, the ids whose emitter did not arrive yet have empty batches
+        bool m_is_created {false};
+        void freeUpBatch(std::shared_ptr<RHI> rhi);
     };
 
     class ParticlePass : public RenderPass
@@ -68,10 +70,15 @@ namespace Piccolo
 
         void updateAfterFramebufferRecreate();
 
+        // grows the batches to count emitters, the emitters created in earlier frames are kept
         void setEmitterCount(int count);
 
+        // frees all the emitters when a level is loaded, its emitter ids start over
+        void clearEmitters();
+
         void createEmitter(int id, const ParticleEmitterDesc& desc);
 
+        // sets up the descriptor sets of the emitters created since the last call
         void initializeEmitters();
 
         void setTickIndices(const std::vector<ParticleEmitterID>& tick_indices);
@@ -91,11 +98,13 @@ namespace Piccolo
 
         void setupPipelines();
 
-        void allocateDescriptorSet();
+        void allocateDescriptorSet(const std::vector<int>& emitter_ids);
+
+        void updateDescriptorSet(const std::vector<int>& emitter_ids);
 
-        void updateDescriptorSet();
+        void setupParticleDescriptorSet(const std::vector<int>& emitter_ids);
 
-        void setupParticleDescriptorSet();
+        std::vector<int> getCreatedEmitterIds() const;
 
         RHIPipeline* m_kickoff_pipeline = nullptr;
         RHIPipeline* m_emit_pipeline = nullptr;
@@ -197,7 +206,9 @@ namespace Piccolo
 
         DefaultRNG m_random_engine;
 
-        int m_emitter_count;
+        int m_emitter_count {0};
+
+        std::vector<int> m_uninitialized_emitter_ids;
 
         static constexpr bool s_verbose_particle_alive_info {false};
 
@@ -47,6 +47,7 @@ namespace Piccolo
 
     void RenderCamera::zoom(float offset)
     {
+        std::lock_guard<std::mutex> lock_guard(m_view_matrix_mutex);
         // > 0 = zoom in (decrease FOV by <offset> angles)
         m_fovx = Math::clamp(m_fovx - offset, MIN_FOV, MAX_FOV);
     }
@@ -102,6 +103,7 @@ namespace Piccolo
 
     void RenderCamera::setAspect(float aspect)
     {
+        std::lock_guard<std::mutex> lock_guard(m_view_matrix_mutex);
         m_aspect = aspect;
 
         // 1 / tan(fovy * 0.5) / aspect = 1 / tan(fovx * 0.5)
@@ -110,4 +112,16 @@ namespace Piccolo
 
         m_fovy = Radian(Math::atan(Math::tan(Radian(Degree(m_fovx) * 0.5f)) / m_aspect) * 2.0f).valueDegrees();
     }
+
+    void RenderCamera::setFOVx(float fovx)
+    {
+        std::lock_guard<std::mutex> lock_guard(m_view_matrix_mutex);
+        m_fovx = fovx;
+    }
+
+    Vector2 RenderCamera::getFOV() const
+    {
+        std::lock_guard<std::mutex> lock_guard(m_view_matrix_mutex);
+        return {m_fovx, m_fovy};
+    }
 } // namespace Piccolo
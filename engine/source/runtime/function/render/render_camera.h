@@ -41,7 +41,7 @@ namespace Piccolo
         void lookAt(const Vector3& position, const Vector3& target, const Vector3& up);
 
         void setAspect(float aspect);
-        void setFOVx(float fovx) { m_fovx = fovx; }
+        void setFOVx(float fovx);
 
         Vector3    position() const { return m_position; }
         Quaternion rotation() const { return m_rotation; }
@@ -49,7 +49,7 @@ namespace Piccolo
         Vector3   forward() const { return (m_invRotation * Y); }
         Vector3   up() const { return (m_invRotation * Z); }
         Vector3   right() const { return (m_invRotation * X); }
-        Vector2   getFOV() const { return {m_fovx, m_fovy}; }
+        Vector2   getFOV() const;
         Matrix4x4 getViewMatrix();
         Matrix4x4 getPersProjMatrix() const;
         Matrix4x4 getLookAtMatrix() const { return Math::makeLookAtMatrix(position(), position() + forward(), up()); }
@@ -60,7 +60,8 @@ namespace Piccolo
         float m_fovx {Degree(89.f).valueDegrees()};
         float m_fovy {0.f};
 
-        std::mutex m_view_matrix_mutex;
+        // the logic thread reads the view matrix and the fov while the render thread updates them
+        mutable std::mutex m_view_matrix_mutex;
     };
 
     inline const Vector3 RenderCamera::X = {1.0f, 0.0f, 0.0f};
@@ -0,0 +1,180 @@
+#include "runtime/function/render/render_command_queue.h"
+
+#include <utility>
+
+namespace Piccolo
+{
+    RenderCommandQueue::RenderCommandQueue() :
+        m_arena(new std::byte[k_initial_arena_size]), m_arena_size(k_initial_arena_size)
+    {}
+
+    RenderCommandQueue::~RenderCommandQueue() { reset(); }
+
+    void RenderCommandQueue::submit(RenderCommand* command) { link(command); }
+
+    void RenderCommandQueue::uploadLevelResource(const LevelResourceDesc& level_resource_desc)
+    {
+        RenderCommandLevelResource* command = allocate<RenderCommandLevelResource>();
+        command->m_level_resource_desc      = level_resource_desc;
+        submit(command);
+    }
+
+    void RenderCommandQueue::addGameObject(GameObjectDesc&& game_object_desc)
+    {
+        RenderCommandAddGameObject* command = allocate<RenderCommandAddGameObject>();
+        command->m_game_object_desc         = std::move(game_object_desc);
+        submit(command);
+    }
+
+    RenderCommandGameObjectTransform* RenderCommandQueue::allocateGameObjectTransform(GObjectID go_id,
+                                                                                      uint32_t  part_count)
+    {
+        RenderCommandGameObjectTransform* command =
+            allocate<RenderCommandGameObjectTransform>(sizeof(Matrix4x4) * part_count);
+        command->m_go_id      = go_id;
+        command->m_part_count = part_count;
+
+        Matrix4x4* part_transforms = command->getPartTransforms();
+        for (uint32_t part_index = 0; part_index < part_count; ++part_index)
+        {
+            new (part_transforms + part_index) Matrix4x4();
+        }
+        return command;
+    }
+
+    void RenderCommandQueue::deleteGameObject(GObjectID go_id)
+    {
+        RenderCommandDeleteGameObject* command = allocate<RenderCommandDeleteGameObject>();
+        command->m_go_id                       = go_id;
+        submit(command);
+    }
+
+    void RenderCommandQueue::updateCamera(const CameraSwapData& camera_swap_data)
+    {
+        RenderCommandCamera* command = allocate<RenderCommandCamera>();
+        command->m_camera_swap_data  = camera_swap_data;
+        submit(command);
+    }
+
+    void RenderCommandQueue::resetParticleEmitters() { submit(allocate<RenderCommandResetParticleEmitters>()); }
+
+    void RenderCommandQueue::addNewParticleEmitter(ParticleEmitterID emitter_id, const ParticleEmitterDesc& emitter_desc)
+    {
+        RenderCommandNewParticleEmitter* command = allocate<RenderCommandNewParticleEmitter>();
+        command->m_emitter_id                    = emitter_id;
+        command->m_emitter_desc                  = emitter_desc;
+        submit(command);
+    }
+
+    void RenderCommandQueue::addTickParticleEmitter(ParticleEmitterID emitter_id)
+    {
+        RenderCommandTickParticleEmitter* command = allocate<RenderCommandTickParticleEmitter>();
+        command->m_emitter_id                     = emitter_id;
+        submit(command);
+    }
+
+    void RenderCommandQueue::updateParticleTransform(const ParticleEmitterTransformDesc& transform_desc)
+    {
+        RenderCommandParticleEmitterTransform* command = allocate<RenderCommandParticleEmitterTransform>();
+        command->m_transform_desc                      = transform_desc;
+        submit(command);
+    }
+
+    RenderCommand* RenderCommandQueue::pop()
+    {
+        RenderCommand* head = m_head;
+        RenderCommand* next = head->m_next.load(std::memory_order_acquire);
+        if (head == &m_stub)
+        {
+            if (next == nullptr)
+                return nullptr;
+
+            m_head = next;
+            head   = next;
+            next   = next->m_next.load(std::memory_order_acquire);
+        }
+
+        if (next != nullptr)
+        {
+            m_head = next;
+            return head;
+        }
+
+        // the head is the last linked command, a producer has already exchanged the tail but not linked yet
+        if (head != m_tail.load(std::memory_order_acquire))
+            return nullptr;
+
+        // the stub goes behind the head so that it can be taken
+        link(&m_stub);
+        next = head->m_next.load(std::memory_order_acquire);
+        if (next != nullptr)
+        {
+            m_head = next;
+            return head;
+        }
+        return nullptr;
+    }
+
+    bool RenderCommandQueue::isEmpty() const
+    {
+        return m_head == &m_stub && m_stub.m_next.load(std::memory_order_acquire) == nullptr;
+    }
+
+    void RenderCommandQueue::reset()
+    {
+        RenderCommand* command = m_destroy_list.exchange(nullptr, std::memory_order_acquire);
+        while (command != nullptr)
+        {
+            RenderCommand* next_to_destroy = command->m_next_to_destroy;
+            command->m_destroy(command);
+            command = next_to_destroy;
+        }
+
+        // the arena grows to what the frame used, the failed reservations of the overflowed commands included
+        const size_t arena_used = m_arena_used.load(std::memory_order_relaxed);
+        if (arena_used > m_arena_size)
+        {
+            while (m_arena_size < arena_used)
+            {
+                m_arena_size *= 2;
+            }
+            m_arena.reset(new std::byte[m_arena_size]);
+        }
+        m_arena_used.store(0, std::memory_order_relaxed);
+        m_overflow_blocks.clear();
+
+        m_stub.m_next.store(nullptr, std::memory_order_relaxed);
+        m_tail.store(&m_stub, std::memory_order_relaxed);
+        m_head = &m_stub;
+    }
+
+    void* RenderCommandQueue::allocateMemory(size_t size)
+    {
+        const size_t aligned_size = (size + k_alignment - 1) & ~(k_alignment - 1);
+        const size_t offset       = m_arena_used.fetch_add(aligned_size, std::memory_order_relaxed);
+        if (offset + aligned_size <= m_arena_size)
+        {
+            return m_arena.get() + offset;
+        }
+
+        std::lock_guard<std::mutex> lock(m_overflow_mutex);
+        m_overflow_blocks.emplace_back(new std::byte[aligned_size]);
+        return m_overflow_blocks.back().get();
+    }
+
+    void RenderCommandQueue::addToDestroyList(RenderCommand* command)
+    {
+        command->m_next_to_destroy = m_destroy_list.load(std::memory_order_relaxed);
+        while (!m_destroy_list.compare_exchange_weak(
+            command->m_next_to_destroy, command, std::memory_order_release, std::memory_order_relaxed))
+        {
+        }
+    }
+
+    void RenderCommandQueue::link(RenderCommand* command)
+    {
+        command->m_next.store(nullptr, std::memory_order_relaxed);
+        RenderCommand* previous = m_tail.exchange(command, std::memory_order_acq_rel);
+        previous->m_next.store(command, std::memory_order_release);
+    }
+} // namespace Piccolo
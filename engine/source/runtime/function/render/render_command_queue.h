@@ -0,0 +1,216 @@
+#pragma once
+
+#include "runtime/function/particle/emitter_id_allocator.h"
+#include "runtime/function/particle/particle_desc.h"
+#include "runtime/function/render/render_camera.h"
+#include "runtime/function/render/render_object.h"
+
+#include "runtime/resource/res_type/global/global_rendering.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace Piccolo
+{
+    struct LevelIBLResourceDesc
+    {
+        SkyBoxIrradianceMap m_skybox_irradiance_map;
+        SkyBoxSpecularMap   m_skybox_specular_map;
+        std::string         m_brdf_map;
+    };
+
+    struct LevelColorGradingResourceDesc
+    {
+        std::string m_color_grading_map;
+    };
+
+    struct LevelResourceDesc
+    {
+        LevelIBLResourceDesc          m_ibl_resource_desc;
+        LevelColorGradingResourceDesc m_color_grading_resource_desc;
+    };
+
+    struct CameraSwapData
+    {
+        std::optional<float>            m_fov_x;
+        std::optional<RenderCameraType> m_camera_type;
+        std::optional<Matrix4x4>        m_view_matrix;
+    };
+
+    enum class RenderCommandType : uint8_t
+    {
+        LevelResource = 0,
+        AddGameObject,
+        GameObjectTransform,
+        DeleteGameObject,
+        Camera,
+        ResetParticleEmitters,
+        NewParticleEmitter,
+        TickParticleEmitter,
+        ParticleEmitterTransform
+    };
+
+    /// Header of the render commands. A command lives in the arena of its queue, m_next links it into the queue
+    /// and the commands with members to destruct are also linked by m_next_to_destroy.
+    struct RenderCommand
+    {
+        RenderCommandType           m_type {RenderCommandType::LevelResource};
+        std::atomic<RenderCommand*> m_next {nullptr};
+        RenderCommand*              m_next_to_destroy {nullptr};
+        void (*m_destroy)(RenderCommand* command) {nullptr};
+    };
+
+    struct RenderCommandLevelResource : public RenderCommand
+    {
+        static constexpr RenderCommandType k_type = RenderCommandType::LevelResource;
+
+        LevelResourceDesc m_level_resource_desc;
+    };
+
+    // sent once per object with the mesh and material sources of its parts, the render side keeps them and the
+    // later moves of the object only send the transforms
+    struct RenderCommandAddGameObject : public RenderCommand
+    {
+        static constexpr RenderCommandType k_type = RenderCommandType::AddGameObject;
+
+        GameObjectDesc m_game_object_desc;
+    };
+
+    // the m_part_count world transforms of the parts follow the command in the arena, in part order
+    struct RenderCommandGameObjectTransform : public RenderCommand
+    {
+        static constexpr RenderCommandType k_type = RenderCommandType::GameObjectTransform;
+
+        GObjectID m_go_id {k_invalid_gobject_id};
+        uint32_t  m_part_count {0};
+
+        Matrix4x4*       getPartTransforms() { return reinterpret_cast<Matrix4x4*>(this + 1); }
+        const Matrix4x4* getPartTransforms() const { return reinterpret_cast<const Matrix4x4*>(this + 1); }
+    };
+
+    struct RenderCommandDeleteGameObject : public RenderCommand
+    {
+        static constexpr RenderCommandType k_type = RenderCommandType::DeleteGameObject;
+
+        GObjectID m_go_id {k_invalid_gobject_id};
+    };
+
+    struct RenderCommandCamera : public RenderCommand
+    {
+        static constexpr RenderCommandType k_type = RenderCommandType::Camera;
+
+        CameraSwapData m_camera_swap_data;
+    };
+
+    // the emitters created after it are those of a new level, their ids start over
+    struct RenderCommandResetParticleEmitters : public RenderCommand
+    {
+        static constexpr RenderCommandType k_type = RenderCommandType::ResetParticleEmitters;
+    };
+
+    struct RenderCommandNewParticleEmitter : public RenderCommand
+    {
+        static constexpr RenderCommandType k_type = RenderCommandType::NewParticleEmitter;
+
+        ParticleEmitterID   m_emitter_id {k_invalid_particke_emmiter_id};
+        ParticleEmitterDesc m_emitter_desc;
+    };
+
+    struct RenderCommandTickParticleEmitter : public RenderCommand
+    {
+        static constexpr RenderCommandType k_type = RenderCommandType::TickParticleEmitter;
+
+        ParticleEmitterID m_emitter_id {k_invalid_particke_emmiter_id};
+    };
+
+    struct RenderCommandParticleEmitterTransform : public RenderCommand
+    {
+        static constexpr RenderCommandType k_type = RenderCommandType::ParticleEmitterTransform;
+
+        ParticleEmitterTransformDesc m_transform_desc;
+    };
+
+    /// Lock-free multi producer single consumer queue of the render commands of a frame.
+    /// Producers on any thread allocate a command from the linear arena of the queue with one atomic add, fill it
+    /// and submit it with one atomic exchange. The consumer pops concurrently with them and gets the commands of
+    /// every producer in the order that producer submitted them. A popped command stays valid until reset, which
+    /// frees all the commands of the frame at once.
+    /// When the arena is full the command is allocated on the heap under a lock, and the next reset grows the arena
+    /// to what the frame used.
+    class RenderCommandQueue
+    {
+    public:
+        RenderCommandQueue();
+        ~RenderCommandQueue();
+
+        RenderCommandQueue(const RenderCommandQueue&) = delete;
+        RenderCommandQueue& operator=(const RenderCommandQueue&) = delete;
+
+        // a command with extra_bytes of trailing data, the consumer does not see it before it is submitted
+        template<typename CommandType>
+        CommandType* allocate(size_t extra_bytes = 0)
+        {
+            static_assert(std::is_base_of<RenderCommand, CommandType>::value, "not a render command");
+            static_assert(alignof(CommandType) <= k_alignment, "render command alignment is too large");
+
+            CommandType* command = new (allocateMemory(sizeof(CommandType) + extra_bytes)) CommandType();
+            command->m_type      = CommandType::k_type;
+            if constexpr (!std::is_trivially_destructible<CommandType>::value)
+            {
+                command->m_destroy = [](RenderCommand* base) { static_cast<CommandType*>(base)->~CommandType(); };
+                addToDestroyList(command);
+            }
+            return command;
+        }
+        void submit(RenderCommand* command);
+
+        void uploadLevelResource(const LevelResourceDesc& level_resource_desc);
+        void addGameObject(GameObjectDesc&& game_object_desc);
+        // the part_count transforms of the command are written before submitting it
+        RenderCommandGameObjectTransform* allocateGameObjectTransform(GObjectID go_id, uint32_t part_count);
+        void                              deleteGameObject(GObjectID go_id);
+        void                              updateCamera(const CameraSwapData& camera_swap_data);
+        void resetParticleEmitters();
+        void addNewParticleEmitter(ParticleEmitterID emitter_id, const ParticleEmitterDesc& emitter_desc);
+        void addTickParticleEmitter(ParticleEmitterID emitter_id);
+        void updateParticleTransform(const ParticleEmitterTransformDesc& transform_desc);
+
+        // consumer side, nullptr when the queue is empty or the command submitted next is not linked yet
+        RenderCommand* pop();
+        bool           isEmpty() const;
+
+        // destroys all the commands, neither the producers nor the consumer may use the queue meanwhile
+        void reset();
+
+    private:
+        static constexpr size_t k_alignment          = alignof(std::max_align_t);
+        static constexpr size_t k_initial_arena_size = 64 * 1024;
+
+        void* allocateMemory(size_t size);
+        void  addToDestroyList(RenderCommand* command);
+        void  link(RenderCommand* command);
+
+        std::unique_ptr<std::byte[]> m_arena;
+        size_t                       m_arena_size {0};
+        std::atomic<size_t>          m_arena_used {0};
+
+        std::mutex                                m_overflow_mutex;
+        std::vector<std::unique_ptr<std::byte[]>> m_overflow_blocks;
+
+        std::atomic<RenderCommand*> m_destroy_list {nullptr};
+
+        // the producers exchange the tail and the consumer owns the head, the stub is linked in whenever the
+        // consumer takes the last command so the list is never empty
+        RenderCommand               m_stub;
+        std::atomic<RenderCommand*> m_tail {&m_stub};
+        RenderCommand*              m_head {&m_stub};
+    };
+} // namespace Piccolo
@@ -10,6 +10,8 @@
 #include <vk_mem_alloc.h>
 #include <vulkan/vulkan.h>
 
+#include <vector>
+
 namespace Piccolo
 {
     static const uint32_t s_point_light_shadow_map_dimension       = 2048;
@@ -193,10 +195,14 @@ namespace Piccolo
         RHIBuffer*    mesh_vertex_varying_buffer;
         VmaAllocation mesh_vertex_varying_buffer_allocation;
 
-        uint32_t mesh_index_count;
+        uint32_t     mesh_index_count;
+        RHIIndexType mesh_index_type {RHI_INDEX_TYPE_UINT16};
 
         RHIBuffer*    mesh_index_buffer;
         VmaAllocation mesh_index_buffer_allocation;
+
+        // covering the index buffer in order, empty for the meshes built in code
+        std::vector<MeshletDataDefinition> mesh_meshlets;
     };
 
     // material
@@ -229,6 +235,12 @@ namespace Piccolo
     };
 
     // nodes
+    struct RenderMeshDrawRange
+    {
+        uint32_t first_index {0};
+        uint32_t index_count {0};
+    };
+
     struct RenderMeshNode
     {
         const Matrix4x4*   model_matrix {nullptr};
@@ -238,6 +250,14 @@ namespace Piccolo
         VulkanPBRMaterial* ref_material {nullptr};
         uint32_t           node_id;
         bool               enable_vertex_blending {false};
+
+        // order the nodes in the draw list
+        size_t mesh_asset_id {0};
+        size_t material_asset_id {0};
+
+        // the index ranges left by the meshlet culling of the main camera, the whole mesh when there are none
+        const RenderMeshDrawRange* draw_ranges {nullptr};
+        uint32_t                   draw_range_count {0};
     };
 
     struct RenderAxisNode
@@ -254,22 +274,27 @@ namespace Piccolo
         uint32_t           base_color_image_width;
         uint32_t           base_color_image_height;
         RHIFormat base_color_image_format;
+        uint32_t           base_color_image_miplevels;
         void*              metallic_roughness_image_pixels;
         uint32_t           metallic_roughness_image_width;
         uint32_t           metallic_roughness_image_height;
         RHIFormat metallic_roughness_image_format;
+        uint32_t           metallic_roughness_image_miplevels;
         void*              normal_roughness_image_pixels;
         uint32_t           normal_roughness_image_width;
         uint32_t           normal_roughness_image_height;
         RHIFormat normal_roughness_image_format;
+        uint32_t           normal_roughness_image_miplevels;
         void*              occlusion_image_pixels;
         uint32_t           occlusion_image_width;
         uint32_t           occlusion_image_height;
         RHIFormat occlusion_image_format;
+        uint32_t           occlusion_image_miplevels;
         void*              emissive_image_pixels;
         uint32_t           emissive_image_width;
         uint32_t           emissive_image_height;
         RHIFormat emissive_image_format;
+        uint32_t           emissive_image_miplevels;
         VulkanPBRMaterial* now_material;
     };
 } // namespace Piccolo
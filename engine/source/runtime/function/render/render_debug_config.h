@@ -16,9 +16,14 @@ namespace Piccolo
         {
             bool show_bounding_box = false;
         };
+        struct Performance
+        {
+            bool show_tick_time = false;
+        };
 
         Animation animation;
         Camera camera;
         GameObject gameObject;
+        Performance performance;
     };
 }
\ No newline at end of file
@@ -0,0 +1,153 @@
+#include "runtime/function/render/render_draw_list.h"
+
+#include <cstring>
+#include <utility>
+
+namespace Piccolo
+{
+    void RenderDrawList::clear()
+    {
+        m_keys.clear();
+        m_nodes.clear();
+        m_has_truncated_ids = false;
+        for (std::vector<RenderDrawBatch>& batches : m_batches)
+        {
+            batches.clear();
+        }
+    }
+
+    void RenderDrawList::addNodes(RenderDrawListPass                 pass,
+                                  const std::vector<RenderMeshNode>& nodes,
+                                  const Vector3&                     view_position,
+                                  const Vector3&                     view_direction)
+    {
+        const bool is_depth_sorted = view_direction != Vector3::ZERO;
+        for (const RenderMeshNode& node : nodes)
+        {
+            const Pipeline pipeline =
+                node.enable_vertex_blending && node.joint_matrices ? _pipeline_vertex_blending : _pipeline_static;
+            uint32_t depth_bucket = 0;
+            if (is_depth_sorted)
+            {
+                const float depth = (node.model_matrix->getTrans() - view_position).dotProduct(view_direction);
+                depth_bucket      = getDepthBucket(depth);
+            }
+
+            if ((node.material_asset_id >> k_material_bits) != 0 || (node.mesh_asset_id >> k_mesh_bits) != 0)
+            {
+                m_has_truncated_ids = true;
+            }
+            m_keys.push_back(makeSortKey(pass, pipeline, node.material_asset_id, node.mesh_asset_id, depth_bucket));
+            m_nodes.push_back(&node);
+        }
+    }
+
+    void RenderDrawList::build()
+    {
+        sortKeys();
+
+        for (uint32_t instance_index = 0; instance_index < static_cast<uint32_t>(m_nodes.size()); ++instance_index)
+        {
+            const uint64_t                key     = m_keys[instance_index];
+            std::vector<RenderDrawBatch>& batches = m_batches[key >> k_pass_shift];
+
+            // the key above the depth bucket is the state of the batch, the nodes are only read when it changes or
+            // when an asset id was cut to its field and the keys of two meshes or materials may be equal
+            if (!batches.empty())
+            {
+                RenderDrawBatch& batch = batches.back();
+                if (batch.first_instance + batch.instance_count == instance_index &&
+                    batch.instance_count < s_mesh_per_drawcall_max_instance_count &&
+                    (key >> k_mesh_shift) == (m_keys[instance_index - 1] >> k_mesh_shift) &&
+                    (!m_has_truncated_ids || (batch.ref_material == m_nodes[instance_index]->ref_material &&
+                                              batch.ref_mesh == m_nodes[instance_index]->ref_mesh)))
+                {
+                    ++batch.instance_count;
+                    continue;
+                }
+            }
+
+            const RenderMeshNode& node   = *m_nodes[instance_index];
+            RenderDrawBatch&      batch  = batches.emplace_back();
+            batch.ref_material           = node.ref_material;
+            batch.ref_mesh               = node.ref_mesh;
+            batch.first_instance         = instance_index;
+            batch.instance_count         = 1;
+            batch.enable_vertex_blending = ((key >> k_pipeline_shift) & ((uint64_t {1} << k_pipeline_bits) - 1)) ==
+                                           _pipeline_vertex_blending;
+        }
+    }
+
+    uint64_t RenderDrawList::makeSortKey(RenderDrawListPass pass,
+                                         Pipeline           pipeline,
+                                         size_t             material_asset_id,
+                                         size_t             mesh_asset_id,
+                                         uint32_t           depth_bucket)
+    {
+        auto field = [](uint64_t value, uint32_t bits, uint32_t shift) {
+            return (value & ((uint64_t {1} << bits) - 1)) << shift;
+        };
+        return field(pass, k_pass_bits, k_pass_shift) | field(pipeline, k_pipeline_bits, k_pipeline_shift) |
+               field(material_asset_id, k_material_bits, k_material_shift) |
+               field(mesh_asset_id, k_mesh_bits, k_mesh_shift) | field(depth_bucket, k_depth_bits, k_depth_shift);
+    }
+
+    uint32_t RenderDrawList::getDepthBucket(float depth)
+    {
+        // also false for nan
+        if (!(depth > 0.0f))
+            return 0;
+
+        // the bits of a positive float increase with it, below the sign bit are the exponent and the mantissa
+        uint32_t bits;
+        std::memcpy(&bits, &depth, sizeof(bits));
+        return bits >> (31 - k_depth_bits);
+    }
+
+    void RenderDrawList::sortKeys()
+    {
+        const size_t key_count = m_keys.size();
+        if (key_count < 2)
+            return;
+
+        m_sort_keys.resize(key_count);
+        m_sort_nodes.resize(key_count);
+
+        // the histograms of all the bytes are counted in one pass over the keys
+        uint32_t histograms[sizeof(uint64_t)][256] = {};
+        for (uint64_t key : m_keys)
+        {
+            for (uint32_t byte = 0; byte < sizeof(uint64_t); ++byte)
+            {
+                ++histograms[byte][(key >> (byte * 8)) & 0xff];
+            }
+        }
+
+        for (uint32_t byte = 0; byte < sizeof(uint64_t); ++byte)
+        {
+            uint32_t*      histogram = histograms[byte];
+            const uint32_t shift     = byte * 8;
+
+            // the pass, pipeline and high id bytes are mostly the same for every key
+            if (histogram[(m_keys[0] >> shift) & 0xff] == key_count)
+                continue;
+
+            uint32_t offset = 0;
+            for (uint32_t digit = 0; digit < 256; ++digit)
+            {
+                const uint32_t count = histogram[digit];
+                histogram[digit]     = offset;
+                offset += count;
+            }
+
+            for (size_t i = 0; i < key_count; ++i)
+            {
+                const uint32_t destination = histogram[(m_keys[i] >> shift) & 0xff]++;
+                m_sort_keys[destination]   = m_keys[i];
+                m_sort_nodes[destination]  = m_nodes[i];
+            }
+            std::swap(m_keys, m_sort_keys);
+            std::swap(m_nodes, m_sort_nodes);
+        }
+    }
+} // namespace Piccolo
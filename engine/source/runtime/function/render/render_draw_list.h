@@ -0,0 +1,103 @@
+#pragma once
+
+#include "runtime/core/math/vector3.h"
+#include "runtime/function/render/render_common.h"
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace Piccolo
+{
+    // the views whose visible mesh nodes are drawn through the draw list, the main camera one is drawn by the
+    // gbuffer, forward lighting and pick passes
+    enum RenderDrawListPass : uint32_t
+    {
+        _draw_list_pass_main_camera = 0,
+        _draw_list_pass_directional_light,
+        _draw_list_pass_point_lights,
+        _draw_list_pass_count
+    };
+
+    // instances [first_instance, first_instance + instance_count) of the draw list, drawn with one instanced
+    // drawcall of ref_mesh. either all of them or none have joint matrices
+    struct RenderDrawBatch
+    {
+        VulkanPBRMaterial* ref_material {nullptr};
+        VulkanMesh*        ref_mesh {nullptr};
+        uint32_t           first_instance {0};
+        uint32_t           instance_count {0};
+        bool               enable_vertex_blending {false};
+    };
+
+    /// Batches the visible mesh nodes of every view into instanced drawcalls once per frame, after the visibility.
+    /// Each node gets a 64 bit sort key of its pass, pipeline, material, mesh and depth bucket, the keys of all the
+    /// passes are radix sorted together and the runs of equal material and mesh are cut into batches of at most
+    /// s_mesh_per_drawcall_max_instance_count instances. The batches of a pass are in state order, so a pass only
+    /// binds the material and the mesh when they change, and the instances of a batch are sorted near to far.
+    /// The buffers are kept from one frame to the next.
+    class RenderDrawList
+    {
+    public:
+        static constexpr uint32_t k_pass_bits     = 4;
+        static constexpr uint32_t k_pipeline_bits = 4;
+        static constexpr uint32_t k_material_bits = 20;
+        static constexpr uint32_t k_mesh_bits     = 20;
+        static constexpr uint32_t k_depth_bits    = 16;
+
+        // the skinned instances are drawn with the vertex blending storage buffer bound
+        enum Pipeline : uint32_t
+        {
+            _pipeline_static = 0,
+            _pipeline_vertex_blending,
+        };
+
+        void clear();
+
+        // the nodes must stay in place until the next clear. the depth of a node is the distance of its origin along
+        // view_direction from view_position, a zero direction leaves the instances unordered
+        void addNodes(RenderDrawListPass                 pass,
+                      const std::vector<RenderMeshNode>& nodes,
+                      const Vector3&                     view_position,
+                      const Vector3&                     view_direction);
+        void build();
+
+        const std::vector<RenderDrawBatch>& getBatches(RenderDrawListPass pass) const { return m_batches[pass]; }
+        const RenderMeshNode&               getInstance(uint32_t instance_index) const
+        {
+            return *m_nodes[instance_index];
+        }
+
+        // the asset ids only order the nodes, the batches compare the mesh and material when ids are wider than
+        // their field
+        static uint64_t makeSortKey(RenderDrawListPass pass,
+                                    Pipeline           pipeline,
+                                    size_t             material_asset_id,
+                                    size_t             mesh_asset_id,
+                                    uint32_t           depth_bucket);
+        // the top bits of the float, increasing with the depth and finer near the view. behind the view is 0
+        static uint32_t getDepthBucket(float depth);
+
+    private:
+        static constexpr uint32_t k_depth_shift    = 0;
+        static constexpr uint32_t k_mesh_shift     = k_depth_shift + k_depth_bits;
+        static constexpr uint32_t k_material_shift = k_mesh_shift + k_mesh_bits;
+        static constexpr uint32_t k_pipeline_shift = k_material_shift + k_material_bits;
+        static constexpr uint32_t k_pass_shift     = k_pipeline_shift + k_pipeline_bits;
+        static_assert(k_pass_shift + k_pass_bits == 64, "the sort key fields should fill 64 bits");
+        static_assert(_draw_list_pass_count <= (1u << k_pass_bits), "too many draw list passes");
+
+        // lsd radix sort of the keys with their node, 8 bits at a time, skipping the bytes all keys share
+        void sortKeys();
+
+        // the nodes in key order once built, the instances of the batches
+        std::vector<uint64_t>              m_keys;
+        std::vector<const RenderMeshNode*> m_nodes;
+        std::vector<uint64_t>              m_sort_keys;
+        std::vector<const RenderMeshNode*> m_sort_nodes;
+
+        bool                               m_has_truncated_ids {false};
+
+        std::array<std::vector<RenderDrawBatch>, _draw_list_pass_count> m_batches;
+    };
+} // namespace Piccolo
@@ -2,6 +2,7 @@
 
 #include "runtime/core/math/axis_aligned.h"
 #include "runtime/core/math/matrix4.h"
+#include "runtime/function/render/render_object.h"
 
 #include <cstdint>
 #include <vector>
@@ -15,10 +16,10 @@ namespace Piccolo
         Matrix4x4 m_model_matrix {Matrix4x4::IDENTITY};
 
         // mesh
-        size_t                 m_mesh_asset_id {0};
-        bool                   m_enable_vertex_blending {false};
-        std::vector<Matrix4x4> m_joint_matrices;
-        AxisAlignedBox         m_bounding_box;
+        size_t                                 m_mesh_asset_id {0};
+        bool                                   m_enable_vertex_blending {false};
+        std::shared_ptr<const SkinningPalette> m_skinning_palette;
+        AxisAlignedBox                         m_bounding_box;
 
         // material
         size_t  m_material_asset_id {0};
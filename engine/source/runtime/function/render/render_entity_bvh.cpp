@@ -0,0 +1,446 @@
+#include "runtime/function/render/render_entity_bvh.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace Piccolo
+{
+    namespace
+    {
+        BoundingBox mergeBoxes(const BoundingBox& a, const BoundingBox& b)
+        {
+            BoundingBox merged = a;
+            merged.merge(b);
+            return merged;
+        }
+
+        // half of the surface area, the cost of a node is proportional to the chance a query visits it
+        float boxArea(const BoundingBox& b)
+        {
+            const Vector3 size = b.max_bound - b.min_bound;
+            return size.x * size.y + size.y * size.z + size.z * size.x;
+        }
+
+        bool boxesEqual(const BoundingBox& a, const BoundingBox& b)
+        {
+            return a.min_bound == b.min_bound && a.max_bound == b.max_bound;
+        }
+
+        constexpr uint32_t k_all_planes = (1u << 6) - 1;
+    } // namespace
+
+    void RenderEntityBvh::insert(uint32_t entity_index, const BoundingBox& bounding_box)
+    {
+        if (entity_index >= m_entity_leaves.size())
+        {
+            m_entity_leaves.resize(entity_index + 1, k_null_node);
+            m_entity_bounding_boxes.resize(entity_index + 1);
+        }
+        assert(m_entity_leaves[entity_index] == k_null_node);
+        m_entity_bounding_boxes.set(entity_index, bounding_box);
+
+        const int32_t leaf            = allocateNode();
+        m_nodes[leaf].bounding_box    = bounding_box;
+        m_nodes[leaf].entity_index    = entity_index;
+        m_entity_leaves[entity_index] = leaf;
+        insertLeaf(leaf);
+    }
+
+    void RenderEntityBvh::update(uint32_t entity_index, const BoundingBox& bounding_box)
+    {
+        const int32_t leaf = m_entity_leaves[entity_index];
+        // most updates of static entities do not move them
+        if (boxesEqual(m_nodes[leaf].bounding_box, bounding_box))
+            return;
+
+        removeLeaf(leaf);
+        m_nodes[leaf].bounding_box = bounding_box;
+        insertLeaf(leaf);
+        m_entity_bounding_boxes.set(entity_index, bounding_box);
+    }
+
+    void RenderEntityBvh::remove(uint32_t entity_index)
+    {
+        const int32_t leaf = m_entity_leaves[entity_index];
+        removeLeaf(leaf);
+        freeNode(leaf);
+        m_entity_leaves[entity_index] = k_null_node;
+        m_entity_bounding_boxes.setEmpty(entity_index);
+        trimFreeEntities();
+    }
+
+    void RenderEntityBvh::move(uint32_t from_index, uint32_t to_index)
+    {
+        if (to_index >= m_entity_leaves.size())
+        {
+            m_entity_leaves.resize(to_index + 1, k_null_node);
+            m_entity_bounding_boxes.resize(to_index + 1);
+        }
+        assert(m_entity_leaves[to_index] == k_null_node);
+
+        const int32_t leaf          = m_entity_leaves[from_index];
+        m_nodes[leaf].entity_index  = to_index;
+        m_entity_leaves[to_index]   = leaf;
+        m_entity_leaves[from_index] = k_null_node;
+        m_entity_bounding_boxes.copy(from_index, to_index);
+        m_entity_bounding_boxes.setEmpty(from_index);
+        trimFreeEntities();
+    }
+
+    void RenderEntityBvh::clear()
+    {
+        m_nodes.clear();
+        m_entity_leaves.clear();
+        m_entity_bounding_boxes.resize(0);
+        m_root      = k_null_node;
+        m_free_list = k_null_node;
+    }
+
+    void RenderEntityBvh::queryFrustum(const ClusterFrustum& frustum, std::vector<uint32_t>& out_entity_indices) const
+    {
+        out_entity_indices.clear();
+        if (m_root == k_null_node)
+            return;
+
+        const Vector4* const planes[6] = {&frustum.m_plane_right,
+                                          &frustum.m_plane_left,
+                                          &frustum.m_plane_top,
+                                          &frustum.m_plane_bottom,
+                                          &frustum.m_plane_near,
+                                          &frustum.m_plane_far};
+
+        // each entry carries the planes its node still intersects
+        m_query_stack.clear();
+        m_query_stack.emplace_back(m_root, k_all_planes);
+        while (!m_query_stack.empty())
+        {
+            const int32_t node_index = m_query_stack.back().first;
+            uint32_t      plane_mask = m_query_stack.back().second;
+            m_query_stack.pop_back();
+
+            const Node& node = m_nodes[node_index];
+
+            // a node inside of all the planes is visible with everything below it
+            bool is_outside = false;
+            if (plane_mask != 0)
+            {
+                const BoundingBox& b = node.bounding_box;
+                const Vector4      box_center((b.max_bound.x + b.min_bound.x) * 0.5f,
+                                         (b.max_bound.y + b.min_bound.y) * 0.5f,
+                                         (b.max_bound.z + b.min_bound.z) * 0.5f,
+                                         1.0f);
+                const Vector3      box_extents((b.max_bound.x - b.min_bound.x) * 0.5f,
+                                          (b.max_bound.y - b.min_bound.y) * 0.5f,
+                                          (b.max_bound.z - b.min_bound.z) * 0.5f);
+
+                for (uint32_t plane_index = 0; plane_index < 6; plane_index++)
+                {
+                    if ((plane_mask & (1u << plane_index)) == 0)
+                        continue;
+
+                    const Vector4& plane           = *planes[plane_index];
+                    const float    signed_distance = plane.dotProduct(box_center);
+                    const float    radius_project =
+                        Vector3(fabs(plane.x), fabs(plane.y), fabs(plane.z)).dotProduct(box_extents);
+                    if (signed_distance >= radius_project)
+                    {
+                        is_outside = true;
+                        break;
+                    }
+                    // the children are inside of this plane as well
+                    if (signed_distance <= -radius_project)
+                    {
+                        plane_mask &= ~(1u << plane_index);
+                    }
+                }
+            }
+            if (is_outside)
+                continue;
+
+            if (node.isLeaf())
+            {
+                out_entity_indices.push_back(node.entity_index);
+            }
+            else
+            {
+                m_query_stack.emplace_back(node.right, plane_mask);
+                m_query_stack.emplace_back(node.left, plane_mask);
+            }
+        }
+    }
+
+    void RenderEntityBvh::querySpheres(const std::vector<BoundingSphere>& spheres,
+                                       std::vector<uint32_t>&             out_entity_indices) const
+    {
+        out_entity_indices.clear();
+        if (m_root == k_null_node)
+            return;
+
+        m_query_stack.clear();
+        m_query_stack.emplace_back(m_root, 0);
+        while (!m_query_stack.empty())
+        {
+            const Node& node = m_nodes[m_query_stack.back().first];
+            m_query_stack.pop_back();
+
+            // the test only gets stricter for the boxes inside of this one
+            bool intersect_with_spheres = true;
+            for (const BoundingSphere& sphere : spheres)
+            {
+                if (!BoxIntersectsWithSphere(node.bounding_box, sphere))
+                {
+                    intersect_with_spheres = false;
+                    break;
+                }
+            }
+            if (!intersect_with_spheres)
+                continue;
+
+            if (node.isLeaf())
+            {
+                out_entity_indices.push_back(node.entity_index);
+            }
+            else
+            {
+                m_query_stack.emplace_back(node.right, 0);
+                m_query_stack.emplace_back(node.left, 0);
+            }
+        }
+    }
+
+    int32_t RenderEntityBvh::allocateNode()
+    {
+        int32_t node_index;
+        if (m_free_list != k_null_node)
+        {
+            node_index  = m_free_list;
+            m_free_list = m_nodes[node_index].parent;
+        }
+        else
+        {
+            node_index = static_cast<int32_t>(m_nodes.size());
+            m_nodes.emplace_back();
+        }
+
+        Node& node  = m_nodes[node_index];
+        node.parent = k_null_node;
+        node.left   = k_null_node;
+        node.right  = k_null_node;
+        node.height = 0;
+        return node_index;
+    }
+
+    void RenderEntityBvh::freeNode(int32_t node_index)
+    {
+        m_nodes[node_index].parent = m_free_list;
+        m_nodes[node_index].height = -1;
+        m_free_list                = node_index;
+    }
+
+    void RenderEntityBvh::insertLeaf(int32_t leaf)
+    {
+        if (m_root == k_null_node)
+        {
+            m_root               = leaf;
+            m_nodes[leaf].parent = k_null_node;
+            return;
+        }
+
+        // walk down to the sibling that makes the tree grow the least
+        const BoundingBox leaf_box = m_nodes[leaf].bounding_box;
+        int32_t           index    = m_root;
+        while (!m_nodes[index].isLeaf())
+        {
+            const Node& node          = m_nodes[index];
+            const float area          = boxArea(node.bounding_box);
+            const float combined_area = boxArea(mergeBoxes(node.bounding_box, leaf_box));
+
+            // cost of a new parent for this node and the leaf
+            const float cost = 2.0f * combined_area;
+            // the leaf grows all the ancestors of the children as well
+            const float inheritance_cost = 2.0f * (combined_area - area);
+
+            auto descend_cost = [&](int32_t child_index) {
+                const Node& child     = m_nodes[child_index];
+                const float with_leaf = boxArea(mergeBoxes(child.bounding_box, leaf_box));
+                return child.isLeaf() ? with_leaf + inheritance_cost :
+                                        with_leaf - boxArea(child.bounding_box) + inheritance_cost;
+            };
+            const float left_cost  = descend_cost(node.left);
+            const float right_cost = descend_cost(node.right);
+
+            if (cost < left_cost && cost < right_cost)
+                break;
+
+            index = left_cost < right_cost ? node.left : node.right;
+        }
+        const int32_t sibling = index;
+
+        const int32_t old_parent = m_nodes[sibling].parent;
+        const int32_t new_parent = allocateNode();
+        Node&         parent     = m_nodes[new_parent];
+        parent.parent            = old_parent;
+        parent.bounding_box      = mergeBoxes(leaf_box, m_nodes[sibling].bounding_box);
+        parent.height            = m_nodes[sibling].height + 1;
+        parent.left              = sibling;
+        parent.right             = leaf;
+        m_nodes[sibling].parent  = new_parent;
+        m_nodes[leaf].parent     = new_parent;
+
+        if (old_parent == k_null_node)
+        {
+            m_root = new_parent;
+        }
+        else if (m_nodes[old_parent].left == sibling)
+        {
+            m_nodes[old_parent].left = new_parent;
+        }
+        else
+        {
+            m_nodes[old_parent].right = new_parent;
+        }
+
+        refitAncestors(m_nodes[leaf].parent);
+    }
+
+    void RenderEntityBvh::removeLeaf(int32_t leaf)
+    {
+        if (leaf == m_root)
+        {
+            m_root = k_null_node;
+            return;
+        }
+
+        const int32_t parent       = m_nodes[leaf].parent;
+        const int32_t grand_parent = m_nodes[parent].parent;
+        const int32_t sibling      = m_nodes[parent].left == leaf ? m_nodes[parent].right : m_nodes[parent].left;
+
+        // the sibling takes the place of the parent
+        if (grand_parent == k_null_node)
+        {
+            m_root                  = sibling;
+            m_nodes[sibling].parent = k_null_node;
+            freeNode(parent);
+            return;
+        }
+
+        if (m_nodes[grand_parent].left == parent)
+        {
+            m_nodes[grand_parent].left = sibling;
+        }
+        else
+        {
+            m_nodes[grand_parent].right = sibling;
+        }
+        m_nodes[sibling].parent = grand_parent;
+        freeNode(parent);
+
+        refitAncestors(grand_parent);
+    }
+
+    void RenderEntityBvh::trimFreeEntities()
+    {
+        // the free slots at the end are not scanned by the SoA culling
+        size_t entity_count = m_entity_leaves.size();
+        while (entity_count > 0 && m_entity_leaves[entity_count - 1] == k_null_node)
+        {
+            entity_count--;
+        }
+        m_entity_leaves.resize(entity_count);
+        m_entity_bounding_boxes.resize(entity_count);
+    }
+
+    void RenderEntityBvh::refitAncestors(int32_t node_index)
+    {
+        while (node_index != k_null_node)
+        {
+            node_index = balance(node_index);
+
+            Node&       node  = m_nodes[node_index];
+            const Node& left  = m_nodes[node.left];
+            const Node& right = m_nodes[node.right];
+            node.height       = 1 + std::max(left.height, right.height);
+            node.bounding_box = mergeBoxes(left.bounding_box, right.bounding_box);
+
+            node_index = node.parent;
+        }
+    }
+
+    // rotates the taller child of a up when the heights of the children of a differ by more than one,
+    // returns the node now at the place of a
+    int32_t RenderEntityBvh::balance(int32_t a_index)
+    {
+        Node& a = m_nodes[a_index];
+        if (a.isLeaf() || a.height < 2)
+            return a_index;
+
+        const int32_t b_index = a.left;
+        const int32_t c_index = a.right;
+        Node&         b       = m_nodes[b_index];
+        Node&         c       = m_nodes[c_index];
+
+        const int32_t height_difference = c.height - b.height;
+
+        // the tallest child of the taller side becomes a child of a, the other one stays with the promoted node
+        auto rotate_up = [&](int32_t up_index, int32_t other_index, bool up_is_right) {
+            Node&         up      = m_nodes[up_index];
+            Node&         other   = m_nodes[other_index];
+            const int32_t f_index = up.left;
+            const int32_t g_index = up.right;
+            Node&         f       = m_nodes[f_index];
+            Node&         g       = m_nodes[g_index];
+
+            // swap a and up
+            up.left   = a_index;
+            up.parent = a.parent;
+            a.parent  = up_index;
+
+            if (up.parent == k_null_node)
+            {
+                m_root = up_index;
+            }
+            else if (m_nodes[up.parent].left == a_index)
+            {
+                m_nodes[up.parent].left = up_index;
+            }
+            else
+            {
+                m_nodes[up.parent].right = up_index;
+            }
+
+            // the taller grandchild stays under up, the shorter one moves under a
+            const bool    f_is_taller   = f.height > g.height;
+            const int32_t taller_index  = f_is_taller ? f_index : g_index;
+            const int32_t shorter_index = f_is_taller ? g_index : f_index;
+            Node&         shorter       = m_nodes[shorter_index];
+
+            up.right = taller_index;
+            if (up_is_right)
+            {
+                a.right = shorter_index;
+            }
+            else
+            {
+                a.left = shorter_index;
+            }
+            shorter.parent = a_index;
+
+            a.bounding_box  = mergeBoxes(other.bounding_box, shorter.bounding_box);
+            up.bounding_box = mergeBoxes(a.bounding_box, m_nodes[taller_index].bounding_box);
+            a.height        = 1 + std::max(other.height, shorter.height);
+            up.height       = 1 + std::max(a.height, m_nodes[taller_index].height);
+        };
+
+        if (height_difference > 1)
+        {
+            rotate_up(c_index, b_index, true);
+            return c_index;
+        }
+        if (height_difference < -1)
+        {
+            rotate_up(b_index, c_index, false);
+            return b_index;
+        }
+        return a_index;
+    }
+} // namespace Piccolo
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "runtime/core/math/matrix4.h"
+#include "runtime/function/render/render_helper.h"
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace Piccolo
+{
+    /// Dynamic bounding volume hierarchy of the world bounding boxes of the render entities.
+    /// The leaves are inserted one by one where they grow the surface area of the tree the least and the tree is
+    /// kept height balanced with rotations, so adding, moving or removing an entity only touches the path to the
+    /// root. Entities are referred to by their index in RenderScene::m_render_entities.
+    /// The boxes are also kept in entity order as SoA, for the views that see a large part of the scene and are
+    /// cheaper to cull with TiledFrustumCullBoxes than by traversing the tree.
+    class RenderEntityBvh
+    {
+    public:
+        void insert(uint32_t entity_index, const BoundingBox& bounding_box);
+        void update(uint32_t entity_index, const BoundingBox& bounding_box);
+        void remove(uint32_t entity_index);
+        // the entity at from_index is now at to_index, to_index must not be in the tree
+        void move(uint32_t from_index, uint32_t to_index);
+        void clear();
+
+        bool               empty() const { return m_root == k_null_node; }
+        const BoundingBox& getBoundingBox() const { return m_nodes[m_root].bounding_box; }
+        const BoundingBox& getEntityBoundingBox(uint32_t entity_index) const
+        {
+            return m_nodes[m_entity_leaves[entity_index]].bounding_box;
+        }
+        const BoundingBoxSoA& getEntityBoundingBoxes() const { return m_entity_bounding_boxes; }
+
+        // same test as TiledFrustumIntersectBox, but a subtree inside of a plane is not tested against it again
+        void queryFrustum(const ClusterFrustum& frustum, std::vector<uint32_t>& out_entity_indices) const;
+        // entities whose bounding box intersects every sphere, like BoxIntersectsWithSphere
+        void querySpheres(const std::vector<BoundingSphere>& spheres, std::vector<uint32_t>& out_entity_indices) const;
+
+    private:
+        static constexpr int32_t k_null_node = -1;
+
+        struct Node
+        {
+            BoundingBox bounding_box;
+            int32_t     parent {k_null_node};
+            int32_t     left {k_null_node};
+            int32_t     right {k_null_node};
+            // 0 for a leaf, -1 for a free node
+            int32_t  height {0};
+            uint32_t entity_index {0};
+
+            bool isLeaf() const { return left == k_null_node; }
+        };
+
+        int32_t allocateNode();
+        void    freeNode(int32_t node_index);
+
+        void    insertLeaf(int32_t leaf);
+        void    removeLeaf(int32_t leaf);
+        void    refitAncestors(int32_t node_index);
+        int32_t balance(int32_t node_index);
+        void    trimFreeEntities();
+
+        std::vector<Node> m_nodes;
+        int32_t           m_root {k_null_node};
+        // the free nodes are chained through their parent index
+        int32_t m_free_list {k_null_node};
+
+        std::vector<int32_t> m_entity_leaves;
+        BoundingBoxSoA       m_entity_bounding_boxes;
+
+        // traversal stack of the queries, kept to avoid allocating every frame
+        mutable std::vector<std::pair<int32_t, uint32_t>> m_query_stack;
+    };
+} // namespace Piccolo
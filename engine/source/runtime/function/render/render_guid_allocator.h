@@ -1,11 +1,17 @@
 #pragma once
 
+#include <functional>
 #include <unordered_map>
+#include <vector>
 
 namespace Piccolo
 {
     static const size_t s_invalid_guid = 0;
 
+    /// Gives each distinct element a guid and finds either from the other.
+    /// The elements are stored once, densely at guid - 1, and are found back through a table keyed by their hash
+    /// that only holds guids: an element is hashed once per lookup and copied once when allocated, however long its
+    /// paths are. The freed guids are kept on a free list and reused first, so the guids stay small and dense.
     template<typename T>
     class GuidAllocator
     {
@@ -14,91 +20,130 @@ namespace Piccolo
 
         size_t allocGuid(const T& t)
         {
-            auto find_it = m_elements_guid_map.find(t);
-            if (find_it != m_elements_guid_map.end())
+            const size_t hash       = std::hash<T> {}(t);
+            const size_t found_guid = findGuid(t, hash);
+            if (isValidGuid(found_guid))
             {
-                return find_it->second;
+                return found_guid;
             }
 
-            for (size_t i = 0; i < m_guid_elements_map.size() + 1; i++)
+            size_t guid;
+            if (!m_free_guids.empty())
             {
-                size_t guid = i + 1;
-                if (m_guid_elements_map.find(guid) == m_guid_elements_map.end())
-                {
-                    m_guid_elements_map.insert(std::make_pair(guid, t));
-                    m_elements_guid_map.insert(std::make_pair(t, guid));
-                    return guid;
-                }
+                guid = m_free_guids.back();
+                m_free_guids.pop_back();
+            }
+            else
+            {
+                m_slots.emplace_back();
+                guid = m_slots.size();
             }
 
-            return s_invalid_guid;
+            Slot& slot          = m_slots[guid - 1];
+            slot.m_element      = t;
+            slot.m_hash         = hash;
+            slot.m_is_allocated = true;
+            m_guids_by_hash.emplace(hash, guid);
+            return guid;
         }
 
-        bool getGuidRelatedElement(size_t guid, T& t)
+        bool getGuidRelatedElement(size_t guid, T& t) const
         {
-            auto find_it = m_guid_elements_map.find(guid);
-            if (find_it != m_guid_elements_map.end())
-            {
-                t = find_it->second;
-                return true;
-            }
-            return false;
+            if (!isAllocated(guid))
+                return false;
+
+            t = m_slots[guid - 1].m_element;
+            return true;
         }
 
-        bool getElementGuid(const T& t, size_t& guid)
+        bool getElementGuid(const T& t, size_t& guid) const
         {
-            auto find_it = m_elements_guid_map.find(t);
-            if (find_it != m_elements_guid_map.end())
-            {
-                guid = find_it->second;
-                return true;
-            }
-            return false;
+            const size_t found_guid = findGuid(t, std::hash<T> {}(t));
+            if (!isValidGuid(found_guid))
+                return false;
+
+            guid = found_guid;
+            return true;
         }
 
-        bool hasElement(const T& t) { return m_elements_guid_map.find(t) != m_elements_guid_map.end(); }
+        bool hasElement(const T& t) const { return isValidGuid(findGuid(t, std::hash<T> {}(t))); }
 
         void freeGuid(size_t guid)
         {
-            auto find_it = m_guid_elements_map.find(guid);
-            if (find_it != m_guid_elements_map.end())
-            {
-                const auto& ele = find_it->second;
-                m_elements_guid_map.erase(ele);
-                m_guid_elements_map.erase(guid);
-            }
-        }
+            if (!isAllocated(guid))
+                return;
 
-        void freeElement(const T& t)
-        {
-            auto find_it = m_elements_guid_map.find(t);
-            if (find_it != m_elements_guid_map.end())
+            Slot& slot  = m_slots[guid - 1];
+            auto  guids = m_guids_by_hash.equal_range(slot.m_hash);
+            for (auto it = guids.first; it != guids.second; ++it)
             {
-                const auto& guid = find_it->second;
-                m_elements_guid_map.erase(t);
-                m_guid_elements_map.erase(guid);
+                if (it->second == guid)
+                {
+                    m_guids_by_hash.erase(it);
+                    break;
+                }
             }
+
+            // the element is released now rather than when the guid is reused
+            slot.m_element      = T {};
+            slot.m_is_allocated = false;
+            m_free_guids.push_back(guid);
         }
 
+        void freeElement(const T& t) { freeGuid(findGuid(t, std::hash<T> {}(t))); }
+
         std::vector<size_t> getAllocatedGuids() const
         {
             std::vector<size_t> allocated_guids;
-            for (const auto& ele : m_guid_elements_map)
+            allocated_guids.reserve(m_slots.size() - m_free_guids.size());
+            for (size_t slot_index = 0; slot_index < m_slots.size(); ++slot_index)
             {
-                allocated_guids.push_back(ele.first);
+                if (m_slots[slot_index].m_is_allocated)
+                {
+                    allocated_guids.push_back(slot_index + 1);
+                }
             }
             return allocated_guids;
         }
 
         void clear()
         {
-            m_elements_guid_map.clear();
-            m_guid_elements_map.clear();
+            m_slots.clear();
+            m_free_guids.clear();
+            m_guids_by_hash.clear();
         }
 
     private:
-        std::unordered_map<T, size_t> m_elements_guid_map;
-        std::unordered_map<size_t, T> m_guid_elements_map;
+        struct Slot
+        {
+            T      m_element {};
+            size_t m_hash {0};
+            bool   m_is_allocated {false};
+        };
+
+        bool isAllocated(size_t guid) const
+        {
+            return isValidGuid(guid) && guid <= m_slots.size() && m_slots[guid - 1].m_is_allocated;
+        }
+
+        size_t findGuid(const T& t, size_t hash) const
+        {
+            auto guids = m_guids_by_hash.equal_range(hash);
+            for (auto it = guids.first; it != guids.second; ++it)
+            {
+                if (m_slots[it->second - 1].m_element == t)
+                {
+                    return it->second;
+                }
+            }
+            return s_invalid_guid;
+        }
+
+        // indexed by guid - 1
+        std::vector<Slot>   m_slots;
+        std::vector<size_t> m_free_guids;
+        // the element itself is only compared on a hash match
+        std::unordered_multimap<size_t, size_t> m_guids_by_hash;
     };
 
 } // namespace Piccolo
@@ -2,6 +2,14 @@
 #include "runtime/function/render/render_camera.h"
 #include "runtime/function/render/render_scene.h"
 
+#if defined(__AVX2__)
+#define PICCOLO_RENDER_AVX2
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PICCOLO_RENDER_SSE2
+#include <emmintrin.h>
+#endif
+
 namespace Piccolo
 {
     ClusterFrustum CreateClusterFrustumFromMatrix(Matrix4x4 mat,
@@ -179,6 +187,182 @@ namespace Piccolo
         return true;
     }
 
+    void BoundingBoxSoA::resize(size_t size)
+    {
+        center_x.resize(size);
+        center_y.resize(size);
+        center_z.resize(size);
+        extent_x.resize(size, -std::numeric_limits<float>::max());
+        extent_y.resize(size, -std::numeric_limits<float>::max());
+        extent_z.resize(size, -std::numeric_limits<float>::max());
+    }
+
+    void BoundingBoxSoA::set(size_t index, BoundingBox const& b)
+    {
+        center_x[index] = (b.max_bound.x + b.min_bound.x) * 0.5f;
+        center_y[index] = (b.max_bound.y + b.min_bound.y) * 0.5f;
+        center_z[index] = (b.max_bound.z + b.min_bound.z) * 0.5f;
+        extent_x[index] = (b.max_bound.x - b.min_bound.x) * 0.5f;
+        extent_y[index] = (b.max_bound.y - b.min_bound.y) * 0.5f;
+        extent_z[index] = (b.max_bound.z - b.min_bound.z) * 0.5f;
+    }
+
+    void BoundingBoxSoA::setEmpty(size_t index)
+    {
+        center_x[index] = 0.0f;
+        center_y[index] = 0.0f;
+        center_z[index] = 0.0f;
+        extent_x[index] = -std::numeric_limits<float>::max();
+        extent_y[index] = -std::numeric_limits<float>::max();
+        extent_z[index] = -std::numeric_limits<float>::max();
+    }
+
+    void BoundingBoxSoA::copy(size_t from_index, size_t to_index)
+    {
+        center_x[to_index] = center_x[from_index];
+        center_y[to_index] = center_y[from_index];
+        center_z[to_index] = center_z[from_index];
+        extent_x[to_index] = extent_x[from_index];
+        extent_y[to_index] = extent_y[from_index];
+        extent_z[to_index] = extent_z[from_index];
+    }
+
+    void TiledFrustumCullBoxes(ClusterFrustum const& f, BoundingBoxSoA const& boxes, std::vector<uint32_t>& out_visible)
+    {
+        const Vector4* const planes[6] = {
+            &f.m_plane_right, &f.m_plane_left, &f.m_plane_top, &f.m_plane_bottom, &f.m_plane_near, &f.m_plane_far};
+
+        // the box is outside of a plane when its center is farther than its extent projected on the normal,
+        // a free slot has a negative projected extent and is outside of all the planes
+        auto is_box_visible = [&](size_t index) {
+            for (const Vector4* plane : planes)
+            {
+                const float signed_distance = plane->x * boxes.center_x[index] + plane->y * boxes.center_y[index] +
+                                              plane->z * boxes.center_z[index] + plane->w;
+                const float radius_project = fabs(plane->x) * boxes.extent_x[index] +
+                                             fabs(plane->y) * boxes.extent_y[index] +
+                                             fabs(plane->z) * boxes.extent_z[index];
+                if (!(signed_distance < radius_project))
+                    return false;
+            }
+            return true;
+        };
+
+        // every box is written and the index only advances past the visible ones
+        const size_t box_count = boxes.size();
+        out_visible.resize(box_count);
+        uint32_t* out_index = out_visible.data();
+        size_t    box_index = 0;
+
+#if defined(PICCOLO_RENDER_AVX2)
+        __m256 normal_x[6], normal_y[6], normal_z[6], normal_w[6], abs_normal_x[6], abs_normal_y[6], abs_normal_z[6];
+        for (size_t plane_index = 0; plane_index < 6; plane_index++)
+        {
+            normal_x[plane_index]     = _mm256_set1_ps(planes[plane_index]->x);
+            normal_y[plane_index]     = _mm256_set1_ps(planes[plane_index]->y);
+            normal_z[plane_index]     = _mm256_set1_ps(planes[plane_index]->z);
+            normal_w[plane_index]     = _mm256_set1_ps(planes[plane_index]->w);
+            abs_normal_x[plane_index] = _mm256_set1_ps(fabs(planes[plane_index]->x));
+            abs_normal_y[plane_index] = _mm256_set1_ps(fabs(planes[plane_index]->y));
+            abs_normal_z[plane_index] = _mm256_set1_ps(fabs(planes[plane_index]->z));
+        }
+
+        for (; box_index + 8 <= box_count; box_index += 8)
+        {
+            const __m256 center_x = _mm256_loadu_ps(&boxes.center_x[box_index]);
+            const __m256 center_y = _mm256_loadu_ps(&boxes.center_y[box_index]);
+            const __m256 center_z = _mm256_loadu_ps(&boxes.center_z[box_index]);
+            const __m256 extent_x = _mm256_loadu_ps(&boxes.extent_x[box_index]);
+            const __m256 extent_y = _mm256_loadu_ps(&boxes.extent_y[box_index]);
+            const __m256 extent_z = _mm256_loadu_ps(&boxes.extent_z[box_index]);
+
+            __m256 visible = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+            for (size_t plane_index = 0; plane_index < 6; plane_index++)
+            {
+                const __m256 signed_distance =
+                    _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(normal_x[plane_index], center_x),
+                                                _mm256_mul_ps(normal_y[plane_index], center_y)),
+                                  _mm256_add_ps(_mm256_mul_ps(normal_z[plane_index], center_z), normal_w[plane_index]));
+                const __m256 radius_project =
+                    _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(abs_normal_x[plane_index], extent_x),
+                                                _mm256_mul_ps(abs_normal_y[plane_index], extent_y)),
+                                  _mm256_mul_ps(abs_normal_z[plane_index], extent_z));
+                visible = _mm256_and_ps(visible, _mm256_cmp_ps(signed_distance, radius_project, _CMP_LT_OQ));
+            }
+
+            // compact the visible lanes
+            const int mask = _mm256_movemask_ps(visible);
+            for (uint32_t lane = 0; lane < 8; lane++)
+            {
+                *out_index = static_cast<uint32_t>(box_index + lane);
+                out_index += (mask >> lane) & 1;
+            }
+        }
+#elif defined(PICCOLO_RENDER_SSE2)
+        __m128 normal_x[6], normal_y[6], normal_z[6], normal_w[6], abs_normal_x[6], abs_normal_y[6], abs_normal_z[6];
+        for (size_t plane_index = 0; plane_index < 6; plane_index++)
+        {
+            normal_x[plane_index]     = _mm_set1_ps(planes[plane_index]->x);
+            normal_y[plane_index]     = _mm_set1_ps(planes[plane_index]->y);
+            normal_z[plane_index]     = _mm_set1_ps(planes[plane_index]->z);
+            normal_w[plane_index]     = _mm_set1_ps(planes[plane_index]->w);
+            abs_normal_x[plane_index] = _mm_set1_ps(fabs(planes[plane_index]->x));
+            abs_normal_y[plane_index] = _mm_set1_ps(fabs(planes[plane_index]->y));
+            abs_normal_z[plane_index] = _mm_set1_ps(fabs(planes[plane_index]->z));
+        }
+
+        for (; box_index + 4 <= box_count; box_index += 4)
+        {
+            const __m128 center_x = _mm_loadu_ps(&boxes.center_x[box_index]);
+            const __m128 center_y = _mm_loadu_ps(&boxes.center_y[box_index]);
+            const __m128 center_z = _mm_loadu_ps(&boxes.center_z[box_index]);
+            const __m128 extent_x = _mm_loadu_ps(&boxes.extent_x[box_index]);
+            const __m128 extent_y = _mm_loadu_ps(&boxes.extent_y[box_index]);
+            const __m128 extent_z = _mm_loadu_ps(&boxes.extent_z[box_index]);
+
+            __m128 visible = _mm_castsi128_ps(_mm_set1_epi32(-1));
+            for (size_t plane_index = 0; plane_index < 6; plane_index++)
+            {
+                const __m128 signed_distance =
+                    _mm_add_ps(_mm_add_ps(_mm_mul_ps(normal_x[plane_index], center_x),
+                                          _mm_mul_ps(normal_y[plane_index], center_y)),
+                               _mm_add_ps(_mm_mul_ps(normal_z[plane_index], center_z), normal_w[plane_index]));
+                const __m128 radius_project = _mm_add_ps(_mm_add_ps(_mm_mul_ps(abs_normal_x[plane_index], extent_x),
+                                                                    _mm_mul_ps(abs_normal_y[plane_index], extent_y)),
+                                                         _mm_mul_ps(abs_normal_z[plane_index], extent_z));
+                visible = _mm_and_ps(visible, _mm_cmplt_ps(signed_distance, radius_project));
+            }
+
+            // compact the visible lanes
+            const int mask = _mm_movemask_ps(visible);
+            for (uint32_t lane = 0; lane < 4; lane++)
+            {
+                *out_index = static_cast<uint32_t>(box_index + lane);
+                out_index += (mask >> lane) & 1;
+            }
+        }
+#endif
+
+        for (; box_index < box_count; box_index++)
+        {
+            *out_index = static_cast<uint32_t>(box_index);
+            out_index += is_box_visible(box_index) ? 1 : 0;
+        }
+
+        out_visible.resize(out_index - out_visible.data());
+    }
+
+    char const* TiledFrustumCullInstructionSet()
+    {
+#if defined(PICCOLO_RENDER_AVX2)
+        return "AVX2";
+#elif defined(PICCOLO_RENDER_SSE2)
+        return "SSE2";
+#else
+        return "scalar";
+#endif
+    }
+
     BoundingBox BoundingBoxTransform(BoundingBox const& b, Matrix4x4 const& m)
     {
         // we follow the "BoundingBox::Transform"
@@ -259,6 +443,69 @@ namespace Piccolo
         return true;
     }
 
+    bool CullMeshlets(ClusterFrustum const&                     f,
+                      Vector3 const&                            camera_position,
+                      Matrix4x4 const&                          model_matrix,
+                      std::vector<MeshletDataDefinition> const& meshlets,
+                      std::vector<RenderMeshDrawRange>&         out_draw_ranges)
+    {
+        // the meshlet bounds are in model space, the planes are brought there instead: a world plane p is the
+        // model plane p * model_matrix, whose normal is scaled along with the distances
+        Vector4 const world_planes[6] = {
+            f.m_plane_right, f.m_plane_left, f.m_plane_top, f.m_plane_bottom, f.m_plane_near, f.m_plane_far};
+        Vector4 model_planes[6];
+        float   model_plane_scales[6];
+        for (size_t i = 0; i < 6; ++i)
+        {
+            for (size_t column = 0; column < 4; ++column)
+            {
+                model_planes[i][column] = world_planes[i].x * model_matrix[0][column] +
+                                          world_planes[i].y * model_matrix[1][column] +
+                                          world_planes[i].z * model_matrix[2][column] +
+                                          world_planes[i].w * model_matrix[3][column];
+            }
+            model_plane_scales[i] = Vector3(model_planes[i].x, model_planes[i].y, model_planes[i].z).length();
+        }
+
+        // which side of a triangle faces the camera does not change with an affine transform, unless it mirrors
+        bool const    is_cone_culled        = !model_matrix.hasNegativeScale();
+        Vector3 const model_camera_position = model_matrix.inverseAffine().transformAffine(camera_position);
+
+        size_t const first_draw_range = out_draw_ranges.size();
+        for (MeshletDataDefinition const& meshlet : meshlets)
+        {
+            Vector4 const center(meshlet.m_center[0], meshlet.m_center[1], meshlet.m_center[2], 1.0f);
+
+            bool is_visible = true;
+            for (size_t i = 0; i < 6 && is_visible; ++i)
+            {
+                is_visible = model_planes[i].dotProduct(center) < meshlet.m_radius * model_plane_scales[i];
+            }
+
+            if (is_visible && is_cone_culled && meshlet.m_cone_cutoff < 1.0f)
+            {
+                Vector3 const to_center = Vector3(center.x, center.y, center.z) - model_camera_position;
+                Vector3 const cone_axis(meshlet.m_cone_axis[0], meshlet.m_cone_axis[1], meshlet.m_cone_axis[2]);
+                is_visible = to_center.dotProduct(cone_axis) <
+                             meshlet.m_cone_cutoff * to_center.length() + meshlet.m_radius;
+            }
+
+            if (!is_visible)
+                continue;
+
+            if (out_draw_ranges.size() > first_draw_range &&
+                out_draw_ranges.back().first_index + out_draw_ranges.back().index_count == meshlet.m_first_index)
+            {
+                out_draw_ranges.back().index_count += meshlet.m_index_count;
+            }
+            else
+            {
+                out_draw_ranges.push_back({meshlet.m_first_index, meshlet.m_index_count});
+            }
+        }
+        return out_draw_ranges.size() > first_draw_range;
+    }
+
     Matrix4x4 CalculateDirectionalLightCamera(RenderScene& scene, RenderCamera& camera)
     {
         Matrix4x4 proj_view_matrix;
@@ -300,21 +547,8 @@ namespace Piccolo
             }
         }
 
-        BoundingBox scene_bounding_box;
-        {
-            scene_bounding_box.min_bound = Vector3(FLT_MAX, FLT_MAX, FLT_MAX);
-            scene_bounding_box.max_bound = Vector3(FLT_MIN, FLT_MIN, FLT_MIN);
-
-            for (const RenderEntity& entity : scene.m_render_entities)
-            {
-                BoundingBox mesh_asset_bounding_box {entity.m_bounding_box.getMinCorner(),
-                                                     entity.m_bounding_box.getMaxCorner()};
-
-                BoundingBox mesh_bounding_box_world =
-                    BoundingBoxTransform(mesh_asset_bounding_box, entity.m_model_matrix);
-                scene_bounding_box.merge(mesh_bounding_box_world);
-            }
-        }
+        // the root of the bvh bounds the world bounding boxes of all the entities
+        const BoundingBox& scene_bounding_box = scene.getSceneBoundingBox();
 
         // CascadedShadowMaps11 / ComputeNearAndFar
         Matrix4x4 light_view;
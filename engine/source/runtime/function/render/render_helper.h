@@ -3,10 +3,16 @@
 #include "runtime/core/math/vector3.h"
 #include "runtime/core/math/vector4.h"
 
+#include <cstdint>
+#include <limits>
+#include <vector>
+
 namespace Piccolo
 {
     class RenderScene;
     class RenderCamera;
+    struct MeshletDataDefinition;
+    struct RenderMeshDrawRange;
 
     static inline uint32_t roundUp(uint32_t value, uint32_t alignment)
     {
@@ -56,6 +62,24 @@ namespace Piccolo
         }
     };
 
+    /// Boxes as centers and half extents, one array per component, so a batch of boxes is tested with a few
+    /// SIMD operations. A free slot has infinitely negative extents and is never visible.
+    struct BoundingBoxSoA
+    {
+        std::vector<float> center_x;
+        std::vector<float> center_y;
+        std::vector<float> center_z;
+        std::vector<float> extent_x;
+        std::vector<float> extent_y;
+        std::vector<float> extent_z;
+
+        size_t size() const { return center_x.size(); }
+        void   resize(size_t size);
+        void   set(size_t index, BoundingBox const& b);
+        void   setEmpty(size_t index);
+        void   copy(size_t from_index, size_t to_index);
+    };
+
     struct BoundingSphere
     {
         Vector3   m_center;
@@ -77,9 +101,23 @@ namespace Piccolo
 
     bool TiledFrustumIntersectBox(ClusterFrustum const& f, BoundingBox const& b);
 
+    // same test as TiledFrustumIntersectBox for all the boxes, 8 or 4 at a time with AVX2 or SSE2,
+    // the indices of the visible ones are written in increasing order
+    void TiledFrustumCullBoxes(ClusterFrustum const& f, BoundingBoxSoA const& boxes, std::vector<uint32_t>& out_visible);
+    // "AVX2", "SSE2" or "scalar", AVX2 is used when the build sets ENABLE_RENDER_AVX2
+    char const* TiledFrustumCullInstructionSet();
+
     BoundingBox BoundingBoxTransform(BoundingBox const& b, Matrix4x4 const& m);
 
     bool BoxIntersectsWithSphere(BoundingBox const& b, BoundingSphere const& s);
 
+    // appends the index ranges of the meshlets inside the frustum and not facing away from the camera, the adjacent
+    // ones merged. false when no meshlet is left
+    bool CullMeshlets(ClusterFrustum const&                     f,
+                      Vector3 const&                            camera_position,
+                      Matrix4x4 const&                          model_matrix,
+                      std::vector<MeshletDataDefinition> const& meshlets,
+                      std::vector<RenderMeshDrawRange>&         out_draw_ranges);
+
     Matrix4x4 CalculateDirectionalLightCamera(RenderScene& scene, RenderCamera& camera);
 } // namespace Piccolo
@@ -3,7 +3,10 @@
 #include "runtime/core/math/matrix4.h"
 #include "runtime/function/framework/object/object_id_allocator.h"
 
+#include <array>
+#include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace Piccolo
@@ -22,18 +25,15 @@ namespace Piccolo
         std::string m_skeleton_binding_file;
     };
 
-    REFLECTION_TYPE(SkeletonAnimationResultTransform)
-    STRUCT(SkeletonAnimationResultTransform, WhiteListFields)
+    /// Skinning matrices of an animated object, joint 0 is the identity and joint i + 1 is bone i.
+    /// The animation rewrites them in place every tick, the render entities of the object only keep
+    /// a pointer to them. There is a copy per swap data of the RenderSwapContext, the logic writes the one of the
+    /// logic swap data while the render reads the other, so a threaded render never reads a pose being written.
+    struct SkinningPalette
     {
-        REFLECTION_BODY(SkeletonAnimationResultTransform)
-        Matrix4x4 m_matrix;
-    };
+        static constexpr size_t k_copy_count = 2;
 
-    REFLECTION_TYPE(SkeletonAnimationResult)
-    STRUCT(SkeletonAnimationResult, Fields)
-    {
-        REFLECTION_BODY(SkeletonAnimationResult)
-        std::vector<SkeletonAnimationResultTransform> m_transforms;
+        std::array<std::vector<Matrix4x4>, k_copy_count> m_joint_matrices;
     };
 
     REFLECTION_TYPE(GameObjectMaterialDesc)
@@ -64,7 +64,9 @@ namespace Piccolo
         GameObjectTransformDesc m_transform_desc;
         bool                    m_with_animation {false};
         SkeletonBindingDesc     m_skeleton_binding_desc;
-        SkeletonAnimationResult m_skeleton_animation_result;
+
+        META(Disable)
+        std::shared_ptr<const SkinningPalette> m_skinning_palette;
     };
 
     constexpr size_t k_invalid_part_id = std::numeric_limits<size_t>::max();
@@ -83,12 +85,13 @@ namespace Piccolo
     {
     public:
         GameObjectDesc() : m_go_id(0) {}
-        GameObjectDesc(size_t go_id, const std::vector<GameObjectPartDesc>& parts) :
-            m_go_id(go_id), m_object_parts(parts)
+        GameObjectDesc(size_t go_id, std::vector<GameObjectPartDesc> parts) :
+            m_go_id(go_id), m_object_parts(std::move(parts))
         {}
 
         GObjectID                              getId() const { return m_go_id; }
         const std::vector<GameObjectPartDesc>& getObjectParts() const { return m_object_parts; }
+        std::vector<GameObjectPartDesc>&       getObjectParts() { return m_object_parts; }
 
     private:
         GObjectID                       m_go_id {k_invalid_gobject_id};
@@ -131,6 +131,9 @@ namespace Piccolo
             return;
         }
 
+        // the rendering submitted below waits for the uploads on the gpu
+        vulkan_resource->m_upload_queue.submit();
+
         static_cast<DirectionalLightShadowPass*>(m_directional_light_pass.get())->draw();
 
         static_cast<PointLightShadowPass*>(m_point_light_shadow_pass.get())->draw();
@@ -181,6 +184,9 @@ namespace Piccolo
             return;
         }
 
+        // the rendering submitted below waits for the uploads on the gpu
+        vulkan_resource->m_upload_queue.submit();
+
         static_cast<DirectionalLightShadowPass*>(m_directional_light_pass.get())->draw();
 
         static_cast<PointLightShadowPass*>(m_point_light_shadow_pass.get())->draw();
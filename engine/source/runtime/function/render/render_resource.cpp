@@ -3,6 +3,7 @@
 #include "runtime/function/render/render_camera.h"
 #include "runtime/function/render/render_helper.h"
 
+#include "runtime/function/render/mesh_optimizer.h"
 #include "runtime/function/render/render_mesh.h"
 #include "runtime/function/render/interface/vulkan/vulkan_rhi.h"
 #include "runtime/function/render/interface/vulkan/vulkan_util.h"
@@ -17,10 +18,17 @@ namespace Piccolo
 {
     void RenderResource::clear()
     {
+        m_upload_queue.clear();
     }
 
     void RenderResource::uploadGlobalRenderResource(std::shared_ptr<RHI> rhi, LevelResourceDesc level_resource_desc)
     {
+        // the staging ring is kept across the levels
+        if (!m_upload_queue.isInitialized())
+        {
+            m_upload_queue.initialize(rhi);
+        }
+
         // create and map global storage buffer
         createAndMapStorageBuffer(rhi);
 
@@ -43,7 +51,9 @@ namespace Piccolo
         std::shared_ptr<TextureData> specular_neg_z_map  = loadTextureHDR(skybox_specular_map.m_negative_z_map);
 
         // brdf
-        std::shared_ptr<TextureData> brdf_map = loadTextureHDR(level_resource_desc.m_ibl_resource_desc.m_brdf_map);
+        // the lookup tables keep their source pixels
+        std::shared_ptr<TextureData> brdf_map =
+            loadTextureHDR(level_resource_desc.m_ibl_resource_desc.m_brdf_map, 4, false);
 
         // create IBL samplers
         createIBLSamplers(rhi);
@@ -75,7 +85,7 @@ namespace Piccolo
 
         // color grading
         std::shared_ptr<TextureData> color_grading_map =
-            loadTexture(level_resource_desc.m_color_grading_resource_desc.m_color_grading_map);
+            loadTexture(level_resource_desc.m_color_grading_resource_desc.m_color_grading_map, false, false);
 
         // create color grading texture
         rhi->createGlobalImage(
@@ -246,7 +256,8 @@ namespace Piccolo
              irradiance_maps[4]->m_pixels,
              irradiance_maps[5]->m_pixels },
             irradiance_maps[0]->m_format,
-            irradiance_cubemap_miplevels);
+            irradiance_cubemap_miplevels,
+            irradiance_maps[0]->m_mip_levels);
 
         uint32_t specular_cubemap_miplevels =
             static_cast<uint32_t>(
@@ -265,7 +276,8 @@ namespace Piccolo
              specular_maps[4]->m_pixels,
              specular_maps[5]->m_pixels },
             specular_maps[0]->m_format,
-            specular_cubemap_miplevels);
+            specular_cubemap_miplevels,
+            specular_maps[0]->m_mip_levels);
     }
 
     VulkanMesh&
@@ -286,6 +298,7 @@ namespace Piccolo
 
             uint32_t index_buffer_size = static_cast<uint32_t>(mesh_data.m_static_mesh_data.m_index_buffer->m_size);
             void* index_buffer_data = mesh_data.m_static_mesh_data.m_index_buffer->m_data;
+            RHIIndexType index_type = mesh_data.m_static_mesh_data.m_index_type;
 
             uint32_t vertex_buffer_size = static_cast<uint32_t>(mesh_data.m_static_mesh_data.m_vertex_buffer->m_size);
             MeshVertexDataDefinition* vertex_buffer_data =
@@ -293,6 +306,16 @@ namespace Piccolo
 
             VulkanMesh& now_mesh = res.first->second;
 
+            // kept on the cpu for the culling of the main camera
+            const std::shared_ptr<BufferData>& meshlet_buffer = mesh_data.m_static_mesh_data.m_meshlet_buffer;
+            if (meshlet_buffer && meshlet_buffer->m_size > 0)
+            {
+                const MeshletDataDefinition* meshlets =
+                    static_cast<const MeshletDataDefinition*>(meshlet_buffer->m_data);
+                now_mesh.mesh_meshlets.assign(meshlets,
+                                              meshlets + meshlet_buffer->m_size / sizeof(MeshletDataDefinition));
+            }
+
             if (mesh_data.m_skeleton_binding_buffer)
             {
                 uint32_t joint_binding_buffer_size = (uint32_t)mesh_data.m_skeleton_binding_buffer->m_size;
@@ -302,6 +325,7 @@ namespace Piccolo
                                true,
                                index_buffer_size,
                                index_buffer_data,
+                               index_type,
                                vertex_buffer_size,
                                vertex_buffer_data,
                                joint_binding_buffer_size,
@@ -314,6 +338,7 @@ namespace Piccolo
                                false,
                                index_buffer_size,
                                index_buffer_data,
+                               index_type,
                                vertex_buffer_size,
                                vertex_buffer_data,
                                0,
@@ -350,108 +375,84 @@ namespace Piccolo
             uint32_t           base_color_image_width = 1;
             uint32_t           base_color_image_height = 1;
             RHIFormat base_color_image_format = RHIFormat::RHI_FORMAT_R8G8B8A8_SRGB;
+            uint32_t           base_color_image_miplevels = 1;
             if (material_data.m_base_color_texture)
             {
                 base_color_image_pixels = material_data.m_base_color_texture->m_pixels;
                 base_color_image_width = static_cast<uint32_t>(material_data.m_base_color_texture->m_width);
                 base_color_image_height = static_cast<uint32_t>(material_data.m_base_color_texture->m_height);
                 base_color_image_format = material_data.m_base_color_texture->m_format;
+                base_color_image_miplevels = material_data.m_base_color_texture->m_mip_levels;
             }
 
             void* metallic_roughness_image_pixels = empty_image;
             uint32_t           metallic_roughness_width = 1;
             uint32_t           metallic_roughness_height = 1;
             RHIFormat metallic_roughness_format = RHIFormat::RHI_FORMAT_R8G8B8A8_UNORM;
+            uint32_t           metallic_roughness_miplevels = 1;
             if (material_data.m_metallic_roughness_texture)
             {
                 metallic_roughness_image_pixels = material_data.m_metallic_roughness_texture->m_pixels;
                 metallic_roughness_width = static_cast<uint32_t>(material_data.m_metallic_roughness_texture->m_width);
                 metallic_roughness_height = static_cast<uint32_t>(material_data.m_metallic_roughness_texture->m_height);
                 metallic_roughness_format = material_data.m_metallic_roughness_texture->m_format;
+                metallic_roughness_miplevels = material_data.m_metallic_roughness_texture->m_mip_levels;
             }
 
             void* normal_roughness_image_pixels = empty_image;
             uint32_t           normal_roughness_width = 1;
             uint32_t           normal_roughness_height = 1;
             RHIFormat normal_roughness_format = RHIFormat::RHI_FORMAT_R8G8B8A8_UNORM;
+            uint32_t           normal_roughness_miplevels = 1;
             if (material_data.m_normal_texture)
             {
                 normal_roughness_image_pixels = material_data.m_normal_texture->m_pixels;
                 normal_roughness_width = static_cast<uint32_t>(material_data.m_normal_texture->m_width);
                 normal_roughness_height = static_cast<uint32_t>(material_data.m_normal_texture->m_height);
                 normal_roughness_format = material_data.m_normal_texture->m_format;
+                normal_roughness_miplevels = material_data.m_normal_texture->m_mip_levels;
             }
 
             void* occlusion_image_pixels = empty_image;
             uint32_t           occlusion_image_width = 1;
             uint32_t           occlusion_image_height = 1;
             RHIFormat occlusion_image_format = RHIFormat::RHI_FORMAT_R8G8B8A8_UNORM;
+            uint32_t           occlusion_image_miplevels = 1;
             if (material_data.m_occlusion_texture)
             {
                 occlusion_image_pixels = material_data.m_occlusion_texture->m_pixels;
                 occlusion_image_width = static_cast<uint32_t>(material_data.m_occlusion_texture->m_width);
                 occlusion_image_height = static_cast<uint32_t>(material_data.m_occlusion_texture->m_height);
                 occlusion_image_format = material_data.m_occlusion_texture->m_format;
+                occlusion_image_miplevels = material_data.m_occlusion_texture->m_mip_levels;
             }
 
             void* emissive_image_pixels = empty_image;
             uint32_t           emissive_image_width = 1;
             uint32_t           emissive_image_height = 1;
             RHIFormat emissive_image_format = RHIFormat::RHI_FORMAT_R8G8B8A8_UNORM;
+            uint32_t           emissive_image_miplevels = 1;
             if (material_data.m_emissive_texture)
             {
                 emissive_image_pixels = material_data.m_emissive_texture->m_pixels;
                 emissive_image_width  = static_cast<uint32_t>(material_data.m_emissive_texture->m_width);
                 emissive_image_height = static_cast<uint32_t>(material_data.m_emissive_texture->m_height);
                 emissive_image_format = material_data.m_emissive_texture->m_format;
+                emissive_image_miplevels = material_data.m_emissive_texture->m_mip_levels;
             }
 
             VulkanPBRMaterial& now_material = res.first->second;
 
-            // similiarly to the vertex/index buffer, we should allocate the uniform
-            // buffer in DEVICE_LOCAL memory and use the temp stage buffer to copy the
-            // data
+            // the uniform buffer is in DEVICE_LOCAL memory and written through the upload queue,
+            // similiarly to the vertex/index buffer
             {
-                // temporary staging buffer
-
                 RHIDeviceSize buffer_size = sizeof(MeshPerMaterialUniformBufferObject);
 
-                RHIBuffer* inefficient_staging_buffer = RHI_NULL_HANDLE;
-                RHIDeviceMemory* inefficient_staging_buffer_memory = RHI_NULL_HANDLE;
-                rhi->createBuffer(
-                    buffer_size,
-                    RHI_BUFFER_USAGE_TRANSFER_SRC_BIT,
-                    RHI_MEMORY_PROPERTY_HOST_VISIBLE_BIT | RHI_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-                    inefficient_staging_buffer,
-                    inefficient_staging_buffer_memory);
-                // RHI_BUFFER_USAGE_TRANSFER_SRC_BIT: buffer can be used as source in a
-                // memory transfer operation
-
-                void* staging_buffer_data = nullptr;
-                rhi->mapMemory(
-                    inefficient_staging_buffer_memory,
-                    0,
-                    buffer_size,
-                    0,
-                    &staging_buffer_data);
-                
-                MeshPerMaterialUniformBufferObject& material_uniform_buffer_info =
-                    (*static_cast<MeshPerMaterialUniformBufferObject*>(staging_buffer_data));
-                material_uniform_buffer_info.is_blend = entity.m_blend;
-                material_uniform_buffer_info.is_double_sided = entity.m_double_sided;
-                material_uniform_buffer_info.baseColorFactor = entity.m_base_color_factor;
-                material_uniform_buffer_info.metallicFactor = entity.m_metallic_factor;
-                material_uniform_buffer_info.roughnessFactor = entity.m_roughness_factor;
-                material_uniform_buffer_info.normalScale = entity.m_normal_scale;
-                material_uniform_buffer_info.occlusionStrength = entity.m_occlusion_strength;
-                material_uniform_buffer_info.emissiveFactor = entity.m_emissive_factor;
-
-                rhi->unmapMemory(inefficient_staging_buffer_memory);
-
                 // use the vmaAllocator to allocate asset uniform buffer
                 RHIBufferCreateInfo bufferInfo = { RHI_STRUCTURE_TYPE_BUFFER_CREATE_INFO };
                 bufferInfo.size = buffer_size;
                 bufferInfo.usage = RHI_BUFFER_USAGE_UNIFORM_BUFFER_BIT | RHI_BUFFER_USAGE_TRANSFER_DST_BIT;
+                m_upload_queue.setSharingMode(bufferInfo);
 
                 VmaAllocationCreateInfo allocInfo = {};
                 allocInfo.usage = VMA_MEMORY_USAGE_GPU_ONLY;
@@ -465,36 +466,46 @@ namespace Piccolo
                     &now_material.material_uniform_buffer_allocation,
                     NULL);
 
-                // use the data from staging buffer
-                rhi->copyBuffer(inefficient_staging_buffer, now_material.material_uniform_buffer, 0, 0, buffer_size);
-
-                // release staging buffer
-                rhi->destroyBuffer(inefficient_staging_buffer);
-                rhi->freeMemory(inefficient_staging_buffer_memory);
+                MeshPerMaterialUniformBufferObject& material_uniform_buffer_info =
+                    *static_cast<MeshPerMaterialUniformBufferObject*>(
+                        m_upload_queue.uploadBuffer(now_material.material_uniform_buffer, 0, buffer_size));
+                material_uniform_buffer_info.is_blend = entity.m_blend;
+                material_uniform_buffer_info.is_double_sided = entity.m_double_sided;
+                material_uniform_buffer_info.baseColorFactor = entity.m_base_color_factor;
+                material_uniform_buffer_info.metallicFactor = entity.m_metallic_factor;
+                material_uniform_buffer_info.roughnessFactor = entity.m_roughness_factor;
+                material_uniform_buffer_info.normalScale = entity.m_normal_scale;
+                material_uniform_buffer_info.occlusionStrength = entity.m_occlusion_strength;
+                material_uniform_buffer_info.emissiveFactor = entity.m_emissive_factor;
             }
 
             TextureDataToUpdate update_texture_data;
-            update_texture_data.base_color_image_pixels         = base_color_image_pixels;
-            update_texture_data.base_color_image_width          = base_color_image_width;
-            update_texture_data.base_color_image_height         = base_color_image_height;
-            update_texture_data.base_color_image_format         = base_color_image_format;
-            update_texture_data.metallic_roughness_image_pixels = metallic_roughness_image_pixels;
-            update_texture_data.metallic_roughness_image_width  = metallic_roughness_width;
-            update_texture_data.metallic_roughness_image_height = metallic_roughness_height;
-            update_texture_data.metallic_roughness_image_format = metallic_roughness_format;
-            update_texture_data.normal_roughness_image_pixels   = normal_roughness_image_pixels;
-            update_texture_data.normal_roughness_image_width    = normal_roughness_width;
-            update_texture_data.normal_roughness_image_height   = normal_roughness_height;
-            update_texture_data.normal_roughness_image_format   = normal_roughness_format;
-            update_texture_data.occlusion_image_pixels          = occlusion_image_pixels;
-            update_texture_data.occlusion_image_width           = occlusion_image_width;
-            update_texture_data.occlusion_image_height          = occlusion_image_height;
-            update_texture_data.occlusion_image_format          = occlusion_image_format;
-            update_texture_data.emissive_image_pixels           = emissive_image_pixels;
-            update_texture_data.emissive_image_width            = emissive_image_width;
-            update_texture_data.emissive_image_height           = emissive_image_height;
-            update_texture_data.emissive_image_format           = emissive_image_format;
-            update_texture_data.now_material                    = &now_material;
+            update_texture_data.base_color_image_pixels            = base_color_image_pixels;
+            update_texture_data.base_color_image_width             = base_color_image_width;
+            update_texture_data.base_color_image_height            = base_color_image_height;
+            update_texture_data.base_color_image_format            = base_color_image_format;
+            update_texture_data.base_color_image_miplevels         = base_color_image_miplevels;
+            update_texture_data.metallic_roughness_image_pixels    = metallic_roughness_image_pixels;
+            update_texture_data.metallic_roughness_image_width     = metallic_roughness_width;
+            update_texture_data.metallic_roughness_image_height    = metallic_roughness_height;
+            update_texture_data.metallic_roughness_image_format    = metallic_roughness_format;
+            update_texture_data.metallic_roughness_image_miplevels = metallic_roughness_miplevels;
+            update_texture_data.normal_roughness_image_pixels      = normal_roughness_image_pixels;
+            update_texture_data.normal_roughness_image_width       = normal_roughness_width;
+            update_texture_data.normal_roughness_image_height      = normal_roughness_height;
+            update_texture_data.normal_roughness_image_format      = normal_roughness_format;
+            update_texture_data.normal_roughness_image_miplevels   = normal_roughness_miplevels;
+            update_texture_data.occlusion_image_pixels             = occlusion_image_pixels;
+            update_texture_data.occlusion_image_width              = occlusion_image_width;
+            update_texture_data.occlusion_image_height             = occlusion_image_height;
+            update_texture_data.occlusion_image_format             = occlusion_image_format;
+            update_texture_data.occlusion_image_miplevels          = occlusion_image_miplevels;
+            update_texture_data.emissive_image_pixels              = emissive_image_pixels;
+            update_texture_data.emissive_image_width               = emissive_image_width;
+            update_texture_data.emissive_image_height              = emissive_image_height;
+            update_texture_data.emissive_image_format              = emissive_image_format;
+            update_texture_data.emissive_image_miplevels           = emissive_image_miplevels;
+            update_texture_data.now_material                       = &now_material;
 
             updateTextureImageData(rhi, update_texture_data);
 
@@ -591,6 +602,7 @@ namespace Piccolo
                                         bool                                   enable_vertex_blending,
                                         uint32_t                               index_buffer_size,
                                         void*                                  index_buffer_data,
+                                        RHIIndexType                           index_type,
                                         uint32_t                               vertex_buffer_size,
                                         MeshVertexDataDefinition const*        vertex_buffer_data,
                                         uint32_t                               joint_binding_buffer_size,
@@ -606,11 +618,11 @@ namespace Piccolo
                            vertex_buffer_data,
                            joint_binding_buffer_size,
                            joint_binding_buffer_data,
-                           index_buffer_size,
-                           reinterpret_cast<uint16_t*>(index_buffer_data),
                            now_mesh);
-        assert(0 == (index_buffer_size % sizeof(uint16_t)));
-        now_mesh.mesh_index_count = index_buffer_size / sizeof(uint16_t);
+        const uint32_t index_size = static_cast<uint32_t>(MeshOptimizer::getIndexSize(index_type));
+        assert(0 == (index_buffer_size % index_size));
+        now_mesh.mesh_index_type  = index_type;
+        now_mesh.mesh_index_count = index_buffer_size / index_size;
         updateIndexBuffer(rhi, index_buffer_size, index_buffer_data, now_mesh);
     }
 
@@ -620,8 +632,6 @@ namespace Piccolo
                                             MeshVertexDataDefinition const*        vertex_buffer_data,
                                             uint32_t                               joint_binding_buffer_size,
                                             MeshVertexBindingDataDefinition const* joint_binding_buffer_data,
-                                            uint32_t                               index_buffer_size,
-                                            uint16_t*                              index_buffer_data,
                                             VulkanMesh&                            now_mesh)
     {
         VulkanRHI* vulkan_context = static_cast<VulkanRHI*>(rhi.get());
@@ -630,105 +640,18 @@ namespace Piccolo
         {
             assert(0 == (vertex_buffer_size % sizeof(MeshVertexDataDefinition)));
             uint32_t vertex_count = vertex_buffer_size / sizeof(MeshVertexDataDefinition);
-            assert(0 == (index_buffer_size % sizeof(uint16_t)));
-            uint32_t index_count = index_buffer_size / sizeof(uint16_t);
+            assert(joint_binding_buffer_size == sizeof(MeshVertexBindingDataDefinition) * vertex_count);
 
             RHIDeviceSize vertex_position_buffer_size = sizeof(MeshVertex::VulkanMeshVertexPostition) * vertex_count;
             RHIDeviceSize vertex_varying_enable_blending_buffer_size =
                 sizeof(MeshVertex::VulkanMeshVertexVaryingEnableBlending) * vertex_count;
             RHIDeviceSize vertex_varying_buffer_size = sizeof(MeshVertex::VulkanMeshVertexVarying) * vertex_count;
             RHIDeviceSize vertex_joint_binding_buffer_size =
-                sizeof(MeshVertex::VulkanMeshVertexJointBinding) * index_count;
-
-            RHIDeviceSize vertex_position_buffer_offset = 0;
-            RHIDeviceSize vertex_varying_enable_blending_buffer_offset =
-                vertex_position_buffer_offset + vertex_position_buffer_size;
-            RHIDeviceSize vertex_varying_buffer_offset =
-                vertex_varying_enable_blending_buffer_offset + vertex_varying_enable_blending_buffer_size;
-            RHIDeviceSize vertex_joint_binding_buffer_offset = vertex_varying_buffer_offset + vertex_varying_buffer_size;
-
-            // temporary staging buffer
-            RHIDeviceSize inefficient_staging_buffer_size =
-                vertex_position_buffer_size + vertex_varying_enable_blending_buffer_size + vertex_varying_buffer_size +
-                vertex_joint_binding_buffer_size;
-            RHIBuffer* inefficient_staging_buffer = RHI_NULL_HANDLE;
-            RHIDeviceMemory* inefficient_staging_buffer_memory = RHI_NULL_HANDLE;
-            rhi->createBuffer(inefficient_staging_buffer_size,
-                              RHI_BUFFER_USAGE_TRANSFER_SRC_BIT,
-                              RHI_MEMORY_PROPERTY_HOST_VISIBLE_BIT | RHI_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-                              inefficient_staging_buffer,
-                              inefficient_staging_buffer_memory);
-
-            void* inefficient_staging_buffer_data;
-            rhi->mapMemory(inefficient_staging_buffer_memory,
-                           0,
-                           RHI_WHOLE_SIZE,
-                           0,
-                           &inefficient_staging_buffer_data);
-
-            MeshVertex::VulkanMeshVertexPostition* mesh_vertex_positions =
-                reinterpret_cast<MeshVertex::VulkanMeshVertexPostition*>(
-                    reinterpret_cast<uintptr_t>(inefficient_staging_buffer_data) + vertex_position_buffer_offset);
-            MeshVertex::VulkanMeshVertexVaryingEnableBlending* mesh_vertex_blending_varyings =
-                reinterpret_cast<MeshVertex::VulkanMeshVertexVaryingEnableBlending*>(
-                    reinterpret_cast<uintptr_t>(inefficient_staging_buffer_data) +
-                    vertex_varying_enable_blending_buffer_offset);
-            MeshVertex::VulkanMeshVertexVarying* mesh_vertex_varyings =
-                reinterpret_cast<MeshVertex::VulkanMeshVertexVarying*>(
-                    reinterpret_cast<uintptr_t>(inefficient_staging_buffer_data) + vertex_varying_buffer_offset);
-            MeshVertex::VulkanMeshVertexJointBinding* mesh_vertex_joint_binding =
-                reinterpret_cast<MeshVertex::VulkanMeshVertexJointBinding*>(
-                    reinterpret_cast<uintptr_t>(inefficient_staging_buffer_data) + vertex_joint_binding_buffer_offset);
-
-            for (uint32_t vertex_index = 0; vertex_index < vertex_count; ++vertex_index)
-            {
-                Vector3 normal = Vector3(vertex_buffer_data[vertex_index].nx,
-                    vertex_buffer_data[vertex_index].ny,
-                    vertex_buffer_data[vertex_index].nz);
-                Vector3 tangent = Vector3(vertex_buffer_data[vertex_index].tx,
-                    vertex_buffer_data[vertex_index].ty,
-                    vertex_buffer_data[vertex_index].tz);
-
-                mesh_vertex_positions[vertex_index].position = Vector3(vertex_buffer_data[vertex_index].x,
-                    vertex_buffer_data[vertex_index].y,
-                    vertex_buffer_data[vertex_index].z);
-
-                mesh_vertex_blending_varyings[vertex_index].normal = normal;
-                mesh_vertex_blending_varyings[vertex_index].tangent = tangent;
-
-                mesh_vertex_varyings[vertex_index].texcoord =
-                    Vector2(vertex_buffer_data[vertex_index].u, vertex_buffer_data[vertex_index].v);
-            }
-
-            for (uint32_t index_index = 0; index_index < index_count; ++index_index)
-            {
-                uint32_t vertex_buffer_index = index_buffer_data[index_index];
-
-                // TODO: move to assets loading process
-
-                mesh_vertex_joint_binding[index_index].indices[0] = joint_binding_buffer_data[vertex_buffer_index].m_index0;
-                mesh_vertex_joint_binding[index_index].indices[1] = joint_binding_buffer_data[vertex_buffer_index].m_index1;
-                mesh_vertex_joint_binding[index_index].indices[2] = joint_binding_buffer_data[vertex_buffer_index].m_index2;
-                mesh_vertex_joint_binding[index_index].indices[3] = joint_binding_buffer_data[vertex_buffer_index].m_index3;
-
-                float inv_total_weight = joint_binding_buffer_data[vertex_buffer_index].m_weight0 +
-                                         joint_binding_buffer_data[vertex_buffer_index].m_weight1 +
-                                         joint_binding_buffer_data[vertex_buffer_index].m_weight2 +
-                                         joint_binding_buffer_data[vertex_buffer_index].m_weight3;
-
-                inv_total_weight = (inv_total_weight != 0.0) ? 1 / inv_total_weight : 1.0;
-
-                mesh_vertex_joint_binding[index_index].weights =
-                    Vector4(joint_binding_buffer_data[vertex_buffer_index].m_weight0 * inv_total_weight,
-                        joint_binding_buffer_data[vertex_buffer_index].m_weight1 * inv_total_weight,
-                        joint_binding_buffer_data[vertex_buffer_index].m_weight2 * inv_total_weight,
-                        joint_binding_buffer_data[vertex_buffer_index].m_weight3 * inv_total_weight);
-            }
-
-            rhi->unmapMemory(inefficient_staging_buffer_memory);
+                sizeof(MeshVertex::VulkanMeshVertexJointBinding) * vertex_count;
 
             // use the vmaAllocator to allocate asset vertex buffer
             RHIBufferCreateInfo bufferInfo = { RHI_STRUCTURE_TYPE_BUFFER_CREATE_INFO };
+            m_upload_queue.setSharingMode(bufferInfo);
 
             VmaAllocationCreateInfo allocInfo = {};
             allocInfo.usage = VMA_MEMORY_USAGE_GPU_ONLY;
@@ -765,31 +688,33 @@ namespace Piccolo
                                  &now_mesh.mesh_vertex_joint_binding_buffer_allocation,
                                  NULL);
 
-            // use the data from staging buffer
-            rhi->copyBuffer(inefficient_staging_buffer,
-                            now_mesh.mesh_vertex_position_buffer,
-                            vertex_position_buffer_offset,
-                            0,
-                            vertex_position_buffer_size);
-            rhi->copyBuffer(inefficient_staging_buffer,
-                            now_mesh.mesh_vertex_varying_enable_blending_buffer,
-                            vertex_varying_enable_blending_buffer_offset,
-                            0,
-                            vertex_varying_enable_blending_buffer_size);
-            rhi->copyBuffer(inefficient_staging_buffer,
-                            now_mesh.mesh_vertex_varying_buffer,
-                            vertex_varying_buffer_offset,
-                            0,
-                            vertex_varying_buffer_size);
-            rhi->copyBuffer(inefficient_staging_buffer,
-                            now_mesh.mesh_vertex_joint_binding_buffer,
-                            vertex_joint_binding_buffer_offset,
-                            0,
-                            vertex_joint_binding_buffer_size);
-
-            // release staging buffer
-            rhi->destroyBuffer(inefficient_staging_buffer);
-            rhi->freeMemory(inefficient_staging_buffer_memory);
+            writeVertexStreams(vertex_count, vertex_buffer_data, now_mesh);
+
+            MeshVertex::VulkanMeshVertexJointBinding* mesh_vertex_joint_binding =
+                static_cast<MeshVertex::VulkanMeshVertexJointBinding*>(m_upload_queue.uploadBuffer(
+                    now_mesh.mesh_vertex_joint_binding_buffer, 0, vertex_joint_binding_buffer_size));
+
+            for (uint32_t vertex_index = 0; vertex_index < vertex_count; ++vertex_index)
+            {
+                // read by the vertex shader at gl_VertexIndex
+                mesh_vertex_joint_binding[vertex_index].indices[0] = joint_binding_buffer_data[vertex_index].m_index0;
+                mesh_vertex_joint_binding[vertex_index].indices[1] = joint_binding_buffer_data[vertex_index].m_index1;
+                mesh_vertex_joint_binding[vertex_index].indices[2] = joint_binding_buffer_data[vertex_index].m_index2;
+                mesh_vertex_joint_binding[vertex_index].indices[3] = joint_binding_buffer_data[vertex_index].m_index3;
+
+                float inv_total_weight = joint_binding_buffer_data[vertex_index].m_weight0 +
+                                         joint_binding_buffer_data[vertex_index].m_weight1 +
+                                         joint_binding_buffer_data[vertex_index].m_weight2 +
+                                         joint_binding_buffer_data[vertex_index].m_weight3;
+
+                inv_total_weight = (inv_total_weight != 0.0) ? 1 / inv_total_weight : 1.0;
+
+                mesh_vertex_joint_binding[vertex_index].weights =
+                    Vector4(joint_binding_buffer_data[vertex_index].m_weight0 * inv_total_weight,
+                        joint_binding_buffer_data[vertex_index].m_weight1 * inv_total_weight,
+                        joint_binding_buffer_data[vertex_index].m_weight2 * inv_total_weight,
+                        joint_binding_buffer_data[vertex_index].m_weight3 * inv_total_weight);
+            }
 
             // update descriptor set
             RHIDescriptorSetAllocateInfo mesh_vertex_blending_per_mesh_descriptor_set_alloc_info;
@@ -847,66 +772,10 @@ namespace Piccolo
                 sizeof(MeshVertex::VulkanMeshVertexVaryingEnableBlending) * vertex_count;
             RHIDeviceSize vertex_varying_buffer_size = sizeof(MeshVertex::VulkanMeshVertexVarying) * vertex_count;
 
-            RHIDeviceSize vertex_position_buffer_offset = 0;
-            RHIDeviceSize vertex_varying_enable_blending_buffer_offset =
-                vertex_position_buffer_offset + vertex_position_buffer_size;
-            RHIDeviceSize vertex_varying_buffer_offset =
-                vertex_varying_enable_blending_buffer_offset + vertex_varying_enable_blending_buffer_size;
-
-            // temporary staging buffer
-            RHIDeviceSize inefficient_staging_buffer_size =
-                vertex_position_buffer_size + vertex_varying_enable_blending_buffer_size + vertex_varying_buffer_size;
-            RHIBuffer* inefficient_staging_buffer = RHI_NULL_HANDLE;
-            RHIDeviceMemory* inefficient_staging_buffer_memory = RHI_NULL_HANDLE;
-            rhi->createBuffer(inefficient_staging_buffer_size,
-                              RHI_BUFFER_USAGE_TRANSFER_SRC_BIT,
-                              RHI_MEMORY_PROPERTY_HOST_VISIBLE_BIT | RHI_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-                              inefficient_staging_buffer,
-                              inefficient_staging_buffer_memory);
-
-            void* inefficient_staging_buffer_data;
-            rhi->mapMemory(inefficient_staging_buffer_memory,
-                           0,
-                           RHI_WHOLE_SIZE,
-                           0,
-                           &inefficient_staging_buffer_data);
-
-            MeshVertex::VulkanMeshVertexPostition* mesh_vertex_positions =
-                reinterpret_cast<MeshVertex::VulkanMeshVertexPostition*>(
-                    reinterpret_cast<uintptr_t>(inefficient_staging_buffer_data) + vertex_position_buffer_offset);
-            MeshVertex::VulkanMeshVertexVaryingEnableBlending* mesh_vertex_blending_varyings =
-                reinterpret_cast<MeshVertex::VulkanMeshVertexVaryingEnableBlending*>(
-                    reinterpret_cast<uintptr_t>(inefficient_staging_buffer_data) +
-                    vertex_varying_enable_blending_buffer_offset);
-            MeshVertex::VulkanMeshVertexVarying* mesh_vertex_varyings =
-                reinterpret_cast<MeshVertex::VulkanMeshVertexVarying*>(
-                    reinterpret_cast<uintptr_t>(inefficient_staging_buffer_data) + vertex_varying_buffer_offset);
-
-            for (uint32_t vertex_index = 0; vertex_index < vertex_count; ++vertex_index)
-            {
-                Vector3 normal = Vector3(vertex_buffer_data[vertex_index].nx,
-                    vertex_buffer_data[vertex_index].ny,
-                    vertex_buffer_data[vertex_index].nz);
-                Vector3 tangent = Vector3(vertex_buffer_data[vertex_index].tx,
-                    vertex_buffer_data[vertex_index].ty,
-                    vertex_buffer_data[vertex_index].tz);
-
-                mesh_vertex_positions[vertex_index].position = Vector3(vertex_buffer_data[vertex_index].x,
-                    vertex_buffer_data[vertex_index].y,
-                    vertex_buffer_data[vertex_index].z);
-
-                mesh_vertex_blending_varyings[vertex_index].normal = normal;
-                mesh_vertex_blending_varyings[vertex_index].tangent = tangent;
-
-                mesh_vertex_varyings[vertex_index].texcoord =
-                    Vector2(vertex_buffer_data[vertex_index].u, vertex_buffer_data[vertex_index].v);
-            }
-
-            rhi->unmapMemory(inefficient_staging_buffer_memory);
-
             // use the vmaAllocator to allocate asset vertex buffer
             RHIBufferCreateInfo bufferInfo = { RHI_STRUCTURE_TYPE_BUFFER_CREATE_INFO };
             bufferInfo.usage = RHI_BUFFER_USAGE_VERTEX_BUFFER_BIT | RHI_BUFFER_USAGE_TRANSFER_DST_BIT;
+            m_upload_queue.setSharingMode(bufferInfo);
 
             VmaAllocationCreateInfo allocInfo = {};
             allocInfo.usage = VMA_MEMORY_USAGE_GPU_ONLY;
@@ -933,26 +802,7 @@ namespace Piccolo
                                  &now_mesh.mesh_vertex_varying_buffer_allocation,
                                  NULL);
 
-            // use the data from staging buffer
-            rhi->copyBuffer(inefficient_staging_buffer,
-                            now_mesh.mesh_vertex_position_buffer,
-                            vertex_position_buffer_offset,
-                            0,
-                            vertex_position_buffer_size);
-            rhi->copyBuffer(inefficient_staging_buffer,
-                            now_mesh.mesh_vertex_varying_enable_blending_buffer,
-                            vertex_varying_enable_blending_buffer_offset,
-                            0,
-                            vertex_varying_enable_blending_buffer_size);
-            rhi->copyBuffer(inefficient_staging_buffer,
-                            now_mesh.mesh_vertex_varying_buffer,
-                            vertex_varying_buffer_offset,
-                            0,
-                            vertex_varying_buffer_size);
-
-            // release staging buffer
-            rhi->destroyBuffer(inefficient_staging_buffer);
-            rhi->freeMemory(inefficient_staging_buffer_memory);
+            writeVertexStreams(vertex_count, vertex_buffer_data, now_mesh);
 
             // update descriptor set
             RHIDescriptorSetAllocateInfo mesh_vertex_blending_per_mesh_descriptor_set_alloc_info;
@@ -1003,6 +853,50 @@ namespace Piccolo
         }
     }
 
+    void RenderResource::writeVertexStreams(uint32_t                        vertex_count,
+                                            MeshVertexDataDefinition const* vertex_buffer_data,
+                                            VulkanMesh&                     now_mesh)
+    {
+        // each stream is written into the staging memory of the upload queue before the next one is requested
+        MeshVertex::VulkanMeshVertexPostition* mesh_vertex_positions =
+            static_cast<MeshVertex::VulkanMeshVertexPostition*>(
+                m_upload_queue.uploadBuffer(now_mesh.mesh_vertex_position_buffer,
+                                            0,
+                                            sizeof(MeshVertex::VulkanMeshVertexPostition) * vertex_count));
+        for (uint32_t vertex_index = 0; vertex_index < vertex_count; ++vertex_index)
+        {
+            mesh_vertex_positions[vertex_index].position = Vector3(vertex_buffer_data[vertex_index].x,
+                vertex_buffer_data[vertex_index].y,
+                vertex_buffer_data[vertex_index].z);
+        }
+
+        MeshVertex::VulkanMeshVertexVaryingEnableBlending* mesh_vertex_blending_varyings =
+            static_cast<MeshVertex::VulkanMeshVertexVaryingEnableBlending*>(
+                m_upload_queue.uploadBuffer(now_mesh.mesh_vertex_varying_enable_blending_buffer,
+                                            0,
+                                            sizeof(MeshVertex::VulkanMeshVertexVaryingEnableBlending) * vertex_count));
+        for (uint32_t vertex_index = 0; vertex_index < vertex_count; ++vertex_index)
+        {
+            mesh_vertex_blending_varyings[vertex_index].normal = Vector3(vertex_buffer_data[vertex_index].nx,
+                vertex_buffer_data[vertex_index].ny,
+                vertex_buffer_data[vertex_index].nz);
+            mesh_vertex_blending_varyings[vertex_index].tangent = Vector3(vertex_buffer_data[vertex_index].tx,
+                vertex_buffer_data[vertex_index].ty,
+                vertex_buffer_data[vertex_index].tz);
+        }
+
+        MeshVertex::VulkanMeshVertexVarying* mesh_vertex_varyings =
+            static_cast<MeshVertex::VulkanMeshVertexVarying*>(
+                m_upload_queue.uploadBuffer(now_mesh.mesh_vertex_varying_buffer,
+                                            0,
+                                            sizeof(MeshVertex::VulkanMeshVertexVarying) * vertex_count));
+        for (uint32_t vertex_index = 0; vertex_index < vertex_count; ++vertex_index)
+        {
+            mesh_vertex_varyings[vertex_index].texcoord =
+                Vector2(vertex_buffer_data[vertex_index].u, vertex_buffer_data[vertex_index].v);
+        }
+    }
+
     void RenderResource::updateIndexBuffer(std::shared_ptr<RHI> rhi,
                                            uint32_t             index_buffer_size,
                                            void*                index_buffer_data,
@@ -1010,26 +904,13 @@ namespace Piccolo
     {
         VulkanRHI* vulkan_context = static_cast<VulkanRHI*>(rhi.get());
 
-        // temp staging buffer
         RHIDeviceSize buffer_size = index_buffer_size;
 
-        RHIBuffer* inefficient_staging_buffer;
-        RHIDeviceMemory* inefficient_staging_buffer_memory;
-        rhi->createBuffer(buffer_size,
-                          RHI_BUFFER_USAGE_TRANSFER_SRC_BIT,
-                          RHI_MEMORY_PROPERTY_HOST_VISIBLE_BIT | RHI_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-                          inefficient_staging_buffer,
-                          inefficient_staging_buffer_memory);
-
-        void* staging_buffer_data;
-        rhi->mapMemory(inefficient_staging_buffer_memory, 0, buffer_size, 0, &staging_buffer_data);
-        memcpy(staging_buffer_data, index_buffer_data, (size_t)buffer_size);
-        rhi->unmapMemory(inefficient_staging_buffer_memory);
-
         // use the vmaAllocator to allocate asset index buffer
         RHIBufferCreateInfo bufferInfo = { RHI_STRUCTURE_TYPE_BUFFER_CREATE_INFO };
         bufferInfo.size = buffer_size;
         bufferInfo.usage = RHI_BUFFER_USAGE_INDEX_BUFFER_BIT | RHI_BUFFER_USAGE_TRANSFER_DST_BIT;
+        m_upload_queue.setSharingMode(bufferInfo);
 
         VmaAllocationCreateInfo allocInfo = {};
         allocInfo.usage = VMA_MEMORY_USAGE_GPU_ONLY;
@@ -1041,12 +922,8 @@ namespace Piccolo
                              &now_mesh.mesh_index_buffer_allocation,
                              NULL);
 
-        // use the data from staging buffer
-        rhi->copyBuffer( inefficient_staging_buffer, now_mesh.mesh_index_buffer, 0, 0, buffer_size);
-
-        // release temp staging buffer
-        rhi->destroyBuffer(inefficient_staging_buffer);
-        rhi->freeMemory(inefficient_staging_buffer_memory);
+        // copied by the next submit of the upload queue
+        m_upload_queue.uploadBuffer(now_mesh.mesh_index_buffer, 0, index_buffer_data, buffer_size);
     }
 
     void RenderResource::updateTextureImageData(std::shared_ptr<RHI> rhi, const TextureDataToUpdate& texture_data)
@@ -1058,7 +935,9 @@ namespace Piccolo
             texture_data.base_color_image_width,
             texture_data.base_color_image_height,
             texture_data.base_color_image_pixels,
-            texture_data.base_color_image_format);
+            texture_data.base_color_image_format,
+            0,
+            texture_data.base_color_image_miplevels);
 
         rhi->createGlobalImage(
             texture_data.now_material->metallic_roughness_texture_image,
@@ -1067,7 +946,9 @@ namespace Piccolo
             texture_data.metallic_roughness_image_width,
             texture_data.metallic_roughness_image_height,
             texture_data.metallic_roughness_image_pixels,
-            texture_data.metallic_roughness_image_format);
+            texture_data.metallic_roughness_image_format,
+            0,
+            texture_data.metallic_roughness_image_miplevels);
 
         rhi->createGlobalImage(
             texture_data.now_material->normal_texture_image,
@@ -1076,7 +957,9 @@ namespace Piccolo
             texture_data.normal_roughness_image_width,
             texture_data.normal_roughness_image_height,
             texture_data.normal_roughness_image_pixels,
-            texture_data.normal_roughness_image_format);
+            texture_data.normal_roughness_image_format,
+            0,
+            texture_data.normal_roughness_image_miplevels);
 
         rhi->createGlobalImage(
             texture_data.now_material->occlusion_texture_image,
@@ -1085,7 +968,9 @@ namespace Piccolo
             texture_data.occlusion_image_width,
             texture_data.occlusion_image_height,
             texture_data.occlusion_image_pixels,
-            texture_data.occlusion_image_format);
+            texture_data.occlusion_image_format,
+            0,
+            texture_data.occlusion_image_miplevels);
 
         rhi->createGlobalImage(
             texture_data.now_material->emissive_texture_image,
@@ -1094,7 +979,9 @@ namespace Piccolo
             texture_data.emissive_image_width,
             texture_data.emissive_image_height,
             texture_data.emissive_image_pixels,
-            texture_data.emissive_image_format);
+            texture_data.emissive_image_format,
+            0,
+            texture_data.emissive_image_miplevels);
     }
 
     VulkanMesh& RenderResource::getEntityMesh(RenderEntity entity)
@@ -2,6 +2,7 @@
 
 #include "runtime/function/render/render_resource_base.h"
 #include "runtime/function/render/render_type.h"
+#include "runtime/function/render/render_upload_queue.h"
 #include "runtime/function/render/interface/rhi.h"
 
 #include "runtime/function/render/render_common.h"
@@ -134,6 +135,9 @@ namespace Piccolo
         // global rendering resource, include IBL data, global storage buffer
         GlobalRenderResource m_global_render_resource;
 
+        // copies the mesh and material buffers, submitted once per frame by the pipeline
+        RenderUploadQueue m_upload_queue;
+
         // storage buffer objects
         MeshPerframeStorageBufferObject                 m_mesh_perframe_storage_buffer_object;
         MeshPointLightShadowPerframeStorageBufferObject m_mesh_point_light_shadow_perframe_storage_buffer_object;
@@ -167,6 +171,7 @@ namespace Piccolo
                             bool                                          enable_vertex_blending,
                             uint32_t                                      index_buffer_size,
                             void*                                         index_buffer_data,
+                            RHIIndexType                                  index_type,
                             uint32_t                                      vertex_buffer_size,
                             struct MeshVertexDataDefinition const*        vertex_buffer_data,
                             uint32_t                                      joint_binding_buffer_size,
@@ -178,9 +183,11 @@ namespace Piccolo
                                 struct MeshVertexDataDefinition const*        vertex_buffer_data,
                                 uint32_t                                      joint_binding_buffer_size,
                                 struct MeshVertexBindingDataDefinition const* joint_binding_buffer_data,
-                                uint32_t                                      index_buffer_size,
-                                uint16_t*                                     index_buffer_data,
                                 VulkanMesh&                                   now_mesh);
+        // position, varying blending and varying streams of the vertices
+        void writeVertexStreams(uint32_t                               vertex_count,
+                                struct MeshVertexDataDefinition const* vertex_buffer_data,
+                                VulkanMesh&                            now_mesh);
         void updateIndexBuffer(std::shared_ptr<RHI> rhi,
                                uint32_t             index_buffer_size,
                                void*                index_buffer_data,
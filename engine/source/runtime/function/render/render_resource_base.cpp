@@ -7,6 +7,10 @@
 #include "runtime/resource/res_type/data/mesh_data.h"
 
 #include "runtime/function/global/global_context.h"
+#include "runtime/function/render/mesh_blob.h"
+#include "runtime/function/render/mesh_optimizer.h"
+#include "runtime/function/render/texture_blob.h"
+#include "runtime/function/render/texture_compressor.h"
 
 #define STB_IMAGE_IMPLEMENTATION
 #include <stb_image.h>
@@ -16,20 +20,48 @@
 
 #include <algorithm>
 #include <filesystem>
+#include <initializer_list>
 #include <vector>
 
 namespace Piccolo
 {
-    std::shared_ptr<TextureData> RenderResourceBase::loadTextureHDR(std::string file, int desired_channels)
+    namespace
+    {
+        // the cooked mip chain of the image when its blob is up to date and in one of the formats
+        std::shared_ptr<TextureData> loadTextureBlob(const std::filesystem::path&     image_file,
+                                                     std::initializer_list<RHIFormat> formats)
+        {
+            const std::filesystem::path blob_path = TextureBlob::getBlobPath(image_file);
+            if (!TextureBlob::isUpToDate(image_file, blob_path))
+                return nullptr;
+
+            std::shared_ptr<TextureData> texture = std::make_shared<TextureData>();
+            if (!TextureBlob::load(blob_path, *texture) ||
+                std::find(formats.begin(), formats.end(), texture->m_format) == formats.end())
+                return nullptr;
+            return texture;
+        }
+    } // namespace
+
+    std::shared_ptr<TextureData>
+    RenderResourceBase::loadTextureHDR(std::string file, int desired_channels, bool is_compressible)
     {
         std::shared_ptr<AssetManager> asset_manager = g_runtime_global_context.m_asset_manager;
         ASSERT(asset_manager);
 
+        const std::filesystem::path image_file = asset_manager->getFullPath(file);
+        if (is_compressible && m_is_texture_compression_supported)
+        {
+            std::shared_ptr<TextureData> cooked_texture =
+                loadTextureBlob(image_file, {RHIFormat::RHI_FORMAT_BC6H_UFLOAT_BLOCK});
+            if (cooked_texture)
+                return cooked_texture;
+        }
+
         std::shared_ptr<TextureData> texture = std::make_shared<TextureData>();
 
         int iw, ih, n;
-        texture->m_pixels =
-            stbi_loadf(asset_manager->getFullPath(file).generic_string().c_str(), &iw, &ih, &n, desired_channels);
+        texture->m_pixels = stbi_loadf(image_file.generic_string().c_str(), &iw, &ih, &n, desired_channels);
 
         if (!texture->m_pixels)
             return nullptr;
@@ -57,15 +89,30 @@ namespace Piccolo
         return texture;
     }
 
-    std::shared_ptr<TextureData> RenderResourceBase::loadTexture(std::string file, bool is_srgb)
+    std::shared_ptr<TextureData> RenderResourceBase::loadTexture(std::string file, bool is_srgb, bool is_compressible)
     {
         std::shared_ptr<AssetManager> asset_manager = g_runtime_global_context.m_asset_manager;
         ASSERT(asset_manager);
 
+        const std::filesystem::path image_file = asset_manager->getFullPath(file);
+        if (is_compressible && m_is_texture_compression_supported)
+        {
+            std::shared_ptr<TextureData> cooked_texture = loadTextureBlob(
+                image_file, {RHIFormat::RHI_FORMAT_BC1_RGB_UNORM_BLOCK, RHIFormat::RHI_FORMAT_BC3_UNORM_BLOCK});
+            if (cooked_texture)
+            {
+                if (is_srgb)
+                {
+                    cooked_texture->m_format = TextureCompressor::getSrgbFormat(cooked_texture->m_format);
+                }
+                return cooked_texture;
+            }
+        }
+
         std::shared_ptr<TextureData> texture = std::make_shared<TextureData>();
 
         int iw, ih, n;
-        texture->m_pixels = stbi_load(asset_manager->getFullPath(file).generic_string().c_str(), &iw, &ih, &n, 4);
+        texture->m_pixels = stbi_load(image_file.generic_string().c_str(), &iw, &ih, &n, 4);
 
         if (!texture->m_pixels)
             return nullptr;
@@ -83,6 +130,64 @@ namespace Piccolo
     }
 
     RenderMeshData RenderResourceBase::loadMeshData(const MeshSourceDesc& source, AxisAlignedBox& bounding_box)
+    {
+        RenderMeshData ret = decodeMeshData(source, bounding_box);
+        cacheBoundingBox(source, bounding_box);
+        return ret;
+    }
+
+    void RenderResourceBase::cacheBoundingBox(const MeshSourceDesc& source, const AxisAlignedBox& bounding_box)
+    {
+        m_bounding_box_cache_map.insert(std::make_pair(source, bounding_box));
+    }
+
+    RenderMeshData RenderResourceBase::decodeMeshData(const MeshSourceDesc& source, AxisAlignedBox& bounding_box)
+    {
+        RenderMeshData ret;
+
+        // a cooked blob is mapped and uploaded in place, with its precomputed bounding box
+        const std::filesystem::path blob_path = MeshBlob::getBlobPath(source.m_mesh_file);
+        if (!MeshBlob::isUpToDate(source.m_mesh_file, blob_path) || !MeshBlob::load(blob_path, ret, bounding_box))
+        {
+            ret = loadMeshSource(source, bounding_box);
+        }
+
+        return ret;
+    }
+
+    bool RenderResourceBase::cookMeshData(const MeshSourceDesc& source)
+    {
+        AxisAlignedBox bounding_box;
+        RenderMeshData mesh_data = loadMeshSource(source, bounding_box);
+        return MeshBlob::save(MeshBlob::getBlobPath(source.m_mesh_file), mesh_data, bounding_box);
+    }
+
+    bool RenderResourceBase::cookTextureData(const std::string& image_file)
+    {
+        int                          iw, ih, n;
+        std::shared_ptr<TextureData> texture;
+        if (stbi_is_hdr(image_file.c_str()))
+        {
+            float* pixels = stbi_loadf(image_file.c_str(), &iw, &ih, &n, 4);
+            texture       = TextureCompressor::compressHDR(pixels, iw, ih);
+            stbi_image_free(pixels);
+        }
+        else
+        {
+            stbi_uc* pixels = stbi_load(image_file.c_str(), &iw, &ih, &n, 4);
+            texture         = TextureCompressor::compressLDR(pixels, iw, ih);
+            stbi_image_free(pixels);
+        }
+
+        if (!texture)
+        {
+            LOG_ERROR("load image {} failed!", image_file);
+            return false;
+        }
+        return TextureBlob::save(TextureBlob::getBlobPath(image_file), *texture);
+    }
+
+    RenderMeshData RenderResourceBase::loadMeshSource(const MeshSourceDesc& source, AxisAlignedBox& bounding_box)
     {
         std::shared_ptr<AssetManager> asset_manager = g_runtime_global_context.m_asset_manager;
         ASSERT(asset_manager);
@@ -98,56 +203,50 @@ namespace Piccolo
             std::shared_ptr<MeshData> bind_data = std::make_shared<MeshData>();
             asset_manager->loadAsset<MeshData>(source.m_mesh_file, *bind_data);
 
-            // vertex buffer
-            size_t vertex_size                     = bind_data->vertex_buffer.size() * sizeof(MeshVertexDataDefinition);
-            ret.m_static_mesh_data.m_vertex_buffer = std::make_shared<BufferData>(vertex_size);
-            MeshVertexDataDefinition* vertex =
-                (MeshVertexDataDefinition*)ret.m_static_mesh_data.m_vertex_buffer->m_data;
+            std::vector<MeshVertexDataDefinition> vertices(bind_data->vertex_buffer.size());
             for (size_t i = 0; i < bind_data->vertex_buffer.size(); i++)
             {
-                vertex[i].x  = bind_data->vertex_buffer[i].px;
-                vertex[i].y  = bind_data->vertex_buffer[i].py;
-                vertex[i].z  = bind_data->vertex_buffer[i].pz;
-                vertex[i].nx = bind_data->vertex_buffer[i].nx;
-                vertex[i].ny = bind_data->vertex_buffer[i].ny;
-                vertex[i].nz = bind_data->vertex_buffer[i].nz;
-                vertex[i].tx = bind_data->vertex_buffer[i].tx;
-                vertex[i].ty = bind_data->vertex_buffer[i].ty;
-                vertex[i].tz = bind_data->vertex_buffer[i].tz;
-                vertex[i].u  = bind_data->vertex_buffer[i].u;
-                vertex[i].v  = bind_data->vertex_buffer[i].v;
-
-                bounding_box.merge(Vector3(vertex[i].x, vertex[i].y, vertex[i].z));
+                vertices[i].x  = bind_data->vertex_buffer[i].px;
+                vertices[i].y  = bind_data->vertex_buffer[i].py;
+                vertices[i].z  = bind_data->vertex_buffer[i].pz;
+                vertices[i].nx = bind_data->vertex_buffer[i].nx;
+                vertices[i].ny = bind_data->vertex_buffer[i].ny;
+                vertices[i].nz = bind_data->vertex_buffer[i].nz;
+                vertices[i].tx = bind_data->vertex_buffer[i].tx;
+                vertices[i].ty = bind_data->vertex_buffer[i].ty;
+                vertices[i].tz = bind_data->vertex_buffer[i].tz;
+                vertices[i].u  = bind_data->vertex_buffer[i].u;
+                vertices[i].v  = bind_data->vertex_buffer[i].v;
+
+                bounding_box.merge(Vector3(vertices[i].x, vertices[i].y, vertices[i].z));
             }
 
-            // index buffer
-            size_t index_size                     = bind_data->index_buffer.size() * sizeof(uint16_t);
-            ret.m_static_mesh_data.m_index_buffer = std::make_shared<BufferData>(index_size);
-            uint16_t* index                       = (uint16_t*)ret.m_static_mesh_data.m_index_buffer->m_data;
-            for (size_t i = 0; i < bind_data->index_buffer.size(); i++)
-            {
-                index[i] = static_cast<uint16_t>(bind_data->index_buffer[i]);
-            }
+            std::vector<uint32_t> indices(bind_data->index_buffer.begin(), bind_data->index_buffer.end());
 
-            // skeleton binding buffer
-            size_t data_size              = bind_data->bind.size() * sizeof(MeshVertexBindingDataDefinition);
-            ret.m_skeleton_binding_buffer = std::make_shared<BufferData>(data_size);
-            MeshVertexBindingDataDefinition* binding_data =
-                reinterpret_cast<MeshVertexBindingDataDefinition*>(ret.m_skeleton_binding_buffer->m_data);
+            // skeleton binding, one per vertex
+            std::vector<MeshVertexBindingDataDefinition> bindings(bind_data->bind.size());
             for (size_t i = 0; i < bind_data->bind.size(); i++)
             {
-                binding_data[i].m_index0  = bind_data->bind[i].index0;
-                binding_data[i].m_index1  = bind_data->bind[i].index1;
-                binding_data[i].m_index2  = bind_data->bind[i].index2;
-                binding_data[i].m_index3  = bind_data->bind[i].index3;
-                binding_data[i].m_weight0 = bind_data->bind[i].weight0;
-                binding_data[i].m_weight1 = bind_data->bind[i].weight1;
-                binding_data[i].m_weight2 = bind_data->bind[i].weight2;
-                binding_data[i].m_weight3 = bind_data->bind[i].weight3;
+                bindings[i].m_index0  = bind_data->bind[i].index0;
+                bindings[i].m_index1  = bind_data->bind[i].index1;
+                bindings[i].m_index2  = bind_data->bind[i].index2;
+                bindings[i].m_index3  = bind_data->bind[i].index3;
+                bindings[i].m_weight0 = bind_data->bind[i].weight0;
+                bindings[i].m_weight1 = bind_data->bind[i].weight1;
+                bindings[i].m_weight2 = bind_data->bind[i].weight2;
+                bindings[i].m_weight3 = bind_data->bind[i].weight3;
+            }
+            if (!bindings.empty() && bindings.size() != vertices.size())
+            {
+                LOG_ERROR("mesh {} has {} vertices but {} skeleton bindings!",
+                          source.m_mesh_file,
+                          vertices.size(),
+                          bindings.size());
+                bindings.resize(vertices.size());
             }
-        }
 
-        m_bounding_box_cache_map.insert(std::make_pair(source, bounding_box));
+            ret = MeshOptimizer::optimizeMesh(std::move(vertices), std::move(indices), std::move(bindings));
+        }
 
         return ret;
     }
@@ -323,20 +422,13 @@ namespace Piccolo
             }
         }
 
-        uint32_t stride           = sizeof(MeshVertexDataDefinition);
-        mesh_data.m_vertex_buffer = std::make_shared<BufferData>(mesh_vertices.size() * stride);
-        mesh_data.m_index_buffer  = std::make_shared<BufferData>(mesh_vertices.size() * sizeof(uint16_t));
-
-        assert(mesh_vertices.size() <= std::numeric_limits<uint16_t>::max()); // take care of the index range, should be
-                                                                              // consistent with the index range used by
-                                                                              // vulkan
-
-        uint16_t* indices = (uint16_t*)mesh_data.m_index_buffer->m_data;
+        // the faces are expanded to three vertices each, the shared ones are welded by the optimizer
+        std::vector<uint32_t> indices(mesh_vertices.size());
         for (size_t i = 0; i < mesh_vertices.size(); i++)
         {
-            ((MeshVertexDataDefinition*)(mesh_data.m_vertex_buffer->m_data))[i] = mesh_vertices[i];
-            indices[i]                                                          = static_cast<uint16_t>(i);
+            indices[i] = static_cast<uint32_t>(i);
         }
+        mesh_data = MeshOptimizer::optimizeMesh(std::move(mesh_vertices), std::move(indices), {}).m_static_mesh_data;
 
         return mesh_data;
     }
@@ -40,14 +40,31 @@ namespace Piccolo
                                           std::shared_ptr<RenderCamera> camera) = 0;
 
         // TODO: data caching
-        std::shared_ptr<TextureData> loadTextureHDR(std::string file, int desired_channels = 4);
-        std::shared_ptr<TextureData> loadTexture(std::string file, bool is_srgb = false);
+        // the texture and material loads only read files, they may run on job system tasks
+        // a cooked texture is loaded with its mip chain, unless it is not compressible as the lookup tables
+        std::shared_ptr<TextureData> loadTextureHDR(std::string file,
+                                                    int         desired_channels = 4,
+                                                    bool        is_compressible  = true);
+        std::shared_ptr<TextureData> loadTexture(std::string file, bool is_srgb = false, bool is_compressible = true);
         RenderMeshData               loadMeshData(const MeshSourceDesc& source, AxisAlignedBox& bounding_box);
         RenderMaterialData           loadMaterialData(const MaterialSourceDesc& source);
         AxisAlignedBox               getCachedBoudingBox(const MeshSourceDesc& source) const;
+        void                         cacheBoundingBox(const MeshSourceDesc& source, const AxisAlignedBox& bounding_box);
+
+        // loadMeshData without the bounding box caching, safe to call from job system tasks
+        static RenderMeshData decodeMeshData(const MeshSourceDesc& source, AxisAlignedBox& bounding_box);
+
+        // writes the mesh blob that loadMeshData maps instead of parsing the source mesh
+        static bool cookMeshData(const MeshSourceDesc& source);
+        // writes the texture blob with the compressed mip chain that loadTexture and loadTextureHDR upload
+        static bool cookTextureData(const std::string& image_file);
+
+        // set from the rhi before any texture is loaded, the source images are loaded when it is off
+        bool m_is_texture_compression_supported {true};
 
     private:
-        StaticMeshData loadStaticMesh(std::string mesh_file, AxisAlignedBox& bounding_box);
+        static RenderMeshData loadMeshSource(const MeshSourceDesc& source, AxisAlignedBox& bounding_box);
+        static StaticMeshData loadStaticMesh(std::string mesh_file, AxisAlignedBox& bounding_box);
 
         std::unordered_map<MeshSourceDesc, AxisAlignedBox> m_bounding_box_cache_map;
     };
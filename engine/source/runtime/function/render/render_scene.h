@@ -4,11 +4,15 @@
 
 #include "runtime/function/render/light.h"
 #include "runtime/function/render/render_common.h"
+#include "runtime/function/render/render_draw_list.h"
 #include "runtime/function/render/render_entity.h"
+#include "runtime/function/render/render_entity_bvh.h"
 #include "runtime/function/render/render_guid_allocator.h"
 #include "runtime/function/render/render_object.h"
 
+#include <cstdint>
 #include <optional>
+#include <unordered_map>
 #include <vector>
 
 namespace Piccolo
@@ -16,6 +20,16 @@ namespace Piccolo
     class RenderResource;
     class RenderCamera;
 
+    // smoothed cpu time of the visibility of each view, in milliseconds
+    struct RenderSceneCullTime
+    {
+        float directional_light {0.f};
+        float point_lights {0.f};
+        float main_camera {0.f};
+        // sorting the visible nodes of all the views into batches
+        float draw_list {0.f};
+    };
+
     class RenderScene
     {
     public:
@@ -24,7 +38,8 @@ namespace Piccolo
         PDirectionalLight m_directional_light;
         PointLightList    m_point_light_list;
 
-        // render entities
+        // render entities, dense for the culling, added, updated and removed through the scene to keep the bvh and
+        // the entity slots in sync
         std::vector<RenderEntity> m_render_entities;
 
         // axis, for editor
@@ -35,10 +50,15 @@ namespace Piccolo
         std::vector<RenderMeshNode> m_point_lights_visible_mesh_nodes;
         std::vector<RenderMeshNode> m_main_camera_visible_mesh_nodes;
         RenderAxisNode              m_axis_node;
+        // the visible mesh nodes batched for drawing
+        RenderDrawList m_draw_list;
 
         // clear
         void clear();
 
+        // the copy of the skinning palettes the visible nodes point to
+        void setSkinningPaletteIndex(uint8_t palette_index) { m_skinning_palette_index = palette_index; }
+
         // update visible objects in each frame
         void updateVisibleObjects(std::shared_ptr<RenderResource> render_resource,
                                   std::shared_ptr<RenderCamera>   camera);
@@ -50,9 +70,21 @@ namespace Piccolo
         GuidAllocator<MeshSourceDesc>&     getMeshAssetIdAllocator();
         GuidAllocator<MaterialSourceDesc>& getMaterialAssetdAllocator();
 
-        void      addInstanceIdToMap(uint32_t instance_id, GObjectID go_id);
+        // the entity is the part part_index of the object, its instance id is its handle
+        void addOrUpdateRenderEntity(GObjectID go_id, size_t part_index, const RenderEntity& render_entity);
+        // moves an added part, false when the object has no such part
+        bool updateRenderEntityTransform(GObjectID go_id, size_t part_index, const Matrix4x4& model_matrix);
+
+        const BoundingBox& getSceneBoundingBox() const;
+
+        // the logic side reads the copy taken at the swap, the render side updates the times while the logic ticks
+        const RenderSceneCullTime& getCullTime() const { return m_swapped_cull_time; }
+        void                       swapCullTime() { m_swapped_cull_time = m_cull_time; }
+
         GObjectID getGObjectIDByMeshID(uint32_t mesh_id) const;
-        void      deleteEntityByGObjectID(GObjectID go_id);
+
+        // removes the parts of the object from first_part_index on and frees their instance ids
+        void deleteEntityByGObjectID(GObjectID go_id, size_t first_part_index = 0);
 
         void clearForLevelReloading();
 
@@ -61,7 +93,34 @@ namespace Piccolo
         GuidAllocator<MeshSourceDesc>     m_mesh_asset_id_allocator;
         GuidAllocator<MaterialSourceDesc> m_material_asset_id_allocator;
 
-        std::unordered_map<uint32_t, GObjectID> m_mesh_object_id_map;
+        static constexpr uint32_t k_invalid_entity_index = UINT32_MAX;
+
+        // where the entity with an instance id is in m_render_entities and which object it is a part of
+        struct RenderEntitySlot
+        {
+            uint32_t  m_entity_index {k_invalid_entity_index};
+            GObjectID m_go_id {k_invalid_gobject_id};
+        };
+
+        // indexed by instance id, the instance ids are allocated densely so the slots of the freed ones are reused
+        std::vector<RenderEntitySlot> m_entity_slots;
+        // the instance ids of the parts of each object in part order, s_invalid_guid for a part not added
+        std::unordered_map<GObjectID, std::vector<uint32_t>> m_object_instance_ids;
+
+        // world bounding boxes of the entities, all the views are culled against them
+        RenderEntityBvh                  m_entity_bvh;
+        std::vector<uint32_t>            m_culled_entity_indices;
+        std::vector<RenderMeshDrawRange> m_main_camera_draw_ranges;
+        RenderSceneCullTime              m_cull_time;
+        RenderSceneCullTime              m_swapped_cull_time;
+        uint8_t                          m_skinning_palette_index {0};
+
+        // the tree is traversed when few entities were visible in the last frame, otherwise all the boxes are
+        // tested with SIMD, which costs less per entity
+        void cullEntities(const ClusterFrustum& frustum, size_t previous_visible_count);
+
+        // the last entity takes the place of the removed one
+        void removeRenderEntity(uint32_t instance_id);
 
         void updateVisibleObjectsDirectionalLight(std::shared_ptr<RenderResource> render_resource,
                                                   std::shared_ptr<RenderCamera>   camera);
@@ -70,5 +129,6 @@ namespace Piccolo
                                             std::shared_ptr<RenderCamera>   camera);
         void updateVisibleObjectsAxis(std::shared_ptr<RenderResource> render_resource);
         void updateVisibleObjectsParticle(std::shared_ptr<RenderResource> render_resource);
+        void updateDrawList(std::shared_ptr<RenderCamera> camera);
     };
 } // namespace Piccolo
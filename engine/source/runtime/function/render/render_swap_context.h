@@ -1,104 +1,11 @@
 #pragma once
 
-#include "runtime/function/particle/emitter_id_allocator.h"
-#include "runtime/function/particle/particle_desc.h"
-#include "runtime/function/render/render_camera.h"
-#include "runtime/function/render/render_object.h"
-
-#include "runtime/resource/res_type/global/global_particle.h"
-#include "runtime/resource/res_type/global/global_rendering.h"
+#include "runtime/function/render/render_command_queue.h"
 
 #include <cstdint>
-#include <deque>
-#include <optional>
-#include <string>
 
 namespace Piccolo
 {
-    struct LevelIBLResourceDesc
-    {
-        SkyBoxIrradianceMap m_skybox_irradiance_map;
-        SkyBoxSpecularMap   m_skybox_specular_map;
-        std::string         m_brdf_map;
-    };
-
-    struct LevelColorGradingResourceDesc
-    {
-        std::string m_color_grading_map;
-    };
-
-    struct LevelResourceDesc
-    {
-        LevelIBLResourceDesc          m_ibl_resource_desc;
-        LevelColorGradingResourceDesc m_color_grading_resource_desc;
-    };
-
-    struct CameraSwapData
-    {
-        std::optional<float>            m_fov_x;
-        std::optional<RenderCameraType> m_camera_type;
-        std::optional<Matrix4x4>        m_view_matrix;
-    };
-
-    struct GameObjectResourceDesc
-    {
-        std::deque<GameObjectDesc> m_game_object_descs;
-
-        void add(GameObjectDesc& desc);
-        void pop();
-
-        bool isEmpty() const;
-
-        GameObjectDesc& getNextProcessObject();
-    };
-
-    struct ParticleSubmitRequest
-    {
-        std::vector<ParticleEmitterDesc> m_emitter_descs;
-
-        void add(ParticleEmitterDesc& desc);
-
-        unsigned int getEmitterCount() const;
-
-        const ParticleEmitterDesc& getEmitterDesc(unsigned int index);
-    };
-
-    struct EmitterTickRequest
-    {
-        std::vector<ParticleEmitterID> m_emitter_indices;
-    };
-
-    struct EmitterTransformRequest
-    {
-        std::vector<ParticleEmitterTransformDesc> m_transform_descs;
-
-        void add(ParticleEmitterTransformDesc& desc);
-
-        void clear();
-
-        unsigned int getEmitterCount() const;
-
-        const ParticleEmitterTransformDesc& getNextEmitterTransformDesc(unsigned int index);
-    };
-
-    struct RenderSwapData
-    {
-        std::optional<LevelResourceDesc>       m_level_resource_desc;
-        std::optional<GameObjectResourceDesc>  m_game_object_resource_desc;
-        std::optional<GameObjectResourceDesc>  m_game_object_to_delete;
-        std::optional<CameraSwapData>          m_camera_swap_data;
-        std::optional<ParticleSubmitRequest>   m_particle_submit_request;
-        std::optional<EmitterTickRequest>      m_emitter_tick_request;
-        std::optional<EmitterTransformRequest> m_emitter_transform_request;
-
-        void addDirtyGameObject(GameObjectDesc&& desc);
-        void addDeleteGameObject(GameObjectDesc&& desc);
-
-        void addNewParticleEmitter(ParticleEmitterDesc& desc);
-        void addTickParticleEmitter(ParticleEmitterID id);
-        void updateParticleTransform(ParticleEmitterTransformDesc& desc);
-    };
-
     enum SwapDataType : uint8_t
     {
         LogicSwapDataType = 0,
@@ -106,24 +13,26 @@ namespace Piccolo
         SwapDataTypeCount
     };
 
+    /// Hands the render commands of the logic frames to the render side. The logic side submits to one queue while
+    /// the render side pops the other, they are swapped once the render side has popped all its commands, until
+    /// then the logic side keeps submitting to the same queue.
     class RenderSwapContext
     {
     public:
-        RenderSwapData& getLogicSwapData();
-        RenderSwapData& getRenderSwapData();
-        void            swapLogicRenderData();
-        void            resetLevelRsourceSwapData();
-        void            resetGameObjectResourceSwapData();
-        void            resetGameObjectToDelete();
-        void            resetCameraSwapData();
-        void            resetPartilceBatchSwapData();
-        void            resetEmitterTickSwapData();
-        void            resetEmitterTransformSwapData();
+        RenderCommandQueue& getLogicCommands();
+        RenderCommandQueue& getRenderCommands();
+        void                swapLogicRenderData();
+
+        // the index of each side, also the copy of the skinning palettes it uses
+        uint8_t getLogicSwapDataIndex() const { return m_logic_swap_data_index; }
+        uint8_t getRenderSwapDataIndex() const { return m_render_swap_data_index; }
 
     private:
-        uint8_t        m_logic_swap_data_index {LogicSwapDataType};
-        uint8_t        m_render_swap_data_index {RenderSwapDataType};
-        RenderSwapData m_swap_data[SwapDataTypeCount];
+        uint8_t            m_logic_swap_data_index {LogicSwapDataType};
+        uint8_t            m_render_swap_data_index {RenderSwapDataType};
+        RenderCommandQueue m_command_queues[SwapDataTypeCount];
+
+        static_assert(SwapDataTypeCount == SkinningPalette::k_copy_count, "a skinning palette copy per swap data");
 
         bool isReadyToSwap() const;
         void swap();
@@ -20,6 +20,8 @@
 
 #include "runtime/function/render/interface/vulkan/vulkan_rhi.h"
 
+#include <algorithm>
+
 namespace Piccolo
 {
     RenderSystem::~RenderSystem()
@@ -55,6 +57,7 @@ namespace Piccolo
             global_rendering_res.m_color_grading_map;
 
         m_render_resource = std::make_shared<RenderResource>();
+        m_render_resource->m_is_texture_compression_supported = m_rhi->isTextureCompressionBCSupported();
         m_render_resource->uploadGlobalRenderResource(m_rhi, level_resource_desc);
 
         // setup render camera
@@ -105,7 +108,8 @@ namespace Piccolo
         // update per-frame buffer
         m_render_resource->updatePerFrameBuffer(m_render_scene, m_render_camera);
 
-        // update per-frame visible objects
+        // update per-frame visible objects, with the poses the logic wrote before the last swap
+        m_render_scene->setSkinningPaletteIndex(m_swap_context.getRenderSwapDataIndex());
         m_render_scene->updateVisibleObjects(std::static_pointer_cast<RenderResource>(m_render_resource),
                                              m_render_camera);
 
@@ -156,12 +160,18 @@ namespace Piccolo
         m_render_pipeline.reset();
     }
 
-    void RenderSystem::swapLogicRenderData() { m_swap_context.swapLogicRenderData(); }
+    void RenderSystem::swapLogicRenderData()
+    {
+        m_swap_context.swapLogicRenderData();
+        m_render_scene->swapCullTime();
+    }
 
     RenderSwapContext& RenderSystem::getSwapContext() { return m_swap_context; }
 
     std::shared_ptr<RenderCamera> RenderSystem::getRenderCamera() const { return m_render_camera; }
 
+    const RenderSceneCullTime& RenderSystem::getCullTime() const { return m_render_scene->getCullTime(); }
+
     std::shared_ptr<RHI>          RenderSystem::getRHI() const { return m_rhi; }
 
     void RenderSystem::updateEngineContentViewport(float offset_x, float offset_y, float width, float height)
@@ -234,6 +244,7 @@ namespace Piccolo
 
     void RenderSystem::clearForLevelReloading()
     {
+        m_streamed_game_objects.clear();
         m_render_scene->clearForLevelReloading();
     }
 
@@ -247,199 +258,306 @@ namespace Piccolo
         m_render_pipeline->initializeUIRenderBackend(window_ui);
     }
 
-    void RenderSystem::processSwapData()
+    MaterialSourceDesc RenderSystem::getMaterialSource(const GameObjectPartDesc& game_object_part) const
     {
-        RenderSwapData& swap_data = m_swap_context.getRenderSwapData();
+        if (game_object_part.m_material_desc.m_with_texture)
+        {
+            return {game_object_part.m_material_desc.m_base_color_texture_file,
+                    game_object_part.m_material_desc.m_metallic_roughness_texture_file,
+                    game_object_part.m_material_desc.m_normal_texture_file,
+                    game_object_part.m_material_desc.m_occlusion_texture_file,
+                    game_object_part.m_material_desc.m_emissive_texture_file};
+        }
 
+        // TODO: move to default material definition json file
         std::shared_ptr<AssetManager> asset_manager = g_runtime_global_context.m_asset_manager;
-        ASSERT(asset_manager);
+        return {asset_manager->getFullPath("asset/texture/default/albedo.jpg").generic_string(),
+                asset_manager->getFullPath("asset/texture/default/mr.jpg").generic_string(),
+                asset_manager->getFullPath("asset/texture/default/normal.jpg").generic_string(),
+                "",
+                ""};
+    }
 
-        // TODO: update global resources if needed
-        if (swap_data.m_level_resource_desc.has_value())
+    bool RenderSystem::requestGameObjectResources(const GameObjectDesc& gobject)
+    {
+        std::shared_ptr<JobSystem> job_system = g_runtime_global_context.m_job_system;
+        ASSERT(job_system);
+
+        bool is_ready = true;
+        for (const GameObjectPartDesc& game_object_part : gobject.getObjectParts())
         {
-            m_render_resource->uploadGlobalRenderResource(m_rhi, *swap_data.m_level_resource_desc);
+            MeshSourceDesc mesh_source = {game_object_part.m_mesh_desc.m_mesh_file};
+            if (!m_render_scene->getMeshAssetIdAllocator().hasElement(mesh_source))
+            {
+                std::shared_ptr<StreamedMesh>& streamed_mesh = m_streamed_meshes[mesh_source];
+                if (!streamed_mesh)
+                {
+                    streamed_mesh      = std::make_shared<StreamedMesh>();
+                    streamed_mesh->job = job_system->submit([mesh_source, mesh = streamed_mesh] {
+                        mesh->mesh_data = RenderResourceBase::decodeMeshData(mesh_source, mesh->bounding_box);
+                    });
+                }
+                is_ready = is_ready && streamed_mesh->job.isDone();
+            }
 
-            // reset level resource swap data to a clean state
-            m_swap_context.resetLevelRsourceSwapData();
+            MaterialSourceDesc material_source = getMaterialSource(game_object_part);
+            if (!m_render_scene->getMaterialAssetdAllocator().hasElement(material_source))
+            {
+                std::shared_ptr<StreamedMaterial>& streamed_material = m_streamed_materials[material_source];
+                if (!streamed_material)
+                {
+                    streamed_material      = std::make_shared<StreamedMaterial>();
+                    streamed_material->job = job_system->submit(
+                        [material_source, material = streamed_material, render_resource = m_render_resource] {
+                            material->material_data = render_resource->loadMaterialData(material_source);
+                        });
+                }
+                is_ready = is_ready && streamed_material->job.isDone();
+            }
         }
+        return is_ready;
+    }
 
-        // update game object if needed
-        if (swap_data.m_game_object_resource_desc.has_value())
+    void RenderSystem::addGameObject(const GameObjectDesc& gobject)
+    {
+        for (size_t part_index = 0; part_index < gobject.getObjectParts().size(); part_index++)
         {
-            while (!swap_data.m_game_object_resource_desc->isEmpty())
+            const auto&      game_object_part = gobject.getObjectParts()[part_index];
+            GameObjectPartId part_id          = {gobject.getId(), part_index};
+
+            RenderEntity render_entity;
+            render_entity.m_instance_id =
+                static_cast<uint32_t>(m_render_scene->getInstanceIdAllocator().allocGuid(part_id));
+            render_entity.m_model_matrix = game_object_part.m_transform_desc.m_transform_matrix;
+
+            // mesh properties, decoded by requestGameObjectResources when not loaded yet
+            MeshSourceDesc mesh_source    = {game_object_part.m_mesh_desc.m_mesh_file};
+            bool           is_mesh_loaded = m_render_scene->getMeshAssetIdAllocator().hasElement(mesh_source);
+
+            RenderMeshData mesh_data;
+            if (!is_mesh_loaded)
             {
-                GameObjectDesc gobject = swap_data.m_game_object_resource_desc->getNextProcessObject();
+                auto streamed_mesh = m_streamed_meshes.find(mesh_source);
+                ASSERT(streamed_mesh != m_streamed_meshes.end() && streamed_mesh->second->job.isDone());
+                mesh_data                    = std::move(streamed_mesh->second->mesh_data);
+                render_entity.m_bounding_box = streamed_mesh->second->bounding_box;
+                m_render_resource->cacheBoundingBox(mesh_source, render_entity.m_bounding_box);
+                m_streamed_meshes.erase(streamed_mesh);
+            }
+            else
+            {
+                render_entity.m_bounding_box = m_render_resource->getCachedBoudingBox(mesh_source);
+            }
 
-                for (size_t part_index = 0; part_index < gobject.getObjectParts().size(); part_index++)
-                {
-                    const auto&      game_object_part = gobject.getObjectParts()[part_index];
-                    GameObjectPartId part_id          = {gobject.getId(), part_index};
+            render_entity.m_mesh_asset_id = m_render_scene->getMeshAssetIdAllocator().allocGuid(mesh_source);
+            // the palette is shared with the animation, the matrices are read in place every frame
+            render_entity.m_skinning_palette = game_object_part.m_skinning_palette;
+            render_entity.m_enable_vertex_blending =
+                render_entity.m_skinning_palette &&
+                render_entity.m_skinning_palette->m_joint_matrices[0].size() > 1; // take care
 
-                    bool is_entity_in_scene = m_render_scene->getInstanceIdAllocator().hasElement(part_id);
+            // material properties
+            MaterialSourceDesc material_source = getMaterialSource(game_object_part);
+            bool is_material_loaded = m_render_scene->getMaterialAssetdAllocator().hasElement(material_source);
 
-                    RenderEntity render_entity;
-                    render_entity.m_instance_id =
-                        static_cast<uint32_t>(m_render_scene->getInstanceIdAllocator().allocGuid(part_id));
-                    render_entity.m_model_matrix = game_object_part.m_transform_desc.m_transform_matrix;
+            RenderMaterialData material_data;
+            if (!is_material_loaded)
+            {
+                auto streamed_material = m_streamed_materials.find(material_source);
+                ASSERT(streamed_material != m_streamed_materials.end() && streamed_material->second->job.isDone());
+                material_data = std::move(streamed_material->second->material_data);
+                m_streamed_materials.erase(streamed_material);
+            }
 
-                    m_render_scene->addInstanceIdToMap(render_entity.m_instance_id, gobject.getId());
+            render_entity.m_material_asset_id = m_render_scene->getMaterialAssetdAllocator().allocGuid(material_source);
 
-                    // mesh properties
-                    MeshSourceDesc mesh_source    = {game_object_part.m_mesh_desc.m_mesh_file};
-                    bool           is_mesh_loaded = m_render_scene->getMeshAssetIdAllocator().hasElement(mesh_source);
+            // create game object on the graphics api side
+            if (!is_mesh_loaded)
+            {
+                m_render_resource->uploadGameObjectRenderResource(m_rhi, render_entity, mesh_data);
+            }
 
-                    RenderMeshData mesh_data;
-                    if (!is_mesh_loaded)
-                    {
-                        mesh_data = m_render_resource->loadMeshData(mesh_source, render_entity.m_bounding_box);
-                    }
-                    else
-                    {
-                        render_entity.m_bounding_box = m_render_resource->getCachedBoudingBox(mesh_source);
-                    }
+            if (!is_material_loaded)
+            {
+                m_render_resource->uploadGameObjectRenderResource(m_rhi, render_entity, material_data);
+            }
 
-                    render_entity.m_mesh_asset_id = m_render_scene->getMeshAssetIdAllocator().allocGuid(mesh_source);
-                    render_entity.m_enable_vertex_blending =
-                        game_object_part.m_skeleton_animation_result.m_transforms.size() > 1; // take care
-                    render_entity.m_joint_matrices.resize(
-                        game_object_part.m_skeleton_animation_result.m_transforms.size());
-                    for (size_t i = 0; i < game_object_part.m_skeleton_animation_result.m_transforms.size(); ++i)
-                    {
-                        render_entity.m_joint_matrices[i] =
-                            game_object_part.m_skeleton_animation_result.m_transforms[i].m_matrix;
-                    }
+            // add object to render scene if needed
+            m_render_scene->addOrUpdateRenderEntity(gobject.getId(), part_index, render_entity);
+        }
+
+        // a new description of the object may have fewer parts
+        m_render_scene->deleteEntityByGObjectID(gobject.getId(), gobject.getObjectParts().size());
+    }
+
+    void RenderSystem::processSwapData()
+    {
+        RenderCommandQueue& render_commands = m_swap_context.getRenderCommands();
+
+        std::shared_ptr<ParticlePass> particle_pass =
+            std::static_pointer_cast<ParticlePass>(m_render_pipeline->m_particle_pass);
 
-                    // material properties
-                    MaterialSourceDesc material_source;
-                    if (game_object_part.m_material_desc.m_with_texture)
+        m_new_particle_emitters.clear();
+        m_particle_tick_indices.clear();
+        m_particle_transform_descs.clear();
+
+        // the commands of an object come from one producer, so they are popped in the order they were submitted
+        while (RenderCommand* command = render_commands.pop())
+        {
+            switch (command->m_type)
+            {
+                case RenderCommandType::LevelResource:
+                {
+                    const auto& level_resource = static_cast<const RenderCommandLevelResource&>(*command);
+                    m_render_resource->uploadGlobalRenderResource(m_rhi, level_resource.m_level_resource_desc);
+                    break;
+                }
+                case RenderCommandType::AddGameObject:
+                {
+                    // an object waits until the data of all its parts is decoded, a newer description replaces
+                    // the waiting one
+                    GameObjectDesc& gobject = static_cast<RenderCommandAddGameObject&>(*command).m_game_object_desc;
+                    m_streamed_game_objects.erase(gobject.getId());
+                    if (requestGameObjectResources(gobject))
                     {
-                        material_source = {game_object_part.m_material_desc.m_base_color_texture_file,
-                                           game_object_part.m_material_desc.m_metallic_roughness_texture_file,
-                                           game_object_part.m_material_desc.m_normal_texture_file,
-                                           game_object_part.m_material_desc.m_occlusion_texture_file,
-                                           game_object_part.m_material_desc.m_emissive_texture_file};
+                        addGameObject(gobject);
                     }
                     else
                     {
-                        // TODO: move to default material definition json file
-                        material_source = {
-                            asset_manager->getFullPath("asset/texture/default/albedo.jpg").generic_string(),
-                            asset_manager->getFullPath("asset/texture/default/mr.jpg").generic_string(),
-                            asset_manager->getFullPath("asset/texture/default/normal.jpg").generic_string(),
-                            "",
-                            ""};
+                        const GObjectID go_id = gobject.getId();
+                        m_streamed_game_objects.emplace(go_id, std::move(gobject));
                     }
-                    bool is_material_loaded = m_render_scene->getMaterialAssetdAllocator().hasElement(material_source);
-
-                    RenderMaterialData material_data;
-                    if (!is_material_loaded)
-                    {
-                        material_data = m_render_resource->loadMaterialData(material_source);
-                    }
-
-                    render_entity.m_material_asset_id =
-                        m_render_scene->getMaterialAssetdAllocator().allocGuid(material_source);
-
-                    // create game object on the graphics api side
-                    if (!is_mesh_loaded)
+                    break;
+                }
+                case RenderCommandType::GameObjectTransform:
+                {
+                    updateGameObjectTransform(static_cast<const RenderCommandGameObjectTransform&>(*command));
+                    break;
+                }
+                case RenderCommandType::DeleteGameObject:
+                {
+                    const GObjectID go_id = static_cast<const RenderCommandDeleteGameObject&>(*command).m_go_id;
+                    m_streamed_game_objects.erase(go_id);
+                    m_render_scene->deleteEntityByGObjectID(go_id);
+                    break;
+                }
+                case RenderCommandType::Camera:
+                {
+                    const CameraSwapData& camera_swap_data =
+                        static_cast<const RenderCommandCamera&>(*command).m_camera_swap_data;
+                    if (camera_swap_data.m_fov_x.has_value())
                     {
-                        m_render_resource->uploadGameObjectRenderResource(m_rhi, render_entity, mesh_data);
+                        m_render_camera->setFOVx(*camera_swap_data.m_fov_x);
                     }
 
-                    if (!is_material_loaded)
+                    if (camera_swap_data.m_view_matrix.has_value())
                     {
-                        m_render_resource->uploadGameObjectRenderResource(m_rhi, render_entity, material_data);
+                        m_render_camera->setMainViewMatrix(*camera_swap_data.m_view_matrix);
                     }
 
-                    // add object to render scene if needed
-                    if (!is_entity_in_scene)
-                    {
-                        m_render_scene->m_render_entities.push_back(render_entity);
-                    }
-                    else
+                    if (camera_swap_data.m_camera_type.has_value())
                     {
-                        for (auto& entity : m_render_scene->m_render_entities)
-                        {
-                            if (entity.m_instance_id == render_entity.m_instance_id)
-                            {
-                                entity = render_entity;
-                                break;
-                            }
-                        }
+                        m_render_camera->setCurrentCameraType(*camera_swap_data.m_camera_type);
                     }
+                    break;
+                }
+                case RenderCommandType::ResetParticleEmitters:
+                {
+                    // the commands popped before are for the emitters of the previous level
+                    m_new_particle_emitters.clear();
+                    m_particle_tick_indices.clear();
+                    m_particle_transform_descs.clear();
+                    particle_pass->clearEmitters();
+                    break;
+                }
+                case RenderCommandType::NewParticleEmitter:
+                {
+                    m_new_particle_emitters.push_back(static_cast<const RenderCommandNewParticleEmitter*>(command));
+                    break;
+                }
+                case RenderCommandType::TickParticleEmitter:
+                {
+                    m_particle_tick_indices.push_back(
+                        static_cast<const RenderCommandTickParticleEmitter&>(*command).m_emitter_id);
+                    break;
+                }
+                case RenderCommandType::ParticleEmitterTransform:
+                {
+                    m_particle_transform_descs.push_back(
+                        static_cast<const RenderCommandParticleEmitterTransform&>(*command).m_transform_desc);
+                    break;
+                }
+                default:
+                {
+                    LOG_ERROR("unknown render command type {}", static_cast<uint32_t>(command->m_type));
+                    break;
                 }
-                // after finished processing, pop this game object
-                swap_data.m_game_object_resource_desc->pop();
             }
-
-            // reset game object swap data to a clean state
-            m_swap_context.resetGameObjectResourceSwapData();
         }
 
-        // remove deleted objects
-        if (swap_data.m_game_object_to_delete.has_value())
+        for (auto iter = m_streamed_game_objects.begin(); iter != m_streamed_game_objects.end();)
         {
-            while (!swap_data.m_game_object_to_delete->isEmpty())
+            if (requestGameObjectResources(iter->second))
             {
-                GameObjectDesc gobject = swap_data.m_game_object_to_delete->getNextProcessObject();
-                m_render_scene->deleteEntityByGObjectID(gobject.getId());
-                swap_data.m_game_object_to_delete->pop();
+                addGameObject(iter->second);
+                iter = m_streamed_game_objects.erase(iter);
+            }
+            else
+            {
+                ++iter;
             }
-
-            m_swap_context.resetGameObjectToDelete();
         }
 
-        // process camera swap data
-        if (swap_data.m_camera_swap_data.has_value())
+        if (!m_new_particle_emitters.empty())
         {
-            if (swap_data.m_camera_swap_data->m_fov_x.has_value())
+            // the emitters are indexed by id and arrive over several frames while a level streams in, the ones
+            // created in earlier frames are kept
+            ParticleEmitterID max_emitter_id = 0;
+            for (const RenderCommandNewParticleEmitter* command : m_new_particle_emitters)
             {
-                m_render_camera->setFOVx(*swap_data.m_camera_swap_data->m_fov_x);
+                max_emitter_id = std::max(max_emitter_id, command->m_emitter_id);
             }
+            particle_pass->setEmitterCount(static_cast<int>(max_emitter_id + 1));
 
-            if (swap_data.m_camera_swap_data->m_view_matrix.has_value())
+            for (const RenderCommandNewParticleEmitter* command : m_new_particle_emitters)
             {
-                m_render_camera->setMainViewMatrix(*swap_data.m_camera_swap_data->m_view_matrix);
+                particle_pass->createEmitter(static_cast<int>(command->m_emitter_id), command->m_emitter_desc);
             }
 
-            if (swap_data.m_camera_swap_data->m_camera_type.has_value())
-            {
-                m_render_camera->setCurrentCameraType(*swap_data.m_camera_swap_data->m_camera_type);
-            }
+            particle_pass->initializeEmitters();
+        }
 
-            m_swap_context.resetCameraSwapData();
+        // the pass keeps the indices of the last frame that sent some
+        if (!m_particle_tick_indices.empty())
+        {
+            particle_pass->setTickIndices(m_particle_tick_indices);
         }
 
-        if (swap_data.m_particle_submit_request.has_value())
+        if (!m_particle_transform_descs.empty())
         {
-            std::shared_ptr<ParticlePass> particle_pass =
-                std::static_pointer_cast<ParticlePass>(m_render_pipeline->m_particle_pass);
+            particle_pass->setTransformIndices(m_particle_transform_descs);
+        }
+    }
 
-            int emitter_count = swap_data.m_particle_submit_request->getEmitterCount();
-            particle_pass->setEmitterCount(emitter_count);
+    void RenderSystem::updateGameObjectTransform(const RenderCommandGameObjectTransform& command)
+    {
+        const Matrix4x4* part_transforms = command.getPartTransforms();
 
-            for (int index = 0; index < emitter_count; ++index)
+        // an object still streaming is added with its latest transforms
+        auto streamed_game_object = m_streamed_game_objects.find(command.m_go_id);
+        if (streamed_game_object != m_streamed_game_objects.end())
+        {
+            std::vector<GameObjectPartDesc>& parts = streamed_game_object->second.getObjectParts();
+            for (size_t part_index = 0; part_index < parts.size() && part_index < command.m_part_count; ++part_index)
             {
-                const ParticleEmitterDesc& desc = swap_data.m_particle_submit_request->getEmitterDesc(index);
-                particle_pass->createEmitter(index, desc);
+                parts[part_index].m_transform_desc.m_transform_matrix = part_transforms[part_index];
             }
-
-            particle_pass->initializeEmitters();
-
-            m_swap_context.resetPartilceBatchSwapData();
-        }
-        if (swap_data.m_emitter_tick_request.has_value())
-        {
-            std::static_pointer_cast<ParticlePass>(m_render_pipeline->m_particle_pass)
-                ->setTickIndices(swap_data.m_emitter_tick_request->m_emitter_indices);
-            m_swap_context.resetEmitterTickSwapData();
+            return;
         }
 
-        if (swap_data.m_emitter_transform_request.has_value())
+        for (uint32_t part_index = 0; part_index < command.m_part_count; ++part_index)
         {
-            std::static_pointer_cast<ParticlePass>(m_render_pipeline->m_particle_pass)
-                ->setTransformIndices(swap_data.m_emitter_transform_request->m_transform_descs);
-            m_swap_context.resetEmitterTransformSwapData();
+            m_render_scene->updateRenderEntityTransform(command.m_go_id, part_index, part_transforms[part_index]);
         }
     }
 } // namespace Piccolo
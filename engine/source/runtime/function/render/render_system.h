@@ -1,5 +1,8 @@
 #pragma once
 
+#include "runtime/core/job/job_system.h"
+#include "runtime/core/math/axis_aligned.h"
+
 #include "runtime/function/render/render_entity.h"
 #include "runtime/function/render/render_guid_allocator.h"
 #include "runtime/function/render/render_swap_context.h"
@@ -8,6 +11,8 @@
 #include <array>
 #include <memory>
 #include <optional>
+#include <unordered_map>
+#include <vector>
 
 namespace Piccolo
 {
@@ -16,6 +21,7 @@ namespace Piccolo
     class RenderResourceBase;
     class RenderPipelineBase;
     class RenderScene;
+    struct RenderSceneCullTime;
     class RenderCamera;
     class WindowUI;
     class DebugDrawManager;
@@ -47,6 +53,7 @@ namespace Piccolo
         void                          swapLogicRenderData();
         RenderSwapContext&            getSwapContext();
         std::shared_ptr<RenderCamera> getRenderCamera() const;
+        const RenderSceneCullTime&    getCullTime() const;
         std::shared_ptr<RHI>          getRHI() const;
 
         void      setRenderPipelineType(RENDER_PIPELINE_TYPE pipeline_type);
@@ -76,6 +83,33 @@ namespace Piccolo
         std::shared_ptr<RenderResourceBase> m_render_resource;
         std::shared_ptr<RenderPipelineBase> m_render_pipeline;
 
+        // mesh and material data decoded by job system tasks, removed once uploaded
+        struct StreamedMesh
+        {
+            JobHandle      job;
+            RenderMeshData mesh_data;
+            AxisAlignedBox bounding_box;
+        };
+        struct StreamedMaterial
+        {
+            JobHandle          job;
+            RenderMaterialData material_data;
+        };
+        std::unordered_map<MeshSourceDesc, std::shared_ptr<StreamedMesh>>         m_streamed_meshes;
+        std::unordered_map<MaterialSourceDesc, std::shared_ptr<StreamedMaterial>> m_streamed_materials;
+        // the latest description of the objects waiting for their data
+        std::unordered_map<GObjectID, GameObjectDesc> m_streamed_game_objects;
+
+        // the particle commands of a frame, handed to the particle pass together
+        std::vector<const RenderCommandNewParticleEmitter*> m_new_particle_emitters;
+        std::vector<ParticleEmitterID>                      m_particle_tick_indices;
+        std::vector<ParticleEmitterTransformDesc>           m_particle_transform_descs;
+
         void processSwapData();
+        void updateGameObjectTransform(const RenderCommandGameObjectTransform& command);
+        // start decoding what the object misses, true when all of it can be uploaded
+        bool               requestGameObjectResources(const GameObjectDesc& gobject);
+        void               addGameObject(const GameObjectDesc& gobject);
+        MaterialSourceDesc getMaterialSource(const GameObjectPartDesc& game_object_part) const;
     };
 } // namespace Piccolo
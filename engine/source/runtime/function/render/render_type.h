@@ -5,6 +5,7 @@
 #include <cstdint>
 #include <memory>
 #include <string>
+#include <utility>
 
 
 /// <summary>
@@ -1696,6 +1697,8 @@ namespace Piccolo
         PIPELINE_TYPE_COUNT
     };
 
+    class MappedFile;
+
     class BufferData
     {
     public:
@@ -1708,14 +1711,21 @@ namespace Piccolo
             m_size = size;
             m_data = malloc(size);
         }
+        // a section of a mapped file, used in place and kept mapped as long as the buffer lives
+        BufferData(std::shared_ptr<MappedFile> mapped_file, void* data, size_t size) :
+            m_size(size), m_data(data), m_mapped_file(std::move(mapped_file))
+        {}
         ~BufferData()
         {
-            if (m_data)
+            if (m_data && !m_mapped_file)
             {
                 free(m_data);
             }
         }
         bool isValid() const { return m_data != nullptr; }
+
+    private:
+        std::shared_ptr<MappedFile> m_mapped_file;
     };
 
     class TextureData
@@ -1726,6 +1736,7 @@ namespace Piccolo
         uint32_t m_depth {0};
         uint32_t m_mip_levels {0};
         uint32_t m_array_layers {0};
+        // the m_mip_levels levels one after the other, the largest first
         void*    m_pixels {nullptr};
 
         RHIFormat m_format = RHI_FORMAT_MAX_ENUM;
@@ -1763,6 +1774,21 @@ namespace Piccolo
         float m_weight3 {0.f};
     };
 
+    // a run of triangles of the index buffer with their bounds in model space, culled on the cpu by the main camera
+    struct MeshletDataDefinition
+    {
+        uint32_t m_first_index {0};
+        uint32_t m_index_count {0};
+
+        float m_center[3] {};
+        float m_radius {0.f};
+        // the triangles all face away from a camera for which
+        // dot(center - camera, cone_axis) >= cone_cutoff * length(center - camera) + radius,
+        // never true for a cutoff of 1
+        float m_cone_axis[3] {};
+        float m_cone_cutoff {1.f};
+    };
+
     struct MeshSourceDesc
     {
         std::string m_mesh_file;
@@ -1805,6 +1831,10 @@ namespace Piccolo
     {
         std::shared_ptr<BufferData> m_vertex_buffer;
         std::shared_ptr<BufferData> m_index_buffer;
+        // uint16_t or uint32_t indices
+        RHIIndexType                m_index_type {RHI_INDEX_TYPE_UINT16};
+        // MeshletDataDefinition covering the index buffer in order, none for the meshes built in code
+        std::shared_ptr<BufferData> m_meshlet_buffer;
     };
 
     struct RenderMeshData
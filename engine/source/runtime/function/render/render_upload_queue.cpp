@@ -0,0 +1,404 @@
+#include "runtime/function/render/render_upload_queue.h"
+
+#include "runtime/core/base/macro.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace Piccolo
+{
+    namespace
+    {
+        // the uploaded buffers are read by the draws as vertices, indices, uniforms and storage
+        constexpr RHIPipelineStageFlags k_upload_consumer_stages = RHI_PIPELINE_STAGE_VERTEX_INPUT_BIT |
+                                                                   RHI_PIPELINE_STAGE_VERTEX_SHADER_BIT |
+                                                                   RHI_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+
+        uint64_t alignUp(uint64_t value, uint64_t alignment) { return (value + alignment - 1) / alignment * alignment; }
+    } // namespace
+
+    void RenderUploadQueue::initialize(std::shared_ptr<RHI> rhi, RHIDeviceSize ring_size)
+    {
+        m_rhi            = rhi;
+        m_transfer_queue = rhi->getTransferQueue();
+
+        QueueFamilyIndices queue_indices = rhi->getQueueFamilyIndices();
+        m_queue_families = {queue_indices.graphics_family.value(), queue_indices.m_transfer_family.value()};
+        m_is_transfer_queue_dedicated = m_queue_families[0] != m_queue_families[1];
+
+        // staging ring, mapped for as long as the queue lives
+        m_ring_size = alignUp(ring_size, k_staging_alignment);
+        m_ring_head = 0;
+        m_ring_tail = 0;
+        rhi->createBuffer(m_ring_size,
+                          RHI_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                          RHI_MEMORY_PROPERTY_HOST_VISIBLE_BIT | RHI_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                          m_ring_buffer,
+                          m_ring_buffer_memory);
+        void* ring_buffer_pointer = nullptr;
+        if (RHI_SUCCESS != rhi->mapMemory(m_ring_buffer_memory, 0, RHI_WHOLE_SIZE, 0, &ring_buffer_pointer))
+        {
+            throw std::runtime_error("map upload ring buffer");
+        }
+        m_ring_buffer_pointer = static_cast<uint8_t*>(ring_buffer_pointer);
+
+        // the command buffers are recorded again for each submit
+        RHICommandPoolCreateInfo command_pool_create_info {};
+        command_pool_create_info.sType            = RHI_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+        command_pool_create_info.flags            = RHI_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+        command_pool_create_info.queueFamilyIndex = m_queue_families[1];
+        if (RHI_SUCCESS != rhi->createCommandPool(&command_pool_create_info, m_command_pool))
+        {
+            throw std::runtime_error("create upload command pool");
+        }
+
+        RHICommandBufferAllocateInfo command_buffer_allocate_info {};
+        command_buffer_allocate_info.sType              = RHI_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+        command_buffer_allocate_info.commandPool        = m_command_pool;
+        command_buffer_allocate_info.level              = RHI_COMMAND_BUFFER_LEVEL_PRIMARY;
+        command_buffer_allocate_info.commandBufferCount = 1;
+
+        RHIFenceCreateInfo fence_create_info {};
+        fence_create_info.sType = RHI_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+        fence_create_info.flags = 0;
+
+        m_batches.resize(k_batch_count);
+        m_free_batches.clear();
+        m_in_flight_batches.clear();
+        for (uint32_t batch_index = 0; batch_index < k_batch_count; ++batch_index)
+        {
+            Batch& batch = m_batches[batch_index];
+            if (RHI_SUCCESS != rhi->allocateCommandBuffers(&command_buffer_allocate_info, batch.command_buffer))
+            {
+                throw std::runtime_error("alloc upload command buffer");
+            }
+            if (RHI_SUCCESS != rhi->createFence(&fence_create_info, batch.fence))
+            {
+                throw std::runtime_error("create upload fence");
+            }
+            if (batch_index != 0)
+            {
+                m_free_batches.push_back(batch_index);
+            }
+        }
+        m_recording_batch = 0;
+
+        RHISemaphoreCreateInfo semaphore_create_info {};
+        semaphore_create_info.sType = RHI_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+
+        m_frame_semaphores.resize(rhi->getMaxFramesInFlight());
+        for (RHISemaphore*& semaphore : m_frame_semaphores)
+        {
+            if (RHI_SUCCESS != rhi->createSemaphore(&semaphore_create_info, semaphore))
+            {
+                throw std::runtime_error("create upload semaphore");
+            }
+        }
+        m_has_unsignaled_copies = false;
+    }
+
+    void RenderUploadQueue::clear()
+    {
+        if (!m_rhi)
+        {
+            return;
+        }
+
+        // the copies not submitted yet are dropped with their destinations
+        while (!m_in_flight_batches.empty())
+        {
+            retireBatches(true);
+        }
+        retireBatch(m_batches[m_recording_batch]);
+
+        // the last rendering submits may still wait for the semaphores
+        m_rhi->queueWaitIdle(m_rhi->getGraphicsQueue());
+        for (RHISemaphore* semaphore : m_frame_semaphores)
+        {
+            m_rhi->destroySemaphore(semaphore);
+        }
+        m_frame_semaphores.clear();
+
+        for (Batch& batch : m_batches)
+        {
+            m_rhi->freeCommandBuffers(m_command_pool, 1, batch.command_buffer);
+            m_rhi->destroyFence(batch.fence);
+        }
+        m_batches.clear();
+        m_free_batches.clear();
+        m_rhi->destroyCommandPool(m_command_pool);
+        m_command_pool = nullptr;
+
+        m_rhi->unmapMemory(m_ring_buffer_memory);
+        m_rhi->destroyBuffer(m_ring_buffer);
+        m_rhi->freeMemory(m_ring_buffer_memory);
+        m_ring_buffer_pointer = nullptr;
+
+        m_transfer_queue = nullptr;
+        m_rhi.reset();
+    }
+
+    void RenderUploadQueue::setSharingMode(RHIBufferCreateInfo& buffer_create_info) const
+    {
+        if (m_is_transfer_queue_dedicated)
+        {
+            buffer_create_info.sharingMode           = RHI_SHARING_MODE_CONCURRENT;
+            buffer_create_info.queueFamilyIndexCount = static_cast<uint32_t>(m_queue_families.size());
+            buffer_create_info.pQueueFamilyIndices   = m_queue_families.data();
+        }
+        else
+        {
+            buffer_create_info.sharingMode           = RHI_SHARING_MODE_EXCLUSIVE;
+            buffer_create_info.queueFamilyIndexCount = 0;
+            buffer_create_info.pQueueFamilyIndices   = nullptr;
+        }
+    }
+
+    void* RenderUploadQueue::uploadBuffer(RHIBuffer* dst_buffer, RHIDeviceSize dst_offset, RHIDeviceSize size)
+    {
+        ASSERT(m_rhi);
+        if (size == 0)
+        {
+            return nullptr;
+        }
+
+        if (size > m_ring_size)
+        {
+            // larger than the whole ring, through a staging buffer of its own
+            RHIBuffer*       staging_buffer        = RHI_NULL_HANDLE;
+            RHIDeviceMemory* staging_buffer_memory = RHI_NULL_HANDLE;
+            m_rhi->createBuffer(size,
+                                RHI_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                                RHI_MEMORY_PROPERTY_HOST_VISIBLE_BIT | RHI_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                                staging_buffer,
+                                staging_buffer_memory);
+            void* staging_buffer_data = nullptr;
+            m_rhi->mapMemory(staging_buffer_memory, 0, RHI_WHOLE_SIZE, 0, &staging_buffer_data);
+
+            Batch& batch = m_batches[m_recording_batch];
+            batch.oversized_buffers.emplace_back(staging_buffer, staging_buffer_memory);
+            batch.copies.push_back({staging_buffer, dst_buffer, {0, dst_offset, size}});
+            return staging_buffer_data;
+        }
+
+        // may submit the batch, so the batch is only looked up after
+        RHIDeviceSize ring_offset = allocateRing(size);
+        m_batches[m_recording_batch].copies.push_back({m_ring_buffer, dst_buffer, {ring_offset, dst_offset, size}});
+        return m_ring_buffer_pointer + ring_offset;
+    }
+
+    void RenderUploadQueue::uploadBuffer(RHIBuffer*    dst_buffer,
+                                         RHIDeviceSize dst_offset,
+                                         const void*   data,
+                                         RHIDeviceSize size)
+    {
+        void* staging_data = uploadBuffer(dst_buffer, dst_offset, size);
+        if (staging_data)
+        {
+            memcpy(staging_data, data, static_cast<size_t>(size));
+        }
+    }
+
+    void RenderUploadQueue::submit()
+    {
+        if (!m_rhi)
+        {
+            return;
+        }
+        retireBatches(false);
+        flushBatch(true);
+    }
+
+    RHIDeviceSize RenderUploadQueue::allocateRing(RHIDeviceSize size)
+    {
+        RHIDeviceSize ring_offset = 0;
+        while (!tryAllocateRing(size, ring_offset))
+        {
+            // the copies recorded since the last submit hold ring space too
+            if (!m_batches[m_recording_batch].copies.empty())
+            {
+                flushBatch(false);
+            }
+            else if (!retireBatches(true))
+            {
+                // nothing left to wait for, the ring is empty and the size fits it
+                LOG_ERROR("upload ring of {} bytes cannot fit {} bytes!", m_ring_size, size);
+                throw std::runtime_error("allocate upload ring");
+            }
+        }
+        return ring_offset;
+    }
+
+    bool RenderUploadQueue::tryAllocateRing(RHIDeviceSize size, RHIDeviceSize& out_offset)
+    {
+        if (m_ring_head == m_ring_tail)
+        {
+            // nothing in use, start over at the beginning of the ring
+            m_ring_head = alignUp(m_ring_head, m_ring_size);
+            m_ring_tail = m_ring_head;
+        }
+
+        uint64_t position = alignUp(m_ring_head, k_staging_alignment);
+        // an allocation does not wrap around the end of the ring
+        if (position % m_ring_size + size > m_ring_size)
+        {
+            position = alignUp(position + 1, m_ring_size);
+        }
+        if (position + size - m_ring_tail > m_ring_size)
+        {
+            return false;
+        }
+
+        m_ring_head = position + size;
+        out_offset  = position % m_ring_size;
+        return true;
+    }
+
+    void RenderUploadQueue::flushBatch(bool is_frame_submit)
+    {
+        Batch& batch = m_batches[m_recording_batch];
+
+        RHISemaphore* signal_semaphore = nullptr;
+        if (is_frame_submit && (m_has_unsignaled_copies || !batch.copies.empty()))
+        {
+            signal_semaphore = m_frame_semaphores[m_rhi->getCurrentFrameIndex() % m_frame_semaphores.size()];
+        }
+
+        const RHISemaphore* signal_semaphores[] = {signal_semaphore};
+
+        RHISubmitInfo submit_info {};
+        submit_info.sType = RHI_STRUCTURE_TYPE_SUBMIT_INFO;
+        if (signal_semaphore)
+        {
+            submit_info.signalSemaphoreCount = 1;
+            submit_info.pSignalSemaphores    = signal_semaphores;
+        }
+
+        if (batch.copies.empty())
+        {
+            if (signal_semaphore)
+            {
+                // only the copies submitted to make room are left, the semaphore orders them before the rendering
+                if (RHI_SUCCESS != m_rhi->queueSubmit(m_transfer_queue, 1, &submit_info, RHI_NULL_HANDLE))
+                {
+                    throw std::runtime_error("upload queue submit");
+                }
+                m_rhi->addRenderingWaitSemaphore(signal_semaphore, k_upload_consumer_stages);
+                m_has_unsignaled_copies = false;
+            }
+            return;
+        }
+
+        recordBatch(batch);
+        submit_info.commandBufferCount = 1;
+        submit_info.pCommandBuffers    = &batch.command_buffer;
+        if (RHI_SUCCESS != m_rhi->queueSubmit(m_transfer_queue, 1, &submit_info, batch.fence))
+        {
+            throw std::runtime_error("upload queue submit");
+        }
+        if (signal_semaphore)
+        {
+            m_rhi->addRenderingWaitSemaphore(signal_semaphore, k_upload_consumer_stages);
+        }
+        m_has_unsignaled_copies = !is_frame_submit;
+
+        batch.ring_end = m_ring_head;
+        m_in_flight_batches.push_back(m_recording_batch);
+
+        // the next copies are recorded into a batch the gpu is done with
+        if (m_free_batches.empty())
+        {
+            retireBatches(true);
+        }
+        m_recording_batch = m_free_batches.back();
+        m_free_batches.pop_back();
+    }
+
+    void RenderUploadQueue::recordBatch(Batch& batch)
+    {
+        RHICommandBufferBeginInfo command_buffer_begin_info {};
+        command_buffer_begin_info.sType = RHI_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+        command_buffer_begin_info.flags = RHI_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+        if (RHI_SUCCESS != m_rhi->beginCommandBuffer(batch.command_buffer, &command_buffer_begin_info))
+        {
+            throw std::runtime_error("begin upload command buffer");
+        }
+
+        // one copy command for all the regions between the same two buffers
+        std::stable_sort(batch.copies.begin(), batch.copies.end(), [](const PendingCopy& a, const PendingCopy& b) {
+            return a.src_buffer != b.src_buffer ? a.src_buffer < b.src_buffer : a.dst_buffer < b.dst_buffer;
+        });
+
+        std::vector<RHIBufferCopy> regions;
+        for (size_t copy_begin = 0; copy_begin < batch.copies.size();)
+        {
+            const PendingCopy& first_copy = batch.copies[copy_begin];
+
+            regions.clear();
+            size_t copy_end = copy_begin;
+            for (; copy_end < batch.copies.size() && batch.copies[copy_end].src_buffer == first_copy.src_buffer &&
+                   batch.copies[copy_end].dst_buffer == first_copy.dst_buffer;
+                 ++copy_end)
+            {
+                regions.push_back(batch.copies[copy_end].region);
+            }
+
+            m_rhi->cmdCopyBuffer(batch.command_buffer,
+                                 first_copy.src_buffer,
+                                 first_copy.dst_buffer,
+                                 static_cast<uint32_t>(regions.size()),
+                                 regions.data());
+            copy_begin = copy_end;
+        }
+
+        if (RHI_SUCCESS != m_rhi->endCommandBuffer(batch.command_buffer))
+        {
+            throw std::runtime_error("end upload command buffer");
+        }
+    }
+
+    bool RenderUploadQueue::retireBatches(bool wait_for_oldest)
+    {
+        bool is_retired = false;
+        while (!m_in_flight_batches.empty())
+        {
+            uint32_t batch_index = m_in_flight_batches.front();
+            Batch&   batch       = m_batches[batch_index];
+            if (!m_rhi->getFenceStatus(batch.fence))
+            {
+                if (!wait_for_oldest || is_retired)
+                {
+                    break;
+                }
+                if (RHI_SUCCESS != m_rhi->waitForFencesPFN(1, &batch.fence, RHI_TRUE, UINT64_MAX))
+                {
+                    throw std::runtime_error("wait upload fence");
+                }
+            }
+
+            if (RHI_SUCCESS != m_rhi->resetFencesPFN(1, &batch.fence))
+            {
+                throw std::runtime_error("reset upload fence");
+            }
+            retireBatch(batch);
+            m_ring_tail = std::max(m_ring_tail, batch.ring_end);
+
+            m_in_flight_batches.pop_front();
+            m_free_batches.push_back(batch_index);
+            is_retired = true;
+        }
+        return is_retired;
+    }
+
+    void RenderUploadQueue::retireBatch(Batch& batch)
+    {
+        for (auto& [staging_buffer, staging_buffer_memory] : batch.oversized_buffers)
+        {
+            m_rhi->destroyBuffer(staging_buffer);
+            m_rhi->freeMemory(staging_buffer_memory);
+        }
+        batch.oversized_buffers.clear();
+        batch.copies.clear();
+    }
+} // namespace Piccolo
@@ -0,0 +1,103 @@
+#pragma once
+
+#include "runtime/function/render/interface/rhi.h"
+
+#include <array>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <vector>
+
+namespace Piccolo
+{
+    /// Uploads the buffers of the render resources through a persistent staging ring. The copies made between two
+    /// submits are recorded into one command buffer and run on the transfer queue, a dedicated one when the device
+    /// has it, and the rendering of the frame waits for them on the gpu instead of the cpu waiting for each copy.
+    /// A submit gives its ring space back once its fence is signaled. Only the RHI interface is used here.
+    class RenderUploadQueue
+    {
+    public:
+        static constexpr RHIDeviceSize k_default_ring_size = 64 * 1024 * 1024;
+        static constexpr RHIDeviceSize k_staging_alignment = 16;
+        static constexpr uint32_t      k_batch_count       = 4;
+
+        void initialize(std::shared_ptr<RHI> rhi, RHIDeviceSize ring_size = k_default_ring_size);
+        // waits for the copies in flight
+        void clear();
+        bool isInitialized() const { return m_rhi != nullptr; }
+
+        // the buffers written by the queue have to be created with this sharing mode, they are shared with the
+        // graphics queue when the copies run on a dedicated transfer queue
+        void setSharingMode(RHIBufferCreateInfo& buffer_create_info) const;
+
+        // staging memory copied into size bytes of dst_buffer at dst_offset by the next submit. it has to be
+        // written before the next call to the queue, which may submit it to make room in the ring. the copies are not
+        // ordered against each other on the gpu, the destination ranges must not overlap
+        void* uploadBuffer(RHIBuffer* dst_buffer, RHIDeviceSize dst_offset, RHIDeviceSize size);
+        void  uploadBuffer(RHIBuffer* dst_buffer, RHIDeviceSize dst_offset, const void* data, RHIDeviceSize size);
+
+        // submits the copies made since the last submit, once per frame between prepareBeforePass and
+        // submitRendering. the rendering of the frame waits for them
+        void submit();
+
+        // bytes of the ring waiting for the gpu or written since the last submit
+        RHIDeviceSize getRingUsedSize() const { return m_ring_head - m_ring_tail; }
+        uint32_t      getInFlightBatchCount() const { return static_cast<uint32_t>(m_in_flight_batches.size()); }
+
+    private:
+        struct PendingCopy
+        {
+            RHIBuffer*    src_buffer;
+            RHIBuffer*    dst_buffer;
+            RHIBufferCopy region;
+        };
+
+        struct Batch
+        {
+            RHICommandBuffer* command_buffer {nullptr};
+            RHIFence*         fence {nullptr};
+            // position of the ring head when the batch was submitted, the tail moves there when it is retired
+            uint64_t ring_end {0};
+
+            std::vector<PendingCopy> copies;
+            // staging buffers of the uploads larger than the ring, freed with the batch
+            std::vector<std::pair<RHIBuffer*, RHIDeviceMemory*>> oversized_buffers;
+        };
+
+        // offset in the ring of size bytes, submits and waits for the batches in flight until they fit
+        RHIDeviceSize allocateRing(RHIDeviceSize size);
+        bool          tryAllocateRing(RHIDeviceSize size, RHIDeviceSize& out_offset);
+
+        void flushBatch(bool is_frame_submit);
+        void recordBatch(Batch& batch);
+        // frees the batches the gpu is done with in submission order, waiting for the oldest one if needed
+        bool retireBatches(bool wait_for_oldest);
+        void retireBatch(Batch& batch);
+
+        std::shared_ptr<RHI> m_rhi;
+        RHIQueue*            m_transfer_queue {nullptr};
+        RHICommandPool*      m_command_pool {nullptr};
+
+        // the queue families of the graphics and transfer queues, for the concurrent sharing
+        std::array<uint32_t, 2> m_queue_families {};
+        bool                    m_is_transfer_queue_dedicated {false};
+
+        RHIBuffer*       m_ring_buffer {nullptr};
+        RHIDeviceMemory* m_ring_buffer_memory {nullptr};
+        uint8_t*         m_ring_buffer_pointer {nullptr};
+        RHIDeviceSize    m_ring_size {0};
+        // monotonic positions in the ring, the bytes in [tail, head) are in use
+        uint64_t m_ring_head {0};
+        uint64_t m_ring_tail {0};
+
+        std::vector<Batch>    m_batches;
+        uint32_t              m_recording_batch {0};
+        std::deque<uint32_t>  m_in_flight_batches;
+        std::vector<uint32_t> m_free_batches;
+
+        // signaled by the last submit of each frame for its rendering. a batch submitted to make room is waited for
+        // with the later ones, the semaphore covers all the copies submitted before it on the transfer queue
+        std::vector<RHISemaphore*> m_frame_semaphores;
+        bool                       m_has_unsignaled_copies {false};
+    };
+} // namespace Piccolo
@@ -0,0 +1,129 @@
+#include "runtime/function/render/texture_blob.h"
+
+#include "runtime/core/base/macro.h"
+
+#include "runtime/function/render/texture_compressor.h"
+
+#include <cstdlib>
+#include <fstream>
+#include <system_error>
+
+namespace Piccolo
+{
+    namespace
+    {
+        // the levels start aligned for the staging copy
+        constexpr size_t k_data_alignment = 16;
+
+        bool readHeader(std::ifstream& blob_file, TextureBlobHeader& out_header)
+        {
+            blob_file.read(reinterpret_cast<char*>(&out_header), sizeof(out_header));
+            return blob_file && out_header.magic == TextureBlob::k_magic &&
+                   out_header.version == TextureBlob::k_version;
+        }
+    } // namespace
+
+    std::filesystem::path TextureBlob::getBlobPath(const std::filesystem::path& image_file)
+    {
+        // foo.png and foo.jpg get their own blob
+        std::filesystem::path blob_path = image_file;
+        blob_path += k_extension;
+        return blob_path;
+    }
+
+    bool TextureBlob::isUpToDate(const std::filesystem::path& image_file, const std::filesystem::path& blob_path)
+    {
+        std::error_code error;
+        const auto      blob_time = std::filesystem::last_write_time(blob_path, error);
+        if (error)
+            return false;
+        const auto image_time = std::filesystem::last_write_time(image_file, error);
+        if (!error && blob_time < image_time)
+            return false;
+
+        std::ifstream     blob_file(blob_path, std::ios::binary);
+        TextureBlobHeader header;
+        return readHeader(blob_file, header);
+    }
+
+    bool TextureBlob::load(const std::filesystem::path& blob_path, TextureData& out_texture)
+    {
+        std::ifstream     blob_file(blob_path, std::ios::binary | std::ios::ate);
+        TextureBlobHeader header;
+        const size_t      file_size = blob_file ? static_cast<size_t>(blob_file.tellg()) : 0;
+        blob_file.seekg(0);
+        if (!readHeader(blob_file, header))
+        {
+            LOG_ERROR("texture blob {} is missing or outdated!", blob_path.generic_string());
+            return false;
+        }
+
+        const RHIFormat format = static_cast<RHIFormat>(header.format);
+        if (!TextureCompressor::isBlockCompressed(format) || header.width == 0 || header.height == 0 ||
+            header.mip_levels == 0 ||
+            header.data_size !=
+                TextureCompressor::getMipChainSize(format, header.width, header.height, header.mip_levels) ||
+            header.data_offset > file_size || header.data_size > file_size - header.data_offset)
+        {
+            LOG_ERROR("texture blob {} is corrupted!", blob_path.generic_string());
+            return false;
+        }
+
+        // freed by TextureData like the stb_image pixels
+        void* pixels = malloc(header.data_size);
+        blob_file.seekg(header.data_offset);
+        blob_file.read(static_cast<char*>(pixels), header.data_size);
+        if (!blob_file)
+        {
+            free(pixels);
+            LOG_ERROR("read texture blob {} failed!", blob_path.generic_string());
+            return false;
+        }
+
+        if (out_texture.m_pixels)
+        {
+            free(out_texture.m_pixels);
+        }
+        out_texture.m_pixels       = pixels;
+        out_texture.m_width        = header.width;
+        out_texture.m_height       = header.height;
+        out_texture.m_depth        = 1;
+        out_texture.m_array_layers = 1;
+        out_texture.m_mip_levels   = header.mip_levels;
+        out_texture.m_format       = format;
+        out_texture.m_type         = PICCOLO_IMAGE_TYPE::PICCOLO_IMAGE_TYPE_2D;
+        return true;
+    }
+
+    bool TextureBlob::save(const std::filesystem::path& blob_path, const TextureData& texture)
+    {
+        if (!texture.isValid() || !TextureCompressor::isBlockCompressed(texture.m_format))
+        {
+            LOG_ERROR("texture blob {} has no compressed pixels!", blob_path.generic_string());
+            return false;
+        }
+
+        TextureBlobHeader header;
+        header.magic       = k_magic;
+        header.version     = k_version;
+        header.format      = static_cast<uint32_t>(texture.m_format);
+        header.width       = texture.m_width;
+        header.height      = texture.m_height;
+        header.mip_levels  = texture.m_mip_levels;
+        header.data_offset = static_cast<uint32_t>((sizeof(header) + k_data_alignment - 1) & ~(k_data_alignment - 1));
+        header.data_size   = static_cast<uint32_t>(TextureCompressor::getMipChainSize(
+            texture.m_format, texture.m_width, texture.m_height, texture.m_mip_levels));
+
+        std::ofstream blob_file(blob_path, std::ios::binary);
+        if (!blob_file)
+        {
+            LOG_ERROR("open file {} failed!", blob_path.generic_string());
+            return false;
+        }
+        const char padding[k_data_alignment] {};
+        blob_file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        blob_file.write(padding, header.data_offset - sizeof(header));
+        blob_file.write(static_cast<const char*>(texture.m_pixels), header.data_size);
+        return static_cast<bool>(blob_file);
+    }
+} // namespace Piccolo
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "runtime/function/render/render_type.h"
+
+#include <cstdint>
+#include <filesystem>
+
+namespace Piccolo
+{
+    /// Cooked texture, written next to its image source. The levels of the mip chain follow the header in the
+    /// layout of TextureCompressor, already block compressed, so a loaded blob is uploaded without any decoding.
+    struct TextureBlobHeader
+    {
+        uint32_t magic {0};
+        uint32_t version {0};
+        // the unorm variant, the srgb one is chosen when the texture is loaded
+        uint32_t format {0};
+        uint32_t width {0};
+        uint32_t height {0};
+        uint32_t mip_levels {0};
+        // byte offset of the first level from the start of the file, and the size of all the levels
+        uint32_t data_offset {0};
+        uint32_t data_size {0};
+    };
+
+    class TextureBlob
+    {
+    public:
+        static constexpr uint32_t    k_magic     = 0x58455450; // "PTEX"
+        static constexpr uint32_t    k_version   = 1;
+        static constexpr const char* k_extension = ".texture";
+
+        // asset/foo.png -> asset/foo.png.texture
+        static std::filesystem::path getBlobPath(const std::filesystem::path& image_file);
+        // written after the last change of image_file and by this version
+        static bool isUpToDate(const std::filesystem::path& image_file, const std::filesystem::path& blob_path);
+
+        static bool load(const std::filesystem::path& blob_path, TextureData& out_texture);
+        static bool save(const std::filesystem::path& blob_path, const TextureData& texture);
+    };
+} // namespace Piccolo
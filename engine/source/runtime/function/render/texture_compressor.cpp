@@ -0,0 +1,524 @@
+#include "runtime/function/render/texture_compressor.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+// stb_dxt uses memcpy without including it
+#define STB_DXT_IMPLEMENTATION
+#include <stb_dxt.h>
+
+namespace Piccolo
+{
+    namespace
+    {
+        constexpr uint32_t k_block_dimension = 4;
+        constexpr uint32_t k_block_texels    = k_block_dimension * k_block_dimension;
+
+        // BC6H mode 11: one region, 10 bit endpoints stored as they are and 4 bit indices
+        constexpr uint32_t k_bc6h_mode_11       = 0x03;
+        constexpr uint32_t k_bc6h_endpoint_bits = 10;
+        constexpr uint32_t k_bc6h_max_endpoint  = (1u << k_bc6h_endpoint_bits) - 1;
+        constexpr int32_t  k_bc6h_weights[16]   = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+        // the largest finite half
+        constexpr uint16_t k_half_max = 0x7BFF;
+
+        uint32_t getBlockCount(uint32_t dimension) { return (dimension + k_block_dimension - 1) / k_block_dimension; }
+
+        // BC6H unsigned interpolates the bits of the halves, not their values
+        uint16_t floatToHalf(float value)
+        {
+            // also catches NaN
+            if (!(value > 0.0f))
+                return 0;
+            if (value >= 65504.0f)
+                return k_half_max;
+
+            uint32_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            const int32_t exponent = static_cast<int32_t>((bits >> 23) & 0xFF) - 127 + 15;
+            uint32_t      mantissa = bits & 0x7FFFFF;
+            if (exponent <= 0)
+            {
+                if (exponent < -10)
+                    return 0;
+                // subnormal half, rounded half up
+                mantissa |= 0x800000;
+                const uint32_t shift = static_cast<uint32_t>(14 - exponent);
+                return static_cast<uint16_t>((mantissa >> shift) + ((mantissa >> (shift - 1)) & 1));
+            }
+
+            // the rounding may carry into the exponent, which is still the nearest half
+            const uint32_t half = (static_cast<uint32_t>(exponent) << 10 | (mantissa >> 13)) + ((mantissa >> 12) & 1);
+            return static_cast<uint16_t>(std::min<uint32_t>(half, k_half_max));
+        }
+
+        int32_t unquantizeBC6HEndpoint(uint32_t endpoint)
+        {
+            if (endpoint == 0)
+                return 0;
+            if (endpoint == k_bc6h_max_endpoint)
+                return 0xFFFF;
+            return static_cast<int32_t>(((endpoint << 16) + 0x8000) >> k_bc6h_endpoint_bits);
+        }
+
+        // an unquantized value back to the bits of a half
+        int32_t finishBC6HUnquantize(int32_t value) { return (value * 31) >> 6; }
+
+        // the endpoint decoding to the half nearest to value
+        uint32_t quantizeBC6HEndpoint(float value)
+        {
+            const uint32_t lower =
+                std::min(static_cast<uint32_t>(std::max(value, 0.0f) / 31.0f), k_bc6h_max_endpoint - 1);
+            const float lower_error = std::fabs(finishBC6HUnquantize(unquantizeBC6HEndpoint(lower)) - value);
+            const float upper_error = std::fabs(finishBC6HUnquantize(unquantizeBC6HEndpoint(lower + 1)) - value);
+            return upper_error < lower_error ? lower + 1 : lower;
+        }
+
+        struct BC6HEncoding
+        {
+            uint32_t endpoints[2][3] {};
+            uint32_t indices[k_block_texels] {};
+            float    error {0.0f};
+        };
+
+        // the nearest of the 16 interpolated colors for every texel
+        void selectBC6HIndices(const float (&texels)[k_block_texels][3], BC6HEncoding& encoding)
+        {
+            int32_t palette[16][3];
+            for (uint32_t channel = 0; channel < 3; ++channel)
+            {
+                const int32_t start = unquantizeBC6HEndpoint(encoding.endpoints[0][channel]);
+                const int32_t end   = unquantizeBC6HEndpoint(encoding.endpoints[1][channel]);
+                for (uint32_t index = 0; index < 16; ++index)
+                {
+                    const int32_t weight    = k_bc6h_weights[index];
+                    palette[index][channel] = finishBC6HUnquantize(((64 - weight) * start + weight * end + 32) >> 6);
+                }
+            }
+
+            encoding.error = 0.0f;
+            for (uint32_t texel = 0; texel < k_block_texels; ++texel)
+            {
+                float best_error = std::numeric_limits<float>::max();
+                for (uint32_t index = 0; index < 16; ++index)
+                {
+                    float error = 0.0f;
+                    for (uint32_t channel = 0; channel < 3; ++channel)
+                    {
+                        const float difference = texels[texel][channel] - static_cast<float>(palette[index][channel]);
+                        error += difference * difference;
+                    }
+                    if (error < best_error)
+                    {
+                        best_error              = error;
+                        encoding.indices[texel] = index;
+                    }
+                }
+                encoding.error += best_error;
+            }
+        }
+
+        void quantizeBC6HEndpoints(const float (&endpoints)[2][3], BC6HEncoding& encoding)
+        {
+            for (uint32_t endpoint = 0; endpoint < 2; ++endpoint)
+            {
+                for (uint32_t channel = 0; channel < 3; ++channel)
+                {
+                    const float value = std::clamp(endpoints[endpoint][channel], 0.0f, static_cast<float>(k_half_max));
+                    encoding.endpoints[endpoint][channel] = quantizeBC6HEndpoint(value);
+                }
+            }
+        }
+
+        // least squares endpoints for the weights of the current indices
+        bool fitBC6HEndpoints(const float (&texels)[k_block_texels][3],
+                              const BC6HEncoding& encoding,
+                              float (&out_endpoints)[2][3])
+        {
+            float start_start = 0.0f, start_end = 0.0f, end_end = 0.0f;
+            float start_texel[3] {}, end_texel[3] {};
+            for (uint32_t texel = 0; texel < k_block_texels; ++texel)
+            {
+                const float end_weight   = k_bc6h_weights[encoding.indices[texel]] / 64.0f;
+                const float start_weight = 1.0f - end_weight;
+                start_start += start_weight * start_weight;
+                start_end += start_weight * end_weight;
+                end_end += end_weight * end_weight;
+                for (uint32_t channel = 0; channel < 3; ++channel)
+                {
+                    start_texel[channel] += start_weight * texels[texel][channel];
+                    end_texel[channel] += end_weight * texels[texel][channel];
+                }
+            }
+
+            const float determinant = start_start * end_end - start_end * start_end;
+            if (std::fabs(determinant) < 1e-6f)
+                return false;
+            for (uint32_t channel = 0; channel < 3; ++channel)
+            {
+                out_endpoints[0][channel] =
+                    (end_end * start_texel[channel] - start_end * end_texel[channel]) / determinant;
+                out_endpoints[1][channel] =
+                    (start_start * end_texel[channel] - start_end * start_texel[channel]) / determinant;
+            }
+            return true;
+        }
+
+        class BlockBitWriter
+        {
+        public:
+            explicit BlockBitWriter(uint8_t (&block)[16]) : m_block(block) { std::memset(m_block, 0, sizeof(m_block)); }
+
+            // least significant bit first
+            void write(uint32_t value, uint32_t bit_count)
+            {
+                for (uint32_t bit = 0; bit < bit_count; ++bit, ++m_position)
+                {
+                    m_block[m_position / 8] |= static_cast<uint8_t>(((value >> bit) & 1) << (m_position % 8));
+                }
+            }
+
+        private:
+            uint8_t (&m_block)[16];
+            uint32_t m_position {0};
+        };
+
+        // a level with half the size, every texel the average of the 2x2 texels it covers
+        template<typename Channel>
+        std::vector<Channel> downsample(const std::vector<Channel>& pixels, uint32_t width, uint32_t height)
+        {
+            const uint32_t       half_width  = std::max(width / 2, 1u);
+            const uint32_t       half_height = std::max(height / 2, 1u);
+            std::vector<Channel> result(size_t(half_width) * half_height * 4);
+            for (uint32_t y = 0; y < half_height; ++y)
+            {
+                const uint32_t rows[2] = {std::min(y * 2, height - 1), std::min(y * 2 + 1, height - 1)};
+                for (uint32_t x = 0; x < half_width; ++x)
+                {
+                    const uint32_t columns[2] = {std::min(x * 2, width - 1), std::min(x * 2 + 1, width - 1)};
+                    for (uint32_t channel = 0; channel < 4; ++channel)
+                    {
+                        float sum = 0.0f;
+                        for (uint32_t row : rows)
+                        {
+                            for (uint32_t column : columns)
+                            {
+                                sum += static_cast<float>(pixels[(size_t(row) * width + column) * 4 + channel]);
+                            }
+                        }
+
+                        Channel& texel = result[(size_t(y) * half_width + x) * 4 + channel];
+                        if constexpr (std::is_integral<Channel>::value)
+                        {
+                            texel = static_cast<Channel>(sum * 0.25f + 0.5f);
+                        }
+                        else
+                        {
+                            texel = sum * 0.25f;
+                        }
+                    }
+                }
+            }
+            return result;
+        }
+
+        // the rgba texels of a block, the blocks over the border repeat the last row and column
+        template<typename Channel>
+        void gatherBlock(const std::vector<Channel>& pixels,
+                         uint32_t                    width,
+                         uint32_t                    height,
+                         uint32_t                    block_x,
+                         uint32_t                    block_y,
+                         Channel (&out_texels)[k_block_texels * 4])
+        {
+            for (uint32_t y = 0; y < k_block_dimension; ++y)
+            {
+                const uint32_t row = std::min(block_y * k_block_dimension + y, height - 1);
+                for (uint32_t x = 0; x < k_block_dimension; ++x)
+                {
+                    const uint32_t column = std::min(block_x * k_block_dimension + x, width - 1);
+                    std::memcpy(&out_texels[(y * k_block_dimension + x) * 4],
+                                &pixels[(size_t(row) * width + column) * 4],
+                                sizeof(Channel) * 4);
+                }
+            }
+        }
+
+        // encodes every level of the chain with encode_block(texels, out_block), downsampling level by level
+        template<typename Channel, typename EncodeBlock>
+        std::shared_ptr<TextureData> compressMipChain(std::vector<Channel> pixels,
+                                                      uint32_t             width,
+                                                      uint32_t             height,
+                                                      RHIFormat            format,
+                                                      EncodeBlock          encode_block)
+        {
+            std::shared_ptr<TextureData> texture = std::make_shared<TextureData>();
+            texture->m_width                     = width;
+            texture->m_height                    = height;
+            texture->m_depth                     = 1;
+            texture->m_array_layers              = 1;
+            texture->m_mip_levels                = TextureCompressor::getMipLevelCount(width, height);
+            texture->m_format                    = format;
+            texture->m_type                      = PICCOLO_IMAGE_TYPE::PICCOLO_IMAGE_TYPE_2D;
+            texture->m_pixels =
+                malloc(TextureCompressor::getMipChainSize(format, width, height, texture->m_mip_levels));
+            if (!texture->m_pixels)
+                return nullptr;
+
+            const size_t block_size  = TextureCompressor::getLevelSize(format, 1, 1);
+            uint8_t*     destination = static_cast<uint8_t*>(texture->m_pixels);
+            for (uint32_t level = 0; level < texture->m_mip_levels; ++level)
+            {
+                Channel texels[k_block_texels * 4];
+                for (uint32_t block_y = 0; block_y < getBlockCount(height); ++block_y)
+                {
+                    for (uint32_t block_x = 0; block_x < getBlockCount(width); ++block_x)
+                    {
+                        gatherBlock(pixels, width, height, block_x, block_y, texels);
+                        encode_block(texels, destination);
+                        destination += block_size;
+                    }
+                }
+
+                if (level + 1 < texture->m_mip_levels)
+                {
+                    pixels = downsample(pixels, width, height);
+                    width  = std::max(width / 2, 1u);
+                    height = std::max(height / 2, 1u);
+                }
+            }
+            return texture;
+        }
+    } // namespace
+
+    bool TextureCompressor::isBlockCompressed(RHIFormat format)
+    {
+        return format >= RHIFormat::RHI_FORMAT_BC1_RGB_UNORM_BLOCK && format <= RHIFormat::RHI_FORMAT_BC7_SRGB_BLOCK;
+    }
+
+    RHIFormat TextureCompressor::getSrgbFormat(RHIFormat format)
+    {
+        switch (format)
+        {
+            case RHIFormat::RHI_FORMAT_R8G8B8_UNORM:
+                return RHIFormat::RHI_FORMAT_R8G8B8_SRGB;
+            case RHIFormat::RHI_FORMAT_R8G8B8A8_UNORM:
+                return RHIFormat::RHI_FORMAT_R8G8B8A8_SRGB;
+            case RHIFormat::RHI_FORMAT_BC1_RGB_UNORM_BLOCK:
+                return RHIFormat::RHI_FORMAT_BC1_RGB_SRGB_BLOCK;
+            case RHIFormat::RHI_FORMAT_BC3_UNORM_BLOCK:
+                return RHIFormat::RHI_FORMAT_BC3_SRGB_BLOCK;
+            default:
+                return format;
+        }
+    }
+
+    size_t TextureCompressor::getLevelSize(RHIFormat format, uint32_t width, uint32_t height)
+    {
+        const size_t texel_count = size_t(width) * height;
+        const size_t block_count = size_t(getBlockCount(width)) * getBlockCount(height);
+        switch (format)
+        {
+            case RHIFormat::RHI_FORMAT_R8G8B8_UNORM:
+            case RHIFormat::RHI_FORMAT_R8G8B8_SRGB:
+                return texel_count * 3;
+            case RHIFormat::RHI_FORMAT_R8G8B8A8_UNORM:
+            case RHIFormat::RHI_FORMAT_R8G8B8A8_SRGB:
+            case RHIFormat::RHI_FORMAT_R32_SFLOAT:
+                return texel_count * 4;
+            case RHIFormat::RHI_FORMAT_R32G32_SFLOAT:
+                return texel_count * 4 * 2;
+            case RHIFormat::RHI_FORMAT_R32G32B32_SFLOAT:
+                return texel_count * 4 * 3;
+            case RHIFormat::RHI_FORMAT_R32G32B32A32_SFLOAT:
+                return texel_count * 4 * 4;
+            case RHIFormat::RHI_FORMAT_BC1_RGB_UNORM_BLOCK:
+            case RHIFormat::RHI_FORMAT_BC1_RGB_SRGB_BLOCK:
+                return block_count * 8;
+            case RHIFormat::RHI_FORMAT_BC3_UNORM_BLOCK:
+            case RHIFormat::RHI_FORMAT_BC3_SRGB_BLOCK:
+            case RHIFormat::RHI_FORMAT_BC6H_UFLOAT_BLOCK:
+                return block_count * 16;
+            default:
+                return 0;
+        }
+    }
+
+    size_t TextureCompressor::getMipChainSize(RHIFormat format, uint32_t width, uint32_t height, uint32_t mip_levels)
+    {
+        size_t chain_size = 0;
+        for (uint32_t level = 0; level < mip_levels; ++level)
+        {
+            chain_size += getLevelSize(format, std::max(width >> level, 1u), std::max(height >> level, 1u));
+        }
+        return chain_size;
+    }
+
+    uint32_t TextureCompressor::getMipLevelCount(uint32_t width, uint32_t height)
+    {
+        uint32_t mip_levels = 1;
+        for (uint32_t size = std::max(width, height); size > 1; size >>= 1)
+        {
+            ++mip_levels;
+        }
+        return mip_levels;
+    }
+
+    std::shared_ptr<TextureData>
+    TextureCompressor::compressLDR(const uint8_t* rgba_pixels, uint32_t width, uint32_t height)
+    {
+        if (!rgba_pixels || width == 0 || height == 0)
+            return nullptr;
+
+        std::vector<uint8_t> pixels(rgba_pixels, rgba_pixels + size_t(width) * height * 4);
+        bool                 is_opaque = true;
+        for (size_t texel = 3; texel < pixels.size() && is_opaque; texel += 4)
+        {
+            is_opaque = pixels[texel] == 255;
+        }
+
+        const int alpha = is_opaque ? 0 : 1;
+        return compressMipChain(std::move(pixels),
+                                width,
+                                height,
+                                is_opaque ? RHIFormat::RHI_FORMAT_BC1_RGB_UNORM_BLOCK :
+                                            RHIFormat::RHI_FORMAT_BC3_UNORM_BLOCK,
+                                [alpha](const uint8_t(&texels)[k_block_texels * 4], uint8_t* out_block) {
+                                    stb_compress_dxt_block(out_block, texels, alpha, STB_DXT_HIGHQUAL);
+                                });
+    }
+
+    std::shared_ptr<TextureData>
+    TextureCompressor::compressHDR(const float* rgba_pixels, uint32_t width, uint32_t height)
+    {
+        if (!rgba_pixels || width == 0 || height == 0)
+            return nullptr;
+
+        std::vector<float> pixels(rgba_pixels, rgba_pixels + size_t(width) * height * 4);
+        return compressMipChain(std::move(pixels),
+                                width,
+                                height,
+                                RHIFormat::RHI_FORMAT_BC6H_UFLOAT_BLOCK,
+                                [](const float(&texels)[k_block_texels * 4], uint8_t* out_block) {
+                                    float rgb_pixels[k_block_texels][3];
+                                    for (uint32_t texel = 0; texel < k_block_texels; ++texel)
+                                    {
+                                        std::memcpy(rgb_pixels[texel], &texels[texel * 4], sizeof(rgb_pixels[texel]));
+                                    }
+                                    encodeBC6HBlock(rgb_pixels, *reinterpret_cast<uint8_t(*)[16]>(out_block));
+                                });
+    }
+
+    void TextureCompressor::encodeBC6HBlock(const float (&rgb_pixels)[16][3], uint8_t (&out_block)[16])
+    {
+        // the texels as the integer bits of their halves, the space the block is interpolated in
+        float texels[k_block_texels][3];
+        float mean[3] {};
+        for (uint32_t texel = 0; texel < k_block_texels; ++texel)
+        {
+            for (uint32_t channel = 0; channel < 3; ++channel)
+            {
+                texels[texel][channel] = static_cast<float>(floatToHalf(rgb_pixels[texel][channel]));
+                mean[channel] += texels[texel][channel] / k_block_texels;
+            }
+        }
+
+        // principal axis of the texels by power iteration on their covariance
+        float covariance[3][3] {};
+        for (uint32_t texel = 0; texel < k_block_texels; ++texel)
+        {
+            for (uint32_t row = 0; row < 3; ++row)
+            {
+                for (uint32_t column = 0; column < 3; ++column)
+                {
+                    covariance[row][column] +=
+                        (texels[texel][row] - mean[row]) * (texels[texel][column] - mean[column]);
+                }
+            }
+        }
+        float axis[3] = {1.0f, 1.0f, 1.0f};
+        for (uint32_t iteration = 0; iteration < 8; ++iteration)
+        {
+            float next_axis[3] {};
+            for (uint32_t row = 0; row < 3; ++row)
+            {
+                next_axis[row] =
+                    covariance[row][0] * axis[0] + covariance[row][1] * axis[1] + covariance[row][2] * axis[2];
+            }
+            const float length =
+                std::sqrt(next_axis[0] * next_axis[0] + next_axis[1] * next_axis[1] + next_axis[2] * next_axis[2]);
+            if (length < 1e-6f)
+                break;
+            for (uint32_t channel = 0; channel < 3; ++channel)
+            {
+                axis[channel] = next_axis[channel] / length;
+            }
+        }
+
+        // the endpoints at the extreme projections on the axis
+        float min_projection = 0.0f, max_projection = 0.0f;
+        for (uint32_t texel = 0; texel < k_block_texels; ++texel)
+        {
+            float projection = 0.0f;
+            for (uint32_t channel = 0; channel < 3; ++channel)
+            {
+                projection += (texels[texel][channel] - mean[channel]) * axis[channel];
+            }
+            min_projection = std::min(min_projection, projection);
+            max_projection = std::max(max_projection, projection);
+        }
+        float endpoints[2][3];
+        for (uint32_t channel = 0; channel < 3; ++channel)
+        {
+            endpoints[0][channel] = mean[channel] + axis[channel] * min_projection;
+            endpoints[1][channel] = mean[channel] + axis[channel] * max_projection;
+        }
+
+        BC6HEncoding encoding;
+        quantizeBC6HEndpoints(endpoints, encoding);
+        selectBC6HIndices(texels, encoding);
+
+        // refit the endpoints to the selected indices while it helps
+        for (uint32_t iteration = 0; iteration < 2; ++iteration)
+        {
+            BC6HEncoding refined;
+            if (!fitBC6HEndpoints(texels, encoding, endpoints))
+                break;
+            quantizeBC6HEndpoints(endpoints, refined);
+            selectBC6HIndices(texels, refined);
+            if (refined.error >= encoding.error)
+                break;
+            encoding = refined;
+        }
+
+        // the first index is stored without its high bit, swapping the endpoints clears it
+        if (encoding.indices[0] >= 8)
+        {
+            std::swap(encoding.endpoints[0], encoding.endpoints[1]);
+            for (uint32_t& index : encoding.indices)
+            {
+                index = 15 - index;
+            }
+        }
+
+        BlockBitWriter writer(out_block);
+        writer.write(k_bc6h_mode_11, 5);
+        for (uint32_t endpoint = 0; endpoint < 2; ++endpoint)
+        {
+            for (uint32_t channel = 0; channel < 3; ++channel)
+            {
+                writer.write(encoding.endpoints[endpoint][channel], k_bc6h_endpoint_bits);
+            }
+        }
+        writer.write(encoding.indices[0], 3);
+        for (uint32_t texel = 1; texel < k_block_texels; ++texel)
+        {
+            writer.write(encoding.indices[texel], 4);
+        }
+    }
+} // namespace Piccolo
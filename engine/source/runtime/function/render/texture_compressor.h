@@ -0,0 +1,35 @@
+#pragma once
+
+#include "runtime/function/render/render_type.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace Piccolo
+{
+    /// Builds the mip chain of a texture on the cpu and encodes it in a block compressed format, for the texture
+    /// cooker. Nothing here needs a gpu. The levels of a chain are stored one after the other, the largest first,
+    /// each down to 1x1 as the chain the gpu generates.
+    class TextureCompressor
+    {
+    public:
+        static bool isBlockCompressed(RHIFormat format);
+        // the srgb variant of a color format, the format itself when it has none
+        static RHIFormat getSrgbFormat(RHIFormat format);
+
+        // bytes of a width x height level, the compressed levels are padded to whole 4x4 blocks.
+        // 0 for the formats the textures are not loaded in
+        static size_t   getLevelSize(RHIFormat format, uint32_t width, uint32_t height);
+        static size_t   getMipChainSize(RHIFormat format, uint32_t width, uint32_t height, uint32_t mip_levels);
+        static uint32_t getMipLevelCount(uint32_t width, uint32_t height);
+
+        // rgba8 pixels to a BC1 chain, or BC3 when a pixel is not opaque. the formats are the unorm ones
+        static std::shared_ptr<TextureData> compressLDR(const uint8_t* rgba_pixels, uint32_t width, uint32_t height);
+        // rgba32f pixels to a BC6H chain, the alpha is dropped and the negative values are clamped to 0
+        static std::shared_ptr<TextureData> compressHDR(const float* rgba_pixels, uint32_t width, uint32_t height);
+
+        // one 4x4 block of rgb pixels in rows, in the single region mode with 10 bit endpoints
+        static void encodeBC6HBlock(const float (&rgb_pixels)[16][3], uint8_t (&out_block)[16]);
+    };
+} // namespace Piccolo
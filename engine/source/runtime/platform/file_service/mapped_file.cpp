@@ -0,0 +1,95 @@
+#include "runtime/platform/file_service/mapped_file.h"
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Piccolo
+{
+#if defined(_WIN32)
+    std::shared_ptr<MappedFile> MappedFile::open(const std::filesystem::path& file_path)
+    {
+        HANDLE file_handle = CreateFileW(file_path.c_str(),
+                                         GENERIC_READ,
+                                         FILE_SHARE_READ,
+                                         nullptr,
+                                         OPEN_EXISTING,
+                                         FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+                                         nullptr);
+        if (file_handle == INVALID_HANDLE_VALUE)
+            return nullptr;
+
+        LARGE_INTEGER file_size;
+        if (!GetFileSizeEx(file_handle, &file_size) || file_size.QuadPart == 0)
+        {
+            CloseHandle(file_handle);
+            return nullptr;
+        }
+
+        HANDLE mapping_handle = CreateFileMappingW(file_handle, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+        void*  data           = mapping_handle ? MapViewOfFile(mapping_handle, FILE_MAP_COPY, 0, 0, 0) : nullptr;
+        if (data == nullptr)
+        {
+            if (mapping_handle)
+            {
+                CloseHandle(mapping_handle);
+            }
+            CloseHandle(file_handle);
+            return nullptr;
+        }
+
+        std::shared_ptr<MappedFile> mapped_file(new MappedFile());
+        mapped_file->m_data           = static_cast<uint8_t*>(data);
+        mapped_file->m_size           = static_cast<size_t>(file_size.QuadPart);
+        mapped_file->m_file_handle    = file_handle;
+        mapped_file->m_mapping_handle = mapping_handle;
+        return mapped_file;
+    }
+
+    MappedFile::~MappedFile()
+    {
+        UnmapViewOfFile(m_data);
+        CloseHandle(m_mapping_handle);
+        CloseHandle(m_file_handle);
+    }
+#else
+    std::shared_ptr<MappedFile> MappedFile::open(const std::filesystem::path& file_path)
+    {
+        const int file_descriptor = ::open(file_path.c_str(), O_RDONLY);
+        if (file_descriptor < 0)
+            return nullptr;
+
+        struct stat file_stat;
+        if (fstat(file_descriptor, &file_stat) != 0 || file_stat.st_size == 0)
+        {
+            close(file_descriptor);
+            return nullptr;
+        }
+
+        const size_t size = static_cast<size_t>(file_stat.st_size);
+        void*        data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, file_descriptor, 0);
+        // the mapping keeps its own reference to the file
+        close(file_descriptor);
+        if (data == MAP_FAILED)
+            return nullptr;
+
+        std::shared_ptr<MappedFile> mapped_file(new MappedFile());
+        mapped_file->m_data = static_cast<uint8_t*>(data);
+        mapped_file->m_size = size;
+        return mapped_file;
+    }
+
+    MappedFile::~MappedFile() { munmap(m_data, m_size); }
+#endif
+} // namespace Piccolo
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+
+namespace Piccolo
+{
+    /// Read-only file mapped in memory. The pages are copy on write, a view handed to code that writes to its
+    /// buffer changes the memory of this process but never the file.
+    class MappedFile
+    {
+    public:
+        // nullptr when the file cannot be opened or is empty
+        static std::shared_ptr<MappedFile> open(const std::filesystem::path& file_path);
+
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        uint8_t* data() const { return m_data; }
+        size_t   size() const { return m_size; }
+
+    private:
+        MappedFile() = default;
+
+        uint8_t* m_data {nullptr};
+        size_t   m_size {0};
+#if defined(_WIN32)
+        void* m_file_handle {nullptr};
+        void* m_mapping_handle {nullptr};
+#endif
+    };
+} // namespace Piccolo
@@ -0,0 +1,160 @@
+#include "runtime/resource/asset_manager/asset_cache.h"
+
+#include <algorithm>
+
+namespace Piccolo
+{
+    AssetUrlId AssetCache::internUrl(const std::string& url)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return internUrlLocked(url);
+    }
+
+    AssetUrlId AssetCache::internUrlLocked(const std::string& url)
+    {
+        auto iter = m_url_ids.find(url);
+        if (iter != m_url_ids.end())
+            return iter->second;
+
+        const AssetUrlId url_id = static_cast<AssetUrlId>(m_url_ids.size());
+        m_url_ids.emplace(url, url_id);
+        return url_id;
+    }
+
+    std::shared_ptr<void>
+    AssetCache::getOrCreate(const std::string& url, std::type_index type, const CreateFunction& create)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+
+        const Key key {internUrlLocked(url), type};
+        auto      iter = m_entries.find(key);
+        if (iter != m_entries.end())
+        {
+            ++m_stats.hit_count;
+            iter->second.last_use = ++m_use_counter;
+
+            std::shared_ptr<Slot> slot = iter->second.slot;
+            m_created_condition.wait(lock, [&slot] { return slot->is_created; });
+            return slot->asset;
+        }
+
+        ++m_stats.miss_count;
+        std::shared_ptr<Slot> slot = std::make_shared<Slot>();
+        m_entries.emplace(key, Entry {slot, 0, ++m_use_counter});
+
+        // the asset is created without the lock, the other assets can be requested meanwhile
+        lock.unlock();
+        size_t                memory_size = 0;
+        std::shared_ptr<void> asset;
+        try
+        {
+            asset = create(memory_size);
+        }
+        catch (...)
+        {
+            // handled as a failure, so the waiting requests wake up, then the caller gets the exception
+            lock.lock();
+            finishCreationLocked(key, slot, nullptr, 0);
+            throw;
+        }
+        lock.lock();
+
+        finishCreationLocked(key, slot, asset, memory_size);
+        return asset;
+    }
+
+    void AssetCache::setMemoryBudget(size_t memory_budget)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stats.memory_budget = memory_budget;
+        evictLocked(memory_budget);
+    }
+
+    void AssetCache::releaseUnused()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        evictLocked(0);
+    }
+
+    void AssetCache::clear()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        // the assets being created keep their slot, they are just not cached anymore
+        for (auto iter = m_entries.begin(); iter != m_entries.end();)
+        {
+            if (iter->second.slot->is_created)
+            {
+                m_stats.memory_size -= iter->second.memory_size;
+                iter = m_entries.erase(iter);
+            }
+            else
+            {
+                ++iter;
+            }
+        }
+        m_stats.entry_count = m_entries.size();
+    }
+
+    AssetCacheStats AssetCache::getStats() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_stats;
+    }
+
+    void AssetCache::finishCreationLocked(const Key&                   key,
+                                          const std::shared_ptr<Slot>& slot,
+                                          std::shared_ptr<void>        asset,
+                                          size_t                       memory_size)
+    {
+        slot->asset      = asset;
+        slot->is_created = true;
+
+        auto iter = m_entries.find(key);
+        if (asset == nullptr)
+        {
+            // failures are not cached, the next request tries again
+            m_entries.erase(iter);
+        }
+        else
+        {
+            iter->second.memory_size = memory_size;
+            m_stats.memory_size += memory_size;
+            evictLocked(m_stats.memory_budget);
+        }
+        m_stats.entry_count = m_entries.size();
+
+        m_created_condition.notify_all();
+    }
+
+    void AssetCache::evictLocked(size_t memory_budget)
+    {
+        if (m_stats.memory_size <= memory_budget)
+            return;
+
+        // only the cache holds the candidates, the least recently requested go first
+        std::vector<std::pair<uint64_t, Key>> candidates;
+        for (const auto& key_entry_pair : m_entries)
+        {
+            const Entry& entry = key_entry_pair.second;
+            if (entry.slot->is_created && entry.slot->asset.use_count() == 1)
+            {
+                candidates.emplace_back(entry.last_use, key_entry_pair.first);
+            }
+        }
+        std::sort(candidates.begin(), candidates.end(), [](const auto& lhs, const auto& rhs) {
+            return lhs.first < rhs.first;
+        });
+
+        for (const auto& candidate : candidates)
+        {
+            if (m_stats.memory_size <= memory_budget)
+                break;
+
+            auto iter = m_entries.find(candidate.second);
+            m_stats.memory_size -= iter->second.memory_size;
+            ++m_stats.eviction_count;
+            m_entries.erase(iter);
+        }
+        m_stats.entry_count = m_entries.size();
+    }
+} // namespace Piccolo
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
+
+namespace Piccolo
+{
+    using AssetUrlId = uint32_t;
+
+    struct AssetCacheStats
+    {
+        size_t hit_count {0};
+        size_t miss_count {0};
+        size_t eviction_count {0};
+        size_t entry_count {0};
+        // estimated from the size of the files the assets were read from
+        size_t memory_size {0};
+        size_t memory_budget {0};
+    };
+
+    /// Assets shared by url and type, one url can be cached as several types (a clip and its compressed form).
+    /// The cache holds a reference to every asset it created, an asset is only evicted once nobody else holds it,
+    /// the least recently requested first, when the estimated memory goes over the budget.
+    /// Thread safe, a request for an asset another thread is creating waits for it instead of creating it twice.
+    class AssetCache
+    {
+    public:
+        // returns nullptr when the asset cannot be created, out_memory_size is its estimated size. An exception
+        // thrown by the function reaches the request that called it, the waiting ones get nullptr
+        using CreateFunction = std::function<std::shared_ptr<void>(size_t& out_memory_size)>;
+
+        static constexpr size_t k_default_memory_budget = 256u * 1024u * 1024u;
+
+        // the url is expected to be normalized by the caller, equal urls get equal ids
+        AssetUrlId internUrl(const std::string& url);
+
+        std::shared_ptr<void> getOrCreate(const std::string& url, std::type_index type, const CreateFunction& create);
+
+        void setMemoryBudget(size_t memory_budget);
+        // evict every asset nobody holds anymore, whatever the budget
+        void releaseUnused();
+        void clear();
+
+        AssetCacheStats getStats() const;
+
+    private:
+        struct Key
+        {
+            AssetUrlId      url_id;
+            std::type_index type;
+
+            bool operator==(const Key& other) const { return url_id == other.url_id && type == other.type; }
+        };
+        struct KeyHash
+        {
+            size_t operator()(const Key& key) const
+            {
+                return std::hash<AssetUrlId> {}(key.url_id) ^ (key.type.hash_code() << 1);
+            }
+        };
+        // shared with the requests waiting for the creation, which may outlive the entry
+        struct Slot
+        {
+            std::shared_ptr<void> asset;
+            bool                  is_created {false};
+        };
+        struct Entry
+        {
+            std::shared_ptr<Slot> slot;
+            size_t                memory_size {0};
+            uint64_t              last_use {0};
+        };
+
+        AssetUrlId internUrlLocked(const std::string& url);
+        // publishes the created asset to the waiting requests, a nullptr asset is removed from the cache
+        void finishCreationLocked(const Key&                   key,
+                                  const std::shared_ptr<Slot>& slot,
+                                  std::shared_ptr<void>        asset,
+                                  size_t                       memory_size);
+        // evicts down to memory_budget, called with the lock held
+        void evictLocked(size_t memory_budget);
+
+        mutable std::mutex      m_mutex;
+        std::condition_variable m_created_condition;
+
+        std::unordered_map<std::string, AssetUrlId> m_url_ids;
+        std::unordered_map<Key, Entry, KeyHash>     m_entries;
+
+        uint64_t        m_use_counter {0};
+        AssetCacheStats m_stats {0, 0, 0, 0, 0, k_default_memory_budget};
+    };
+} // namespace Piccolo
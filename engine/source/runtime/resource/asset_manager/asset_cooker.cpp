@@ -0,0 +1,281 @@
+#include "runtime/resource/asset_manager/asset_cooker.h"
+
+#include "runtime/core/base/macro.h"
+
+#include "runtime/resource/asset_manager/asset_manager.h"
+#include "runtime/resource/res_type/common/level.h"
+#include "runtime/resource/res_type/common/object.h"
+#include "runtime/resource/res_type/common/world.h"
+#include "runtime/resource/res_type/data/animation_clip.h"
+#include "runtime/resource/res_type/data/animation_skeleton_node_map.h"
+#include "runtime/resource/res_type/data/material.h"
+#include "runtime/resource/res_type/data/mesh_data.h"
+#include "runtime/resource/res_type/data/skeleton_data.h"
+#include "runtime/resource/res_type/data/skeleton_mask.h"
+#include "runtime/resource/res_type/global/global_particle.h"
+#include "runtime/resource/res_type/global/global_rendering.h"
+
+#include <chrono>
+#include <fstream>
+#include <string>
+#include <system_error>
+
+namespace Piccolo
+{
+    namespace
+    {
+        using CookFunction = bool (*)(const AssetManager&, const std::filesystem::path&, const std::filesystem::path&);
+        using BenchmarkFunction = bool (*)(const std::string&, uint32_t, SerializerBenchmarkResult&);
+        using LoadFunction      = std::shared_ptr<void> (*)(const AssetManager&, const std::filesystem::path&, bool);
+
+        template<typename AssetType>
+        bool cookAssetOfType(const AssetManager&          asset_manager,
+                             const std::filesystem::path& asset_path,
+                             const std::filesystem::path& cooked_asset_path)
+        {
+            AssetType asset;
+            return asset_manager.loadJsonAsset(asset_path, asset) &&
+                   asset_manager.saveBinaryAsset(asset, cooked_asset_path);
+        }
+
+        template<typename AssetType>
+        std::shared_ptr<void>
+        loadAssetOfType(const AssetManager& asset_manager, const std::filesystem::path& asset_path, bool is_cooked)
+        {
+            std::shared_ptr<AssetType> asset = std::make_shared<AssetType>();
+            const bool                 is_loaded =
+                is_cooked ? asset_manager.loadBinaryAsset(AssetManager::getCookedAssetPath(asset_path), *asset) :
+                                            asset_manager.loadJsonAsset(asset_path, *asset);
+            return is_loaded ? asset : nullptr;
+        }
+
+        double getSecondsSince(std::chrono::steady_clock::time_point start_time)
+        {
+            return std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+        }
+
+        template<typename AssetType>
+        bool benchmarkAssetOfType(const std::string&         asset_json_text,
+                                  uint32_t                   pass_count,
+                                  SerializerBenchmarkResult& result)
+        {
+            for (uint32_t pass_index = 0; pass_index < pass_count; ++pass_index)
+            {
+                auto        start_time = std::chrono::steady_clock::now();
+                std::string error;
+                AssetType   document_asset;
+                Serializer::read(Json::parse(asset_json_text, error), document_asset);
+                result.document_read_seconds += getSecondsSince(start_time);
+                if (!error.empty())
+                    return false;
+
+                start_time                           = std::chrono::steady_clock::now();
+                const std::string document_json_text = Serializer::write(document_asset).dump();
+                result.document_write_seconds += getSecondsSince(start_time);
+
+                start_time = std::chrono::steady_clock::now();
+                AssetType  stream_asset;
+                JsonReader reader(asset_json_text);
+                JsonStreamSerializer::read(reader, stream_asset);
+                result.stream_read_seconds += getSecondsSince(start_time);
+                if (!reader.isValid())
+                    return false;
+
+                start_time = std::chrono::steady_clock::now();
+                JsonWriter writer(asset_json_text.size());
+                JsonStreamSerializer::write(writer, stream_asset);
+                result.stream_write_seconds += getSecondsSince(start_time);
+            }
+            return true;
+        }
+
+        struct CookableAssetType
+        {
+            const char*       file_name_suffix;
+            // nullptr for the meshes, they are cooked to mesh blobs by the render resources
+            CookFunction      cook_function;
+            BenchmarkFunction benchmark_function;
+            LoadFunction      load_function;
+        };
+
+        // the resource type of an asset is only known from its file name
+        const CookableAssetType k_cookable_asset_types[] = {
+            {".level.json", cookAssetOfType<LevelRes>, benchmarkAssetOfType<LevelRes>, loadAssetOfType<LevelRes>},
+            {".world.json", cookAssetOfType<WorldRes>, benchmarkAssetOfType<WorldRes>, loadAssetOfType<WorldRes>},
+            {".object.json",
+             cookAssetOfType<ObjectDefinitionRes>,
+             benchmarkAssetOfType<ObjectDefinitionRes>,
+             loadAssetOfType<ObjectDefinitionRes>},
+            {".material.json",
+             cookAssetOfType<MaterialRes>,
+             benchmarkAssetOfType<MaterialRes>,
+             loadAssetOfType<MaterialRes>},
+            {".animation_clip.json",
+             cookAssetOfType<AnimationAsset>,
+             benchmarkAssetOfType<AnimationAsset>,
+             loadAssetOfType<AnimationAsset>},
+            {".skeleton.json",
+             cookAssetOfType<SkeletonData>,
+             benchmarkAssetOfType<SkeletonData>,
+             loadAssetOfType<SkeletonData>},
+            {".skeleton_map.json",
+             cookAssetOfType<AnimSkelMap>,
+             benchmarkAssetOfType<AnimSkelMap>,
+             loadAssetOfType<AnimSkelMap>},
+            {".skeleton_mask.json",
+             cookAssetOfType<BoneBlendMask>,
+             benchmarkAssetOfType<BoneBlendMask>,
+             loadAssetOfType<BoneBlendMask>},
+            {"rendering.global.json",
+             cookAssetOfType<GlobalRenderingRes>,
+             benchmarkAssetOfType<GlobalRenderingRes>,
+             loadAssetOfType<GlobalRenderingRes>},
+            {"particle.global.json",
+             cookAssetOfType<GlobalParticleRes>,
+             benchmarkAssetOfType<GlobalParticleRes>,
+             loadAssetOfType<GlobalParticleRes>},
+            {".mesh_bind.json", nullptr, benchmarkAssetOfType<MeshData>, loadAssetOfType<MeshData>},
+        };
+
+        const CookableAssetType* findCookableAssetType(const std::filesystem::path& asset_path)
+        {
+            const std::string file_name = asset_path.filename().generic_string();
+            for (const CookableAssetType& asset_type : k_cookable_asset_types)
+            {
+                const std::string suffix = asset_type.file_name_suffix;
+                if (file_name.size() >= suffix.size() &&
+                    file_name.compare(file_name.size() - suffix.size(), suffix.size(), suffix) == 0)
+                {
+                    return &asset_type;
+                }
+            }
+            return nullptr;
+        }
+    } // namespace
+
+    AssetCookResult AssetCooker::cookFolder(const std::filesystem::path& asset_folder, bool force) const
+    {
+        AssetCookResult result;
+        for (const auto& directory_entry : std::filesystem::recursive_directory_iterator {asset_folder})
+        {
+            const std::filesystem::path& asset_path = directory_entry.path();
+            if (!directory_entry.is_regular_file() || !isCookable(asset_path))
+                continue;
+
+            const std::filesystem::path cooked_asset_path = AssetManager::getCookedAssetPath(asset_path);
+            if (!force && m_asset_manager.isCookedAssetUpToDate(asset_path, cooked_asset_path))
+            {
+                result.skipped_count++;
+                continue;
+            }
+
+            if (cookAsset(asset_path))
+            {
+                result.cooked_count++;
+            }
+            else
+            {
+                result.failed_count++;
+            }
+        }
+        return result;
+    }
+
+    bool AssetCooker::cookAsset(const std::filesystem::path& asset_path) const
+    {
+        const CookableAssetType* asset_type = findCookableAssetType(asset_path);
+        if (asset_type == nullptr || asset_type->cook_function == nullptr)
+        {
+            LOG_ERROR("{} is not a cookable asset!", asset_path.generic_string());
+            return false;
+        }
+        return asset_type->cook_function(m_asset_manager, asset_path, AssetManager::getCookedAssetPath(asset_path));
+    }
+
+    bool AssetCooker::isCookable(const std::filesystem::path& asset_path)
+    {
+        const CookableAssetType* asset_type = findCookableAssetType(asset_path);
+        return asset_type != nullptr && asset_type->cook_function != nullptr;
+    }
+
+    SerializerBenchmarkResult AssetCooker::benchmarkSerializers(const std::filesystem::path& asset_folder,
+                                                                uint32_t                     pass_count) const
+    {
+        SerializerBenchmarkResult result;
+        for (const auto& directory_entry : std::filesystem::recursive_directory_iterator {asset_folder})
+        {
+            const std::filesystem::path& asset_path = directory_entry.path();
+            const CookableAssetType*     asset_type = findCookableAssetType(asset_path);
+            if (!directory_entry.is_regular_file() || asset_type == nullptr)
+                continue;
+
+            std::ifstream asset_file(asset_path, std::ios::binary | std::ios::ate);
+            std::string   asset_json_text;
+            if (asset_file)
+            {
+                asset_json_text.resize(static_cast<size_t>(asset_file.tellg()));
+                asset_file.seekg(0);
+                asset_file.read(asset_json_text.data(), asset_json_text.size());
+            }
+
+            if (!asset_file || !asset_type->benchmark_function(asset_json_text, pass_count, result))
+            {
+                LOG_ERROR("benchmark of {} failed!", asset_path.generic_string());
+                result.failed_count++;
+                continue;
+            }
+            result.asset_count++;
+            result.json_size += asset_json_text.size();
+        }
+
+        // the time of one pass
+        if (pass_count > 0)
+        {
+            result.document_read_seconds /= pass_count;
+            result.document_write_seconds /= pass_count;
+            result.stream_read_seconds /= pass_count;
+            result.stream_write_seconds /= pass_count;
+        }
+        return result;
+    }
+
+    AssetLoadBenchmarkResult AssetCooker::benchmarkLoads(const std::vector<std::filesystem::path>& asset_paths,
+                                                         bool                                      is_cooked,
+                                                         std::vector<std::shared_ptr<void>>&       out_assets) const
+    {
+        AssetLoadBenchmarkResult result;
+        for (const std::filesystem::path& asset_path : asset_paths)
+        {
+            const std::filesystem::path read_path =
+                is_cooked ? AssetManager::getCookedAssetPath(asset_path) : asset_path;
+            if (!isCookable(asset_path) || (is_cooked && !m_asset_manager.isCookedAssetUpToDate(asset_path, read_path)))
+            {
+                LOG_ERROR("{} is not cooked!", asset_path.generic_string());
+                result.failed_count++;
+                continue;
+            }
+
+            std::error_code error;
+            const uintmax_t file_size = std::filesystem::file_size(read_path, error);
+            result.file_size += error ? 0 : static_cast<size_t>(file_size);
+        }
+        if (result.failed_count > 0)
+            return result;
+
+        const auto start_time = std::chrono::steady_clock::now();
+        for (const std::filesystem::path& asset_path : asset_paths)
+        {
+            std::shared_ptr<void> asset =
+                findCookableAssetType(asset_path)->load_function(m_asset_manager, asset_path, is_cooked);
+            if (!asset)
+            {
+                result.failed_count++;
+                continue;
+            }
+            out_assets.push_back(std::move(asset));
+            result.asset_count++;
+        }
+        result.seconds = getSecondsSince(start_time);
+        return result;
+    }
+} // namespace Piccolo
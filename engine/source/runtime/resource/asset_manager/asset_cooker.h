@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <vector>
+
+namespace Piccolo
+{
+    class AssetManager;
+
+    struct AssetCookResult
+    {
+        uint32_t cooked_count {0};
+        // the cooked asset is already up to date
+        uint32_t skipped_count {0};
+        uint32_t failed_count {0};
+    };
+
+    /// Time spent reading and writing json assets through the Json document of Serializer and streamed by
+    /// JsonStreamSerializer, the throughput is json_size over the time of one pass.
+    struct SerializerBenchmarkResult
+    {
+        uint32_t asset_count {0};
+        uint32_t failed_count {0};
+        // of one pass over the assets
+        size_t json_size {0};
+        double document_read_seconds {0.0};
+        double document_write_seconds {0.0};
+        double stream_read_seconds {0.0};
+        double stream_write_seconds {0.0};
+    };
+
+    /// Time spent loading a set of assets the way a level does, every asset is kept until all of them are read.
+    struct AssetLoadBenchmarkResult
+    {
+        uint32_t asset_count {0};
+        uint32_t failed_count {0};
+        // of the files read, json or cooked
+        size_t file_size {0};
+        double seconds {0.0};
+    };
+
+    /// Converts the json assets of the known resource types to the binary format of AssetManager, next to the
+    /// json, the cooked sibling is then loaded instead of the json.
+    class AssetCooker
+    {
+    public:
+        explicit AssetCooker(const AssetManager& asset_manager) : m_asset_manager(asset_manager) {}
+
+        // every json asset under asset_folder, recursively
+        AssetCookResult cookFolder(const std::filesystem::path& asset_folder, bool force) const;
+        // false for a json that is not a known resource type too
+        bool cookAsset(const std::filesystem::path& asset_path) const;
+
+        static bool isCookable(const std::filesystem::path& asset_path);
+
+        // reads and writes every json asset under asset_folder of a known resource type, meshes included,
+        // pass_count times with both serializers
+        SerializerBenchmarkResult benchmarkSerializers(const std::filesystem::path& asset_folder,
+                                                       uint32_t                     pass_count) const;
+
+        // reads the cookable json assets with loadJsonAsset, or from their up to date cooked sibling with
+        // loadBinaryAsset when is_cooked, into out_assets
+        AssetLoadBenchmarkResult benchmarkLoads(const std::vector<std::filesystem::path>& asset_paths,
+                                                bool                                      is_cooked,
+                                                std::vector<std::shared_ptr<void>>&       out_assets) const;
+
+    private:
+        const AssetManager& m_asset_manager;
+    };
+} // namespace Piccolo
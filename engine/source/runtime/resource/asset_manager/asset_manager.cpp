@@ -4,12 +4,131 @@
 
 #include "runtime/function/global/global_context.h"
 
+#include <algorithm>
+#include <cstring>
 #include <filesystem>
+#include <system_error>
 
 namespace Piccolo
 {
+    namespace
+    {
+        bool isBinaryAssetHeaderCurrent(const BinaryAssetHeader& header)
+        {
+            return header.magic == AssetManager::k_binary_asset_magic &&
+                   header.version == AssetManager::k_binary_asset_version &&
+                   header.schema_hash == k_binary_schema_hash;
+        }
+    } // namespace
+
     std::filesystem::path AssetManager::getFullPath(const std::string& relative_path) const
     {
         return std::filesystem::absolute(g_runtime_global_context.m_config_manager->getRootFolder() / relative_path);
     }
-} // namespace Piccolo
\ No newline at end of file
+
+    JobSystem& AssetManager::getJobSystem() const
+    {
+        ASSERT(g_runtime_global_context.m_job_system);
+        return *g_runtime_global_context.m_job_system;
+    }
+
+    bool AssetManager::isBinaryAssetPath(const std::filesystem::path& asset_path)
+    {
+        return asset_path.extension() == k_binary_asset_extension;
+    }
+
+    std::filesystem::path AssetManager::getCookedAssetPath(const std::filesystem::path& asset_path)
+    {
+        // appended to the whole file name, assets differing only by their extension get their own cooked file
+        std::filesystem::path cooked_asset_path = asset_path;
+        cooked_asset_path += k_binary_asset_extension;
+        return cooked_asset_path;
+    }
+
+    size_t AssetManager::estimateAssetMemorySize(const std::filesystem::path& asset_path, size_t default_size)
+    {
+        std::error_code error;
+        uintmax_t       file_size = std::filesystem::file_size(getCookedAssetPath(asset_path), error);
+        if (error)
+        {
+            file_size = std::filesystem::file_size(asset_path, error);
+        }
+        return error ? default_size : std::max(static_cast<size_t>(file_size), default_size);
+    }
+
+    bool AssetManager::readTextFile(const std::filesystem::path& asset_path, std::string& out_text) const
+    {
+        std::ifstream asset_file(asset_path, std::ios::binary | std::ios::ate);
+        if (!asset_file)
+        {
+            LOG_ERROR("open file: {} failed!", asset_path.generic_string());
+            return false;
+        }
+
+        out_text.resize(static_cast<size_t>(asset_file.tellg()));
+        asset_file.seekg(0);
+        asset_file.read(out_text.data(), out_text.size());
+        return static_cast<bool>(asset_file);
+    }
+
+    bool AssetManager::readBinaryFile(const std::filesystem::path& asset_path, std::vector<uint8_t>& out_data) const
+    {
+        std::ifstream asset_file(asset_path, std::ios::binary | std::ios::ate);
+        if (!asset_file)
+        {
+            LOG_ERROR("open file: {} failed!", asset_path.generic_string());
+            return false;
+        }
+
+        out_data.resize(static_cast<size_t>(asset_file.tellg()));
+        asset_file.seekg(0);
+        asset_file.read(reinterpret_cast<char*>(out_data.data()), out_data.size());
+
+        BinaryAssetHeader header;
+        if (!asset_file || out_data.size() < sizeof(header))
+        {
+            LOG_ERROR("read binary asset {} failed!", asset_path.generic_string());
+            return false;
+        }
+        std::memcpy(&header, out_data.data(), sizeof(header));
+        if (!isBinaryAssetHeaderCurrent(header))
+        {
+            LOG_ERROR("binary asset {} was cooked by another version, cook it again!", asset_path.generic_string());
+            return false;
+        }
+        return true;
+    }
+
+    bool AssetManager::writeFile(const std::filesystem::path& asset_path, const void* data, size_t size) const
+    {
+        std::ofstream asset_file(asset_path, std::ios::binary);
+        if (!asset_file)
+        {
+            LOG_ERROR("open file {} failed!", asset_path.generic_string());
+            return false;
+        }
+
+        asset_file.write(static_cast<const char*>(data), size);
+        asset_file.flush();
+        return static_cast<bool>(asset_file);
+    }
+
+    bool AssetManager::isCookedAssetUpToDate(const std::filesystem::path& asset_path,
+                                             const std::filesystem::path& cooked_asset_path) const
+    {
+        std::error_code error;
+        const auto      cooked_time = std::filesystem::last_write_time(cooked_asset_path, error);
+        if (error)
+            return false;
+        // a missing json only leaves the cooked asset
+        const auto asset_time = std::filesystem::last_write_time(asset_path, error);
+        if (!error && cooked_time < asset_time)
+            return false;
+
+        // cooked before a reflected type changed, the json is still good
+        std::ifstream     cooked_asset_file(cooked_asset_path, std::ios::binary);
+        BinaryAssetHeader header;
+        cooked_asset_file.read(reinterpret_cast<char*>(&header), sizeof(header));
+        return cooked_asset_file && isBinaryAssetHeaderCurrent(header);
+    }
+} // namespace Piccolo
@@ -1,72 +1,230 @@
 #pragma once
 
 #include "runtime/core/base/macro.h"
+#include "runtime/core/job/job_system.h"
+#include "runtime/core/meta/serializer/binary_serializer.h"
+#include "runtime/core/meta/serializer/json_stream_serializer.h"
 #include "runtime/core/meta/serializer/serializer.h"
+#include "runtime/resource/asset_manager/asset_cache.h"
 
+#include <cstdint>
 #include <filesystem>
 #include <fstream>
 #include <functional>
+#include <memory>
 #include <sstream>
 #include <string>
+#include <system_error>
+#include <typeindex>
+#include <vector>
 
 #include "_generated/serializer/all_serializer.h"
 
 namespace Piccolo
 {
+    /// Header of the assets written by BinarySerializer, followed by the serialized asset.
+    struct BinaryAssetHeader
+    {
+        uint32_t magic {0};
+        uint32_t version {0};
+        uint32_t schema_hash {0};
+        uint32_t reserved {0};
+    };
+
+    /// Asset read on the job system by AssetManager::loadAssetAsync.
+    template<typename AssetType>
+    class AssetHandle
+    {
+    public:
+        bool isValid() const { return m_state != nullptr; }
+        bool isReady() const { return m_job.isDone(); }
+        // block until the asset is read
+        void wait() const { m_job.wait(); }
+
+        // only once ready
+        bool             isLoaded() const { return m_state && m_state->is_loaded; }
+        const AssetType& get() const { return m_state->asset; }
+        AssetType&       get() { return m_state->asset; }
+
+    private:
+        friend class AssetManager;
+
+        struct State
+        {
+            AssetType asset;
+            bool      is_loaded {false};
+        };
+
+        JobHandle              m_job;
+        std::shared_ptr<State> m_state;
+    };
+
     class AssetManager
     {
     public:
+        static constexpr uint32_t    k_binary_asset_magic       = 0x54414250; // "PBAT"
+        static constexpr uint32_t    k_binary_asset_version     = 1;
+        static constexpr const char* k_binary_asset_extension   = ".bin";
+        static constexpr size_t      k_json_asset_reserved_size = 64u * 1024u;
+
+        /// A .bin url is read as a binary asset. A json asset is read from its cooked .bin sibling instead when
+        /// the cooker wrote it after the last change of the json and with the current reflected types.
         template<typename AssetType>
         bool loadAsset(const std::string& asset_url, AssetType& out_asset) const
         {
-            // read json file to string
             std::filesystem::path asset_path = getFullPath(asset_url);
-            std::ifstream asset_json_file(asset_path);
-            if (!asset_json_file)
+            if (isBinaryAssetPath(asset_path))
             {
-                LOG_ERROR("open file: {} failed!", asset_path.generic_string());
-                return false;
+                return loadBinaryAsset(asset_path, out_asset);
             }
 
-            std::stringstream buffer;
-            buffer << asset_json_file.rdbuf();
-            std::string asset_json_text(buffer.str());
-
-            // parse to json object and read to runtime res object
-            std::string error;
-            auto&&      asset_json = Json::parse(asset_json_text, error);
-            if (!error.empty())
+            std::filesystem::path cooked_asset_path = getCookedAssetPath(asset_path);
+            if (isCookedAssetUpToDate(asset_path, cooked_asset_path))
             {
-                LOG_ERROR("parse json file {} failed!", asset_url);
-                return false;
+                return loadBinaryAsset(cooked_asset_path, out_asset);
             }
+            return loadJsonAsset(asset_path, out_asset);
+        }
 
-            Serializer::read(asset_json, out_asset);
-            return true;
+        /// Same as loadAsset, the file is read and deserialized by a job system task.
+        template<typename AssetType>
+        AssetHandle<AssetType> loadAssetAsync(const std::string& asset_url) const
+        {
+            AssetHandle<AssetType> handle;
+            handle.m_state = std::make_shared<typename AssetHandle<AssetType>::State>();
+            handle.m_job   = getJobSystem().submit([this, asset_url, state = handle.m_state] {
+                state->is_loaded = loadAsset(asset_url, state->asset);
+            });
+            return handle;
+        }
+
+        /// Same as loadAsset, but every request of the url gets the same instance, read once while it is held by
+        /// someone or fits in the cache budget. Returns nullptr when the asset cannot be read.
+        template<typename AssetType>
+        std::shared_ptr<const AssetType> loadSharedAsset(const std::string& asset_url) const
+        {
+            return getOrCreateSharedAsset<AssetType>(asset_url, [this, &asset_url] {
+                std::shared_ptr<AssetType> asset = std::make_shared<AssetType>();
+                return loadAsset(asset_url, *asset) ? asset : nullptr;
+            });
         }
 
+        /// Shares an asset built from the url by create, for data derived from the file such as a compressed clip.
+        /// create returns nullptr on failure, it is not cached then.
+        template<typename AssetType, typename CreateFunction>
+        std::shared_ptr<AssetType> getOrCreateSharedAsset(const std::string& asset_url, CreateFunction create) const
+        {
+            const std::filesystem::path asset_path = getFullPath(asset_url).lexically_normal();
+            std::shared_ptr<void>       asset =
+                m_asset_cache.getOrCreate(asset_path.generic_string(),
+                                          std::type_index(typeid(AssetType)),
+                                          [&asset_path, &create](size_t& out_memory_size) -> std::shared_ptr<void> {
+                                              std::shared_ptr<AssetType> created_asset = create();
+                                              out_memory_size = estimateAssetMemorySize(asset_path, sizeof(AssetType));
+                                              return created_asset;
+                                          });
+            return std::static_pointer_cast<AssetType>(asset);
+        }
+
+        // unused cached assets are evicted, least recently requested first, above this estimated size
+        void            setAssetCacheBudget(size_t memory_budget) { m_asset_cache.setMemoryBudget(memory_budget); }
+        void            releaseUnusedAssets() { m_asset_cache.releaseUnused(); }
+        AssetCacheStats getAssetCacheStats() const { return m_asset_cache.getStats(); }
+
+        /// The format follows the extension of the url.
         template<typename AssetType>
         bool saveAsset(const AssetType& out_asset, const std::string& asset_url) const
         {
-            std::ofstream asset_json_file(getFullPath(asset_url));
-            if (!asset_json_file)
+            std::filesystem::path asset_path = getFullPath(asset_url);
+            if (isBinaryAssetPath(asset_path))
+            {
+                return saveBinaryAsset(out_asset, asset_path);
+            }
+            return saveJsonAsset(out_asset, asset_path);
+        }
+
+        template<typename AssetType>
+        bool loadJsonAsset(const std::filesystem::path& asset_path, AssetType& out_asset) const
+        {
+            // read the fields straight from the text, no json object is built
+            std::string asset_json_text;
+            if (!readTextFile(asset_path, asset_json_text))
+                return false;
+
+            JsonReader reader(asset_json_text);
+            JsonStreamSerializer::read(reader, out_asset);
+            if (!reader.isValid())
             {
-                LOG_ERROR("open file {} failed!", asset_url);
+                LOG_ERROR("parse json file {} failed at offset {}!", asset_path.generic_string(), reader.getOffset());
                 return false;
             }
+            return true;
+        }
 
-            // write to json object and dump to string
-            auto&&        asset_json      = Serializer::write(out_asset);
-            std::string&& asset_json_text = asset_json.dump();
+        template<typename AssetType>
+        bool saveJsonAsset(const AssetType& out_asset, const std::filesystem::path& asset_path) const
+        {
+            // the text is written into a buffer the size of the previous file
+            std::error_code error;
+            const uintmax_t previous_size = std::filesystem::file_size(asset_path, error);
+            JsonWriter      writer(error ? k_json_asset_reserved_size : static_cast<size_t>(previous_size));
+            JsonStreamSerializer::write(writer, out_asset);
 
-            // write to file
-            asset_json_file << asset_json_text;
-            asset_json_file.flush();
+            return writeFile(asset_path, writer.getBuffer().data(), writer.getBuffer().size());
+        }
 
+        template<typename AssetType>
+        bool loadBinaryAsset(const std::filesystem::path& asset_path, AssetType& out_asset) const
+        {
+            std::vector<uint8_t> asset_data;
+            if (!readBinaryFile(asset_path, asset_data))
+                return false;
+
+            BinaryReader reader(asset_data.data() + sizeof(BinaryAssetHeader),
+                                asset_data.size() - sizeof(BinaryAssetHeader));
+            BinarySerializer::read(reader, out_asset);
+            if (!reader.isValid() || reader.remaining() != 0)
+            {
+                LOG_ERROR("binary asset {} is corrupted!", asset_path.generic_string());
+                return false;
+            }
             return true;
         }
 
+        template<typename AssetType>
+        bool saveBinaryAsset(const AssetType& out_asset, const std::filesystem::path& asset_path) const
+        {
+            BinaryAssetHeader header;
+            header.magic       = k_binary_asset_magic;
+            header.version     = k_binary_asset_version;
+            header.schema_hash = k_binary_schema_hash;
+
+            BinaryWriter writer;
+            writer.writeBytes(&header, sizeof(header));
+            BinarySerializer::write(writer, out_asset);
+
+            return writeFile(asset_path, writer.getBuffer().data(), writer.getBuffer().size());
+        }
+
         std::filesystem::path getFullPath(const std::string& relative_path) const;
 
+        static bool isBinaryAssetPath(const std::filesystem::path& asset_path);
+        // asset/foo.object.json -> asset/foo.object.json.bin
+        static std::filesystem::path getCookedAssetPath(const std::filesystem::path& asset_path);
+        // written after the last change of the json and with the current reflected types
+        bool isCookedAssetUpToDate(const std::filesystem::path& asset_path,
+                                   const std::filesystem::path& cooked_asset_path) const;
+
+    private:
+        JobSystem& getJobSystem() const;
+        // the size of the file the asset is read from, or of its cooked form when that is the one read
+        static size_t estimateAssetMemorySize(const std::filesystem::path& asset_path, size_t default_size);
+
+        bool readTextFile(const std::filesystem::path& asset_path, std::string& out_text) const;
+        // the whole file, header included, only when the header matches this build
+        bool readBinaryFile(const std::filesystem::path& asset_path, std::vector<uint8_t>& out_data) const;
+        bool writeFile(const std::filesystem::path& asset_path, const void* data, size_t size) const;
+
+        mutable AssetCache m_asset_cache;
     };
 } // namespace Piccolo
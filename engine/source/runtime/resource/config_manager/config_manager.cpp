@@ -2,6 +2,7 @@
 
 #include "runtime/engine.h"
 
+#include <cstdlib>
 #include <filesystem>
 #include <fstream>
 #include <string>
@@ -56,6 +57,14 @@ namespace Piccolo
                 {
                     m_global_particle_res_url = value;
                 }
+                else if (name == "JobWorkerCount")
+                {
+                    m_job_worker_count = std::atoi(value.c_str());
+                }
+                else if (name == "ThreadedLogic")
+                {
+                    m_is_threaded_logic = std::atoi(value.c_str()) != 0;
+                }
 #ifdef ENABLE_PHYSICS_DEBUG_RENDERER
                 else if (name == "JoltAssetFolder")
                 {
@@ -66,6 +75,12 @@ namespace Piccolo
         }
     }
 
+    void ConfigManager::initializeRootFolder(const std::filesystem::path& root_folder)
+    {
+        m_root_folder  = root_folder;
+        m_asset_folder = m_root_folder / "asset";
+    }
+
     const std::filesystem::path& ConfigManager::getRootFolder() const { return m_root_folder; }
 
     const std::filesystem::path& ConfigManager::getAssetFolder() const { return m_asset_folder; }
@@ -84,6 +99,10 @@ namespace Piccolo
 
     const std::string& ConfigManager::getGlobalParticleResUrl() const { return m_global_particle_res_url; }
 
+    int ConfigManager::getJobWorkerCount() const { return m_job_worker_count; }
+
+    bool ConfigManager::isThreadedLogic() const { return m_is_threaded_logic; }
+
 #ifdef ENABLE_PHYSICS_DEBUG_RENDERER
     const std::filesystem::path& ConfigManager::getJoltPhysicsAssetFolder() const { return m_jolt_physics_asset_folder; }
 #endif
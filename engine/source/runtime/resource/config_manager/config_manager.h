@@ -10,6 +10,8 @@ namespace Piccolo
     {
     public:
         void initialize(const std::filesystem::path& config_file_path);
+        // for the tools without a config file, the assets are in the asset folder of the root
+        void initializeRootFolder(const std::filesystem::path& root_folder);
 
         const std::filesystem::path& getRootFolder() const;
         const std::filesystem::path& getAssetFolder() const;
@@ -26,6 +28,9 @@ namespace Piccolo
         const std::string& getGlobalRenderingResUrl() const;
         const std::string& getGlobalParticleResUrl() const;
 
+        int  getJobWorkerCount() const;
+        bool isThreadedLogic() const;
+
     private:
         std::filesystem::path m_root_folder;
         std::filesystem::path m_asset_folder;
@@ -41,5 +46,10 @@ namespace Piccolo
         std::string m_default_world_url;
         std::string m_global_rendering_res_url;
         std::string m_global_particle_res_url;
+
+        // negative: one worker per hardware thread besides the main thread
+        int  m_job_worker_count {-1};
+        // the logic ticks on its own thread one frame ahead of the render, see PiccoloEngine
+        bool m_is_threaded_logic {false};
     };
 } // namespace Piccolo
@@ -9,25 +9,6 @@
 namespace Piccolo
 {
 
-    REFLECTION_TYPE(AnimationResultElement)
-    CLASS(AnimationResultElement, WhiteListFields)
-    {
-        REFLECTION_BODY(AnimationResultElement);
-
-    public:
-        int        index;
-        Matrix4x4_ transform;
-    };
-
-    REFLECTION_TYPE(AnimationResult)
-    CLASS(AnimationResult, Fields)
-    {
-        REFLECTION_BODY(AnimationResult);
-
-    public:
-        std::vector<AnimationResultElement> node;
-    };
-
     REFLECTION_TYPE(AnimationComponentRes)
     CLASS(AnimationComponentRes, Fields)
     {
@@ -38,9 +19,6 @@ namespace Piccolo
         BlendState  blend_state;
         // animation to skeleton map
         float       frame_position; // 0-1
-
-        META(Disable)
-        AnimationResult animation_result;
     };
 
 } // namespace Piccolo
\ No newline at end of file
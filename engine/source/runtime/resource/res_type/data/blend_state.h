@@ -7,28 +7,6 @@
 namespace Piccolo
 {
 
-    REFLECTION_TYPE(BoneBlendWeight)
-    CLASS(BoneBlendWeight, Fields)
-    {
-        REFLECTION_BODY(BoneBlendWeight);
-
-    public:
-        std::vector<float> blend_weight;
-    };
-
-    REFLECTION_TYPE(BlendStateWithClipData)
-    CLASS(BlendStateWithClipData, Fields)
-    {
-        REFLECTION_BODY(BlendStateWithClipData);
-
-    public:
-        int                          clip_count;
-        std::vector<AnimationClip>   blend_clip;
-        std::vector<AnimSkelMap>     blend_anim_skel_map;
-        std::vector<BoneBlendWeight> blend_weight;
-        std::vector<float>           blend_ratio;
-    };
-
     REFLECTION_TYPE(BlendState)
     CLASS(BlendState, Fields)
     {
@@ -42,6 +20,8 @@ namespace Piccolo
         std::vector<float>       blend_weight;
         std::vector<std::string> blend_mask_file_path;
         std::vector<float>       blend_ratio;
+        // 1 for the clips added on top of the blended pose instead of being blended into it
+        std::vector<int> blend_clip_additive;
     };
 
 } // namespace Piccolo
\ No newline at end of file
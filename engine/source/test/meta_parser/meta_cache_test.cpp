@@ -0,0 +1,205 @@
+#include "common/precompiled.h"
+
+#include "language_types/class.h"
+#include "parser/meta_cache.h"
+
+namespace
+{
+    using Properties = std::unordered_map<std::string, std::string>;
+
+    int s_failure_count = 0;
+
+#define CHECK(condition) \
+    do \
+    { \
+        if (!(condition)) \
+        { \
+            std::cerr << __FILE__ << ":" << __LINE__ << ": check failed: " #condition << std::endl; \
+            s_failure_count++; \
+        } \
+    } while (0)
+
+    void writeFile(const fs::path& file_path, const std::string& content)
+    {
+        std::ofstream file_stream(file_path, std::ios::binary | std::ios::trunc);
+        file_stream << content;
+    }
+
+    std::shared_ptr<Class> makeClass(const std::string& source_file)
+    {
+        const Namespace class_namespace {"Piccolo"};
+
+        // a tab, a new line and a backslash in the values must survive the cache
+        Properties class_properties {{"Fields", ""}, {"WhiteListFields", "a\tb"}};
+        auto class_temp = std::make_shared<Class>(
+            "Transform", "Piccolo::Transform", true, MetaInfo(class_properties), source_file, class_namespace);
+        class_temp->m_base_classes.emplace_back(new BaseClass("Piccolo::Component"));
+
+        Properties field_properties {{"default", "\"line\\nbreak\\\\\""}};
+        class_temp->m_fields.emplace_back(new Field("m_position",
+                                                    "Piccolo::Vector3",
+                                                    false,
+                                                    MetaInfo(field_properties),
+                                                    class_namespace,
+                                                    class_temp.get()));
+        class_temp->m_fields.emplace_back(new Field(
+            "m_names", "std::vector<std::string>", true, MetaInfo(Properties {}), class_namespace, class_temp.get()));
+        class_temp->m_methods.emplace_back(
+            new Method("getMatrix", MetaInfo(Properties {{"Enable", ""}}), class_namespace, class_temp.get()));
+        return class_temp;
+    }
+
+    void checkSameClass(const Class& expected, const Class& actual)
+    {
+        CHECK(actual.m_name == expected.m_name);
+        CHECK(actual.m_qualified_name == expected.m_qualified_name);
+        CHECK(actual.m_is_struct == expected.m_is_struct);
+        CHECK(actual.getSourceFile() == expected.getSourceFile());
+        CHECK(actual.getCurrentNamespace() == expected.getCurrentNamespace());
+        CHECK(actual.getMetaData().getProperties() == expected.getMetaData().getProperties());
+
+        CHECK(actual.m_base_classes.size() == expected.m_base_classes.size());
+        for (size_t index = 0; index < std::min(actual.m_base_classes.size(), expected.m_base_classes.size()); ++index)
+        {
+            CHECK(actual.m_base_classes[index]->name == expected.m_base_classes[index]->name);
+        }
+
+        CHECK(actual.m_fields.size() == expected.m_fields.size());
+        for (size_t index = 0; index < std::min(actual.m_fields.size(), expected.m_fields.size()); ++index)
+        {
+            const Field& expected_field = *expected.m_fields[index];
+            const Field& actual_field   = *actual.m_fields[index];
+            CHECK(actual_field.m_name == expected_field.m_name);
+            CHECK(actual_field.m_display_name == expected_field.m_display_name);
+            CHECK(actual_field.m_type == expected_field.m_type);
+            CHECK(actual_field.m_is_const == expected_field.m_is_const);
+            CHECK(actual_field.m_default == expected_field.m_default);
+            CHECK(actual_field.getMetaData().getProperties() == expected_field.getMetaData().getProperties());
+        }
+
+        CHECK(actual.m_methods.size() == expected.m_methods.size());
+        for (size_t index = 0; index < std::min(actual.m_methods.size(), expected.m_methods.size()); ++index)
+        {
+            CHECK(actual.m_methods[index]->m_name == expected.m_methods[index]->m_name);
+            CHECK(actual.m_methods[index]->getMetaData().getProperties() ==
+                  expected.m_methods[index]->getMetaData().getProperties());
+        }
+    }
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const fs::path test_dir = fs::temp_directory_path() / "piccolo_meta_cache_test";
+    fs::remove_all(test_dir);
+    fs::create_directories(test_dir);
+
+    const std::string cache_file  = (test_dir / "test.meta_cache").string();
+    const std::string header_file = (test_dir / "transform.h").string();
+    const std::string other_file  = (test_dir / "other.h").string();
+    const std::string dependency  = (test_dir / "vector3.h").string();
+    const uint64_t    arguments   = MetaCache::hashString("arguments");
+    writeFile(header_file, "CLASS(Transform, Fields) {};");
+    writeFile(other_file, "struct Other {};");
+    writeFile(dependency, "struct Vector3 {};");
+
+    std::shared_ptr<Class> expected_class = makeClass(header_file);
+    {
+        MetaCache meta_cache(cache_file, arguments);
+        meta_cache.load();
+        CHECK(meta_cache.findUpToDateEntry(header_file) == nullptr);
+
+        MetaCache::HeaderEntry entry;
+        entry.content_hash = meta_cache.getFileHash(header_file);
+        entry.dependencies.emplace_back(dependency, meta_cache.getFileHash(dependency));
+        entry.classes.push_back(expected_class);
+        meta_cache.setEntry(header_file, std::move(entry));
+
+        MetaCache::HeaderEntry other_entry;
+        other_entry.content_hash = meta_cache.getFileHash(other_file);
+        meta_cache.setEntry(other_file, std::move(other_entry));
+        meta_cache.save();
+    }
+
+    // the classes read back are the ones written
+    {
+        MetaCache meta_cache(cache_file, arguments);
+        meta_cache.load();
+        const MetaCache::HeaderEntry* entry = meta_cache.findUpToDateEntry(header_file);
+        CHECK(entry != nullptr);
+        if (entry != nullptr)
+        {
+            CHECK(entry->dependencies.size() == 1);
+            CHECK(entry->classes.size() == 1);
+            if (entry->classes.size() == 1)
+            {
+                checkSameClass(*expected_class, *entry->classes[0]);
+            }
+
+            // a header not set during a run is dropped on save
+            meta_cache.setEntry(header_file, *entry);
+            meta_cache.removeUnusedEntries();
+            meta_cache.save();
+        }
+    }
+    {
+        MetaCache meta_cache(cache_file, arguments);
+        meta_cache.load();
+        CHECK(meta_cache.findUpToDateEntry(header_file) != nullptr);
+        CHECK(meta_cache.findUpToDateEntry(other_file) == nullptr);
+    }
+
+    // the cache is ignored when the parser is called with other arguments
+    {
+        MetaCache meta_cache(cache_file, MetaCache::hashString("other arguments"));
+        meta_cache.load();
+        CHECK(meta_cache.findUpToDateEntry(header_file) == nullptr);
+    }
+
+    // an edited dependency outdates the header including it
+    writeFile(dependency, "struct Vector3 { float x; };");
+    {
+        MetaCache meta_cache(cache_file, arguments);
+        meta_cache.load();
+        CHECK(meta_cache.findUpToDateEntry(header_file) == nullptr);
+    }
+
+    // and so does an edited header
+    {
+        MetaCache meta_cache(cache_file, arguments);
+        meta_cache.load();
+        MetaCache::HeaderEntry entry;
+        entry.content_hash = meta_cache.getFileHash(header_file);
+        entry.classes.push_back(expected_class);
+        meta_cache.setEntry(header_file, std::move(entry));
+        meta_cache.save();
+    }
+    writeFile(header_file, "CLASS(Transform, Fields) { int m_x; };");
+    {
+        MetaCache meta_cache(cache_file, arguments);
+        meta_cache.load();
+        CHECK(meta_cache.findUpToDateEntry(header_file) == nullptr);
+    }
+
+    // a truncated cache is dropped as a whole
+    {
+        std::ifstream     cache_stream(cache_file, std::ios::binary);
+        std::stringstream content;
+        content << cache_stream.rdbuf();
+        cache_stream.close();
+        writeFile(cache_file, content.str() + "\nclass\ttruncated");
+        writeFile(header_file, "CLASS(Transform, Fields) {};");
+
+        MetaCache meta_cache(cache_file, arguments);
+        meta_cache.load();
+        CHECK(meta_cache.findUpToDateEntry(header_file) == nullptr);
+    }
+
+    fs::remove_all(test_dir);
+
+    if (s_failure_count != 0)
+    {
+        std::cerr << s_failure_count << " checks failed" << std::endl;
+        return 1;
+    }
+    return 0;
+}
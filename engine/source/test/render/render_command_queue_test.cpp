@@ -0,0 +1,202 @@
+#include "runtime/function/render/render_command_queue.h"
+
+#include <atomic>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace Piccolo;
+
+namespace
+{
+    int s_failure_count = 0;
+
+#define CHECK(condition) \
+    do \
+    { \
+        if (!(condition)) \
+        { \
+            std::cerr << __FILE__ << ":" << __LINE__ << ": check failed: " #condition << std::endl; \
+            s_failure_count++; \
+        } \
+    } while (0)
+
+    std::atomic<int> s_live_counted_command_count {0};
+
+    // a command with a destructor, so the destroy list of the queue is exercised
+    struct CountedCommand : public RenderCommand
+    {
+        static constexpr RenderCommandType k_type = RenderCommandType::TickParticleEmitter;
+
+        CountedCommand() { s_live_counted_command_count++; }
+        ~CountedCommand() { s_live_counted_command_count--; }
+
+        uint32_t m_producer {0};
+        uint32_t m_sequence {0};
+    };
+
+    // the producer and the sequence number are packed in the object id of the transform commands
+    constexpr uint32_t k_sequence_bits = 20;
+
+    GObjectID makeObjectId(uint32_t producer, uint32_t sequence)
+    {
+        return (static_cast<GObjectID>(producer) << k_sequence_bits) | sequence;
+    }
+
+    void pushCommands(RenderCommandQueue& queue, uint32_t producer, uint32_t command_count, uint32_t seed)
+    {
+        std::mt19937 random(seed);
+        for (uint32_t sequence = 0; sequence < command_count; ++sequence)
+        {
+            if (random() % 4 == 0)
+            {
+                CountedCommand* command = queue.allocate<CountedCommand>();
+                command->m_producer     = producer;
+                command->m_sequence     = sequence;
+                queue.submit(command);
+                continue;
+            }
+
+            const uint32_t                    part_count = random() % 9;
+            RenderCommandGameObjectTransform* command =
+                queue.allocateGameObjectTransform(makeObjectId(producer, sequence), part_count);
+            Matrix4x4* part_transforms = command->getPartTransforms();
+            for (uint32_t part_index = 0; part_index < part_count; ++part_index)
+            {
+                part_transforms[part_index][0][3] = static_cast<float>(sequence);
+                part_transforms[part_index][1][3] = static_cast<float>(part_index);
+            }
+            queue.submit(command);
+        }
+    }
+
+    // pops the command_count commands of each producer, every producer's commands in the order it submitted them
+    void popCommands(RenderCommandQueue& queue, uint32_t producer_count, uint32_t command_count)
+    {
+        std::vector<uint32_t> next_sequences(producer_count, 0);
+        uint32_t              popped_count = 0;
+        while (popped_count < producer_count * command_count)
+        {
+            RenderCommand* command = queue.pop();
+            if (command == nullptr)
+            {
+                std::this_thread::yield();
+                continue;
+            }
+            popped_count++;
+
+            uint32_t producer = 0;
+            uint32_t sequence = 0;
+            if (command->m_type == CountedCommand::k_type)
+            {
+                const CountedCommand* counted_command = static_cast<const CountedCommand*>(command);
+                producer                              = counted_command->m_producer;
+                sequence                              = counted_command->m_sequence;
+            }
+            else
+            {
+                CHECK(command->m_type == RenderCommandType::GameObjectTransform);
+                const RenderCommandGameObjectTransform* transform_command =
+                    static_cast<const RenderCommandGameObjectTransform*>(command);
+                producer = static_cast<uint32_t>(transform_command->m_go_id >> k_sequence_bits);
+                sequence = static_cast<uint32_t>(transform_command->m_go_id & ((1u << k_sequence_bits) - 1));
+
+                const Matrix4x4* part_transforms = transform_command->getPartTransforms();
+                for (uint32_t part_index = 0; part_index < transform_command->m_part_count; ++part_index)
+                {
+                    CHECK(part_transforms[part_index][0][3] == static_cast<float>(sequence));
+                    CHECK(part_transforms[part_index][1][3] == static_cast<float>(part_index));
+                }
+            }
+
+            CHECK(producer < producer_count);
+            if (producer < producer_count)
+            {
+                CHECK(sequence == next_sequences[producer]);
+                next_sequences[producer] = sequence + 1;
+            }
+        }
+        CHECK(queue.pop() == nullptr);
+        CHECK(queue.isEmpty());
+    }
+
+    // one thread: the queue drains and refills, the commands come in order and reset destroys them
+    void testSingleProducer()
+    {
+        RenderCommandQueue queue;
+        CHECK(queue.isEmpty());
+        CHECK(queue.pop() == nullptr);
+
+        for (int frame = 0; frame < 3; ++frame)
+        {
+            // popping the last command links the stub back, the next push must still come out
+            for (uint32_t round = 0; round < 4; ++round)
+            {
+                pushCommands(queue, 0, 1 + round * 3, round);
+                popCommands(queue, 1, 1 + round * 3);
+            }
+            pushCommands(queue, 0, 500, frame);
+            popCommands(queue, 1, 500);
+
+            queue.reset();
+            CHECK(s_live_counted_command_count == 0);
+            CHECK(queue.isEmpty());
+        }
+    }
+
+    // several producers fill far more than the initial arena while the consumer pops, the overflowed commands are
+    // as valid as the others, and the frames after the arena grew give the same commands
+    void testMultipleProducers()
+    {
+        constexpr uint32_t k_producer_count = 4;
+        constexpr uint32_t k_command_count  = 4000;
+
+        RenderCommandQueue queue;
+        for (uint32_t frame = 0; frame < 4; ++frame)
+        {
+            std::vector<std::thread> producers;
+            for (uint32_t producer = 0; producer < k_producer_count; ++producer)
+            {
+                const uint32_t seed = frame * k_producer_count + producer;
+                producers.emplace_back(
+                    [&queue, producer, seed] { pushCommands(queue, producer, k_command_count, seed); });
+            }
+            popCommands(queue, k_producer_count, k_command_count);
+            for (std::thread& producer : producers)
+            {
+                producer.join();
+            }
+
+            CHECK(s_live_counted_command_count > 0);
+            queue.reset();
+            CHECK(s_live_counted_command_count == 0);
+            CHECK(queue.isEmpty());
+        }
+    }
+
+    // the commands left in the queue are destroyed with it
+    void testDestroyUnpopped()
+    {
+        {
+            RenderCommandQueue queue;
+            pushCommands(queue, 0, 100000, 1);
+            CHECK(s_live_counted_command_count > 0);
+        }
+        CHECK(s_live_counted_command_count == 0);
+    }
+} // namespace
+
+int main(int argc, char** argv)
+{
+    testSingleProducer();
+    testMultipleProducers();
+    testDestroyUnpopped();
+
+    if (s_failure_count != 0)
+    {
+        std::cerr << s_failure_count << " checks failed" << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,640 @@
+#include "runtime/function/render/render_upload_queue.h"
+
+#include "test/render/rhi_stub.h"
+
+#include <cstring>
+#include <deque>
+#include <iostream>
+#include <random>
+
+using namespace Piccolo;
+
+namespace
+{
+    int s_failure_count = 0;
+
+#define CHECK(condition) \
+    do \
+    { \
+        if (!(condition)) \
+        { \
+            std::cerr << __FILE__ << ":" << __LINE__ << ": check failed: " #condition << std::endl; \
+            s_failure_count++; \
+        } \
+    } while (0)
+
+    struct MockBuffer : RHIBuffer
+    {
+        std::vector<uint8_t> data;
+        bool                 is_alive {true};
+    };
+
+    struct MockMemory : RHIDeviceMemory
+    {
+        MockBuffer* buffer {nullptr};
+    };
+
+    struct MockCopy
+    {
+        MockBuffer*   src_buffer;
+        MockBuffer*   dst_buffer;
+        RHIBufferCopy region;
+    };
+
+    struct MockCommandBuffer : RHICommandBuffer
+    {
+        std::vector<MockCopy> copies;
+        bool                  is_recording {false};
+        bool                  is_pending {false};
+    };
+
+    struct MockFence : RHIFence
+    {
+        bool is_signaled {false};
+        bool is_pending {false};
+    };
+
+    struct MockSemaphore : RHISemaphore
+    {
+        bool is_signaled {false};
+    };
+
+    struct MockQueue : RHIQueue
+    {};
+
+    struct MockCommandPool : RHICommandPool
+    {};
+
+    /// A fake gpu running the submits of the transfer queue in order, only when asked to or when the cpu waits for
+    /// them, so the staging memory reused too early or a semaphore signaled twice shows in the copied bytes.
+    class MockRHI : public RHIStub
+    {
+    public:
+        uint32_t m_graphics_family {0};
+        uint32_t m_transfer_family {0};
+        uint8_t  m_frame_index {0};
+
+        int m_live_buffer_count {0};
+        int m_live_fence_count {0};
+        int m_live_semaphore_count {0};
+        int m_live_command_buffer_count {0};
+        int m_submit_count {0};
+        int m_blocking_wait_count {0};
+        int m_copy_command_count {0};
+
+        std::vector<MockSemaphore*> m_rendering_wait_semaphores;
+
+        QueueFamilyIndices getQueueFamilyIndices() const override
+        {
+            QueueFamilyIndices queue_indices;
+            queue_indices.graphics_family   = m_graphics_family;
+            queue_indices.present_family    = m_graphics_family;
+            queue_indices.m_compute_family  = m_graphics_family;
+            queue_indices.m_transfer_family = m_transfer_family;
+            return queue_indices;
+        }
+        RHIQueue* getTransferQueue() const override { return const_cast<MockQueue*>(&m_transfer_queue); }
+        RHIQueue* getGraphicsQueue() const override { return const_cast<MockQueue*>(&m_graphics_queue); }
+        uint8_t   getMaxFramesInFlight() const override { return 3; }
+        uint8_t   getCurrentFrameIndex() const override { return m_frame_index; }
+
+        void createBuffer(RHIDeviceSize          size,
+                          RHIBufferUsageFlags    usage,
+                          RHIMemoryPropertyFlags properties,
+                          RHIBuffer*&            buffer,
+                          RHIDeviceMemory*&      buffer_memory) override
+        {
+            MockBuffer* mock_buffer = new MockBuffer;
+            mock_buffer->data.assign(static_cast<size_t>(size), 0xcd);
+            MockMemory* mock_memory = new MockMemory;
+            mock_memory->buffer     = mock_buffer;
+            buffer                  = mock_buffer;
+            buffer_memory           = mock_memory;
+            m_live_buffer_count++;
+        }
+        bool mapMemory(RHIDeviceMemory*  memory,
+                       RHIDeviceSize     offset,
+                       RHIDeviceSize     size,
+                       RHIMemoryMapFlags flags,
+                       void**            ppData) override
+        {
+            *ppData = static_cast<MockMemory*>(memory)->buffer->data.data();
+            return true;
+        }
+        void destroyBuffer(RHIBuffer*& buffer) override
+        {
+            // the staging buffers are kept alive until their copies ran, the data is checked in runSubmit
+            MockBuffer* mock_buffer = static_cast<MockBuffer*>(buffer);
+            CHECK(mock_buffer->is_alive);
+            mock_buffer->is_alive = false;
+            m_dead_buffers.emplace_back(mock_buffer);
+            m_live_buffer_count--;
+            buffer = nullptr;
+        }
+        void freeMemory(RHIDeviceMemory*& memory) override
+        {
+            delete static_cast<MockMemory*>(memory);
+            memory = nullptr;
+        }
+
+        bool createCommandPool(const RHICommandPoolCreateInfo* pCreateInfo, RHICommandPool*& pCommandPool) override
+        {
+            CHECK(pCreateInfo->queueFamilyIndex == m_transfer_family);
+            pCommandPool = new MockCommandPool;
+            return true;
+        }
+        void destroyCommandPool(RHICommandPool* commandPool) override
+        {
+            delete static_cast<MockCommandPool*>(commandPool);
+        }
+        bool allocateCommandBuffers(const RHICommandBufferAllocateInfo* pAllocateInfo,
+                                    RHICommandBuffer*&                  pCommandBuffers) override
+        {
+            pCommandBuffers = new MockCommandBuffer;
+            m_live_command_buffer_count++;
+            return true;
+        }
+        void freeCommandBuffers(RHICommandPool*   commandPool,
+                                uint32_t          commandBufferCount,
+                                RHICommandBuffer* pCommandBuffers) override
+        {
+            CHECK(!static_cast<MockCommandBuffer*>(pCommandBuffers)->is_pending);
+            delete static_cast<MockCommandBuffer*>(pCommandBuffers);
+            m_live_command_buffer_count--;
+        }
+        bool createFence(const RHIFenceCreateInfo* pCreateInfo, RHIFence*& pFence) override
+        {
+            MockFence* fence   = new MockFence;
+            fence->is_signaled = pCreateInfo->flags != 0;
+            pFence             = fence;
+            m_live_fence_count++;
+            return true;
+        }
+        void destroyFence(RHIFence* fence) override
+        {
+            CHECK(!static_cast<MockFence*>(fence)->is_pending);
+            delete static_cast<MockFence*>(fence);
+            m_live_fence_count--;
+        }
+        bool createSemaphore(const RHISemaphoreCreateInfo* pCreateInfo, RHISemaphore*& pSemaphore) override
+        {
+            pSemaphore = new MockSemaphore;
+            m_live_semaphore_count++;
+            return true;
+        }
+        void destroySemaphore(RHISemaphore* semaphore) override
+        {
+            delete static_cast<MockSemaphore*>(semaphore);
+            m_live_semaphore_count--;
+        }
+
+        bool beginCommandBuffer(RHICommandBuffer* commandBuffer, const RHICommandBufferBeginInfo* pBeginInfo) override
+        {
+            MockCommandBuffer* command_buffer = static_cast<MockCommandBuffer*>(commandBuffer);
+            // recorded again while the gpu still runs it
+            CHECK(!command_buffer->is_pending);
+            command_buffer->copies.clear();
+            command_buffer->is_recording = true;
+            return true;
+        }
+        void cmdCopyBuffer(RHICommandBuffer* commandBuffer,
+                           RHIBuffer*        srcBuffer,
+                           RHIBuffer*        dstBuffer,
+                           uint32_t          regionCount,
+                           RHIBufferCopy*    pRegions) override
+        {
+            MockCommandBuffer* command_buffer = static_cast<MockCommandBuffer*>(commandBuffer);
+            MockBuffer*        src_buffer     = static_cast<MockBuffer*>(srcBuffer);
+            MockBuffer*        dst_buffer     = static_cast<MockBuffer*>(dstBuffer);
+            CHECK(command_buffer->is_recording);
+            m_copy_command_count++;
+            for (uint32_t region_index = 0; region_index < regionCount; ++region_index)
+            {
+                const RHIBufferCopy& region = pRegions[region_index];
+                CHECK(region.srcOffset + region.size <= src_buffer->data.size());
+                CHECK(region.dstOffset + region.size <= dst_buffer->data.size());
+                command_buffer->copies.push_back({src_buffer, dst_buffer, region});
+            }
+        }
+        bool endCommandBuffer(RHICommandBuffer* commandBuffer) override
+        {
+            static_cast<MockCommandBuffer*>(commandBuffer)->is_recording = false;
+            return true;
+        }
+
+        bool queueSubmit(RHIQueue* queue, uint32_t submitCount, const RHISubmitInfo* pSubmits, RHIFence* fence) override
+        {
+            CHECK(queue == &m_transfer_queue);
+            CHECK(submitCount == 1);
+
+            MockSubmit submit;
+            if (pSubmits->commandBufferCount != 0)
+            {
+                CHECK(pSubmits->commandBufferCount == 1);
+                submit.command_buffer = static_cast<MockCommandBuffer*>(pSubmits->pCommandBuffers[0]);
+                CHECK(!submit.command_buffer->is_recording);
+                CHECK(!submit.command_buffer->is_pending);
+                submit.command_buffer->is_pending = true;
+                // the copies read the staging memory when the gpu runs them, not now
+                submit.copies = submit.command_buffer->copies;
+            }
+            if (fence != nullptr)
+            {
+                submit.fence = static_cast<MockFence*>(fence);
+                CHECK(!submit.fence->is_signaled && !submit.fence->is_pending);
+                submit.fence->is_pending = true;
+            }
+            CHECK(pSubmits->signalSemaphoreCount <= 1);
+            if (pSubmits->signalSemaphoreCount != 0)
+            {
+                submit.signal_semaphore =
+                    static_cast<MockSemaphore*>(const_cast<RHISemaphore*>(pSubmits->pSignalSemaphores[0]));
+                // a binary semaphore signaled again before the rendering waited for it
+                CHECK(!submit.signal_semaphore->is_signaled);
+            }
+            m_transfer_submits.push_back(submit);
+            m_submit_count++;
+            return true;
+        }
+        bool getFenceStatus(RHIFence* fence) override { return static_cast<MockFence*>(fence)->is_signaled; }
+        bool waitForFencesPFN(uint32_t         fenceCount,
+                              RHIFence* const* pFence,
+                              RHIBool32        waitAll,
+                              uint64_t         timeout) override
+        {
+            CHECK(fenceCount == 1);
+            m_blocking_wait_count++;
+            MockFence* fence = static_cast<MockFence*>(pFence[0]);
+            // a fence never submitted would hang
+            CHECK(fence->is_signaled || fence->is_pending);
+            while (!fence->is_signaled && runSubmit())
+                ;
+            return fence->is_signaled;
+        }
+        bool resetFencesPFN(uint32_t fenceCount, RHIFence* const* pFences) override
+        {
+            for (uint32_t fence_index = 0; fence_index < fenceCount; ++fence_index)
+            {
+                MockFence* fence = static_cast<MockFence*>(pFences[fence_index]);
+                CHECK(!fence->is_pending);
+                fence->is_signaled = false;
+            }
+            return true;
+        }
+        void addRenderingWaitSemaphore(RHISemaphore* semaphore, RHIPipelineStageFlags wait_stage_mask) override
+        {
+            CHECK(wait_stage_mask != 0);
+            m_rendering_wait_semaphores.push_back(static_cast<MockSemaphore*>(semaphore));
+        }
+        bool queueWaitIdle(RHIQueue* queue) override { return true; }
+
+        ~MockRHI() override
+        {
+            for (MockBuffer* buffer : m_dead_buffers)
+            {
+                delete buffer;
+            }
+        }
+
+        // the gpu runs the oldest submit of the transfer queue
+        bool runSubmit()
+        {
+            if (m_transfer_submits.empty())
+                return false;
+
+            MockSubmit submit = m_transfer_submits.front();
+            m_transfer_submits.pop_front();
+            for (const MockCopy& copy : submit.copies)
+            {
+                CHECK(copy.src_buffer->is_alive);
+                memcpy(copy.dst_buffer->data.data() + copy.region.dstOffset,
+                       copy.src_buffer->data.data() + copy.region.srcOffset,
+                       static_cast<size_t>(copy.region.size));
+            }
+            if (submit.command_buffer)
+                submit.command_buffer->is_pending = false;
+            if (submit.fence)
+            {
+                submit.fence->is_pending  = false;
+                submit.fence->is_signaled = true;
+            }
+            if (submit.signal_semaphore)
+                submit.signal_semaphore->is_signaled = true;
+            return true;
+        }
+
+        void runAllSubmits()
+        {
+            while (runSubmit())
+                ;
+        }
+
+        // the rendering submit of the frame, the transfer queue runs up to the semaphores it waits for
+        void renderFrame()
+        {
+            for (MockSemaphore* semaphore : m_rendering_wait_semaphores)
+            {
+                while (!semaphore->is_signaled)
+                {
+                    const bool has_run = runSubmit();
+                    // waiting for a semaphore nothing will signal
+                    CHECK(has_run);
+                    if (!has_run)
+                        break;
+                }
+                semaphore->is_signaled = false;
+            }
+            m_rendering_wait_semaphores.clear();
+            m_frame_index = (m_frame_index + 1) % getMaxFramesInFlight();
+        }
+
+    private:
+        struct MockSubmit
+        {
+            std::vector<MockCopy> copies;
+            MockCommandBuffer*    command_buffer {nullptr};
+            MockFence*            fence {nullptr};
+            MockSemaphore*        signal_semaphore {nullptr};
+        };
+
+        MockQueue               m_graphics_queue;
+        MockQueue               m_transfer_queue;
+        std::deque<MockSubmit>  m_transfer_submits;
+        std::vector<MockBuffer*> m_dead_buffers;
+    };
+
+    std::vector<uint8_t> makeBytes(size_t size, uint32_t seed)
+    {
+        std::vector<uint8_t> bytes(size);
+        std::mt19937         random(seed);
+        for (uint8_t& byte : bytes)
+        {
+            byte = static_cast<uint8_t>(random());
+        }
+        return bytes;
+    }
+
+    MockBuffer makeDstBuffer(size_t size)
+    {
+        MockBuffer buffer;
+        buffer.data.assign(size, 0);
+        return buffer;
+    }
+
+    void checkReleased(const MockRHI& rhi)
+    {
+        CHECK(rhi.m_live_buffer_count == 0);
+        CHECK(rhi.m_live_fence_count == 0);
+        CHECK(rhi.m_live_semaphore_count == 0);
+        CHECK(rhi.m_live_command_buffer_count == 0);
+    }
+
+    // the copies of a frame go in one submit, one copy command per destination, signaling one semaphore
+    void testBatching()
+    {
+        auto              rhi = std::make_shared<MockRHI>();
+        RenderUploadQueue upload_queue;
+        upload_queue.initialize(rhi, 4096);
+
+        MockBuffer           buffer_a = makeDstBuffer(256);
+        MockBuffer           buffer_b = makeDstBuffer(256);
+        std::vector<uint8_t> bytes_a  = makeBytes(100, 1);
+        std::vector<uint8_t> bytes_b  = makeBytes(50, 2);
+        std::vector<uint8_t> bytes_c  = makeBytes(60, 3);
+        upload_queue.uploadBuffer(&buffer_a, 0, bytes_a.data(), bytes_a.size());
+        upload_queue.uploadBuffer(&buffer_b, 10, bytes_b.data(), bytes_b.size());
+        upload_queue.uploadBuffer(&buffer_a, 120, bytes_c.data(), bytes_c.size());
+        CHECK(rhi->m_submit_count == 0);
+
+        upload_queue.submit();
+        CHECK(rhi->m_submit_count == 1);
+        CHECK(rhi->m_copy_command_count == 2);
+        CHECK(rhi->m_rendering_wait_semaphores.size() == 1);
+        CHECK(rhi->m_blocking_wait_count == 0);
+
+        rhi->renderFrame();
+        CHECK(memcmp(buffer_a.data.data(), bytes_a.data(), bytes_a.size()) == 0);
+        CHECK(memcmp(buffer_a.data.data() + 120, bytes_c.data(), bytes_c.size()) == 0);
+        CHECK(memcmp(buffer_b.data.data() + 10, bytes_b.data(), bytes_b.size()) == 0);
+
+        // nothing uploaded, nothing submitted, and the ring space is given back
+        upload_queue.submit();
+        CHECK(rhi->m_submit_count == 1);
+        CHECK(rhi->m_rendering_wait_semaphores.empty());
+        CHECK(upload_queue.getRingUsedSize() == 0);
+        CHECK(upload_queue.getInFlightBatchCount() == 0);
+
+        // the staging offsets are aligned
+        uint8_t* staging_a = static_cast<uint8_t*>(upload_queue.uploadBuffer(&buffer_a, 0, 3));
+        uint8_t* staging_b = static_cast<uint8_t*>(upload_queue.uploadBuffer(&buffer_a, 3, 5));
+        CHECK((staging_b - staging_a) % RenderUploadQueue::k_staging_alignment == 0);
+        memset(staging_a, 1, 3);
+        memset(staging_b, 2, 5);
+        upload_queue.submit();
+        rhi->renderFrame();
+        CHECK(buffer_a.data[2] == 1 && buffer_a.data[3] == 2 && buffer_a.data[7] == 2);
+
+        upload_queue.clear();
+        checkReleased(*rhi);
+    }
+
+    // the destinations are shared with the graphics queue only when the transfer queue is another family
+    void testSharingMode()
+    {
+        auto              rhi = std::make_shared<MockRHI>();
+        RenderUploadQueue upload_queue;
+        upload_queue.initialize(rhi, 1024);
+        RHIBufferCreateInfo buffer_create_info {};
+        upload_queue.setSharingMode(buffer_create_info);
+        CHECK(buffer_create_info.sharingMode == RHI_SHARING_MODE_EXCLUSIVE);
+        CHECK(buffer_create_info.queueFamilyIndexCount == 0);
+        upload_queue.clear();
+
+        rhi->m_transfer_family = 2;
+        upload_queue.initialize(rhi, 1024);
+        upload_queue.setSharingMode(buffer_create_info);
+        CHECK(buffer_create_info.sharingMode == RHI_SHARING_MODE_CONCURRENT);
+        CHECK(buffer_create_info.queueFamilyIndexCount == 2);
+        CHECK(buffer_create_info.pQueueFamilyIndices[0] == 0 && buffer_create_info.pQueueFamilyIndices[1] == 2);
+        upload_queue.clear();
+        checkReleased(*rhi);
+    }
+
+    // an allocation past the end of the ring starts over at its beginning, next to the copies still in flight
+    void testRingWrap()
+    {
+        auto              rhi = std::make_shared<MockRHI>();
+        RenderUploadQueue upload_queue;
+        upload_queue.initialize(rhi, 1024);
+
+        MockBuffer           buffer = makeDstBuffer(4096);
+        std::vector<uint8_t> bytes  = makeBytes(1200, 4);
+
+        uint8_t* ring_begin = static_cast<uint8_t*>(upload_queue.uploadBuffer(&buffer, 0, 400));
+        memcpy(ring_begin, bytes.data(), 400);
+        upload_queue.submit();
+        rhi->renderFrame();
+
+        // the first batch is retired by this submit, the second one is retired by the next
+        uint8_t* ring_middle = static_cast<uint8_t*>(upload_queue.uploadBuffer(&buffer, 400, 400));
+        CHECK(ring_middle == ring_begin + 400);
+        memcpy(ring_middle, bytes.data() + 400, 400);
+        upload_queue.submit();
+        CHECK(upload_queue.getInFlightBatchCount() == 1);
+        rhi->renderFrame();
+
+        // the 224 bytes left at the end of the ring are too few
+        uint8_t* ring_wrapped = static_cast<uint8_t*>(upload_queue.uploadBuffer(&buffer, 800, 400));
+        CHECK(ring_wrapped == ring_begin);
+        CHECK(upload_queue.getRingUsedSize() == 1024);
+        memcpy(ring_wrapped, bytes.data() + 800, 400);
+        upload_queue.submit();
+        rhi->renderFrame();
+        CHECK(rhi->m_blocking_wait_count == 0);
+        CHECK(memcmp(buffer.data.data(), bytes.data(), 1200) == 0);
+
+        upload_queue.clear();
+        checkReleased(*rhi);
+    }
+
+    // the copies not fitting the ring within a frame are submitted early and waited for, without a semaphore of
+    // their own, the frame submit signals one covering them
+    void testEarlyFlush()
+    {
+        auto              rhi = std::make_shared<MockRHI>();
+        RenderUploadQueue upload_queue;
+        upload_queue.initialize(rhi, 1024);
+
+        MockBuffer           buffer = makeDstBuffer(4096);
+        std::vector<uint8_t> bytes  = makeBytes(4096, 5);
+        upload_queue.uploadBuffer(&buffer, 0, bytes.data(), 600);
+        upload_queue.uploadBuffer(&buffer, 600, bytes.data() + 600, 600);
+        CHECK(rhi->m_submit_count == 1);
+        CHECK(rhi->m_blocking_wait_count == 1);
+        CHECK(rhi->m_rendering_wait_semaphores.empty());
+
+        upload_queue.submit();
+        CHECK(rhi->m_rendering_wait_semaphores.size() == 1);
+        rhi->renderFrame();
+        CHECK(memcmp(buffer.data.data(), bytes.data(), 1200) == 0);
+
+        // two early submits, the semaphore of the frame submit orders them before the rendering as well
+        upload_queue.uploadBuffer(&buffer, 0, bytes.data(), 700);
+        upload_queue.uploadBuffer(&buffer, 700, bytes.data() + 700, 700);
+        upload_queue.uploadBuffer(&buffer, 1400, bytes.data() + 1400, 700);
+        CHECK(rhi->m_submit_count == 4);
+        // a frame skipped before its submit waits for nothing
+        rhi->renderFrame();
+        upload_queue.submit();
+        CHECK(rhi->m_rendering_wait_semaphores.size() == 1);
+        rhi->renderFrame();
+        CHECK(memcmp(buffer.data.data(), bytes.data(), 2100) == 0);
+
+        upload_queue.clear();
+        checkReleased(*rhi);
+    }
+
+    // larger than the ring, through a staging buffer of its own freed when its batch retires
+    void testOversizedUpload()
+    {
+        auto              rhi = std::make_shared<MockRHI>();
+        RenderUploadQueue upload_queue;
+        upload_queue.initialize(rhi, 1024);
+
+        const int            ring_buffer_count = rhi->m_live_buffer_count;
+        MockBuffer           buffer            = makeDstBuffer(5000);
+        std::vector<uint8_t> bytes             = makeBytes(5000, 6);
+        upload_queue.uploadBuffer(&buffer, 0, bytes.data(), 5000);
+        CHECK(rhi->m_live_buffer_count == ring_buffer_count + 1);
+        CHECK(upload_queue.getRingUsedSize() == 0);
+
+        upload_queue.submit();
+        rhi->renderFrame();
+        CHECK(memcmp(buffer.data.data(), bytes.data(), 5000) == 0);
+        CHECK(rhi->m_live_buffer_count == ring_buffer_count + 1);
+        upload_queue.submit();
+        CHECK(rhi->m_live_buffer_count == ring_buffer_count);
+
+        upload_queue.clear();
+        checkReleased(*rhi);
+    }
+
+    // random frames against a lazy gpu: each destination ends with the bytes written to it, so no staging memory
+    // was reused before its copy ran, and the semaphores are signaled once per wait
+    void testRandomFrames()
+    {
+        for (uint32_t seed = 1; seed <= 200; ++seed)
+        {
+            std::mt19937 random(seed);
+            auto         rhi     = std::make_shared<MockRHI>();
+            rhi->m_transfer_family = seed % 2;
+            RenderUploadQueue upload_queue;
+            upload_queue.initialize(rhi, 256 * (1 + random() % 16));
+
+            std::vector<MockBuffer>           buffers(8);
+            std::vector<std::vector<uint8_t>> expected_bytes(buffers.size());
+            std::vector<uint32_t>             buffer_ends(buffers.size(), 0);
+            for (size_t buffer_index = 0; buffer_index < buffers.size(); ++buffer_index)
+            {
+                buffers[buffer_index].data.assign(1 << 18, 0);
+                expected_bytes[buffer_index].assign(1 << 18, 0);
+            }
+
+            for (int frame = 0; frame < 60; ++frame)
+            {
+                const int upload_count = random() % 6;
+                for (int upload_index = 0; upload_index < upload_count; ++upload_index)
+                {
+                    const size_t   buffer_index = random() % buffers.size();
+                    const uint32_t size         = 1 + random() % (random() % 8 == 0 ? 8000 : 700);
+                    // the destination ranges do not overlap, like the buffers of the render resources
+                    const uint32_t offset = buffer_ends[buffer_index] + random() % 64;
+                    if (offset + size > buffers[buffer_index].data.size())
+                        continue;
+                    buffer_ends[buffer_index] = offset + size;
+
+                    std::vector<uint8_t> bytes = makeBytes(size, random());
+                    upload_queue.uploadBuffer(&buffers[buffer_index], offset, bytes.data(), size);
+                    memcpy(expected_bytes[buffer_index].data() + offset, bytes.data(), size);
+
+                    // the gpu progresses on its own
+                    while (random() % 3 == 0 && rhi->runSubmit())
+                        ;
+                }
+                // sometimes the frame is skipped before its submit, when the swapchain is recreated
+                if (random() % 7 != 0)
+                {
+                    upload_queue.submit();
+                }
+                rhi->renderFrame();
+            }
+            upload_queue.submit();
+            rhi->renderFrame();
+            rhi->runAllSubmits();
+
+            for (size_t buffer_index = 0; buffer_index < buffers.size(); ++buffer_index)
+            {
+                CHECK(buffers[buffer_index].data == expected_bytes[buffer_index]);
+            }
+            upload_queue.clear();
+            checkReleased(*rhi);
+        }
+    }
+} // namespace
+
+int main(int argc, char** argv)
+{
+    testBatching();
+    testSharingMode();
+    testRingWrap();
+    testEarlyFlush();
+    testOversizedUpload();
+    testRandomFrames();
+
+    if (s_failure_count != 0)
+    {
+        std::cerr << s_failure_count << " checks failed" << std::endl;
+        return 1;
+    }
+    return 0;
+}
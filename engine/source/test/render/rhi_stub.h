@@ -0,0 +1,283 @@
+#pragma once
+
+#include "runtime/function/render/interface/rhi.h"
+
+namespace Piccolo
+{
+    /// Every call of the RHI as a no-op returning a default value, the tests override the calls they observe.
+    class RHIStub : public RHI
+    {
+    public:
+        void initialize(RHIInitInfo initialize_info) override {}
+        void prepareContext() override {}
+        bool isPointLightShadowEnabled() override { return {}; }
+        bool isTextureCompressionBCSupported() override { return {}; }
+        bool allocateCommandBuffers(const RHICommandBufferAllocateInfo* pAllocateInfo,
+                                    RHICommandBuffer*&                  pCommandBuffers) override { return {}; }
+        bool allocateDescriptorSets(const RHIDescriptorSetAllocateInfo* pAllocateInfo,
+                                    RHIDescriptorSet*&                  pDescriptorSets) override { return {}; }
+        void createSwapchain() override {}
+        void recreateSwapchain() override {}
+        void createSwapchainImageViews() override {}
+        void createFramebufferImageAndView() override {}
+        RHISampler* getOrCreateDefaultSampler(RHIDefaultSamplerType type) override { return {}; }
+        RHISampler* getOrCreateMipmapSampler(uint32_t width, uint32_t height) override { return {}; }
+        RHIShader* createShaderModule(const std::vector<unsigned char>& shader_code) override { return {}; }
+        void createBuffer(RHIDeviceSize          size,
+                          RHIBufferUsageFlags    usage,
+                          RHIMemoryPropertyFlags properties,
+                          RHIBuffer*&            buffer,
+                          RHIDeviceMemory*&      buffer_memory) override {}
+        void createBufferAndInitialize(RHIBufferUsageFlags    usage,
+                                       RHIMemoryPropertyFlags properties,
+                                       RHIBuffer*&            buffer,
+                                       RHIDeviceMemory*&      buffer_memory,
+                                       RHIDeviceSize          size,
+                                       void*                  data,
+                                       int                    datasize) override {}
+        bool createBufferVMA(VmaAllocator                   allocator,
+                             const RHIBufferCreateInfo*     pBufferCreateInfo,
+                             const VmaAllocationCreateInfo* pAllocationCreateInfo,
+                             RHIBuffer*&                    pBuffer,
+                             VmaAllocation*                 pAllocation,
+                             VmaAllocationInfo*             pAllocationInfo) override { return {}; }
+        bool createBufferWithAlignmentVMA(VmaAllocator                   allocator,
+                                          const RHIBufferCreateInfo*     pBufferCreateInfo,
+                                          const VmaAllocationCreateInfo* pAllocationCreateInfo,
+                                          RHIDeviceSize                  minAlignment,
+                                          RHIBuffer*&                    pBuffer,
+                                          VmaAllocation*                 pAllocation,
+                                          VmaAllocationInfo*             pAllocationInfo) override { return {}; }
+        void copyBuffer(RHIBuffer*    srcBuffer,
+                        RHIBuffer*    dstBuffer,
+                        RHIDeviceSize srcOffset,
+                        RHIDeviceSize dstOffset,
+                        RHIDeviceSize size) override {}
+        void createImage(uint32_t               image_width,
+                         uint32_t               image_height,
+                         RHIFormat              format,
+                         RHIImageTiling         image_tiling,
+                         RHIImageUsageFlags     image_usage_flags,
+                         RHIMemoryPropertyFlags memory_property_flags,
+                         RHIImage*&             image,
+                         RHIDeviceMemory*&      memory,
+                         RHIImageCreateFlags    image_create_flags,
+                         uint32_t               array_layers,
+                         uint32_t               miplevels) override {}
+        void createImageView(RHIImage*           image,
+                             RHIFormat           format,
+                             RHIImageAspectFlags image_aspect_flags,
+                             RHIImageViewType    view_type,
+                             uint32_t            layout_count,
+                             uint32_t            miplevels,
+                             RHIImageView*&      image_view) override {}
+        void createGlobalImage(RHIImage*&     image,
+                               RHIImageView*& image_view,
+                               VmaAllocation& image_allocation,
+                               uint32_t       texture_image_width,
+                               uint32_t       texture_image_height,
+                               void*          texture_image_pixels,
+                               RHIFormat      texture_image_format,
+                               uint32_t       miplevels,
+                               uint32_t       pixel_miplevels) override {}
+        void createCubeMap(RHIImage*&           image,
+                           RHIImageView*&       image_view,
+                           VmaAllocation&       image_allocation,
+                           uint32_t             texture_image_width,
+                           uint32_t             texture_image_height,
+                           std::array<void*, 6> texture_image_pixels,
+                           RHIFormat            texture_image_format,
+                           uint32_t             miplevels,
+                           uint32_t             pixel_miplevels) override {}
+        void createCommandPool() override {}
+        bool createCommandPool(const RHICommandPoolCreateInfo* pCreateInfo,
+                               RHICommandPool*&                pCommandPool) override { return {}; }
+        bool createDescriptorPool(const RHIDescriptorPoolCreateInfo* pCreateInfo,
+                                  RHIDescriptorPool*&                pDescriptorPool) override { return {}; }
+        bool createDescriptorSetLayout(const RHIDescriptorSetLayoutCreateInfo* pCreateInfo,
+                                       RHIDescriptorSetLayout*&                pSetLayout) override { return {}; }
+        bool createFence(const RHIFenceCreateInfo* pCreateInfo, RHIFence*& pFence) override { return {}; }
+        bool createFramebuffer(const RHIFramebufferCreateInfo* pCreateInfo,
+                               RHIFramebuffer*&                pFramebuffer) override { return {}; }
+        bool createGraphicsPipelines(RHIPipelineCache*                    pipelineCache,
+                                     uint32_t                             createInfoCount,
+                                     const RHIGraphicsPipelineCreateInfo* pCreateInfos,
+                                     RHIPipeline*&                        pPipelines) override { return {}; }
+        bool createComputePipelines(RHIPipelineCache*                   pipelineCache,
+                                    uint32_t                            createInfoCount,
+                                    const RHIComputePipelineCreateInfo* pCreateInfos,
+                                    RHIPipeline*&                       pPipelines) override { return {}; }
+        bool createPipelineLayout(const RHIPipelineLayoutCreateInfo* pCreateInfo,
+                                  RHIPipelineLayout*&                pPipelineLayout) override { return {}; }
+        bool createRenderPass(const RHIRenderPassCreateInfo* pCreateInfo,
+                              RHIRenderPass*&                pRenderPass) override { return {}; }
+        bool createSampler(const RHISamplerCreateInfo* pCreateInfo, RHISampler*& pSampler) override { return {}; }
+        bool createSemaphore(const RHISemaphoreCreateInfo* pCreateInfo,
+                             RHISemaphore*&                pSemaphore) override { return {}; }
+        bool waitForFencesPFN(uint32_t         fenceCount,
+                              RHIFence* const* pFence,
+                              RHIBool32        waitAll,
+                              uint64_t         timeout) override { return {}; }
+        bool resetFencesPFN(uint32_t fenceCount, RHIFence* const* pFences) override { return {}; }
+        bool resetCommandPoolPFN(RHICommandPool* commandPool, RHICommandPoolResetFlags flags) override { return {}; }
+        bool beginCommandBufferPFN(RHICommandBuffer*                commandBuffer,
+                                   const RHICommandBufferBeginInfo* pBeginInfo) override { return {}; }
+        bool endCommandBufferPFN(RHICommandBuffer* commandBuffer) override { return {}; }
+        void cmdBeginRenderPassPFN(RHICommandBuffer*             commandBuffer,
+                                   const RHIRenderPassBeginInfo* pRenderPassBegin,
+                                   RHISubpassContents            contents) override {}
+        void cmdNextSubpassPFN(RHICommandBuffer* commandBuffer, RHISubpassContents contents) override {}
+        void cmdEndRenderPassPFN(RHICommandBuffer* commandBuffer) override {}
+        void cmdBindPipelinePFN(RHICommandBuffer*    commandBuffer,
+                                RHIPipelineBindPoint pipelineBindPoint,
+                                RHIPipeline*         pipeline) override {}
+        void cmdSetViewportPFN(RHICommandBuffer*  commandBuffer,
+                               uint32_t           firstViewport,
+                               uint32_t           viewportCount,
+                               const RHIViewport* pViewports) override {}
+        void cmdSetScissorPFN(RHICommandBuffer* commandBuffer,
+                              uint32_t          firstScissor,
+                              uint32_t          scissorCount,
+                              const RHIRect2D*  pScissors) override {}
+        void cmdBindVertexBuffersPFN(RHICommandBuffer*    commandBuffer,
+                                     uint32_t             firstBinding,
+                                     uint32_t             bindingCount,
+                                     RHIBuffer* const*    pBuffers,
+                                     const RHIDeviceSize* pOffsets) override {}
+        void cmdBindIndexBufferPFN(RHICommandBuffer* commandBuffer,
+                                   RHIBuffer*        buffer,
+                                   RHIDeviceSize     offset,
+                                   RHIIndexType      indexType) override {}
+        void cmdBindDescriptorSetsPFN(RHICommandBuffer*              commandBuffer,
+                                      RHIPipelineBindPoint           pipelineBindPoint,
+                                      RHIPipelineLayout*             layout,
+                                      uint32_t                       firstSet,
+                                      uint32_t                       descriptorSetCount,
+                                      const RHIDescriptorSet* const* pDescriptorSets,
+                                      uint32_t                       dynamicOffsetCount,
+                                      const uint32_t*                pDynamicOffsets) override {}
+        void cmdDrawIndexedPFN(RHICommandBuffer* commandBuffer,
+                               uint32_t          indexCount,
+                               uint32_t          instanceCount,
+                               uint32_t          firstIndex,
+                               int32_t           vertexOffset,
+                               uint32_t          firstInstance) override {}
+        void cmdClearAttachmentsPFN(RHICommandBuffer*         commandBuffer,
+                                    uint32_t                  attachmentCount,
+                                    const RHIClearAttachment* pAttachments,
+                                    uint32_t                  rectCount,
+                                    const RHIClearRect*       pRects) override {}
+        bool beginCommandBuffer(RHICommandBuffer*                commandBuffer,
+                                const RHICommandBufferBeginInfo* pBeginInfo) override { return {}; }
+        void cmdCopyImageToBuffer(RHICommandBuffer*         commandBuffer,
+                                  RHIImage*                 srcImage,
+                                  RHIImageLayout            srcImageLayout,
+                                  RHIBuffer*                dstBuffer,
+                                  uint32_t                  regionCount,
+                                  const RHIBufferImageCopy* pRegions) override {}
+        void cmdCopyImageToImage(RHICommandBuffer*      commandBuffer,
+                                 RHIImage*              srcImage,
+                                 RHIImageAspectFlagBits srcFlag,
+                                 RHIImage*              dstImage,
+                                 RHIImageAspectFlagBits dstFlag,
+                                 uint32_t               width,
+                                 uint32_t               height) override {}
+        void cmdCopyBuffer(RHICommandBuffer* commandBuffer,
+                           RHIBuffer*        srcBuffer,
+                           RHIBuffer*        dstBuffer,
+                           uint32_t          regionCount,
+                           RHIBufferCopy*    pRegions) override {}
+        void cmdDraw(RHICommandBuffer* commandBuffer,
+                     uint32_t          vertexCount,
+                     uint32_t          instanceCount,
+                     uint32_t          firstVertex,
+                     uint32_t          firstInstance) override {}
+        void cmdDispatch(RHICommandBuffer* commandBuffer,
+                         uint32_t          groupCountX,
+                         uint32_t          groupCountY,
+                         uint32_t          groupCountZ) override {}
+        void cmdDispatchIndirect(RHICommandBuffer* commandBuffer, RHIBuffer* buffer, RHIDeviceSize offset) override {}
+        void cmdPipelineBarrier(RHICommandBuffer*             commandBuffer,
+                                RHIPipelineStageFlags         srcStageMask,
+                                RHIPipelineStageFlags         dstStageMask,
+                                RHIDependencyFlags            dependencyFlags,
+                                uint32_t                      memoryBarrierCount,
+                                const RHIMemoryBarrier*       pMemoryBarriers,
+                                uint32_t                      bufferMemoryBarrierCount,
+                                const RHIBufferMemoryBarrier* pBufferMemoryBarriers,
+                                uint32_t                      imageMemoryBarrierCount,
+                                const RHIImageMemoryBarrier*  pImageMemoryBarriers) override {}
+        bool endCommandBuffer(RHICommandBuffer* commandBuffer) override { return {}; }
+        void updateDescriptorSets(uint32_t                     descriptorWriteCount,
+                                  const RHIWriteDescriptorSet* pDescriptorWrites,
+                                  uint32_t                     descriptorCopyCount,
+                                  const RHICopyDescriptorSet*  pDescriptorCopies) override {}
+        bool queueSubmit(RHIQueue*            queue,
+                         uint32_t             submitCount,
+                         const RHISubmitInfo* pSubmits,
+                         RHIFence*            fence) override { return {}; }
+        bool queueWaitIdle(RHIQueue* queue) override { return {}; }
+        bool getFenceStatus(RHIFence* fence) override { return {}; }
+        void resetCommandPool() override {}
+        void waitForFences() override {}
+        void getPhysicalDeviceProperties(RHIPhysicalDeviceProperties* pProperties) override {}
+        RHICommandBuffer* getCurrentCommandBuffer() const override { return {}; }
+        RHICommandBuffer* const* getCommandBufferList() const override { return {}; }
+        RHICommandPool* getCommandPoor() const override { return {}; }
+        RHIDescriptorPool* getDescriptorPoor() const override { return {}; }
+        RHIFence* const* getFenceList() const override { return {}; }
+        QueueFamilyIndices getQueueFamilyIndices() const override { return {}; }
+        RHIQueue* getGraphicsQueue() const override { return {}; }
+        RHIQueue* getComputeQueue() const override { return {}; }
+        RHIQueue* getTransferQueue() const override { return {}; }
+        RHISwapChainDesc getSwapchainInfo() override { return {}; }
+        RHIDepthImageDesc getDepthImageInfo() const override { return {}; }
+        uint8_t getMaxFramesInFlight() const override { return {}; }
+        uint8_t getCurrentFrameIndex() const override { return {}; }
+        void setCurrentFrameIndex(uint8_t index) override {}
+        RHICommandBuffer* beginSingleTimeCommands() override { return {}; }
+        void endSingleTimeCommands(RHICommandBuffer* command_buffer) override {}
+        void addRenderingWaitSemaphore(RHISemaphore* semaphore, RHIPipelineStageFlags wait_stage_mask) override {}
+        bool prepareBeforePass(std::function<void()> passUpdateAfterRecreateSwapchain) override { return {}; }
+        void submitRendering(std::function<void()> passUpdateAfterRecreateSwapchain) override {}
+        void pushEvent(RHICommandBuffer* commond_buffer, const char* name, const float* color) override {}
+        void popEvent(RHICommandBuffer* commond_buffer) override {}
+        void clear() override {}
+        void clearSwapchain() override {}
+        void destroyDefaultSampler(RHIDefaultSamplerType type) override {}
+        void destroyMipmappedSampler() override {}
+        void destroyShaderModule(RHIShader* shader) override {}
+        void destroySemaphore(RHISemaphore* semaphore) override {}
+        void destroySampler(RHISampler* sampler) override {}
+        void destroyInstance(RHIInstance* instance) override {}
+        void destroyImageView(RHIImageView* imageView) override {}
+        void destroyImage(RHIImage* image) override {}
+        void destroyFramebuffer(RHIFramebuffer* framebuffer) override {}
+        void destroyFence(RHIFence* fence) override {}
+        void destroyDevice() override {}
+        void destroyCommandPool(RHICommandPool* commandPool) override {}
+        void destroyBuffer(RHIBuffer*& buffer) override {}
+        void freeCommandBuffers(RHICommandPool*   commandPool,
+                                uint32_t          commandBufferCount,
+                                RHICommandBuffer* pCommandBuffers) override {}
+        void freeMemory(RHIDeviceMemory*& memory) override {}
+        bool mapMemory(RHIDeviceMemory*  memory,
+                       RHIDeviceSize     offset,
+                       RHIDeviceSize     size,
+                       RHIMemoryMapFlags flags,
+                       void**            ppData) override { return {}; }
+        void unmapMemory(RHIDeviceMemory* memory) override {}
+        void invalidateMappedMemoryRanges(void*            pNext,
+                                          RHIDeviceMemory* memory,
+                                          RHIDeviceSize    offset,
+                                          RHIDeviceSize    size) override {}
+        void flushMappedMemoryRanges(void*            pNext,
+                                     RHIDeviceMemory* memory,
+                                     RHIDeviceSize    offset,
+                                     RHIDeviceSize    size) override {}
+        RHISemaphore*& getTextureCopySemaphore(uint32_t index) override { return m_texture_copy_semaphore; }
+
+    private:
+        RHISemaphore* m_texture_copy_semaphore {nullptr};
+    };
+} // namespace Piccolo
@@ -0,0 +1,83 @@
+#!/usr/bin/env python3
+#
+# Generate engine/asset/level/animation_benchmark.level.json: the level of 1-1 with a grid of
+# animated crowd characters, used to measure how the component tick scales with the job system.
+#
+# usage: python3 scripts/generate_animation_benchmark_level.py [--rows 48] [--columns 48] [--spacing 1.5]
+#
+# to run the benchmark:
+#   1. set DefaultWorld=asset/world/animation_benchmark.world.json in PiccoloEditor.ini
+#   2. set JobWorkerCount=0, 1, 3, ... in PiccoloEditor.ini (negative or absent: one per hardware thread)
+#   3. start the editor, enter game mode and enable Menu > Debug > Performance > show tick time
+# or, without the editor, run PiccoloAssetCooker engine/asset --benchmark animation, which ticks the
+# animation components of the level on 0, 1, 2, 4... job workers
+#
+# the generated level is about 700 KB for 48x48 characters, so it is not checked in.
+# the crowd characters are not moved, but their skeletons are evaluated and skinned every tick
+# like the one of the player.
+
+import argparse
+import json
+import os
+
+ENGINE_DIR = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "engine")
+SOURCE_LEVEL = os.path.join(ENGINE_DIR, "asset", "level", "1-1.level.json")
+OUTPUT_LEVEL = os.path.join(ENGINE_DIR, "asset", "level", "animation_benchmark.level.json")
+CROWD_DEFINITION = "asset/objects/character/crowd/crowd.object.json"
+
+
+def make_crowd_object(index, x, y):
+    return {
+        "name": "Crowd_%d" % index,
+        "instanced_components": [
+            {
+                "$typeName": "TransformComponent",
+                "$context": {
+                    "transform": {
+                        "position": {"x": x, "y": y, "z": 0},
+                        "rotation": {"w": 1, "x": 0, "y": 0, "z": 0},
+                        "scale": {"x": 1, "y": 1, "z": 1},
+                    }
+                },
+            }
+        ],
+        "definition": CROWD_DEFINITION,
+    }
+
+
+def main():
+    parser = argparse.ArgumentParser(description="generate the animation benchmark level")
+    parser.add_argument("--rows", type=int, default=48)
+    parser.add_argument("--columns", type=int, default=48)
+    parser.add_argument("--spacing", type=float, default=1.5)
+    args = parser.parse_args()
+
+    with open(SOURCE_LEVEL, "r") as source_file:
+        level = json.load(source_file)
+
+    # keep the player and the ground of 1-1, drop the walls that would hide the crowd
+    level["objects"] = [obj for obj in level["objects"] if obj["name"] in ("Player", "Ground")]
+
+    origin_x = -0.5 * (args.columns - 1) * args.spacing
+    origin_y = 6.0
+    for row in range(args.rows):
+        for column in range(args.columns):
+            level["objects"].append(
+                make_crowd_object(row * args.columns + column,
+                                  origin_x + column * args.spacing,
+                                  origin_y + row * args.spacing))
+
+    # one object per line keeps the generated file reasonably small
+    with open(OUTPUT_LEVEL, "w") as output_file:
+        output_file.write("{\n")
+        output_file.write('  "gravity": %s,\n' % json.dumps(level["gravity"]))
+        output_file.write('  "character_name": %s,\n' % json.dumps(level["character_name"]))
+        output_file.write('  "objects": [\n')
+        output_file.write(",\n".join("    " + json.dumps(obj) for obj in level["objects"]))
+        output_file.write("\n  ]\n}\n")
+
+    print("%d crowd characters written to %s" % (args.rows * args.columns, os.path.normpath(OUTPUT_LEVEL)))
+
+
+if __name__ == "__main__":
+    main()
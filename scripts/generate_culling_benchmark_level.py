@@ -0,0 +1,85 @@
+#!/usr/bin/env python3
+#
+# Generate engine/asset/level/culling_benchmark.level.json: the level of 1-1 with a large grid of static
+# mesh objects, used to measure the visibility culling of the render scene.
+#
+# usage: python3 scripts/generate_culling_benchmark_level.py [--count 100000] [--spacing 4.0]
+#
+# to run the benchmark:
+#   1. set DefaultWorld=asset/world/culling_benchmark.world.json in PiccoloEditor.ini
+#   2. start the editor and enable Menu > Debug > Performance > show tick time,
+#      the culling time of each view is shown under the tick time
+#
+# the generated level is about 40 MB for 100k objects, so it is not checked in.
+# the blocks have no rigid body, they only add render entities.
+
+import argparse
+import json
+import math
+import os
+import random
+
+ENGINE_DIR = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "engine")
+SOURCE_LEVEL = os.path.join(ENGINE_DIR, "asset", "level", "1-1.level.json")
+OUTPUT_LEVEL = os.path.join(ENGINE_DIR, "asset", "level", "culling_benchmark.level.json")
+BLOCK_DEFINITION = "asset/objects/benchmark/culling_block.object.json"
+
+
+def make_block_object(index, x, y, z, yaw):
+    return {
+        "name": "Block_%d" % index,
+        "instanced_components": [
+            {
+                "$typeName": "TransformComponent",
+                "$context": {
+                    "transform": {
+                        "position": {"x": x, "y": y, "z": z},
+                        "rotation": {"w": math.cos(0.5 * yaw), "x": 0, "y": 0, "z": math.sin(0.5 * yaw)},
+                        "scale": {"x": 1, "y": 1, "z": 1},
+                    }
+                },
+            }
+        ],
+        "definition": BLOCK_DEFINITION,
+    }
+
+
+def main():
+    parser = argparse.ArgumentParser(description="generate the culling benchmark level")
+    parser.add_argument("--count", type=int, default=100000)
+    parser.add_argument("--spacing", type=float, default=4.0)
+    args = parser.parse_args()
+
+    with open(SOURCE_LEVEL, "r") as source_file:
+        level = json.load(source_file)
+
+    # keep the player and the ground of 1-1, the blocks surround them
+    level["objects"] = [obj for obj in level["objects"] if obj["name"] in ("Player", "Ground")]
+
+    # the same level every time, so the timings can be compared
+    rng = random.Random(0)
+    columns = int(math.ceil(math.sqrt(args.count)))
+    origin = -0.5 * (columns - 1) * args.spacing
+    for index in range(args.count):
+        row, column = divmod(index, columns)
+        level["objects"].append(
+            make_block_object(index,
+                              origin + column * args.spacing + rng.uniform(-1.0, 1.0),
+                              origin + row * args.spacing + rng.uniform(-1.0, 1.0),
+                              rng.uniform(0.0, 4.0),
+                              rng.uniform(0.0, 2.0 * math.pi)))
+
+    # one object per line keeps the generated file reasonably small
+    with open(OUTPUT_LEVEL, "w") as output_file:
+        output_file.write("{\n")
+        output_file.write('  "gravity": %s,\n' % json.dumps(level["gravity"]))
+        output_file.write('  "character_name": %s,\n' % json.dumps(level["character_name"]))
+        output_file.write('  "objects": [\n')
+        output_file.write(",\n".join("    " + json.dumps(obj) for obj in level["objects"]))
+        output_file.write("\n  ]\n}\n")
+
+    print("%d blocks written to %s" % (args.count, os.path.normpath(OUTPUT_LEVEL)))
+
+
+if __name__ == "__main__":
+    main()